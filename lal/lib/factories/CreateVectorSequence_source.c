@@ -21,7 +21,7 @@ STYPE * XFUNC ( UINT4 length, UINT4 veclen )
   if ( ! length || ! veclen )
     XLAL_ERROR_NULL( XLAL_EBADLEN );
 
-  seq = LALMalloc( sizeof( *seq ) );
+  seq = XLALPoolMalloc( sizeof( *seq ) );
   if ( ! seq )
     XLAL_ERROR_NULL( XLAL_ENOMEM );
 
@@ -32,7 +32,7 @@ STYPE * XFUNC ( UINT4 length, UINT4 veclen )
     seq->data = NULL;
   else
   {
-    seq->data = LALMalloc( length * veclen * sizeof( *seq->data ) );
+    seq->data = XLALPoolMalloc( length * veclen * sizeof( *seq->data ) );
     if ( ! seq )
     {
       LALFree( seq );
@@ -31,6 +31,10 @@
 #include <lal/Window.h>
 #include <lal/Date.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 static COMPLEX16 cabs2(COMPLEX16 z)
 {
 	double x = creal(z);
@@ -418,18 +422,347 @@ static void median_cleanup_REAL8( REAL8FrequencySeries *work, UINT4 n )
   return;
 }
 
-/* comparison for floating point numbers */
-static int compare_REAL4( const void *p1, const void *p2 )
+/* partially order an array so that element k holds the value it would
+ * hold if the array were sorted, with no larger values before it and no
+ * smaller values after it (Hoare's selection algorithm, expected O(n)) */
+static void select_REAL4( REAL4 *a, INT8 n, INT8 k )
+{
+  INT8 lo = 0;
+  INT8 hi = n - 1;
+  while ( hi > lo )
+  {
+    INT8 mid = lo + (hi - lo)/2;
+    INT8 i = lo;
+    INT8 j = hi;
+    REAL4 pivot;
+    REAL4 tmp;
+
+    /* median-of-three pivot */
+    if ( a[mid] < a[lo] ) { tmp = a[mid]; a[mid] = a[lo]; a[lo] = tmp; }
+    if ( a[hi] < a[lo] ) { tmp = a[hi]; a[hi] = a[lo]; a[lo] = tmp; }
+    if ( a[hi] < a[mid] ) { tmp = a[hi]; a[hi] = a[mid]; a[mid] = tmp; }
+    pivot = a[mid];
+
+    /* partition */
+    while ( i <= j )
+    {
+      while ( a[i] < pivot )
+        ++i;
+      while ( pivot < a[j] )
+        --j;
+      if ( i <= j )
+      {
+        tmp = a[i]; a[i] = a[j]; a[j] = tmp;
+        ++i;
+        --j;
+      }
+    }
+
+    /* continue in the partition that contains k */
+    if ( k <= j )
+      hi = j;
+    else if ( k >= i )
+      lo = i;
+    else
+      break;
+  }
+  return;
+}
+static void select_REAL8( REAL8 *a, INT8 n, INT8 k )
+{
+  INT8 lo = 0;
+  INT8 hi = n - 1;
+  while ( hi > lo )
+  {
+    INT8 mid = lo + (hi - lo)/2;
+    INT8 i = lo;
+    INT8 j = hi;
+    REAL8 pivot;
+    REAL8 tmp;
+
+    /* median-of-three pivot */
+    if ( a[mid] < a[lo] ) { tmp = a[mid]; a[mid] = a[lo]; a[lo] = tmp; }
+    if ( a[hi] < a[lo] ) { tmp = a[hi]; a[hi] = a[lo]; a[lo] = tmp; }
+    if ( a[hi] < a[mid] ) { tmp = a[hi]; a[hi] = a[mid]; a[mid] = tmp; }
+    pivot = a[mid];
+
+    /* partition */
+    while ( i <= j )
+    {
+      while ( a[i] < pivot )
+        ++i;
+      while ( pivot < a[j] )
+        --j;
+      if ( i <= j )
+      {
+        tmp = a[i]; a[i] = a[j]; a[j] = tmp;
+        ++i;
+        --j;
+      }
+    }
+
+    /* continue in the partition that contains k */
+    if ( k <= j )
+      hi = j;
+    else if ( k >= i )
+      lo = i;
+    else
+      break;
+  }
+  return;
+}
+
+/* median of an array; the array is reordered */
+static REAL4 median_REAL4( REAL4 *a, UINT4 n )
 {
-  REAL4 x1 = *(const REAL4 *)p1;
-  REAL4 x2 = *(const REAL4 *)p2;
-  return (x1 > x2) - (x1 < x2);
+  REAL4 lower;
+  UINT4 i;
+  select_REAL4( a, n, n/2 );
+  if ( n % 2 ) /* odd number */
+    return a[n/2];
+  /* even number... average with the largest value of the lower half */
+  lower = a[0];
+  for ( i = 1; i < n/2; ++i )
+    if ( a[i] > lower )
+      lower = a[i];
+  return 0.5*(lower + a[n/2]);
+}
+static REAL8 median_REAL8( REAL8 *a, UINT4 n )
+{
+  REAL8 lower;
+  UINT4 i;
+  select_REAL8( a, n, n/2 );
+  if ( n % 2 ) /* odd number */
+    return a[n/2];
+  /* even number... average with the largest value of the lower half */
+  lower = a[0];
+  for ( i = 1; i < n/2; ++i )
+    if ( a[i] > lower )
+      lower = a[i];
+  return 0.5*(lower + a[n/2]);
+}
+
+/*
+ * compute the modified periodograms of numseg segments of length seglen,
+ * the first starting at sample offset of the time series and successive
+ * ones spaced by step samples.  the segments are independent so they are
+ * computed in parallel when OpenMP is enabled; the calling thread uses the
+ * supplied plan and every other thread creates a plan of its own.  the
+ * time series is not modified.
+ */
+static int median_periodograms_REAL4(
+    REAL4FrequencySeries        *work,
+    UINT4                        numseg,
+    const REAL4TimeSeries       *tseries,
+    UINT4                        seglen,
+    UINT4                        offset,
+    UINT4                        step,
+    const REAL4Window           *window,
+    const REAL4FFTPlan          *plan
+    )
+{
+  int errnum = 0;
+
+#pragma omp parallel
+  {
+    const REAL4FFTPlan *thread_plan = plan;
+    REAL4FFTPlan *own_plan = NULL;
+    int thread_errnum = 0;
+    UINT4 seg;
+
+#ifdef _OPENMP
+    if ( omp_get_thread_num() != 0 )
+    {
+      thread_plan = own_plan = XLALCreateForwardREAL4FFTPlan( seglen, 0 );
+      if ( ! own_plan )
+        thread_errnum = XLAL_EFUNC;
+    }
+#endif
+
+#pragma omp for schedule(dynamic)
+    for ( seg = 0; seg < numseg; ++seg )
+    {
+      REAL4TimeSeries segment = *tseries;
+      REAL4Vector segdata;
+
+      if ( thread_errnum )
+        continue;
+
+      /* point at the data for this segment */
+      segdata.length = seglen;
+      segdata.data   = tseries->data->data + offset + seg * step;
+      segment.data   = &segdata;
+
+      /* compute the modified periodogram for this segment */
+      if ( XLALREAL4ModifiedPeriodogram( work + seg, &segment, window, thread_plan ) == XLAL_FAILURE )
+        thread_errnum = XLAL_EFUNC;
+    }
+
+    XLALDestroyREAL4FFTPlan( own_plan );
+    if ( thread_errnum )
+    {
+#pragma omp critical (AverageSpectrum_median_periodograms)
+      errnum = thread_errnum;
+    }
+  }
+
+  if ( errnum )
+    XLAL_ERROR( errnum );
+  return 0;
+}
+static int median_periodograms_REAL8(
+    REAL8FrequencySeries        *work,
+    UINT4                        numseg,
+    const REAL8TimeSeries       *tseries,
+    UINT4                        seglen,
+    UINT4                        offset,
+    UINT4                        step,
+    const REAL8Window           *window,
+    const REAL8FFTPlan          *plan
+    )
+{
+  int errnum = 0;
+
+#pragma omp parallel
+  {
+    const REAL8FFTPlan *thread_plan = plan;
+    REAL8FFTPlan *own_plan = NULL;
+    int thread_errnum = 0;
+    UINT4 seg;
+
+#ifdef _OPENMP
+    if ( omp_get_thread_num() != 0 )
+    {
+      thread_plan = own_plan = XLALCreateForwardREAL8FFTPlan( seglen, 0 );
+      if ( ! own_plan )
+        thread_errnum = XLAL_EFUNC;
+    }
+#endif
+
+#pragma omp for schedule(dynamic)
+    for ( seg = 0; seg < numseg; ++seg )
+    {
+      REAL8TimeSeries segment = *tseries;
+      REAL8Vector segdata;
+
+      if ( thread_errnum )
+        continue;
+
+      /* point at the data for this segment */
+      segdata.length = seglen;
+      segdata.data   = tseries->data->data + offset + seg * step;
+      segment.data   = &segdata;
+
+      /* compute the modified periodogram for this segment */
+      if ( XLALREAL8ModifiedPeriodogram( work + seg, &segment, window, thread_plan ) == XLAL_FAILURE )
+        thread_errnum = XLAL_EFUNC;
+    }
+
+    XLALDestroyREAL8FFTPlan( own_plan );
+    if ( thread_errnum )
+    {
+#pragma omp critical (AverageSpectrum_median_periodograms)
+      errnum = thread_errnum;
+    }
+  }
+
+  if ( errnum )
+    XLAL_ERROR( errnum );
+  return 0;
+}
+
+/*
+ * compute the bias-corrected bin-by-bin median of numseg periodograms into
+ * spectrum, scaled by normfac.  frequency bins are distributed over
+ * threads when OpenMP is enabled, each thread with its own scratch array.
+ */
+static int median_bins_REAL4(
+    REAL4 *spectrum,
+    UINT4 length,
+    const REAL4FrequencySeries *work,
+    UINT4 numseg,
+    REAL4 normfac,
+    int accumulate
+    )
+{
+  int errnum = 0;
+
+#pragma omp parallel
+  {
+    /* create array to hold a particular frequency bin data */
+    REAL4 *bin = XLALMalloc( numseg * sizeof( *bin ) );
+    UINT4 k;
+
+    if ( ! bin )
+    {
+#pragma omp critical (AverageSpectrum_median_bins)
+      errnum = XLAL_ENOMEM;
+    }
+
+#pragma omp for schedule(static)
+    for ( k = 0; k < length; ++k )
+    {
+      UINT4 seg;
+      if ( ! bin )
+        continue;
+      for ( seg = 0; seg < numseg; ++seg )
+        bin[seg] = work[seg].data->data[k];
+      if ( accumulate )
+        spectrum[k] += normfac * median_REAL4( bin, numseg );
+      else
+        spectrum[k] = normfac * median_REAL4( bin, numseg );
+    }
+
+    XLALFree( bin );
+  }
+
+  if ( errnum )
+    XLAL_ERROR( errnum );
+  return 0;
 }
-static int compare_REAL8( const void *p1, const void *p2 )
+static int median_bins_REAL8(
+    REAL8 *spectrum,
+    UINT4 length,
+    const REAL8FrequencySeries *work,
+    UINT4 numseg,
+    REAL8 normfac,
+    int accumulate
+    )
 {
-  REAL8 x1 = *(const REAL8 *)p1;
-  REAL8 x2 = *(const REAL8 *)p2;
-  return (x1 > x2) - (x1 < x2);
+  int errnum = 0;
+
+#pragma omp parallel
+  {
+    /* create array to hold a particular frequency bin data */
+    REAL8 *bin = XLALMalloc( numseg * sizeof( *bin ) );
+    UINT4 k;
+
+    if ( ! bin )
+    {
+#pragma omp critical (AverageSpectrum_median_bins)
+      errnum = XLAL_ENOMEM;
+    }
+
+#pragma omp for schedule(static)
+    for ( k = 0; k < length; ++k )
+    {
+      UINT4 seg;
+      if ( ! bin )
+        continue;
+      for ( seg = 0; seg < numseg; ++seg )
+        bin[seg] = work[seg].data->data[k];
+      if ( accumulate )
+        spectrum[k] += normfac * median_REAL8( bin, numseg );
+      else
+        spectrum[k] = normfac * median_REAL8( bin, numseg );
+    }
+
+    XLALFree( bin );
+  }
+
+  if ( errnum )
+    XLAL_ERROR( errnum );
+  return 0;
 }
 
 
@@ -440,6 +773,12 @@ static int compare_REAL8( const void *p1, const void *p2 )
  * is accounted for -- because the segments are not independent and their
  * correlation is non-zero.
  *
+ * The segment periodograms are computed in parallel when LAL is built with
+ * OpenMP support, each thread other than the calling one using an FFT plan
+ * of its own, and the median of each frequency bin is found by selection
+ * rather than by sorting.  To keep a median PSD up to date as new data
+ * arrives, see XLALPSDRunningMedianNew().
+ *
  */
 int XLALREAL4AverageSpectrumMedian(
     REAL4FrequencySeries        *spectrum,
@@ -451,13 +790,11 @@ int XLALREAL4AverageSpectrumMedian(
     )
 {
   REAL4FrequencySeries *work; /* array of frequency series */
-  REAL4 *bin; /* array of bin values */
   REAL4 biasfac; /* median bias factor */
   REAL4 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 seg;
-  UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
       XLAL_ERROR( XLAL_EFAULT );
@@ -490,38 +827,11 @@ int XLALREAL4AverageSpectrumMedian(
     }
   }
 
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    REAL4Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL4ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL4( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
+  /* compute the modified periodograms of all segments */
+  if ( median_periodograms_REAL4( work, numseg, tseries, seglen, 0, stride, window, plan ) == XLAL_FAILURE )
   {
     median_cleanup_REAL4( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* compute median bias factor */
@@ -530,22 +840,11 @@ int XLALREAL4AverageSpectrumMedian(
   /* normaliztion takes into account bias */
   normfac = 1.0 / biasfac;
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median */
+  if ( median_bins_REAL4( spectrum->data->data, spectrum->data->length, work, numseg, normfac, 0 ) == XLAL_FAILURE )
   {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg )
-      bin[seg] = work[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL4 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
-
-    /* remove median bias */
-    spectrum->data->data[k] *= normfac;
+    median_cleanup_REAL4( work, numseg ); /* cleanup */
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* set metadata */
@@ -555,7 +854,6 @@ int XLALREAL4AverageSpectrumMedian(
   spectrum->sampleUnits = work->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_cleanup_REAL4( work, numseg );
 
   return 0;
@@ -568,6 +866,12 @@ int XLALREAL4AverageSpectrumMedian(
  * is accounted for -- because the segments are not independent and their
  * correlation is non-zero.
  *
+ * The segment periodograms are computed in parallel when LAL is built with
+ * OpenMP support, each thread other than the calling one using an FFT plan
+ * of its own, and the median of each frequency bin is found by selection
+ * rather than by sorting.  To keep a median PSD up to date as new data
+ * arrives, see XLALPSDRunningMedianNew().
+ *
  */
 int XLALREAL8AverageSpectrumMedian(
     REAL8FrequencySeries        *spectrum,
@@ -579,13 +883,11 @@ int XLALREAL8AverageSpectrumMedian(
     )
 {
   REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
   REAL8 biasfac; /* median bias factor */
   REAL8 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 seg;
-  UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
       XLAL_ERROR( XLAL_EFAULT );
@@ -618,38 +920,11 @@ int XLALREAL8AverageSpectrumMedian(
     }
   }
 
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
+  /* compute the modified periodograms of all segments */
+  if ( median_periodograms_REAL8( work, numseg, tseries, seglen, 0, stride, window, plan ) == XLAL_FAILURE )
   {
     median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* compute median bias factor */
@@ -658,22 +933,11 @@ int XLALREAL8AverageSpectrumMedian(
   /* normaliztion takes into account bias */
   normfac = 1.0 / biasfac;
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median */
+  if ( median_bins_REAL8( spectrum->data->data, spectrum->data->length, work, numseg, normfac, 0 ) == XLAL_FAILURE )
   {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg )
-      bin[seg] = work[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL8 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
-
-    /* remove median bias */
-    spectrum->data->data[k] *= normfac;
+    median_cleanup_REAL8( work, numseg ); /* cleanup */
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* set metadata */
@@ -683,7 +947,6 @@ int XLALREAL8AverageSpectrumMedian(
   spectrum->sampleUnits = work->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_cleanup_REAL8( work, numseg );
 
   return 0;
@@ -749,14 +1012,12 @@ int XLALREAL4AverageSpectrumMedianMean(
 {
   REAL4FrequencySeries *even; /* array of even frequency series */
   REAL4FrequencySeries *odd;  /* array of odd frequency series */
-  REAL4 *bin; /* array of bin values */
   REAL4 biasfac; /* median bias factor */
   REAL4 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 halfnumseg;
   UINT4 seg;
-  UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
       XLAL_ERROR( XLAL_EFAULT );
@@ -799,53 +1060,12 @@ int XLALREAL4AverageSpectrumMedianMean(
     }
   }
 
-  for ( seg = 0; seg < halfnumseg; ++seg )
-  {
-    REAL4Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += 2 * seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL4ModifiedPeriodogram( even + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* set the data vector to be appropriate for the odd segment */
-    tseries->data->data += stride;
-
-    /* compute the modified periodogram for the odd segment */
-    code = XLALREAL4ModifiedPeriodogram( odd + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
-  if ( ! bin )
+  /* compute the modified periodograms of the even and the odd segments */
+  if ( median_periodograms_REAL4( even, halfnumseg, tseries, seglen, 0, 2 * stride, window, plan ) == XLAL_FAILURE
+    || median_periodograms_REAL4( odd, halfnumseg, tseries, seglen, stride, 2 * stride, window, plan ) == XLAL_FAILURE )
   {
     median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* compute median bias factor */
@@ -855,36 +1075,13 @@ int XLALREAL4AverageSpectrumMedianMean(
    * the even and the odd */
   normfac = 1.0 / ( 2.0 * biasfac );
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median-mean: the spectrum
+   * for each bin is the mean of the even and the odd medians */
+  if ( median_bins_REAL4( spectrum->data->data, spectrum->data->length, even, halfnumseg, normfac, 0 ) == XLAL_FAILURE
+    || median_bins_REAL4( spectrum->data->data, spectrum->data->length, odd, halfnumseg, normfac, 1 ) == XLAL_FAILURE )
   {
-    REAL4 evenmedian;
-    REAL4 oddmedian;
-
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = even[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* assign array of odd segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = odd[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* spectrum for this bin is the mean of the medians */
-    spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* set metadata */
@@ -894,7 +1091,6 @@ int XLALREAL4AverageSpectrumMedianMean(
   spectrum->sampleUnits = even->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_mean_cleanup_REAL4( even, odd, halfnumseg );
 
   return 0;
@@ -918,14 +1114,12 @@ int XLALREAL8AverageSpectrumMedianMean(
 {
   REAL8FrequencySeries *even; /* array of even frequency series */
   REAL8FrequencySeries *odd;  /* array of odd frequency series */
-  REAL8 *bin; /* array of bin values */
   REAL8 biasfac; /* median bias factor */
   REAL8 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 halfnumseg;
   UINT4 seg;
-  UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
       XLAL_ERROR( XLAL_EFAULT );
@@ -968,53 +1162,12 @@ int XLALREAL8AverageSpectrumMedianMean(
     }
   }
 
-  for ( seg = 0; seg < halfnumseg; ++seg )
-  {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += 2 * seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( even + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* set the data vector to be appropriate for the odd segment */
-    tseries->data->data += stride;
-
-    /* compute the modified periodogram for the odd segment */
-    code = XLALREAL8ModifiedPeriodogram( odd + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
-  if ( ! bin )
+  /* compute the modified periodograms of the even and the odd segments */
+  if ( median_periodograms_REAL8( even, halfnumseg, tseries, seglen, 0, 2 * stride, window, plan ) == XLAL_FAILURE
+    || median_periodograms_REAL8( odd, halfnumseg, tseries, seglen, stride, 2 * stride, window, plan ) == XLAL_FAILURE )
   {
     median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* compute median bias factor */
@@ -1024,36 +1177,13 @@ int XLALREAL8AverageSpectrumMedianMean(
    * the even and the odd */
   normfac = 1.0 / ( 2.0 * biasfac );
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median-mean: the spectrum
+   * for each bin is the mean of the even and the odd medians */
+  if ( median_bins_REAL8( spectrum->data->data, spectrum->data->length, even, halfnumseg, normfac, 0 ) == XLAL_FAILURE
+    || median_bins_REAL8( spectrum->data->data, spectrum->data->length, odd, halfnumseg, normfac, 1 ) == XLAL_FAILURE )
   {
-    REAL8 evenmedian;
-    REAL8 oddmedian;
-
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = even[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* assign array of odd segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = odd[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* spectrum for this bin is the mean of the medians */
-    spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* set metadata */
@@ -1063,7 +1193,6 @@ int XLALREAL8AverageSpectrumMedianMean(
   spectrum->sampleUnits = even->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_mean_cleanup_REAL8( even, odd, halfnumseg );
 
   return 0;
@@ -1738,9 +1867,9 @@ int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *samp
     for(j = 0; j < history_length; j++)
       bin_history[j] = r->history[j]->data[i];
 
-    /* sort (to find the median) */
+    /* find the median (history_length is odd) */
 
-    qsort(bin_history, history_length, sizeof(*bin_history), compare_REAL8);
+    select_REAL8(bin_history, history_length, history_length / 2);
     log_bin_median = log(bin_history[history_length / 2]);
 
     /* use logarithm of median to update geometric mean.
@@ -1898,6 +2027,294 @@ int XLALPSDRegressorSetPSD(LALPSDRegressor *r, const REAL8FrequencySeries *psd,
 }
 
 
+/*
+ * Running median PSD functions.
+ */
+
+
+/**
+ * Allocate and initialize a LALPSDRunningMedian object.
+ *
+ * The LALPSDRunningMedian object maintains the bin-by-bin median of the
+ * most recent median_samples modified periodograms, so that a median PSD
+ * can be kept up to date as new segments of data arrive instead of being
+ * recomputed from scratch with XLALREAL8AverageSpectrumMedian().  For each
+ * frequency bin the object keeps the history values in sorted order;
+ * adding a periodogram replaces the oldest value in each bin's sorted list
+ * with the new one, which costs at most O(median_samples) operations per
+ * bin and usually far fewer, and reading the PSD is O(1) per bin.
+ *
+ * Once median_samples periodograms have been added, the PSD returned by
+ * XLALPSDRunningMedianGetPSD() is identical to that computed by
+ * XLALREAL8AverageSpectrumMedian() from the same median_samples segments.
+ * Until then, the median of the periodograms received so far is returned,
+ * corrected for the median bias of that number of samples.
+ */
+LALPSDRunningMedian *XLALPSDRunningMedianNew(unsigned median_samples)
+{
+  LALPSDRunningMedian *new;
+  REAL8Sequence **history;
+
+  /* require the number of samples used for the median to be positive */
+  if(median_samples < 1)
+    XLAL_ERROR_NULL(XLAL_EINVAL);
+
+  new = XLALMalloc(sizeof(*new));
+  history = XLALCalloc(median_samples, sizeof(*history));
+  if(!new || !history)
+  {
+    XLALFree(new);
+    XLALFree(history);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+
+  new->median_samples = median_samples;
+  new->n_samples = 0;
+  new->oldest = 0;
+  new->history = history;
+  new->sorted = NULL;
+  new->spectrum = NULL;
+
+  return new;
+}
+
+/**
+ * Reset a LALPSDRunningMedian object to the newly-allocated state.  This
+ * discards the median history and the internal frequency series
+ * parameters.
+ */
+void XLALPSDRunningMedianReset(LALPSDRunningMedian *r)
+{
+  if(r->history)
+  {
+    unsigned i;
+    for(i = 0; i < r->median_samples; i++)
+    {
+      XLALDestroyREAL8Sequence(r->history[i]);
+      r->history[i] = NULL;
+    }
+  }
+  XLALFree(r->sorted);
+  r->sorted = NULL;
+  XLALDestroyREAL8FrequencySeries(r->spectrum);
+  r->spectrum = NULL;
+  r->n_samples = 0;
+  r->oldest = 0;
+}
+
+/**
+ * Free all memory associated with a LALPSDRunningMedian object.  The
+ * object must not be used again after calling this function.
+ */
+void XLALPSDRunningMedianFree(LALPSDRunningMedian *r)
+{
+  if(r)
+  {
+    XLALPSDRunningMedianReset(r);
+    XLALFree(r->history);
+    r->history = NULL;
+  }
+  XLALFree(r);
+}
+
+/**
+ * Return the number of periodograms currently contributing to the median.
+ * This counts the periodograms that have been added, until the count
+ * reaches median_samples and then it stops increasing.
+ */
+unsigned XLALPSDRunningMedianGetNSamples(const LALPSDRunningMedian *r)
+{
+  return r->n_samples;
+}
+
+/**
+ * Return the median_samples of a LALPSDRunningMedian object.
+ */
+unsigned XLALPSDRunningMedianGetMedianSamples(const LALPSDRunningMedian *r)
+{
+  return r->median_samples;
+}
+
+/**
+ * Update a LALPSDRunningMedian object from a periodogram, such as one
+ * computed with XLALREAL8ModifiedPeriodogram().  Once median_samples
+ * periodograms have been added, the oldest one is dropped from the median
+ * each time a new one is added.  The periodogram is copied, this function
+ * does not take ownership of it.
+ *
+ * The properties of the first periodogram added set the frequency
+ * resolution and length of the PSD;  subsequent periodograms must match
+ * them.  The epoch of the PSD is that of the most recent periodogram.  The
+ * periodogram must not contain NaNs.
+ */
+int XLALPSDRunningMedianAdd(LALPSDRunningMedian *r, const REAL8FrequencySeries *periodogram)
+{
+  REAL8Sequence *slot;
+  const REAL8 *pdata;
+  UINT4 length;
+  UINT4 i;
+
+  if(!r || !periodogram || !periodogram->data)
+    XLAL_ERROR(XLAL_EFAULT);
+  pdata = periodogram->data->data;
+  length = periodogram->data->length;
+  for(i = 0; i < length; i++)
+    if(isnan(pdata[i]))
+      XLAL_ERROR(XLAL_EFPINVAL, "periodogram bin %u is NaN", i);
+
+  /* is this the first sample? */
+
+  if(!r->n_samples)
+  {
+    /* create space for the history and the sorted bin values */
+
+    XLALPSDRunningMedianReset(r);
+    r->spectrum = XLALCreateREAL8FrequencySeries(periodogram->name, &periodogram->epoch, periodogram->f0, periodogram->deltaF, &periodogram->sampleUnits, length);
+    r->sorted = XLALMalloc((size_t) length * r->median_samples * sizeof(*r->sorted));
+    if(!r->spectrum || !r->sorted)
+    {
+      XLALPSDRunningMedianReset(r);
+      XLAL_ERROR(XLAL_EFUNC);
+    }
+    for(i = 0; i < r->median_samples; i++)
+    {
+      r->history[i] = XLALCreateREAL8Sequence(length);
+      if(!r->history[i])
+      {
+        XLALPSDRunningMedianReset(r);
+        XLAL_ERROR(XLAL_EFUNC);
+      }
+    }
+  }
+  else if((periodogram->f0 != r->spectrum->f0) || (periodogram->deltaF != r->spectrum->deltaF) || (length != r->spectrum->data->length) || XLALUnitCompare(&periodogram->sampleUnits, &r->spectrum->sampleUnits))
+    XLAL_ERROR(XLAL_EDATA, "input parameter mismatch");
+
+  r->spectrum->epoch = periodogram->epoch;
+
+  /* each bin's sorted list has room for median_samples values and
+   * currently holds n_samples of them.  if the history is full, the value
+   * from the oldest periodogram is replaced by the new one, otherwise the
+   * new value is inserted.  in both cases the new value is moved into
+   * place by shifting its neighbours, so the cost is proportional to how
+   * far the bin's rank changes.  bins are independent and are distributed
+   * over threads when OpenMP is enabled */
+
+  slot = r->history[r->oldest];
+
+#pragma omp parallel for schedule(static)
+  for(i = 0; i < length; i++)
+  {
+    REAL8 *sorted = r->sorted + (size_t) i * r->median_samples;
+    REAL8 value = pdata[i];
+    UINT4 j;
+
+    if(r->n_samples < r->median_samples)
+      j = r->n_samples;
+    else
+    {
+      /* binary search for the value being dropped */
+      REAL8 old = slot->data[i];
+      UINT4 lo = 0, hi = r->n_samples - 1;
+      while(lo < hi)
+      {
+        UINT4 mid = lo + (hi - lo) / 2;
+        if(sorted[mid] < old)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      j = lo;
+      while(j + 1 < r->n_samples && sorted[j + 1] < value)
+      {
+        sorted[j] = sorted[j + 1];
+        j++;
+      }
+    }
+    while(j > 0 && sorted[j - 1] > value)
+    {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+    slot->data[i] = value;
+  }
+
+  /* advance the ring buffer */
+
+  r->oldest = (r->oldest + 1) % r->median_samples;
+  if(r->n_samples < r->median_samples)
+    r->n_samples++;
+
+  return 0;
+}
+
+/**
+ * Compute the modified periodogram of a segment of time series data with
+ * XLALREAL8ModifiedPeriodogram() and add it to a LALPSDRunningMedian
+ * object with XLALPSDRunningMedianAdd().  The length of the time series
+ * must equal the length of the forward FFT plan.
+ */
+int XLALPSDRunningMedianAddSegment(LALPSDRunningMedian *r, const REAL8TimeSeries *tseries, const REAL8Window *window, const REAL8FFTPlan *plan)
+{
+  REAL8FrequencySeries *periodogram;
+
+  if(!r || !tseries || !tseries->data || !plan)
+    XLAL_ERROR(XLAL_EFAULT);
+
+  periodogram = XLALCreateREAL8FrequencySeries(tseries->name, &tseries->epoch, tseries->f0, 0.0, &lalDimensionlessUnit, tseries->data->length / 2 + 1);
+  if(!periodogram)
+    XLAL_ERROR(XLAL_EFUNC);
+
+  if(XLALREAL8ModifiedPeriodogram(periodogram, tseries, window, plan) || XLALPSDRunningMedianAdd(r, periodogram))
+  {
+    XLALDestroyREAL8FrequencySeries(periodogram);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+
+  XLALDestroyREAL8FrequencySeries(periodogram);
+  return 0;
+}
+
+/**
+ * Retrieve a copy of the current median PSD estimate.  The return value is
+ * a newly-allocated frequency series object, normalized in the same way
+ * as the output of XLALREAL8AverageSpectrumMedian().  The calling code is
+ * responsible for freeing it when it no longer needs it.
+ */
+REAL8FrequencySeries *XLALPSDRunningMedianGetPSD(const LALPSDRunningMedian *r)
+{
+  REAL8FrequencySeries *psd;
+  UINT4 n;
+  REAL8 normfac;
+  UINT4 i;
+
+  /* initialized yet? */
+
+  if(!r->n_samples)
+    XLAL_ERROR_NULL(XLAL_EDATA, "not initialized");
+
+  psd = XLALCutREAL8FrequencySeries(r->spectrum, 0, r->spectrum->data->length);
+  if(!psd)
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+
+  /* normalization takes into account the median bias */
+
+  n = r->n_samples;
+  normfac = 1.0 / XLALMedianBias(n);
+
+  for(i = 0; i < psd->data->length; i++)
+  {
+    const REAL8 *sorted = r->sorted + (size_t) i * r->median_samples;
+    if(n % 2) /* odd number of samples */
+      psd->data->data[i] = normfac * sorted[n / 2];
+    else /* even number... take average */
+      psd->data->data[i] = normfac * (0.5 * (sorted[n / 2 - 1] + sorted[n / 2]));
+  }
+
+  return psd;
+}
+
+
 /**
  * Compute the two-point spectral correlation function for a whitened
  * frequency series from the window applied to the original time series.
@@ -186,6 +186,22 @@ tagLALPSDRegressor
 }
 LALPSDRegressor;
 
+/**
+ * Running bin-by-bin median of the most recent median_samples
+ * periodograms; see XLALPSDRunningMedianNew().
+ */
+typedef struct
+tagLALPSDRunningMedian
+{
+  unsigned median_samples;	/**< number of periodograms in the median */
+  unsigned n_samples;		/**< number of periodograms received, up to median_samples */
+  unsigned oldest;		/**< index in history of the oldest periodogram */
+  REAL8Sequence **history;	/**< ring buffer of periodograms */
+  REAL8 *sorted;		/**< sorted history of each frequency bin, median_samples values per bin */
+  REAL8FrequencySeries *spectrum;	/**< metadata of the PSD */
+}
+LALPSDRunningMedian;
+
 /*
  *
  * XLAL Functions
@@ -411,6 +427,48 @@ XLALPSDRegressorSetPSD(
 );
 
 
+LALPSDRunningMedian *
+XLALPSDRunningMedianNew(
+    unsigned median_samples
+);
+
+void
+XLALPSDRunningMedianFree(
+    LALPSDRunningMedian *r
+);
+
+void
+XLALPSDRunningMedianReset(
+    LALPSDRunningMedian *r
+);
+
+unsigned XLALPSDRunningMedianGetNSamples(
+    const LALPSDRunningMedian *r
+);
+
+unsigned XLALPSDRunningMedianGetMedianSamples(
+    const LALPSDRunningMedian *r
+);
+
+int
+XLALPSDRunningMedianAdd(
+    LALPSDRunningMedian *r,
+    const REAL8FrequencySeries *periodogram
+);
+
+int
+XLALPSDRunningMedianAddSegment(
+    LALPSDRunningMedian *r,
+    const REAL8TimeSeries *tseries,
+    const REAL8Window *window,
+    const REAL8FFTPlan *plan
+);
+
+REAL8FrequencySeries *
+XLALPSDRunningMedianGetPSD(
+    const LALPSDRunningMedian *r
+);
+
 /** @} */
 
 #if 0
@@ -99,6 +99,10 @@ static void XLALSetDebugLevel(void)
                 level |= LALMEMDBG; /* enable memory debugging tools */
             } else if (XLALStringNCaseCompare("MEMTRACE", token, toklen) == 0) {
                 level |= LALMEMTRACE; /* enable memory tracing tools */
+            } else if (XLALStringNCaseCompare("MEMACCT", token, toklen) == 0) {
+                level |= LALMEMACCT; /* enable lightweight memory accounting */
+            } else if (XLALStringNCaseCompare("MEMACCTTRK", token, toklen) == 0) {
+                level |= LALMEMACCTTRK; /* enable lightweight memory accounting with sampled tracking */
             } else if (XLALStringNCaseCompare("ALLDBG", token, toklen) == 0) {
                 level |= LALALLDBG; /* enable all debugging */
             } else {
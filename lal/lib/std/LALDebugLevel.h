@@ -37,7 +37,8 @@ enum {
     LALMEMDBGBIT = 0020,  /**< enable memory debugging routines */
     LALMEMPADBIT = 0040,  /**< enable memory padding */
     LALMEMTRKBIT = 0100,  /**< enable memory tracking */
-    LALMEMINFOBIT = 0200  /**< enable memory info messages */
+    LALMEMINFOBIT = 0200, /**< enable memory info messages */
+    LALMEMACCTBIT = 0400  /**< enable lightweight memory accounting in place of padding */
 };
 
 /** composite lalDebugLevel values */
@@ -52,6 +53,8 @@ enum {
     LALMSGLVL3 = LALERRORBIT | LALWARNINGBIT | LALINFOBIT,      /**< enable error, warning, and info messages */
     LALMEMDBG = LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT,     /**< enable memory debugging tools */
     LALMEMTRACE = LALTRACEBIT | LALMEMDBG | LALMEMINFOBIT,      /**< enable memory tracing tools */
+    LALMEMACCT = LALMEMDBGBIT | LALMEMACCTBIT,  /**< enable lightweight memory accounting */
+    LALMEMACCTTRK = LALMEMACCT | LALMEMTRKBIT,  /**< enable lightweight memory accounting with sampled tracking */
     LALALLDBG = ~LALNDEBUG      /**< enable all debugging */
 };
 
@@ -34,6 +34,12 @@
 #define UNUSED
 #endif
 
+#if defined(LAL_PTHREAD_LOCK) && defined(__GNUC__)
+#define THREAD_LOCAL __thread
+#else
+#define THREAD_LOCAL
+#endif
+
 /* global variables */
 size_t lalMallocTotal = 0;	/**< current amount of memory allocated by process */
 size_t lalMallocTotalPeak = 0;	/**< peak amount of memory allocated so far */
@@ -124,6 +130,383 @@ void XLALFreeLong(void *p, const char *file UNUSED, int line UNUSED)
     return;
 }
 
+/*
+ * Memory pools.
+ *
+ * A memory pool serves the allocations made with XLALPoolMalloc() by one
+ * thread between XLALBeginMemoryPool() and XLALEndMemoryPool().  Requests
+ * are rounded up to a power-of-two size class of at least poolMinSize
+ * bytes, and each class is carved from its own slabs of memory, so that the
+ * size class of a block can be found from its slab when it is freed.  Freed
+ * blocks are kept on a free list for their class, and are only returned to
+ * the system when the pool ends.  The pools of a thread form a stack, the
+ * innermost of which serves new allocations.
+ *
+ * The slabs of the pools of all threads are kept in one table sorted by
+ * address, so that a block can be recognised as a pool block whichever
+ * thread frees it; the table is only searched while some thread has a pool.
+ * Each slab records the pool it belongs to, and the generation of the pool
+ * in which each of its blocks was allocated; the generation is incremented
+ * when the pool is reset.  Freeing a block of a pool of another thread, or
+ * a block that is not allocated in the current generation of its pool
+ * (because it was freed before, or the pool has been reset since), raises
+ * an error instead of corrupting the pool or the heap.
+ */
+
+#if !defined(LAL_MEMORY_FUNCTIONS_DISABLED) && (defined(__GNUC__) || !defined(LAL_PTHREAD_LOCK))
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_rwlock_t pool_lock = PTHREAD_RWLOCK_INITIALIZER;
+#else
+#define pthread_rwlock_rdlock( plock )
+#define pthread_rwlock_wrlock( plock )
+#define pthread_rwlock_unlock( plock )
+#endif
+
+#ifdef __GNUC__
+#define POOL_COUNT() __atomic_load_n(&pool_count, __ATOMIC_RELAXED)
+#define POOL_COUNT_ADD(v) __atomic_add_fetch(&pool_count, v, __ATOMIC_RELAXED)
+#else
+#define POOL_COUNT() pool_count
+#define POOL_COUNT_ADD(v) (pool_count += (v))
+#endif
+
+enum { poolClasses = 26 };
+static const size_t poolMinSize = 64;   /* smallest size class, and alignment of blocks */
+static const size_t poolSlabSize = 0x40000;
+
+struct memoryPool;
+
+struct poolSlab {
+    char *base;                 /* first block, aligned to poolMinSize */
+    size_t size;                /* size of the slab */
+    size_t used;                /* bytes of the slab carved into blocks */
+    int cls;                    /* size class of the blocks */
+    struct memoryPool *pool;    /* pool to which the slab belongs */
+    size_t *tag;                /* generation in which each block was allocated, or zero if free */
+    struct poolSlab *next;      /* next slab of the same class */
+};
+
+struct memoryPool {
+    struct memoryPool *outer;   /* enclosing pool of this thread */
+    size_t generation;          /* incremented when the pool is reset */
+    struct poolSlab *first[poolClasses];        /* slabs of each class */
+    struct poolSlab *current[poolClasses];      /* slab being carved */
+    void *freelist[poolClasses];                /* freed blocks */
+};
+
+/* freed blocks hold the next block on the free list, and their slab */
+struct poolFreeBlock {
+    void *next;
+    struct poolSlab *slab;
+};
+
+static struct poolSlab **pool_slab = NULL;      /* slabs of all pools, sorted by address */
+static size_t pool_nslab = 0;
+static size_t pool_maxslab = 0;
+static size_t pool_count = 0;                   /* number of pools of all threads */
+static THREAD_LOCAL struct memoryPool *pool_top = NULL;
+
+/* Find the slab to which a block belongs, and the pool of the slab */
+static struct poolSlab *PoolFind(void *p, struct memoryPool **owner)
+{
+    struct poolSlab *s = NULL;
+    size_t lo = 0;
+    size_t hi;
+    pthread_rwlock_rdlock(&pool_lock);
+    hi = pool_nslab;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if ((char *) p < pool_slab[mid]->base) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    if (lo > 0 && (char *) p < pool_slab[lo - 1]->base + pool_slab[lo - 1]->size) {
+        s = pool_slab[lo - 1];
+        *owner = s->pool;
+    }
+    pthread_rwlock_unlock(&pool_lock);
+    return s;
+}
+
+/* Find the slab and index of an allocated block of a pool of the calling
+ * thread; returns 0 if the block does not belong to a pool, 1 if it does,
+ * and -1 after raising an error if it may not be freed */
+static int PoolBlock(void *p, struct poolSlab **slab, size_t *k, const char *func)
+{
+    struct memoryPool *owner = NULL;
+    struct memoryPool *pool;
+    struct poolSlab *s;
+    size_t offset;
+    if (!POOL_COUNT() || !(s = PoolFind(p, &owner))) {
+        return 0;
+    }
+    for (pool = pool_top; pool && pool != owner; pool = pool->outer);
+    if (!pool) {
+        lalRaiseHook(SIGSEGV, "%s error: block %p belongs to a memory pool of another thread\n", func, p);
+        return -1;
+    }
+    offset = (char *) p - s->base;
+    if (offset % (poolMinSize << s->cls) || s->tag[offset / (poolMinSize << s->cls)] != pool->generation) {
+        lalRaiseHook(SIGSEGV, "%s error: pool block %p is not allocated (freed twice, or pool reset since)\n", func, p);
+        return -1;
+    }
+    *slab = s;
+    *k = offset / (poolMinSize << s->cls);
+    return 1;
+}
+
+/* Add a slab for blocks of class cls to the pool */
+static struct poolSlab *PoolAddSlab(struct memoryPool *pool, int cls)
+{
+    const size_t block = poolMinSize << cls;
+    const size_t size = block > poolSlabSize ? block : poolSlabSize;
+    const size_t nblock = size / block;
+    struct poolSlab *s;
+    size_t i;
+    s = XLALMalloc(sizeof(*s) + nblock * sizeof(*s->tag) + size + poolMinSize);
+    if (!s) {
+        return NULL;
+    }
+    s->tag = (size_t *) (s + 1);
+    memset(s->tag, 0, nblock * sizeof(*s->tag));
+    s->base = (char *) (s->tag + nblock);
+    s->base += (poolMinSize - (uintptr_t) s->base % poolMinSize) % poolMinSize;
+    s->size = size;
+    s->used = 0;
+    s->cls = cls;
+    s->pool = pool;
+    pthread_rwlock_wrlock(&pool_lock);
+    if (pool_nslab == pool_maxslab) {
+        /* the table is not allocated with XLALRealloc(), which would look
+         * up the pools while the lock is held */
+        size_t maxslab = pool_maxslab ? 2 * pool_maxslab : 16;
+        struct poolSlab **table = realloc(pool_slab, maxslab * sizeof(*table));
+        if (!table) {
+            pthread_rwlock_unlock(&pool_lock);
+            XLALFree(s);
+            return NULL;
+        }
+        pool_slab = table;
+        pool_maxslab = maxslab;
+    }
+    for (i = pool_nslab; i > 0 && pool_slab[i - 1]->base > s->base; --i) {
+        pool_slab[i] = pool_slab[i - 1];
+    }
+    pool_slab[i] = s;
+    ++pool_nslab;
+    pthread_rwlock_unlock(&pool_lock);
+    s->next = pool->first[cls];
+    pool->first[cls] = pool->current[cls] = s;
+    return s;
+}
+
+/* Allocate a block of at least n bytes from the innermost pool; returns
+ * NULL without error if the request is too large for the pool */
+static void *PoolAlloc(size_t n)
+{
+    struct memoryPool *pool = pool_top;
+    struct poolSlab *s;
+    size_t block = poolMinSize;
+    int cls = 0;
+    char *p;
+    while (block < n) {
+        block <<= 1;
+        if (++cls == poolClasses) {
+            return NULL;
+        }
+    }
+    if ((p = pool->freelist[cls])) {
+        s = ((struct poolFreeBlock *) p)->slab;
+        pool->freelist[cls] = ((struct poolFreeBlock *) p)->next;
+    } else {
+        for (s = pool->current[cls]; s && s->used + block > s->size; s = s->next);
+        pool->current[cls] = s;
+        if (!s && !(s = PoolAddSlab(pool, cls))) {
+            return NULL;
+        }
+        p = s->base + s->used;
+        s->used += block;
+    }
+    s->tag[(p - s->base) / block] = pool->generation;
+    return p;
+}
+
+/* Return block k of a slab to the free list of its pool */
+static void PoolRelease(struct poolSlab *s, size_t k)
+{
+    struct memoryPool *pool = s->pool;
+    struct poolFreeBlock *b = (struct poolFreeBlock *) (s->base + k * (poolMinSize << s->cls));
+    s->tag[k] = 0;
+    b->next = pool->freelist[s->cls];
+    b->slab = s;
+    pool->freelist[s->cls] = b;
+}
+
+/* Return a block to its pool if it belongs to one */
+static int PoolFree(void *p, const char *func)
+{
+    struct poolSlab *s;
+    size_t k;
+    int found = PoolBlock(p, &s, &k, func);
+    if (found > 0) {
+        PoolRelease(s, k);
+    }
+    return found != 0;
+}
+
+/* Resize a block belonging to a pool, using the given allocation function
+ * if the block has to move outside the pool */
+static int PoolRealloc(void *p, size_t n, void **q, void *(*alloc)(size_t, const char *, int), const char *func, const char *file, int line)
+{
+    struct poolSlab *s;
+    size_t block;
+    size_t k;
+    int found = PoolBlock(p, &s, &k, func);
+    if (found <= 0) {
+        *q = NULL;
+        return found != 0;
+    }
+    block = poolMinSize << s->cls;
+    if (n == 0) {
+        PoolRelease(s, k);
+        *q = NULL;
+    } else if (n <= block) {
+        *q = p;
+    } else {
+        *q = PoolAlloc(n);
+        if (!*q) {
+            *q = alloc(n, file, line);
+        }
+        if (*q) {
+            memcpy(*q, p, block);
+            PoolRelease(s, k);
+        }
+    }
+    return 1;
+}
+
+int XLALBeginMemoryPool(void)
+{
+    struct memoryPool *pool = XLALCalloc(1, sizeof(*pool));
+    if (!pool) {
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+    pool->generation = 1;
+    pool->outer = pool_top;
+    pool_top = pool;
+    POOL_COUNT_ADD(1);
+    return 0;
+}
+
+int XLALResetMemoryPool(void)
+{
+    struct memoryPool *pool = pool_top;
+    if (!pool) {
+        XLAL_ERROR(XLAL_EFAILED, "No memory pool in use");
+    }
+    ++pool->generation;
+    for (int cls = 0; cls < poolClasses; ++cls) {
+        for (struct poolSlab *s = pool->first[cls]; s; s = s->next) {
+            s->used = 0;
+        }
+        pool->current[cls] = pool->first[cls];
+        pool->freelist[cls] = NULL;
+    }
+    return 0;
+}
+
+int XLALEndMemoryPool(void)
+{
+    struct memoryPool *pool = pool_top;
+    size_t i, j;
+    if (!pool) {
+        XLAL_ERROR(XLAL_EFAILED, "No memory pool in use");
+    }
+    pool_top = pool->outer;
+    pthread_rwlock_wrlock(&pool_lock);
+    for (i = j = 0; i < pool_nslab; ++i) {
+        if (pool_slab[i]->pool != pool) {
+            pool_slab[j++] = pool_slab[i];
+        }
+    }
+    pool_nslab = j;
+    if (POOL_COUNT_ADD(-1) == 0) {
+        free(pool_slab);
+        pool_slab = NULL;
+        pool_maxslab = 0;
+    }
+    pthread_rwlock_unlock(&pool_lock);
+    for (int cls = 0; cls < poolClasses; ++cls) {
+        struct poolSlab *s = pool->first[cls];
+        while (s) {
+            struct poolSlab *next = s->next;
+            XLALFree(s);
+            s = next;
+        }
+    }
+    XLALFree(pool);
+    return 0;
+}
+
+void *XLALPoolMallocLong(size_t n, const char *file, int line)
+{
+    void *p;
+    if (pool_top && n && (p = PoolAlloc(n))) {
+        return p;
+    }
+    return XLALMallocLong(n, file, line);
+}
+
+#if LAL_FFTW3_MEMALIGN_ENABLED
+void *XLALPoolMallocAlignedLong(size_t n, const char *file, int line)
+{
+    void *p;
+    if (pool_top && n && (p = PoolAlloc(n))) {
+        return p;
+    }
+    return XLALMallocAlignedLong(n, file, line);
+}
+#endif
+
+#else /* pools not available */
+
+#define PoolFree(p, func) 0
+#define PoolRealloc(p, n, q, alloc, func, file, line) 0
+
+int XLALBeginMemoryPool(void) { return 0; }
+int XLALResetMemoryPool(void) { return 0; }
+int XLALEndMemoryPool(void) { return 0; }
+
+void *XLALPoolMallocLong(size_t n, const char *file, int line)
+{
+    return XLALMallocLong(n, file, line);
+}
+
+#if LAL_FFTW3_MEMALIGN_ENABLED
+void *XLALPoolMallocAlignedLong(size_t n, const char *file, int line)
+{
+    return XLALMallocAlignedLong(n, file, line);
+}
+#endif
+
+#endif /* pools available */
+
+void *(XLALPoolMalloc)(size_t n)
+{
+    return XLALPoolMallocLong(n, "unknown", -1);
+}
+
+#if LAL_FFTW3_MEMALIGN_ENABLED
+void *(XLALPoolMallocAligned)(size_t n)
+{
+    return XLALPoolMallocAlignedLong(n, "unknown", -1);
+}
+#endif
+
 /*
  * Aligned memory routines.
  */
@@ -178,6 +561,8 @@ void *(XLALCallocAligned)(size_t nelem, size_t elsize)
 void *XLALReallocAlignedLong(void *ptr, size_t size, const char *file, int line)
 {
 	void *p;
+	if (ptr && PoolRealloc(ptr, size, &p, XLALMallocAlignedLong, "XLALReallocAligned", file, line))
+		return p;
 	if (ptr == NULL)
 		return XLALMallocAlignedLong(size, file, line);
 	if (size == 0) {
@@ -197,6 +582,8 @@ void *XLALReallocAlignedLong(void *ptr, size_t size, const char *file, int line)
 void *(XLALReallocAligned)(void *ptr, size_t size)
 {
 	void *p;
+	if (ptr && PoolRealloc(ptr, size, &p, XLALMallocAlignedLong, "XLALReallocAligned", "unknown", -1))
+		return p;
 	if (ptr == NULL)
 		return XLALMallocAligned(size);
 	if (size == 0) {
@@ -215,6 +602,8 @@ void *(XLALReallocAligned)(void *ptr, size_t size)
 
 void XLALFreeAligned(void *ptr)
 {
+	if (ptr && PoolFree(ptr, "XLALFreeAligned"))
+		return;
 	free(ptr); /* use ordinary free */
 }
 
@@ -613,6 +1002,246 @@ static void *ModAlloc(void *p, void *q, size_t n, const char *func,
 }
 
 
+/*
+ * Lightweight memory accounting.
+ *
+ * When the LALMEMACCTBIT bit of lalDebugLevel is set along with
+ * LALMEMDBGBIT, and LALMEMPADBIT is not set, each allocation carries only
+ * a prefix recording its size, and the allocation totals are kept without
+ * taking the global lock: each thread accumulates its allocations in a
+ * counter slot of its own, and adds the accumulated byte count atomically to
+ * a signed running total once it reaches acctFlush bytes either way.  Since
+ * one thread may free memory allocated by another, the running total can go
+ * transiently negative; lalMallocTotal is set to the running total clamped
+ * at zero, and lalMallocTotalPeak is updated only when a positive byte count
+ * is added.  The number of live allocations is
+ * kept exactly in the slots and summed when required.  If LALMEMTRKBIT is
+ * also set, one in every acctSampleInterval allocations made by each thread
+ * is recorded in the allocation hash table, so that leaks and the sources of
+ * the allocations can be identified without locking on every allocation.
+ */
+
+enum { acctSlots = 64 };
+static const size_t acctFlush = 0x10000;
+static const unsigned int acctSampleInterval = 64;
+static const size_t acctMagic = 0xACC7Cafe;
+static const size_t acctSampleMagic = 0xACC75eed;
+
+#define ACCTMODE(level) (((level) & (LALMEMDBGBIT | LALMEMPADBIT | LALMEMACCTBIT)) == (LALMEMDBGBIT | LALMEMACCTBIT))
+
+/* per-thread counters, each on its own cache line; threads share slots
+ * only when there are more than acctSlots of them */
+static struct acctSlot {
+    size_t bytes;       /* bytes allocated but not yet added to lalMallocTotal */
+    size_t count;       /* number of live allocations */
+    char pad[64 - 2 * sizeof(size_t)];
+} acct_slot[acctSlots];
+static size_t acct_next_slot = 0;
+static size_t acct_total = 0;   /* running total as a signed ptrdiff_t, using unsigned wrap-around */
+static THREAD_LOCAL struct acctSlot *acct_thread_slot = NULL;
+static THREAD_LOCAL unsigned int acct_thread_sample = 0;
+
+/* Atomically add v to *x and return the result */
+static size_t AcctAdd(size_t *x, size_t v)
+{
+#ifdef __GNUC__
+    return __atomic_add_fetch(x, v, __ATOMIC_RELAXED);
+#else
+    pthread_mutex_lock(&mut);
+    v = (*x += v);
+    pthread_mutex_unlock(&mut);
+    return v;
+#endif
+}
+
+/* Atomically replace *x with zero and return its previous value */
+static size_t AcctTake(size_t *x)
+{
+#ifdef __GNUC__
+    return __atomic_exchange_n(x, 0, __ATOMIC_RELAXED);
+#else
+    size_t v;
+    pthread_mutex_lock(&mut);
+    v = *x;
+    *x = 0;
+    pthread_mutex_unlock(&mut);
+    return v;
+#endif
+}
+
+/* Atomically read *x */
+static size_t AcctLoad(size_t *x)
+{
+#ifdef __GNUC__
+    return __atomic_load_n(x, __ATOMIC_RELAXED);
+#else
+    size_t v;
+    pthread_mutex_lock(&mut);
+    v = *x;
+    pthread_mutex_unlock(&mut);
+    return v;
+#endif
+}
+
+/* Atomically set *x to v */
+static void AcctStore(size_t *x, size_t v)
+{
+#ifdef __GNUC__
+    __atomic_store_n(x, v, __ATOMIC_RELAXED);
+#else
+    pthread_mutex_lock(&mut);
+    *x = v;
+    pthread_mutex_unlock(&mut);
+#endif
+}
+
+/* Atomically replace *x with v if v is larger */
+static void AcctMax(size_t *x, size_t v)
+{
+#ifdef __GNUC__
+    size_t old = __atomic_load_n(x, __ATOMIC_RELAXED);
+    while (old < v && !__atomic_compare_exchange_n(x, &old, v, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+    pthread_mutex_lock(&mut);
+    if (*x < v) {
+        *x = v;
+    }
+    pthread_mutex_unlock(&mut);
+#endif
+}
+
+/* Add n bytes (negated for frees using unsigned wrap-around) to the
+ * running total, update lalMallocTotal and lalMallocTotalPeak, and return
+ * the clamped total */
+static size_t AcctFlush(size_t n)
+{
+    ptrdiff_t total = (ptrdiff_t) AcctAdd(&acct_total, n);
+    size_t clamped = total > 0 ? (size_t) total : 0;
+    AcctStore(&lalMallocTotal, clamped);
+    if ((ptrdiff_t) n > 0) {
+        AcctMax(&lalMallocTotalPeak, clamped);
+    }
+    return clamped;
+}
+
+/* Account for a change of n bytes and count allocations made by this
+ * thread; n and count are negated for frees using unsigned wrap-around */
+static void AcctUpdate(size_t n, size_t count)
+{
+    struct acctSlot *slot = acct_thread_slot;
+    ptrdiff_t pending;
+    if (slot == NULL) {
+        slot = acct_thread_slot = &acct_slot[(AcctAdd(&acct_next_slot, 1) - 1) % acctSlots];
+    }
+    AcctAdd(&slot->count, count);
+    pending = (ptrdiff_t) AcctAdd(&slot->bytes, n);
+    if (pending >= (ptrdiff_t) acctFlush || pending <= -(ptrdiff_t) acctFlush) {
+        AcctFlush(AcctTake(&slot->bytes));
+    }
+}
+
+/* Add the bytes held by all threads to the running total, and return the
+ * current totals */
+static void AcctTotals(size_t *total, size_t *count)
+{
+    size_t bytes = 0;
+    size_t allocs = 0;
+    for (int k = 0; k < acctSlots; ++k) {
+        bytes += AcctTake(&acct_slot[k].bytes);
+        allocs += AcctLoad(&acct_slot[k].count);
+    }
+    *total = AcctFlush(bytes);
+    *count = allocs;
+}
+
+static int AcctSample(void)
+{
+    if (!(lalDebugLevel & LALMEMTRKBIT)) {
+        return 0;
+    }
+    if (++acct_thread_sample < acctSampleInterval) {
+        return 0;
+    }
+    acct_thread_sample = 0;
+    return 1;
+}
+
+static void *AcctAlloc(size_t n, int zero, const char *func, const char *file, int line)
+{
+    size_t *p;
+    void *q;
+    p = zero ? calloc(1, n + prefix) : malloc(n + prefix);
+    if (!p) {
+        XLALPrintError("%s: failed to allocate %zd bytes of memory\n", func, n);
+        return NULL;
+    }
+    p[0] = n;
+    p[1] = acctMagic;
+    q = ((char *) p) + prefix;
+    if (AcctSample()) {
+        if (!PushAlloc(q, n, file, line)) {
+            free(p);
+            return NULL;
+        }
+        p[1] = acctSampleMagic;
+    }
+    AcctUpdate(n, 1);
+    return q;
+}
+
+/* Check the prefix of an allocation and return its start */
+static size_t *AcctCheck(void *q, const char *func, const char *file, int line)
+{
+    size_t *p = ((size_t *) q) - nprefix;
+    if (p[1] != acctMagic && p[1] != acctSampleMagic) {
+        lalRaiseHook(SIGSEGV,
+                     "%s error: wrong magic for pointer at address %p in %s:%d\n",
+                     func, q, file, line);
+        return NULL;
+    }
+    return p;
+}
+
+static void AcctFree(void *q, const char *func, const char *file, int line)
+{
+    size_t *p = AcctCheck(q, func, file, line);
+    if (!p) {
+        return;
+    }
+    if (p[1] == acctSampleMagic && !PopAlloc(q, func, file, line)) {
+        return;
+    }
+    AcctUpdate(-p[0], (size_t) -1);
+    p[1] = ~acctMagic;  /* detect duplicate frees */
+    free(p);
+}
+
+static void *AcctRealloc(void *q, size_t n, const char *func, const char *file, int line)
+{
+    size_t *p = AcctCheck(q, func, file, line);
+    size_t *r;
+    size_t size;
+    void *s;
+    if (!p) {
+        return NULL;
+    }
+    size = p[0];
+    r = realloc(p, n + prefix);
+    if (!r) {
+        XLALPrintError("%s: failed to allocate %zd bytes of memory\n", func, n);
+        return NULL;
+    }
+    r[0] = n;
+    s = ((char *) r) + prefix;
+    if (r[1] == acctSampleMagic && !ModAlloc(q, s, n, func, file, line)) {
+        /* the block is no longer in the hash table, but is still valid */
+        r[1] = acctMagic;
+    }
+    AcctUpdate(n - size, 0);
+    return s;
+}
+
+
 
 void *LALMallocShort(size_t n)
 {
@@ -625,10 +1254,14 @@ void *LALMallocLong(size_t n, const char *file, int line)
 {
     void *p;
     void *q;
+    int level = lalDebugLevel;
 
-    if (!(lalDebugLevel & LALMEMDBGBIT)) {
+    if (!(level & LALMEMDBGBIT)) {
         return malloc(n);
     }
+    if (ACCTMODE(level)) {
+        return AcctAlloc(n, 0, "LALMalloc", file, line);
+    }
 
     p = malloc(allocsz(n));
     q = PushAlloc(PadAlloc(p, n, 0, "LALMalloc", file, line), n, file, line);
@@ -662,12 +1295,17 @@ void *LALCallocLong(size_t m, size_t n, const char *file, int line)
     size_t sz;
     void *p;
     void *q;
+    int level = lalDebugLevel;
 
-    if (!(lalDebugLevel & LALMEMDBGBIT)) {
+    if (!(level & LALMEMDBGBIT)) {
         return calloc(m, n);
     }
 
     sz = m * n;
+    if (ACCTMODE(level)) {
+        return AcctAlloc(sz, 1, "LALCalloc", file, line);
+    }
+
     p = malloc(allocsz(sz));
     q = PushAlloc(PadAlloc(p, sz, 1, "LALCalloc", file, line), sz, file, line);
     lalMemDbgPtr = lalMemDbgRetPtr = q;
@@ -689,7 +1327,7 @@ void *LALCallocLong(size_t m, size_t n, const char *file, int line)
 
 void *LALReallocShort(void *p, size_t n)
 {
-    return (lalDebugLevel & LALMEMDBGBIT) ? LALReallocLong(p, n, "unknown", -1): realloc(p, n);
+    return LALReallocLong(p, n, "unknown", -1);
 }
 
 
@@ -697,9 +1335,24 @@ void *LALReallocShort(void *p, size_t n)
 void *LALReallocLong(void *q, size_t n, const char *file, const int line)
 {
     void *p;
-    if (!(lalDebugLevel & LALMEMDBGBIT)) {
+    int level;
+    if (q && PoolRealloc(q, n, &p, LALMallocLong, "LALRealloc", file, line)) {
+        return p;
+    }
+    level = lalDebugLevel;
+    if (!(level & LALMEMDBGBIT)) {
         return realloc(q, n);
     }
+    if (ACCTMODE(level)) {
+        if (!q) {
+            return AcctAlloc(n, 0, "LALRealloc", file, line);
+        }
+        if (!n) {
+            AcctFree(q, "LALRealloc", file, line);
+            return NULL;
+        }
+        return AcctRealloc(q, n, "LALRealloc", file, line);
+    }
 
     lalMemDbgPtr = lalMemDbgArgPtr = q;
     lalIsMemDbgPtr = lalIsMemDbgArgPtr = (lalMemDbgArgPtr == lalMemDbgUsrPtr);
@@ -764,12 +1417,18 @@ void LALFreeShort(void *q)
 void LALFreeLong(void *q, const char *file, const int line)
 {
     void *p;
-    if (q == NULL)
+    int level;
+    if (q == NULL || PoolFree(q, "LALFree"))
         return;
-    if (!(lalDebugLevel & LALMEMDBGBIT)) {
+    level = lalDebugLevel;
+    if (!(level & LALMEMDBGBIT)) {
         free(q);
         return;
     }
+    if (ACCTMODE(level)) {
+        AcctFree(q, "LALFree", file, line);
+        return;
+    }
     lalMemDbgPtr = lalMemDbgArgPtr = q;
     lalIsMemDbgPtr = lalIsMemDbgArgPtr = (lalMemDbgArgPtr == lalMemDbgUsrPtr);
     p = UnPadAlloc(PopAlloc(q, "LALFree", file, line), 0, "LALFree", file, line);
@@ -807,6 +1466,16 @@ void LALCheckMemoryLeaks(void)
         leak = 1;
     }
 
+    /* the accounting totals should be zero */
+    if (ACCTMODE(lalDebugLevel)) {
+        size_t total, count;
+        AcctTotals(&total, &count);
+        if (total || count) {
+            XLALPrintError("LALCheckMemoryLeaks: %zu allocs, %zu bytes\n", count, total);
+            leak = 1;
+        }
+    }
+
     if (leak) {
         lalRaiseHook(SIGSEGV, "LALCheckMemoryLeaks: memory leak\n");
     } else if (lalDebugLevel & LALMEMINFOBIT) {
@@ -817,8 +1486,123 @@ void LALCheckMemoryLeaks(void)
     return;
 }
 
+
+
+/* summary of the tracked allocations made in one source file */
+struct allocFile {
+    const char *file;
+    size_t size;
+    size_t count;
+};
+
+/* compare per-file allocation summaries by decreasing size */
+static int CompareAllocFiles(const void *a, const void *b)
+{
+    const struct allocFile *x = a;
+    const struct allocFile *y = b;
+    return (x->size < y->size) - (x->size > y->size);
+}
+
+int XLALGetMemoryAccounting(size_t *total, size_t *peak, size_t *count)
+{
+    int level = lalDebugLevel;
+    size_t bytes = 0;
+    size_t allocs = 0;
+    if (ACCTMODE(level)) {
+        AcctTotals(&bytes, &allocs);
+    } else if (level & LALMEMDBGBIT) {
+        pthread_mutex_lock(&mut);
+        bytes = lalMallocTotal;
+        allocs = alloc_n;
+        pthread_mutex_unlock(&mut);
+    }
+    if (total) {
+        *total = bytes;
+    }
+    if (peak) {
+        *peak = (level & LALMEMDBGBIT) ? AcctLoad(&lalMallocTotalPeak) : 0;
+    }
+    if (count) {
+        *count = allocs;
+    }
+    return 0;
+}
+
+void XLALPrintMemoryAccounting(void)
+{
+    int level = lalDebugLevel;
+    size_t scale = ACCTMODE(level) ? acctSampleInterval : 1;
+    struct allocFile *files = NULL;
+    int nfiles = 0;
+    size_t total, peak, count;
+
+    if (!(level & LALMEMDBGBIT)) {
+        return;
+    }
+
+    XLALGetMemoryAccounting(&total, &peak, &count);
+    XLALPrintError("XLALPrintMemoryAccounting: %zu bytes in %zu allocs, peak %zu bytes\n", total, count, peak);
+    if (!(level & LALMEMTRKBIT)) {
+        return;
+    }
+
+    /* sum the tracked allocations by source file */
+    pthread_mutex_lock(&mut);
+    if (alloc_n > 0) {
+        files = malloc(alloc_n * sizeof(*files));
+    }
+    if (files) {
+        for (int k = 0; k < alloc_data_len; ++k) {
+            struct allocNode *x = alloc_data[k];
+            int i;
+            if (x == NULL || x == DEL) {
+                continue;
+            }
+            for (i = 0; i < nfiles && strcmp(files[i].file, x->file) != 0; ++i);
+            if (i == nfiles) {
+                files[nfiles].file = x->file;
+                files[nfiles].size = 0;
+                files[nfiles].count = 0;
+                ++nfiles;
+            }
+            files[i].size += x->size;
+            ++files[i].count;
+        }
+    }
+    pthread_mutex_unlock(&mut);
+
+    if (scale > 1) {
+        XLALPrintError("XLALPrintMemoryAccounting: estimated from 1 in %zu allocs\n", scale);
+    }
+    if (nfiles > 0) {
+        qsort(files, nfiles, sizeof(*files), CompareAllocFiles);
+    }
+    for (int i = 0; i < nfiles; ++i) {
+        XLALPrintError("%12zu bytes in %8zu allocs: %s\n", scale * files[i].size,
+                       scale * files[i].count, files[i].file);
+    }
+    free(files);
+    return;
+}
+
 #else /* LAL_MEMORY_FUNCTIONS_DISABLED */
 
 void (LALCheckMemoryLeaks)(void) { return; }
 
+int XLALGetMemoryAccounting(size_t *total, size_t *peak, size_t *count)
+{
+    if (total) {
+        *total = 0;
+    }
+    if (peak) {
+        *peak = 0;
+    }
+    if (count) {
+        *count = 0;
+    }
+    return 0;
+}
+
+void XLALPrintMemoryAccounting(void) { return; }
+
 #endif /* !LAL_MEMORY_FUNCTIONS_DISABLED */
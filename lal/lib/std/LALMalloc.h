@@ -69,6 +69,22 @@ void XLALFreeAligned(void *ptr);
 #endif /* LAL_FFTW3_MEMALIGN_ENABLED */
 /** @} */
 
+/** \addtogroup LALMalloc_h */ /** @{ */
+int XLALBeginMemoryPool(void);
+int XLALResetMemoryPool(void);
+int XLALEndMemoryPool(void);
+#ifndef SWIG    /* exclude from SWIG interface */
+void *XLALPoolMalloc(size_t n);
+void *XLALPoolMallocLong(size_t n, const char *file, int line);
+#ifdef LAL_FFTW3_MEMALIGN_ENABLED
+void *XLALPoolMallocAligned(size_t n);
+void *XLALPoolMallocAlignedLong(size_t n, const char *file, int line);
+#define XLALPoolMallocAligned( n ) XLALPoolMallocAlignedLong( n, __FILE__, __LINE__ )
+#endif /* LAL_FFTW3_MEMALIGN_ENABLED */
+#define XLALPoolMalloc( n )    XLALPoolMallocLong( n, __FILE__, __LINE__ )
+#endif /* SWIG */
+/** @} */
+
 #ifdef LAL_MEMORY_FUNCTIONS_DISABLED
 
 #ifndef SWIG    /* exclude from SWIG interface */
@@ -125,6 +141,13 @@ void LALFreeLong(void *p, const char *file, int line);
 
 void (LALCheckMemoryLeaks) (void);
 
+/** \addtogroup LALMalloc_h */ /** @{ */
+#ifndef SWIG    /* exclude from SWIG interface */
+int XLALGetMemoryAccounting(size_t *total, size_t *peak, size_t *count);
+#endif /* SWIG */
+void XLALPrintMemoryAccounting(void);
+/** @} */
+
 #if 0
 {       /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
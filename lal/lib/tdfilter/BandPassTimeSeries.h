@@ -86,6 +86,7 @@ typedef struct tagPassBandParamStruc{
 /** @} */
 
 /* Function prototypes. */
+REAL8SOSFilter *XLALCreateButterworthREAL8SOSFilter( PassBandParamStruc *params, REAL8 deltaT );
 int XLALButterworthREAL4TimeSeries( REAL4TimeSeries *series, PassBandParamStruc *params );
 int XLALButterworthREAL8TimeSeries( REAL8TimeSeries *series, PassBandParamStruc *params );
 int XLALButterworthCOMPLEX8TimeSeries( COMPLEX8TimeSeries *series, PassBandParamStruc *params );
@@ -18,6 +18,7 @@
 */
 
 #include <complex.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALConstants.h>
 #include <lal/AVFactories.h>
@@ -198,9 +199,9 @@
  * for a high-pass filter).
  *
  * Each ZPG filter in the \f$w\f$-plane is first transformed to the \f$z\f$-plane
- * by a bilinear transformation, and is then used to construct a
- * time-domain IIR filter.  Each filter is then applied to the time
- * series.  As mentioned in the description above, the filters are
+ * by a bilinear transformation, and is then used as one second-order
+ * section of a time-domain \c REAL8SOSFilter (see \ref SOSFilter_c).
+ * Each section is then applied to the time series in turn.  As mentioned in the description above, the filters are
  * designed to give an overall amplitude response that is the square root
  * of the desired attenuation; however, each time-domain filter is
  * applied to the data stream twice: once in the normal sense, and once
@@ -218,6 +219,136 @@ XLALParsePassBandParamStruc( PassBandParamStruc *params,
 			 REAL8              deltaT );
 
 
+/* Create the z-plane ZPG filter for section i of an order n Butterworth
+   filter of the given type and characteristic frequency in the w-plane:
+   an order 2 section from the pair of poles i and n-1-i, or, if i is the
+   unpaired middle pole, an order 1 section. */
+static COMPLEX16ZPGFilter *
+XLALButterworthSectionZPGFilter( INT4 type, REAL8 wc, INT4 i, INT4 n )
+{
+  COMPLEX16ZPGFilter *zpgFilter=NULL;
+
+  if(2*i+1<n){
+    /* An order 2 section from a pair of poles symmetric across the
+       imaginary axis. */
+    REAL8 theta=LAL_PI*(i+0.5)/n;
+    REAL8 ar=wc*cos(theta);
+    REAL8 ai=wc*sin(theta);
+    if(type==2){
+      zpgFilter = XLALCreateCOMPLEX16ZPGFilter(2,2);
+      if ( ! zpgFilter )
+        XLAL_ERROR_NULL( XLAL_EFUNC );
+      zpgFilter->zeros->data[0]=0.0;
+      zpgFilter->zeros->data[1]=0.0;
+      zpgFilter->gain=1.0;
+    }else{
+      zpgFilter = XLALCreateCOMPLEX16ZPGFilter(0,2);
+      if ( ! zpgFilter )
+        XLAL_ERROR_NULL( XLAL_EFUNC );
+      zpgFilter->gain=-wc*wc;
+    }
+    zpgFilter->poles->data[0]=ar;
+    zpgFilter->poles->data[0]+=ai*I;
+    zpgFilter->poles->data[1]=-ar;
+    zpgFilter->poles->data[1]+=ai*I;
+  }else{
+    /* An order 1 section from the unpaired pole on the imaginary axis. */
+    if(type==2){
+      zpgFilter=XLALCreateCOMPLEX16ZPGFilter(1,1);
+      if(!zpgFilter)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+      *zpgFilter->zeros->data=0.0;
+      zpgFilter->gain=1.0;
+    }else{
+      zpgFilter=XLALCreateCOMPLEX16ZPGFilter(0,1);
+      if(!zpgFilter)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+      zpgFilter->gain=-wc*I;
+    }
+    *zpgFilter->poles->data=wc*I;
+  }
+
+  /* Transform to the z-plane. */
+  if (XLALWToZCOMPLEX16ZPGFilter(zpgFilter)<0)
+  {
+    XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  return zpgFilter;
+}
+
+/**
+ * Creates the second-order-section form of the Butterworth filter
+ * described by <tt>*params</tt> for data sampled at intervals
+ * \c deltaT.  The sections are the same as those applied by
+ * XLALButterworthREAL8TimeSeries(), in the same order, each carrying its
+ * own share of the gain; applying the filter with
+ * XLALSOSFiltFiltREAL8Vector() therefore reproduces that function.  As
+ * for that function, the amplitude response of the filter is the square
+ * root of the requested attenuation, and the full attenuation is only
+ * obtained by applying it in both directions.
+ */
+REAL8SOSFilter *
+XLALCreateButterworthREAL8SOSFilter( PassBandParamStruc *params, REAL8 deltaT )
+{
+  REAL8SOSFilter *sosFilter;
+  INT4 n;    /* The filter order. */
+  INT4 type; /* The pass-band type: high, low, or undeterminable. */
+  INT4 i;    /* An index. */
+  REAL8 wc;  /* The filter's transformed frequency. */
+
+  if ( ! params )
+    XLAL_ERROR_NULL( XLAL_EFAULT );
+  if ( ! ( deltaT > 0.0 ) )
+    XLAL_ERROR_NULL( XLAL_EINVAL, "Sampling interval must be positive" );
+
+  type=XLALParsePassBandParamStruc(params,&n,&wc,deltaT);
+  if(type<0)
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+
+  sosFilter = LALCalloc( 1, sizeof( *sosFilter ) );
+  if ( ! sosFilter )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  sosFilter->deltaT = deltaT;
+  sosFilter->numSections = ( n + 1 ) / 2;
+  sosFilter->coef = XLALCreateREAL8Vector( 5 * sosFilter->numSections );
+  sosFilter->history = XLALCreateREAL8Vector( 2 * sosFilter->numSections );
+  if ( ! sosFilter->coef || ! sosFilter->history )
+  {
+    XLALDestroyREAL8SOSFilter( sosFilter );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  memset( sosFilter->history->data, 0, sosFilter->history->length * sizeof( *sosFilter->history->data ) );
+
+  /* Each section is a Butterworth filter of order 2 or 1, which is
+     factored on its own so that it keeps its own gain. */
+  for ( i = 0; i < (INT4)sosFilter->numSections; ++i )
+  {
+    COMPLEX16ZPGFilter *zpgFilter;
+    REAL8SOSFilter *section;
+
+    zpgFilter = XLALButterworthSectionZPGFilter( type, wc, i, n );
+    if ( ! zpgFilter )
+    {
+      XLALDestroyREAL8SOSFilter( sosFilter );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+    section = XLALCreateREAL8SOSFilter( zpgFilter );
+    XLALDestroyCOMPLEX16ZPGFilter( zpgFilter );
+    if ( ! section || section->numSections != 1 )
+    {
+      XLALDestroyREAL8SOSFilter( section );
+      XLALDestroyREAL8SOSFilter( sosFilter );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+    memcpy( sosFilter->coef->data + 5 * i, section->coef->data, 5 * sizeof( *section->coef->data ) );
+    XLALDestroyREAL8SOSFilter( section );
+  }
+
+  return sosFilter;
+}
+
 #undef COMPLEX_DATA
 #undef SINGLE_PRECISION
 
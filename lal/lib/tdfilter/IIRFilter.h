@@ -123,6 +123,7 @@ extern "C" {
  * \defgroup IIRFilter_c 		Module IIRFilter.c
  * \defgroup IIRFilterVector_c 	Module IIRFilterVector.c
  * \defgroup IIRFilterVectorR_c 	Module IIRFilterVectorR.c
+ * \defgroup SOSFilter_c 		Module SOSFilter.c
  * @}
  */
 
@@ -189,6 +190,27 @@ typedef struct tagCOMPLEX16IIRFilter{
   COMPLEX16Vector *history;    /**< The previous values of w. */
 } COMPLEX16IIRFilter;
 
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IMMUTABLE_MEMBERS(tagREAL8SOSFilter, name));
+#endif /* SWIG */
+/**
+ * A cascade of second-order sections, or biquads.  Section \f$s\f$ has the
+ * transfer function
+ * \f[
+ * T_s(z) = \frac{b_{0} + b_{1} z^{-1} + b_{2} z^{-2}}
+ * {1 + a_{1} z^{-1} + a_{2} z^{-2}} \; ,
+ * \f]
+ * and its coefficients are stored in the order
+ * \f$(b_{0}, b_{1}, b_{2}, a_{1}, a_{2})\f$; see \ref SOSFilter_c.
+ */
+typedef struct tagREAL8SOSFilter{
+  const CHAR *name;        /**< User assigned name. */
+  REAL8 deltaT;            /**< Sampling time interval of the filter; If \f$\leq0\f$, it will be ignored (ie it will be taken from the data stream). */
+  UINT4 numSections;       /**< The number of second-order sections. */
+  REAL8Vector *coef;       /**< The section coefficients, five per section. */
+  REAL8Vector *history;    /**< The filter state, two values per section. */
+} REAL8SOSFilter;
+
 /** @} */
 
 /* Function prototypes. */
@@ -208,6 +230,33 @@ int XLALIIRFilterReverseREAL8Vector( REAL8Vector *vector, REAL8IIRFilter *filter
 int XLALIIRFilterReverseCOMPLEX8Vector( COMPLEX8Vector *vector, COMPLEX16IIRFilter *filter );
 int XLALIIRFilterReverseCOMPLEX16Vector( COMPLEX16Vector *vector, COMPLEX16IIRFilter *filter );
 
+REAL8SOSFilter *XLALCreateREAL8SOSFilter( COMPLEX16ZPGFilter *input );
+void XLALDestroyREAL8SOSFilter( REAL8SOSFilter *filter );
+int XLALResetREAL8SOSFilter( REAL8SOSFilter *filter );
+
+int XLALSOSFilterREAL4Vector( REAL4Vector *vector, REAL8SOSFilter *filter );
+int XLALSOSFilterREAL8Vector( REAL8Vector *vector, REAL8SOSFilter *filter );
+
+int XLALSOSFilterReverseREAL4Vector( REAL4Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFilterReverseREAL8Vector( REAL8Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFilterReverseCOMPLEX8Vector( COMPLEX8Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFilterReverseCOMPLEX16Vector( COMPLEX16Vector *vector, const REAL8SOSFilter *filter );
+
+int XLALSOSFiltFiltREAL4Vector( REAL4Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFiltFiltREAL8Vector( REAL8Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFiltFiltCOMPLEX8Vector( COMPLEX8Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFiltFiltCOMPLEX16Vector( COMPLEX16Vector *vector, const REAL8SOSFilter *filter );
+
+int XLALSOSFilterREAL4VectorSequence( REAL4VectorSequence *sequence, const REAL8SOSFilter *filter );
+int XLALSOSFilterREAL8VectorSequence( REAL8VectorSequence *sequence, const REAL8SOSFilter *filter );
+int XLALSOSFilterCOMPLEX8VectorSequence( COMPLEX8VectorSequence *sequence, const REAL8SOSFilter *filter );
+int XLALSOSFilterCOMPLEX16VectorSequence( COMPLEX16VectorSequence *sequence, const REAL8SOSFilter *filter );
+
+int XLALSOSFiltFiltREAL4VectorSequence( REAL4VectorSequence *sequence, const REAL8SOSFilter *filter );
+int XLALSOSFiltFiltREAL8VectorSequence( REAL8VectorSequence *sequence, const REAL8SOSFilter *filter );
+int XLALSOSFiltFiltCOMPLEX8VectorSequence( COMPLEX8VectorSequence *sequence, const REAL8SOSFilter *filter );
+int XLALSOSFiltFiltCOMPLEX16VectorSequence( COMPLEX16VectorSequence *sequence, const REAL8SOSFilter *filter );
+
 REAL4 XLALIIRFilterREAL4( REAL4 x, REAL8IIRFilter *filter );
 REAL8 XLALIIRFilterREAL8( REAL8 x, REAL8IIRFilter *filter );
 /* WARNING: THIS FUNCTION IS OBSOLETE */
@@ -0,0 +1,326 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/IIRFilter.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * \addtogroup SOSFilter_c
+ *
+ * \brief Creates and applies IIR filters factored into second-order
+ * sections.
+ *
+ * ### Description ###
+ *
+ * XLALCreateREAL8SOSFilter() factors the transfer function of a
+ * \c COMPLEX16ZPGFilter, given in the \f$z\f$ plane, into a cascade of
+ * second-order sections (biquads) with real coefficients, stored in a
+ * \c REAL8SOSFilter.  The zeros and poles must satisfy the same pairing
+ * constraints as for XLALCreateREAL8IIRFilter(): each must be real or have
+ * a complex conjugate partner, and only the real and positive-imaginary
+ * ones are used.  Zeros and poles at the origin only contribute a pure
+ * delay or advance and are dropped, as they are by
+ * XLALCreateREAL8IIRFilter().
+ *
+ * A high-order filter expanded into a single pair of polynomials, as in
+ * \c REAL8IIRFilter, has coefficients that grow combinatorially with the
+ * order and that must cancel to high precision; its response becomes
+ * inaccurate, or the filter unstable, long before the order of interest
+ * for data conditioning is reached.  The cascade of sections keeps each
+ * section's coefficients of order unity.
+ *
+ * XLALSOSFilterREAL8Vector() and XLALSOSFilterREAL4Vector() filter a
+ * vector in place, carrying the filter state in <tt>filter->history</tt>
+ * across calls so that a long data stream can be filtered in consecutive
+ * pieces; XLALResetREAL8SOSFilter() clears that state.  The reverse
+ * functions run the filter backwards through the data starting from a
+ * zero state, and the filt-filt functions apply each section forward and
+ * then in reverse, in turn, giving the squared amplitude response of the
+ * filter with no phase shift.  This is the order in which the Butterworth
+ * routines of \ref ButterworthTimeSeries_c apply their sections.  None of
+ * these use or modify <tt>filter->history</tt>.
+ *
+ * The \c VectorSequence functions treat each vector of a sequence as an
+ * independent channel (or segment) that starts from a zero filter state.
+ * All channels are filtered together, so that the inner loop of the
+ * section kernel runs across channels and can be vectorised by the
+ * compiler; groups of channels are distributed over threads when LAL is
+ * built with OpenMP support.
+ *
+ * ### Algorithm ###
+ *
+ * Each section is evaluated in transposed direct form II,
+ * \f{eqnarray}{
+ * y_n &=& b_0 x_n + s^{(1)}_{n-1} \; , \\
+ * s^{(1)}_n &=& b_1 x_n - a_1 y_n + s^{(2)}_{n-1} \; , \\
+ * s^{(2)}_n &=& b_2 x_n - a_2 y_n \; ,
+ * \f}
+ * in double precision for all data types.  Data are processed in blocks
+ * that are passed through all the sections of the cascade before moving
+ * on, so that each block stays in cache.
+ *
+ * The poles are paired into sections by taking the remaining pole (or
+ * conjugate pair, or pair of real poles) that lies farthest from the unit
+ * circle first and matching it with the closest remaining zero factor;
+ * the sections are ordered so that the poles closest to the unit circle
+ * are applied last.  The gain is applied in the first section.
+ *
+ */
+/** @{ */
+
+/* number of samples processed through the cascade at a time */
+#define SOS_BLOCK_LENGTH 256
+
+/* number of channels of a vector sequence processed together */
+#define SOS_CHANNEL_BLOCK 8
+
+/* a real factor 1 + c1 z^-1 + c2 z^-2 of the numerator or denominator,
+ * with one of its roots used to pair numerator and denominator factors */
+typedef struct tagSOSFactor {
+  REAL8 c1;
+  REAL8 c2;
+  COMPLEX16 root;
+} SOSFactor;
+
+/* factor the polynomial with the given roots into real first- and
+ * second-order factors; returns the number of factors or -1 if the roots
+ * are not appropriately paired */
+static INT4 sos_factor_roots( SOSFactor *factors, const COMPLEX16 *roots, INT4 numRoots )
+{
+  INT4 numFactors = 0;
+  INT4 num = 0;
+  INT4 haveReal = 0;
+  REAL8 pendingReal = 0.0;
+  INT4 i;
+
+  for ( i = 0; i < numRoots; ++i )
+  {
+    REAL8 x = creal( roots[i] );
+    REAL8 y = cimag( roots[i] );
+    if ( y == 0.0 )
+    {
+      num += 1;
+      if ( x == 0.0 )
+        continue;
+      /* real roots are combined in pairs */
+      if ( haveReal )
+      {
+        factors[numFactors].c1 = -( pendingReal + x );
+        factors[numFactors].c2 = pendingReal * x;
+        factors[numFactors].root = fabs( x ) > fabs( pendingReal ) ? x : pendingReal;
+        ++numFactors;
+        haveReal = 0;
+      }
+      else
+      {
+        pendingReal = x;
+        haveReal = 1;
+      }
+    }
+    else if ( y > 0.0 )
+    {
+      num += 2;
+      factors[numFactors].c1 = -2.0 * x;
+      factors[numFactors].c2 = x * x + y * y;
+      factors[numFactors].root = roots[i];
+      ++numFactors;
+    }
+  }
+  if ( num != numRoots )
+    return -1;
+
+  /* an unpaired real root gives a first-order factor */
+  if ( haveReal )
+  {
+    factors[numFactors].c1 = -pendingReal;
+    factors[numFactors].c2 = 0.0;
+    factors[numFactors].root = pendingReal;
+    ++numFactors;
+  }
+
+  return numFactors;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+REAL8SOSFilter *XLALCreateREAL8SOSFilter( COMPLEX16ZPGFilter *input )
+{
+  REAL8SOSFilter *output;
+  SOSFactor *zeroFactors;
+  SOSFactor *poleFactors;
+  INT4 numZeroFactors;
+  INT4 numPoleFactors;
+  INT4 numSections;
+  INT4 s;
+
+  /* Make sure all the input structures have been initialized. */
+  if ( ! input )
+    XLAL_ERROR_NULL( XLAL_EFAULT );
+  if ( ! input->zeros || ! input->poles
+      || ! input->zeros->data || ! input->poles->data )
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+
+  if ( lalDebugLevel & LALWARNING )
+  {
+    UINT4 i;
+    /* Issue a warning if the gain is nonreal. */
+    if ( fabs( cimag( input->gain ) ) > fabs( LAL_REAL8_EPS * creal( input->gain ) ) )
+      XLALPrintWarning( "XLAL Warning - %s: Gain is non-real\n", __func__ );
+    /* Issue a warning if any poles are outside |z|=1. */
+    for ( i = 0; i < input->poles->length; ++i )
+      if ( cabs( input->poles->data[i] ) > 1.0 )
+        XLALPrintWarning( "XLAL Warning - %s: Filter has pole outside of unit circle\n", __func__ );
+  }
+
+  /* Factor the numerator and denominator. */
+  zeroFactors = XLALMalloc( ( input->zeros->length + 1 ) * sizeof( *zeroFactors ) );
+  poleFactors = XLALMalloc( ( input->poles->length + 1 ) * sizeof( *poleFactors ) );
+  if ( ! zeroFactors || ! poleFactors )
+  {
+    XLALFree( zeroFactors );
+    XLALFree( poleFactors );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  numZeroFactors = sos_factor_roots( zeroFactors, input->zeros->data, input->zeros->length );
+  numPoleFactors = sos_factor_roots( poleFactors, input->poles->data, input->poles->length );
+  if ( numZeroFactors < 0 || numPoleFactors < 0 )
+  {
+    XLALFree( zeroFactors );
+    XLALFree( poleFactors );
+    XLAL_ERROR_NULL( XLAL_EINVAL, "Input has unpaired nonreal poles or zeros" );
+  }
+  numSections = numPoleFactors > numZeroFactors ? numPoleFactors : numZeroFactors;
+  if ( numSections < 1 )
+    numSections = 1;
+
+  /* Create the filter. */
+  output = LALCalloc( 1, sizeof( *output ) );
+  if ( ! output )
+  {
+    XLALFree( zeroFactors );
+    XLALFree( poleFactors );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  output->deltaT = input->deltaT;
+  output->numSections = numSections;
+  output->coef = XLALCreateREAL8Vector( 5 * numSections );
+  output->history = XLALCreateREAL8Vector( 2 * numSections );
+  if ( ! output->coef || ! output->history )
+  {
+    XLALFree( zeroFactors );
+    XLALFree( poleFactors );
+    XLALDestroyREAL8SOSFilter( output );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  memset( output->history->data, 0, output->history->length * sizeof( *output->history->data ) );
+
+  /* Fill the sections from the last to the first: at each step take the
+     remaining pole factor farthest from the unit circle and pair it with
+     the closest remaining zero factor. */
+  for ( s = numSections - 1; s >= 0; --s )
+  {
+    REAL8 *coef = output->coef->data + 5 * s;
+    INT4 p = -1;
+    INT4 z = -1;
+    INT4 k;
+
+    for ( k = 0; k < numPoleFactors; ++k )
+      if ( p < 0 || fabs( 1.0 - cabs( poleFactors[k].root ) ) > fabs( 1.0 - cabs( poleFactors[p].root ) ) )
+        p = k;
+    for ( k = 0; k < numZeroFactors; ++k )
+    {
+      if ( p < 0 )
+      {
+        z = k;
+        break;
+      }
+      if ( z < 0 || cabs( zeroFactors[k].root - poleFactors[p].root ) < cabs( zeroFactors[z].root - poleFactors[p].root ) )
+        z = k;
+    }
+
+    /* numerator */
+    coef[0] = 1.0;
+    coef[1] = z < 0 ? 0.0 : zeroFactors[z].c1;
+    coef[2] = z < 0 ? 0.0 : zeroFactors[z].c2;
+    /* denominator */
+    coef[3] = p < 0 ? 0.0 : poleFactors[p].c1;
+    coef[4] = p < 0 ? 0.0 : poleFactors[p].c2;
+
+    /* remove the used factors */
+    if ( p >= 0 )
+      poleFactors[p] = poleFactors[--numPoleFactors];
+    if ( z >= 0 )
+      zeroFactors[z] = zeroFactors[--numZeroFactors];
+  }
+
+  /* Apply the gain in the first section. */
+  output->coef->data[0] *= creal( input->gain );
+  output->coef->data[1] *= creal( input->gain );
+  output->coef->data[2] *= creal( input->gain );
+
+  XLALFree( zeroFactors );
+  XLALFree( poleFactors );
+
+  /* Normal exit */
+  return output;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+void XLALDestroyREAL8SOSFilter( REAL8SOSFilter *filter )
+{
+  if ( filter )
+  {
+    XLALDestroyREAL8Vector( filter->coef );
+    XLALDestroyREAL8Vector( filter->history );
+    LALFree( filter );
+  }
+  return;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALResetREAL8SOSFilter( REAL8SOSFilter *filter )
+{
+  if ( ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! filter->history || ! filter->history->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  memset( filter->history->data, 0, filter->history->length * sizeof( *filter->history->data ) );
+  return 0;
+}
+
+#define COMPLEX_DATA
+#define SINGLE_PRECISION
+#include "SOSFilter_source.c"
+#undef SINGLE_PRECISION
+#include "SOSFilter_source.c"
+#undef COMPLEX_DATA
+#define SINGLE_PRECISION
+#include "SOSFilter_source.c"
+#undef SINGLE_PRECISION
+#include "SOSFilter_source.c"
+
+/** @} */
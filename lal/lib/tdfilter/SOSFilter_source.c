@@ -0,0 +1,309 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define STRING(a) #a
+
+#ifdef COMPLEX_DATA
+#   define DBLDATATYPE COMPLEX16
+#   ifdef SINGLE_PRECISION
+#       define DATATYPE COMPLEX8
+#   else
+#       define DATATYPE COMPLEX16
+#   endif
+#else
+#   define DBLDATATYPE REAL8
+#   ifdef SINGLE_PRECISION
+#       define DATATYPE REAL4
+#   else
+#       define DATATYPE REAL8
+#   endif
+#endif
+
+#define VECTORTYPE CONCAT2(DATATYPE,Vector)
+#define SEQUENCETYPE CONCAT2(DATATYPE,VectorSequence)
+
+#define VKERNEL CONCAT2(sos_vector_,DATATYPE)
+#define SKERNEL CONCAT2(sos_sequence_,DATATYPE)
+
+#define FFUNC CONCAT2(XLALSOSFilter,VECTORTYPE)
+#define RFUNC CONCAT2(XLALSOSFilterReverse,VECTORTYPE)
+#define FFFUNC CONCAT2(XLALSOSFiltFilt,VECTORTYPE)
+#define SFUNC CONCAT2(XLALSOSFilter,SEQUENCETYPE)
+#define SFFFUNC CONCAT2(XLALSOSFiltFilt,SEQUENCETYPE)
+
+/* Run length samples of data, starting at data[0] and advancing by step
+   (which is -1 to run backwards), through numSections sections starting
+   from, and updating, the state (two values per section). */
+static void VKERNEL(DATATYPE *data, INT8 length, INT8 step, const REAL8 *coef, UINT4 numSections, DBLDATATYPE *state)
+{
+  DBLDATATYPE block[SOS_BLOCK_LENGTH];
+
+  while ( length > 0 )
+  {
+    INT8 n = length < SOS_BLOCK_LENGTH ? length : SOS_BLOCK_LENGTH;
+    UINT4 s;
+    INT8 t;
+
+    for ( t = 0; t < n; ++t )
+      block[t] = data[t * step];
+
+    /* pass the block through each section in turn */
+    for ( s = 0; s < numSections; ++s )
+    {
+      const REAL8 b0 = coef[5 * s];
+      const REAL8 b1 = coef[5 * s + 1];
+      const REAL8 b2 = coef[5 * s + 2];
+      const REAL8 a1 = coef[5 * s + 3];
+      const REAL8 a2 = coef[5 * s + 4];
+      DBLDATATYPE s1 = state[2 * s];
+      DBLDATATYPE s2 = state[2 * s + 1];
+      for ( t = 0; t < n; ++t )
+      {
+        DBLDATATYPE x = block[t];
+        DBLDATATYPE y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        block[t] = y;
+      }
+      state[2 * s] = s1;
+      state[2 * s + 1] = s2;
+    }
+
+    for ( t = 0; t < n; ++t )
+      data[t * step] = block[t];
+
+    data += n * step;
+    length -= n;
+  }
+
+  return;
+}
+
+/* Run every vector of the sequence through numSections sections, starting
+   from a zero state, forwards or backwards in time.  The channels are
+   transposed into a block so that the innermost loop runs across channels,
+   and groups of channels are distributed over threads. */
+static int SKERNEL(SEQUENCETYPE *sequence, const REAL8 *coef, UINT4 numSections, int reverse)
+{
+  const UINT4 numChannels = sequence->length;
+  const INT8 length = sequence->vectorLength;
+  const UINT4 numGroups = ( numChannels + SOS_CHANNEL_BLOCK - 1 ) / SOS_CHANNEL_BLOCK;
+  int errnum = 0;
+  UINT4 g;
+
+#pragma omp parallel for schedule(dynamic)
+  for ( g = 0; g < numGroups; ++g )
+  {
+    const UINT4 c0 = g * SOS_CHANNEL_BLOCK;
+    const UINT4 nc = numChannels - c0 < SOS_CHANNEL_BLOCK ? numChannels - c0 : SOS_CHANNEL_BLOCK;
+    DBLDATATYPE block[SOS_BLOCK_LENGTH][SOS_CHANNEL_BLOCK];
+    DBLDATATYPE *state;
+    INT8 done = 0;
+    UINT4 c;
+
+    state = XLALCalloc( 2 * numSections * SOS_CHANNEL_BLOCK, sizeof( *state ) );
+    if ( ! state )
+    {
+#pragma omp critical (SOSFilter_sequence)
+      errnum = XLAL_ENOMEM;
+      continue;
+    }
+
+    /* unused channels of the last group stay zero */
+    memset( block, 0, sizeof( block ) );
+
+    while ( done < length )
+    {
+      const INT8 n = length - done < SOS_BLOCK_LENGTH ? length - done : SOS_BLOCK_LENGTH;
+      const INT8 first = reverse ? length - done - n : done;
+      UINT4 s;
+      INT8 t;
+
+      /* transpose the block of data into time-major order */
+      for ( c = 0; c < nc; ++c )
+      {
+        const DATATYPE *data = sequence->data + ( c0 + c ) * length + first;
+        for ( t = 0; t < n; ++t )
+          block[t][c] = data[t];
+      }
+
+      /* pass the block through each section in turn */
+      for ( s = 0; s < numSections; ++s )
+      {
+        const REAL8 b0 = coef[5 * s];
+        const REAL8 b1 = coef[5 * s + 1];
+        const REAL8 b2 = coef[5 * s + 2];
+        const REAL8 a1 = coef[5 * s + 3];
+        const REAL8 a2 = coef[5 * s + 4];
+        DBLDATATYPE *s1 = state + 2 * s * SOS_CHANNEL_BLOCK;
+        DBLDATATYPE *s2 = s1 + SOS_CHANNEL_BLOCK;
+        for ( t = 0; t < n; ++t )
+        {
+          DBLDATATYPE *row = block[reverse ? n - 1 - t : t];
+          for ( c = 0; c < SOS_CHANNEL_BLOCK; ++c )
+          {
+            DBLDATATYPE x = row[c];
+            DBLDATATYPE y = b0 * x + s1[c];
+            s1[c] = b1 * x - a1 * y + s2[c];
+            s2[c] = b2 * x - a2 * y;
+            row[c] = y;
+          }
+        }
+      }
+
+      /* transpose back */
+      for ( c = 0; c < nc; ++c )
+      {
+        DATATYPE *data = sequence->data + ( c0 + c ) * length + first;
+        for ( t = 0; t < n; ++t )
+          data[t] = block[t][c];
+      }
+
+      done += n;
+    }
+
+    XLALFree( state );
+  }
+
+  if ( errnum )
+    XLAL_ERROR( errnum );
+  return 0;
+}
+
+#ifndef COMPLEX_DATA
+
+/** \see See \ref SOSFilter_c for documentation */
+int FFUNC(VECTORTYPE *vector, REAL8SOSFilter *filter)
+{
+  /* Make sure all the structures have been initialized. */
+  if ( ! vector || ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( ! filter->coef || ! filter->history
+      || ! filter->coef->data || ! filter->history->data
+      || filter->coef->length != 5 * filter->numSections
+      || filter->history->length != 2 * filter->numSections )
+    XLAL_ERROR( XLAL_EINVAL );
+
+  VKERNEL(vector->data, vector->length, 1, filter->coef->data, filter->numSections, filter->history->data);
+
+  /* Normal exit */
+  return 0;
+}
+
+#endif /* COMPLEX_DATA */
+
+/** \see See \ref SOSFilter_c for documentation */
+int RFUNC(VECTORTYPE *vector, const REAL8SOSFilter *filter)
+{
+  DBLDATATYPE *state;
+
+  /* Make sure all the structures have been initialized. */
+  if ( ! vector || ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( ! filter->coef || ! filter->coef->data
+      || filter->coef->length != 5 * filter->numSections )
+    XLAL_ERROR( XLAL_EINVAL );
+
+  state = XLALCalloc( 2 * filter->numSections, sizeof( *state ) );
+  if ( ! state )
+    XLAL_ERROR( XLAL_ENOMEM );
+
+  if ( vector->length > 0 )
+    VKERNEL(vector->data + vector->length - 1, vector->length, -1, filter->coef->data, filter->numSections, state);
+
+  XLALFree( state );
+
+  /* Normal exit */
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int FFFUNC(VECTORTYPE *vector, const REAL8SOSFilter *filter)
+{
+  DBLDATATYPE state[2];
+  UINT4 s;
+
+  /* Make sure all the structures have been initialized. */
+  if ( ! vector || ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( ! filter->coef || ! filter->coef->data
+      || filter->coef->length != 5 * filter->numSections )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( vector->length == 0 )
+    return 0;
+
+  /* Filter the data with each section, once each way. */
+  for ( s = 0; s < filter->numSections; ++s )
+  {
+    state[0] = state[1] = 0.0;
+    VKERNEL(vector->data, vector->length, 1, filter->coef->data + 5 * s, 1, state);
+    state[0] = state[1] = 0.0;
+    VKERNEL(vector->data + vector->length - 1, vector->length, -1, filter->coef->data + 5 * s, 1, state);
+  }
+
+  /* Normal exit */
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int SFUNC(SEQUENCETYPE *sequence, const REAL8SOSFilter *filter)
+{
+  /* Make sure all the structures have been initialized. */
+  if ( ! sequence || ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! sequence->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( ! filter->coef || ! filter->coef->data
+      || filter->coef->length != 5 * filter->numSections )
+    XLAL_ERROR( XLAL_EINVAL );
+
+  if ( SKERNEL(sequence, filter->coef->data, filter->numSections, 0) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  /* Normal exit */
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int SFFFUNC(SEQUENCETYPE *sequence, const REAL8SOSFilter *filter)
+{
+  UINT4 s;
+
+  /* Make sure all the structures have been initialized. */
+  if ( ! sequence || ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! sequence->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( ! filter->coef || ! filter->coef->data
+      || filter->coef->length != 5 * filter->numSections )
+    XLAL_ERROR( XLAL_EINVAL );
+
+  /* Filter the data with each section, once each way. */
+  for ( s = 0; s < filter->numSections; ++s )
+    if ( SKERNEL(sequence, filter->coef->data + 5 * s, 1, 0) < 0
+        || SKERNEL(sequence, filter->coef->data + 5 * s, 1, 1) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+
+  /* Normal exit */
+  return 0;
+}
+
+#undef VKERNEL
+#undef SKERNEL
+#undef FFUNC
+#undef RFUNC
+#undef FFFUNC
+#undef SFUNC
+#undef SFFFUNC
+#undef VECTORTYPE
+#undef SEQUENCETYPE
+#undef DBLDATATYPE
+#undef DATATYPE
+#undef CONCAT2x
+#undef CONCAT2
+#undef STRING
@@ -39,7 +39,7 @@ SERIESTYPE *CSERIES (
 	SERIESTYPE *new;
 	SEQUENCETYPE *sequence;
 
-	new = XLALMalloc(sizeof(*new));
+	new = XLALPoolMalloc(sizeof(*new));
 	sequence = CSEQUENCE (length);
 	if(!new || !sequence) {
 		XLALFree(new);
@@ -81,7 +81,7 @@ SERIESTYPE *XSERIES (
 	SERIESTYPE *new;
 	SEQUENCETYPE *sequence;
 
-	new = XLALMalloc(sizeof(*new));
+	new = XLALPoolMalloc(sizeof(*new));
 	sequence = XSEQUENCE (series->data, first, length);
 	if(!new || !sequence) {
 		XLALFree(new);
@@ -18,14 +18,20 @@
 */
 
 #include <math.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALStdio.h>
 #include <lal/AVFactories.h>
 #include <lal/LALConstants.h>
 #include <lal/IIRFilter.h>
 #include <lal/BandPassTimeSeries.h>
+#include <lal/Window.h>
 #include <lal/ResampleTimeSeries.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #if __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -38,7 +44,63 @@
  *
  * \author Brown, D. A., Brady, P. R., Charlton, P.
  *
- * \brief Downsamples a time series in place by an integer power of two.
+ * \brief Resamples a time series, in place or as a stream.
+ *
+ * XLALResampleREAL4TimeSeries() and XLALResampleREAL8TimeSeries()
+ * downsample a time series in place by an integer power of two using a
+ * Butterworth low-pass filter followed by decimation.  Any other ratio of
+ * the old and new sample intervals that is rational, with numerator and
+ * denominator no larger than 1024, is handled by passing the series to
+ * XLALPolyphaseResampleREAL4TimeSeries() or
+ * XLALPolyphaseResampleREAL8TimeSeries(), which can also be called
+ * directly for any ratio, including powers of two and upsampling.
+ *
+ * ### Polyphase resampler ###
+ *
+ * Resampling by a rational factor \f$U/D\f$ (the sample rate is multiplied by
+ * \f$U\f$ and divided by \f$D\f$) is conceptually done by inserting \f$U-1\f$
+ * zeros between input samples, low-pass filtering at \f$U\f$ times the input
+ * rate, and keeping every \f$D\f$-th sample.  The polyphase resampler
+ * computes only the samples that are kept, and only from the input
+ * samples that are not zero: each output sample is the dot product of a
+ * contiguous stretch of input with one of \f$U\f$ sub-filters (phases) of
+ * the low-pass filter.  This is cheaper than filtering at the high rate
+ * and discarding samples by a factor of about \f$UD\f$.
+ *
+ * The low-pass filter is a Kaiser-windowed sinc function with
+ * \f$\beta = 8\f$ (a stop-band attenuation of about 80 dB) and a cutoff at
+ * 0.9 times the lower of the input and output Nyquist frequencies.  It
+ * extends over \c halfLength zero crossings of the sinc function at the
+ * lower sample rate either side of its centre; the time series functions
+ * use a half-length of 32, for which the response is flat to better than
+ * 0.1\% below 0.8 times the lower Nyquist frequency.  Each phase of the
+ * filter is normalized to unit DC gain.  The filter is symmetric, so there
+ * is <em>no time shift</em> in the output: output sample \f$m\f$ is at the
+ * same time as input sample \f$mD/U\f$.  The data are taken to be zero
+ * outside the time series, so that there is corrupted data at the start
+ * and end of the output, over about \c halfLength samples at the lower of
+ * the two sample rates.
+ *
+ * A \c LALResampler created by XLALCreateResampler() converts a stream of
+ * data supplied to XLALResamplerProcessREAL4Vector() or
+ * XLALResamplerProcessREAL8Vector() in consecutive blocks of any length,
+ * retaining the input samples needed for the next output samples between
+ * calls, so that the output is the same as resampling the concatenated
+ * blocks at once.  Each call returns the output samples that can be
+ * computed from the input supplied so far: the output lags the input by
+ * XLALResamplerGetDelay() input samples, and that number of zeros may be
+ * supplied at the end of the stream to flush out the remaining output.
+ * On error, XLALResamplerGetDelay() returns <tt>(UINT4) XLAL_FAILURE</tt>,
+ * the largest \c UINT4, which is never a valid delay.
+ * The first output sample is at the time of the first input sample.  A
+ * resampler must not be used for both \c REAL4 and \c REAL8 data without
+ * calling XLALResetResampler() in between.
+ *
+ * The dot products are written so that they can be vectorised by the
+ * compiler, and long blocks of output are computed in parallel when LAL
+ * is built with OpenMP support.
+ *
+ * ### Butterworth and LDAS filters ###
  *
  * The routine LALResampleREAL4TimeSeries() provided functionality to
  * downsample a time series in place by an integer factor which is a power of
@@ -121,6 +183,199 @@
  */
 /** @{ */
 
+/* number of zero crossings of the polyphase filter either side of its
+ * centre used by the time series functions */
+#define RESAMPLER_HALF_LENGTH 32
+
+/* Kaiser window parameter of the polyphase filter */
+#define RESAMPLER_KAISER_BETA 8.0
+
+/* cutoff of the polyphase filter as a fraction of the lower Nyquist
+ * frequency */
+#define RESAMPLER_ROLLOFF 0.9
+
+/* largest numerator or denominator of a resampling ratio */
+#define RESAMPLER_MAX_FACTOR 1024
+
+/* minimum number of output samples to compute in parallel */
+#define RESAMPLER_PARALLEL_MIN 4096
+
+struct tagLALResampler {
+  UINT4 upFactor;        /* factor by which the sample rate is multiplied */
+  UINT4 downFactor;      /* factor by which the sample rate is divided */
+  UINT4 numTaps;         /* number of coefficients in each phase */
+  INT8 offset;           /* input samples before the centre of each phase */
+  REAL8 *coefREAL8;      /* upFactor phases of numTaps coefficients */
+  REAL4 *coefREAL4;      /* the same, in single precision */
+  REAL8 *history;        /* retained input samples */
+  UINT4 historyLength;   /* number of retained input samples */
+  UINT4 historyCapacity; /* allocated length of history */
+  INT8 historyStart;     /* input sample number of history[0] */
+  INT8 numInput;         /* number of input samples consumed */
+  UINT8 numOutput;       /* number of output samples produced */
+};
+
+static UINT4 XLALResampleGCD( UINT4 a, UINT4 b )
+{
+  while ( b )
+  {
+    UINT4 t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/* Express the ratio of sample intervals dt / deltaT as downFactor /
+ * upFactor in lowest terms. */
+static int XLALResampleRatio( UINT4 *upFactor, UINT4 *downFactor, REAL8 deltaT, REAL8 dt )
+{
+  UINT4 up;
+
+  if ( ! ( deltaT > 0.0 ) || ! ( dt > 0.0 ) )
+    XLAL_ERROR( XLAL_EINVAL, "Sample intervals must be positive" );
+
+  for ( up = 1; up <= RESAMPLER_MAX_FACTOR; ++up )
+  {
+    REAL8 down = floor( up * dt / deltaT + 0.5 );
+    if ( down >= 1.0 && down <= RESAMPLER_MAX_FACTOR
+        && fabs( up * dt - down * deltaT ) <= 1e-6 * down * deltaT )
+    {
+      *upFactor = up;
+      *downFactor = (UINT4)down;
+      return 0;
+    }
+  }
+
+  XLAL_ERROR( XLAL_EINVAL, "Ratio of sample intervals %g / %g is not a ratio of integers no larger than %d", dt, deltaT, RESAMPLER_MAX_FACTOR );
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+LALResampler *XLALCreateResampler( UINT4 upFactor, UINT4 downFactor, UINT4 halfLength )
+{
+  LALResampler *resampler;
+  REAL8Window *window;
+  REAL8 cutoff;
+  UINT4 factor;
+  UINT4 gcd;
+  INT8 halfWidth;
+  INT8 offset;
+  UINT4 p;
+  UINT4 u;
+
+  if ( upFactor < 1 || downFactor < 1 || halfLength < 1 )
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+
+  gcd = XLALResampleGCD( upFactor, downFactor );
+  upFactor /= gcd;
+  downFactor /= gcd;
+
+  /* The filter is designed at upFactor times the input rate, where the
+     lower of the two Nyquist frequencies is 0.5 / factor cycles per
+     sample, and extends halfWidth samples either side of its centre. */
+  factor = upFactor > downFactor ? upFactor : downFactor;
+  halfWidth = (INT8)halfLength * factor;
+  if ( 2 * halfWidth + 1 > (INT8)LAL_UINT4_MAX / 2 )
+    XLAL_ERROR_NULL( XLAL_EINVAL, "Resampling filter too long" );
+  cutoff = RESAMPLER_ROLLOFF * 0.5 / factor;
+  offset = ( halfWidth + upFactor - 1 ) / upFactor;
+
+  resampler = XLALCalloc( 1, sizeof( *resampler ) );
+  if ( ! resampler )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  resampler->upFactor = upFactor;
+  resampler->downFactor = downFactor;
+  resampler->numTaps = 2 * offset + 2;
+  resampler->offset = offset;
+  resampler->coefREAL8 = XLALMalloc( upFactor * resampler->numTaps * sizeof( *resampler->coefREAL8 ) );
+  resampler->coefREAL4 = XLALMalloc( upFactor * resampler->numTaps * sizeof( *resampler->coefREAL4 ) );
+  resampler->historyCapacity = resampler->numTaps;
+  resampler->history = XLALMalloc( resampler->historyCapacity * sizeof( *resampler->history ) );
+  window = XLALCreateKaiserREAL8Window( 2 * halfWidth + 1, RESAMPLER_KAISER_BETA );
+  if ( ! resampler->coefREAL8 || ! resampler->coefREAL4 || ! resampler->history || ! window )
+  {
+    XLALDestroyREAL8Window( window );
+    XLALDestroyResampler( resampler );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  /* Coefficient u of phase p multiplies input sample floor(n / up) -
+     offset + u for the output at upsampled index n = floor(n / up) * up
+     + p, so it is the filter at the lag p + (offset - u) * up. */
+  for ( p = 0; p < upFactor; ++p )
+  {
+    REAL8 *coef = resampler->coefREAL8 + p * resampler->numTaps;
+    REAL8 sum = 0.0;
+    for ( u = 0; u < resampler->numTaps; ++u )
+    {
+      INT8 lag = p + ( offset - (INT8)u ) * upFactor;
+      REAL8 x = 2.0 * cutoff * lag;
+      if ( lag > halfWidth || lag < -halfWidth )
+        coef[u] = 0.0;
+      else
+        coef[u] = window->data->data[lag + halfWidth] * ( lag ? sin( LAL_PI * x ) / ( LAL_PI * x ) : 1.0 );
+      sum += coef[u];
+    }
+    /* unit DC gain for every phase */
+    for ( u = 0; u < resampler->numTaps; ++u )
+    {
+      coef[u] /= sum;
+      resampler->coefREAL4[p * resampler->numTaps + u] = coef[u];
+    }
+  }
+  XLALDestroyREAL8Window( window );
+
+  if ( XLALResetResampler( resampler ) < 0 )
+  {
+    XLALDestroyResampler( resampler );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  return resampler;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+void XLALDestroyResampler( LALResampler *resampler )
+{
+  if ( resampler )
+  {
+    XLALFree( resampler->coefREAL8 );
+    XLALFree( resampler->coefREAL4 );
+    XLALFree( resampler->history );
+    XLALFree( resampler );
+  }
+  return;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+int XLALResetResampler( LALResampler *resampler )
+{
+  if ( ! resampler )
+    XLAL_ERROR( XLAL_EFAULT );
+
+  /* The input before the start of the stream is taken to be zero. */
+  resampler->historyStart = -resampler->offset;
+  resampler->historyLength = resampler->offset;
+  memset( resampler->history, 0, resampler->historyLength * sizeof( *resampler->history ) );
+  resampler->numInput = 0;
+  resampler->numOutput = 0;
+
+  return 0;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+UINT4 XLALResamplerGetDelay( const LALResampler *resampler )
+{
+  if ( ! resampler )
+    XLAL_ERROR_VAL( (UINT4) XLAL_FAILURE, XLAL_EFAULT );
+  return resampler->numTaps - 1 - resampler->offset;
+}
+
+#define SINGLE_PRECISION
+#include "ResampleTimeSeries_source.c"
+#undef SINGLE_PRECISION
+#include "ResampleTimeSeries_source.c"
+
 /** \see See \ref ResampleTimeSeries_c for documentation */
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
 {
@@ -134,10 +389,15 @@ int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
   resampleFactor = floor( dt / series->deltaT + 0.5 );
   newNyquistFrequency = 0.5 / dt;
 
-  /* check that the resampling factor is valid */
+  /* use the polyphase resampler unless downsampling by a power of two */
   if ( resampleFactor < 1 ||
-      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT )
-    XLAL_ERROR( XLAL_EINVAL );
+      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT ||
+      ( resampleFactor & (resampleFactor - 1) ) )
+  {
+    if ( XLALPolyphaseResampleREAL4TimeSeries( series, dt ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+    return 0;
+  }
 
   /* just return if no resampling is required */
   if ( resampleFactor == 1 )
@@ -146,10 +406,6 @@ int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
     return 0;
   }
 
-  /* check that we are resampling by a power of two */
-  if ( resampleFactor & (resampleFactor - 1) )
-    XLAL_ERROR( XLAL_EINVAL );
-
   if ( XLALLowPassREAL4TimeSeries( series, newNyquistFrequency,
         newNyquistAmplitude, filterOrder ) < 0 )
     XLAL_ERROR( XLAL_EFUNC );
@@ -182,10 +438,15 @@ int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt )
   resampleFactor = floor( dt / series->deltaT + 0.5 );
   newNyquistFrequency = 0.5 / dt;
 
-  /* check that the resampling factor is valid */
+  /* use the polyphase resampler unless downsampling by a power of two */
   if ( resampleFactor < 1 ||
-      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT )
-    XLAL_ERROR( XLAL_EINVAL );
+      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT ||
+      ( resampleFactor & (resampleFactor - 1) ) )
+  {
+    if ( XLALPolyphaseResampleREAL8TimeSeries( series, dt ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+    return 0;
+  }
 
   /* just return if no resampling is required */
   if ( resampleFactor == 1 )
@@ -194,10 +455,6 @@ int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt )
     return 0;
   }
 
-  /* check that we are resampling by a power of two */
-  if ( resampleFactor & (resampleFactor - 1) )
-    XLAL_ERROR( XLAL_EINVAL );
-
   if ( XLALLowPassREAL8TimeSeries( series, newNyquistFrequency,
         newNyquistAmplitude, filterOrder ) < 0 )
     XLAL_ERROR( XLAL_EFUNC );
@@ -36,7 +36,11 @@ extern "C" {
  *
  * \brief Provides routines to resample a time series.
  *
- * At present only integer downsampling of \c REAL4TimeSeries by a power of two is supported.
+ * Time series may be downsampled in place by an integer power of two
+ * using a Butterworth low-pass filter, or resampled by any rational ratio
+ * using a polyphase FIR filter.  The polyphase resampler can also be
+ * used to convert the rate of a stream of data supplied in consecutive
+ * blocks.
  *
  * ### Synopsis ###
  *
@@ -129,12 +133,27 @@ tagResampleTSParams
 }
 ResampleTSParams;
 
+/**
+ * Opaque structure holding the polyphase filter and the stream state of
+ * a rational-ratio resampler.
+ */
+typedef struct tagLALResampler LALResampler;
+
 /** @} */
 
 /* ---------- Function prototypes ---------- */
 
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt );
 int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt );
+int XLALPolyphaseResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt );
+int XLALPolyphaseResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt );
+
+LALResampler *XLALCreateResampler( UINT4 upFactor, UINT4 downFactor, UINT4 halfLength );
+void XLALDestroyResampler( LALResampler *resampler );
+int XLALResetResampler( LALResampler *resampler );
+UINT4 XLALResamplerGetDelay( const LALResampler *resampler );
+REAL4Vector *XLALResamplerProcessREAL4Vector( LALResampler *resampler, const REAL4Vector *input );
+REAL8Vector *XLALResamplerProcessREAL8Vector( LALResampler *resampler, const REAL8Vector *input );
 
 void
 LALResampleREAL4TimeSeries(
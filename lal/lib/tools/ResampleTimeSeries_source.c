@@ -0,0 +1,220 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define STRING(a) #a
+
+#ifdef SINGLE_PRECISION
+#define DATATYPE REAL4
+#else
+#define DATATYPE REAL8
+#endif
+
+#define VECTORTYPE CONCAT2(DATATYPE,Vector)
+#define SERIESTYPE CONCAT2(DATATYPE,TimeSeries)
+#define COEF CONCAT2(coef,DATATYPE)
+
+#define CREATEVECTOR CONCAT2(XLALCreate,VECTORTYPE)
+#define DESTROYVECTOR CONCAT2(XLALDestroy,VECTORTYPE)
+
+#define KERNEL CONCAT2(resampler_kernel_,DATATYPE)
+#define PFUNC CONCAT2(XLALResamplerProcess,VECTORTYPE)
+#define SFUNC CONCAT2(XLALPolyphaseResample,SERIESTYPE)
+
+/* Compute numOutput samples of output, starting from output sample
+   number resampler->numOutput, from the input samples held in input[],
+   the first of which is input sample number inputStart. */
+static void KERNEL(DATATYPE *output, INT8 numOutput, const DATATYPE *input, INT8 inputStart, const LALResampler *resampler)
+{
+  const UINT8 firstOutput = resampler->numOutput;
+  const UINT4 upFactor = resampler->upFactor;
+  const UINT4 downFactor = resampler->downFactor;
+  const UINT4 numTaps = resampler->numTaps;
+  const INT8 offset = resampler->offset;
+  const DATATYPE *coef = resampler->COEF;
+  INT8 k;
+
+#pragma omp parallel for schedule(static) if(numOutput > RESAMPLER_PARALLEL_MIN)
+  for ( k = 0; k < numOutput; ++k )
+  {
+    /* index of the output sample at the upsampled rate */
+    const UINT8 n = ( firstOutput + k ) * downFactor;
+    const DATATYPE * restrict x = input + (INT8)( n / upFactor ) - offset - inputStart;
+    const DATATYPE * restrict h = coef + ( n % upFactor ) * numTaps;
+    DATATYPE sum = 0.0;
+    UINT4 u;
+#pragma omp simd reduction(+:sum)
+    for ( u = 0; u < numTaps; ++u )
+      sum += h[u] * x[u];
+    output[k] = sum;
+  }
+
+  return;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+VECTORTYPE *PFUNC( LALResampler *resampler, const VECTORTYPE *input )
+{
+  VECTORTYPE *output;
+  DATATYPE *work = NULL;
+  INT8 skip;
+  INT8 end;
+  INT8 last;
+  INT8 workStart;
+  INT8 workLength;
+  INT8 nextStart;
+  INT8 keep;
+  UINT8 endOutput;
+  UINT8 numOutput;
+  INT8 i;
+
+  if ( ! resampler || ! input )
+    XLAL_ERROR_NULL( XLAL_EFAULT );
+  if ( input->length && ! input->data )
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+
+  /* When downsampling by a large factor, input samples that fall between
+     the support of consecutive output samples are not needed at all. */
+  skip = resampler->historyStart - resampler->numInput;
+  if ( skip < 0 )
+    skip = 0;
+  if ( skip > (INT8)input->length )
+    skip = input->length;
+
+  /* Assemble the retained history and the new input. */
+  end = resampler->numInput + input->length;
+  workLength = resampler->historyLength + input->length - skip;
+  workStart = end - workLength;
+  if ( workLength > 0 )
+  {
+    work = XLALMalloc( workLength * sizeof( *work ) );
+    if ( ! work )
+      XLAL_ERROR_NULL( XLAL_ENOMEM );
+    for ( i = 0; i < (INT8)resampler->historyLength; ++i )
+      work[i] = resampler->history[i];
+    if ( input->length > skip )
+      memcpy( work + resampler->historyLength, input->data + skip, ( input->length - skip ) * sizeof( *work ) );
+  }
+
+  /* Output sample m needs input samples up to floor(m * down / up) -
+     offset + numTaps - 1, so those with floor(m * down / up) <= last can
+     be computed now. */
+  last = end - resampler->numTaps + resampler->offset;
+  endOutput = last < 0 ? 0 : ( (UINT8)( last + 1 ) * resampler->upFactor + resampler->downFactor - 1 ) / resampler->downFactor;
+  numOutput = endOutput > resampler->numOutput ? endOutput - resampler->numOutput : 0;
+
+  output = CREATEVECTOR( numOutput );
+  if ( ! output )
+  {
+    XLALFree( work );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  if ( numOutput > 0 )
+    KERNEL( output->data, numOutput, work, workStart, resampler );
+  resampler->numOutput += numOutput;
+  resampler->numInput = end;
+
+  /* Keep the input samples needed by the next output sample. */
+  nextStart = (INT8)( resampler->numOutput * resampler->downFactor / resampler->upFactor ) - resampler->offset;
+  keep = end - nextStart;
+  if ( keep < 0 )
+    keep = 0;
+  if ( keep > (INT8)resampler->historyCapacity )
+  {
+    REAL8 *history = XLALRealloc( resampler->history, keep * sizeof( *history ) );
+    if ( ! history )
+    {
+      XLALFree( work );
+      DESTROYVECTOR( output );
+      XLAL_ERROR_NULL( XLAL_ENOMEM );
+    }
+    resampler->history = history;
+    resampler->historyCapacity = keep;
+  }
+  for ( i = 0; i < keep; ++i )
+    resampler->history[i] = work[workLength - keep + i];
+  resampler->historyLength = keep;
+  resampler->historyStart = nextStart;
+
+  XLALFree( work );
+  return output;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+int SFUNC( SERIESTYPE *series, REAL8 dt )
+{
+  LALResampler *resampler;
+  VECTORTYPE *padded;
+  VECTORTYPE *output;
+  DATATYPE *data;
+  UINT4 upFactor;
+  UINT4 downFactor;
+  UINT4 delay;
+  UINT8 length;
+
+  if ( ! series || ! series->data )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( series->data->length && ! series->data->data )
+    XLAL_ERROR( XLAL_EINVAL );
+
+  if ( XLALResampleRatio( &upFactor, &downFactor, series->deltaT, dt ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  /* just return if no resampling is required */
+  if ( upFactor == 1 && downFactor == 1 )
+  {
+    XLALPrintInfo( "XLAL Info - %s: No resampling required", __func__ );
+    return 0;
+  }
+
+  resampler = XLALCreateResampler( upFactor, downFactor, RESAMPLER_HALF_LENGTH );
+  if ( ! resampler )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  /* Pad the end of the data with enough zeros to flush out the last
+     output samples. */
+  delay = XLALResamplerGetDelay( resampler );
+  padded = CREATEVECTOR( series->data->length + delay );
+  if ( ! padded )
+  {
+    XLALDestroyResampler( resampler );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+  if ( series->data->length )
+    memcpy( padded->data, series->data->data, series->data->length * sizeof( *padded->data ) );
+  memset( padded->data + series->data->length, 0, delay * sizeof( *padded->data ) );
+
+  output = PFUNC( resampler, padded );
+  DESTROYVECTOR( padded );
+  XLALDestroyResampler( resampler );
+  if ( ! output )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  /* Swap the resampled data into the series, keeping the series' vector. */
+  length = (UINT8)series->data->length * upFactor / downFactor;
+  data = series->data->data;
+  series->data->data = output->data;
+  output->data = data;
+  output->length = series->data->length;
+  DESTROYVECTOR( output );
+  series->data->length = length;
+  if ( ! length )
+  {
+    XLALFree( series->data->data );
+    series->data->data = NULL;
+  }
+  series->deltaT = dt;
+
+  return 0;
+}
+
+#undef KERNEL
+#undef PFUNC
+#undef SFUNC
+#undef CREATEVECTOR
+#undef DESTROYVECTOR
+#undef COEF
+#undef VECTORTYPE
+#undef SERIESTYPE
+#undef DATATYPE
+#undef CONCAT2x
+#undef CONCAT2
+#undef STRING
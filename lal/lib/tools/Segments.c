@@ -37,7 +37,12 @@
  * The rest of the functions listed deal with <em>segment lists</em>:
  *
  * XLALSegListInit(), XLALSegListClear(), XLALSegListAppend(), XLALSegListSort()
- * XLALSegListCoalesce(), XLALSegListSearch()
+ * XLALSegListCoalesce(), XLALSegListSearch(), XLALSegListSearchBatch(),
+ * XLALSegListUnion(), XLALSegListIntersect(), XLALSegListSubtract(),
+ * XLALSegListComplement()
+ *
+ * Segment list indexes are handled by XLALSegListIndexCreate(),
+ * XLALSegListIndexDestroy() and XLALSegListIndexQuery().
  *
  * ### Error codes and return values ###
  *
@@ -355,6 +360,36 @@ XLALSegListFree( LALSegList *seglist )
 }
 
 
+/*---------------------------------------------------------------------------*/
+
+/* Increase the number of decimal places used to format the GPS times of a
+   segment list, if necessary to represent the times of the given segment.
+   Work with 0, 3, 6, or 9 decimal places. */
+static void
+SegListUpdateDPlaces( LALSegList *seglist, const LALSeg *seg )
+{
+  INT4 ns1 = seg->start.gpsNanoSeconds;
+  INT4 ns2 = seg->end.gpsNanoSeconds;
+
+  if ( seglist->dplaces < 9 ) {
+    if ( ns1 % 1000 || ns2 % 1000 ) {
+      /* 6 decimal places are not enough */
+      seglist->dplaces = 9;
+    } else if ( seglist->dplaces < 6 ) {
+      if ( ns1 % 1000000 || ns2 % 1000000 ) {
+        /* 3 decimal places are not enough */
+        seglist->dplaces = 6;
+      } else if ( seglist->dplaces < 3 ) {
+        if ( ns1 || ns2 ) {
+          /* At least one of the times does have a decimal part */
+          seglist->dplaces = 3;
+        }
+      }
+    }
+  }
+}
+
+
 /*---------------------------------------------------------------------------*/
 
 /**
@@ -377,7 +412,6 @@ XLALSegListAppend( LALSegList *seglist, const LALSeg *seg )
   LALSeg *segptr;
   LALSeg *prev;
   size_t newSize;
-  INT4 ns1, ns2;
 
   /* Make sure a non-null pointer was passed for the segment list */
   if ( ! seglist ) {
@@ -438,26 +472,8 @@ XLALSegListAppend( LALSegList *seglist, const LALSeg *seg )
   seglist->length++;
 
   /* See whether more decimal places are needed to represent these times than
-     were needed for segments already in the list.  Work with 0, 3, 6, or 9
-     decimal places. */
-  ns1 = seg->start.gpsNanoSeconds;
-  ns2 = seg->end.gpsNanoSeconds;
-  if ( seglist->dplaces < 9 ) {
-    if ( ns1 % 1000 || ns2 % 1000 ) {
-      /* 6 decimal places are not enough */
-      seglist->dplaces = 9;
-    } else if ( seglist->dplaces < 6 ) {
-      if ( ns1 % 1000000 || ns2 % 1000000 ) {
-        /* 3 decimal places are not enough */
-        seglist->dplaces = 6;
-      } else if ( seglist->dplaces < 3 ) {
-        if ( ns1 || ns2 ) {
-          /* At least one of the times does have a decimal part */
-          seglist->dplaces = 3;
-        }
-      }
-    }
-  }
+     were needed for segments already in the list. */
+  SegListUpdateDPlaces( seglist, seg );
 
   /* See whether the "disjoint" and/or "sorted" properties still hold */
   if ( seglist->length > 1 ) {
@@ -1150,3 +1166,577 @@ XLALSegListGet( LALSegList *seglist, UINT4 indx )
         return tmp;
 
 }  /* XLALSegListGet() */
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Return a segment list with the same segments as 'seglist' which is sorted
+   and disjoint: either 'seglist' itself, if it already has these properties,
+   or a coalesced copy of it in 'workspace', which must then be cleared by
+   the caller. */
+static const LALSegList *
+SegListDisjoint( const LALSegList *seglist, LALSegList *workspace )
+{
+  XLAL_CHECK_NULL( XLALSegListInit( workspace ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( seglist->disjoint ) {
+    return seglist;
+  }
+
+  workspace->segs = LALMalloc( seglist->length * sizeof(LALSeg) );
+  XLAL_CHECK_NULL( workspace->segs != NULL, XLAL_ENOMEM );
+  memcpy( workspace->segs, seglist->segs, seglist->length * sizeof(LALSeg) );
+  workspace->arraySize = workspace->length = seglist->length;
+  workspace->dplaces = seglist->dplaces;
+  workspace->sorted = seglist->sorted;
+  workspace->disjoint = 0;
+  XLAL_CHECK_NULL( XLALSegListCoalesce( workspace ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return workspace;
+}
+
+
+/* Replace the segments of 'seglist' with the 'length' sorted and disjoint
+   segments in 'segs', an array allocated with LALMalloc() which the segment
+   list takes ownership of. */
+static void
+SegListReplace( LALSegList *seglist, LALSeg *segs, UINT4 length )
+{
+  if ( seglist->segs ) {
+    LALFree( seglist->segs );
+  }
+  seglist->segs = segs;
+  seglist->arraySize = length;
+  seglist->length = length;
+  seglist->dplaces = 0;
+  for ( UINT4 i = 0; i < length; i++ ) {
+    SegListUpdateDPlaces( seglist, &segs[i] );
+  }
+  seglist->sorted = 1;
+  seglist->disjoint = 1;
+  seglist->lastFound = NULL;
+}
+
+
+/**
+ * Replace the segments in 'seglist' with the union of those in 'seglist' and
+ * 'other'.  The result is coalesced, as by XLALSegListCoalesce(), and each of
+ * its segments is assigned the \c id value of the earliest of the segments
+ * which were joined to make it.  Both lists are coalesced first if they are
+ * not already disjoint ('other' is not modified), after which the union is
+ * computed by a single merge of the two lists, in a time proportional to the
+ * sum of their lengths.
+ */
+int
+XLALSegListUnion( LALSegList *seglist, const LALSegList *other )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+  XLAL_CHECK( other->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  XLAL_CHECK( XLALSegListCoalesce( seglist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  LALSegList workspace;
+  const LALSegList *b = SegListDisjoint( other, &workspace );
+  XLAL_CHECK( b != NULL, XLAL_EFUNC );
+
+  const LALSeg *sa = seglist->segs, *sb = b->segs;
+  const UINT4 na = seglist->length, nb = b->length;
+  if ( na + nb == 0 ) {
+    return XLAL_SUCCESS;
+  }
+  LALSeg *segs = LALMalloc( ( na + nb ) * sizeof(LALSeg) );
+  if ( segs == NULL ) {
+    XLALSegListClear( &workspace );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+
+  /* Merge the two lists in XLALSegCmp() order, joining each segment to the
+     last one written if they touch or overlap */
+  UINT4 i = 0, j = 0, n = 0;
+  while ( i < na || j < nb ) {
+    const LALSeg *next = ( j >= nb || ( i < na && XLALSegCmp( &sa[i], &sb[j] ) <= 0 ) ) ? &sa[i++] : &sb[j++];
+    if ( n > 0 && XLALGPSCmp( &segs[n-1].end, &next->start ) >= 0 ) {
+      if ( XLALGPSCmp( &segs[n-1].end, &next->end ) < 0 ) {
+        segs[n-1].end = next->end;
+      }
+    } else {
+      segs[n++] = *next;
+    }
+  }
+
+  XLALSegListClear( &workspace );
+  SegListReplace( seglist, segs, n );
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Replace the segments in 'seglist' with the intersection of those in
+ * 'seglist' and 'other', i.e. the intervals of time contained in both lists.
+ * The result is sorted and disjoint, and each of its segments is assigned the
+ * \c id value of the segment of 'seglist' it was taken from.  Zero-length
+ * segments contain no time, and do not appear in the result.  Both lists are
+ * coalesced first if they are not already disjoint ('other' is not modified),
+ * after which the intersection is computed by a single merge of the two
+ * lists.
+ */
+int
+XLALSegListIntersect( LALSegList *seglist, const LALSegList *other )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+  XLAL_CHECK( other->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  XLAL_CHECK( XLALSegListCoalesce( seglist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  LALSegList workspace;
+  const LALSegList *b = SegListDisjoint( other, &workspace );
+  XLAL_CHECK( b != NULL, XLAL_EFUNC );
+
+  const LALSeg *sa = seglist->segs, *sb = b->segs;
+  const UINT4 na = seglist->length, nb = b->length;
+  LALSeg *segs = NULL;
+  if ( na > 0 && nb > 0 ) {
+    segs = LALMalloc( ( na + nb ) * sizeof(LALSeg) );
+    if ( segs == NULL ) {
+      XLALSegListClear( &workspace );
+      XLAL_ERROR( XLAL_ENOMEM );
+    }
+  }
+
+  /* Step through both lists, always advancing past the segment which ends
+     first, since it cannot overlap any later segment of the other list */
+  UINT4 i = 0, j = 0, n = 0;
+  while ( i < na && j < nb ) {
+    const LIGOTimeGPS *start = XLALGPSCmp( &sa[i].start, &sb[j].start ) > 0 ? &sa[i].start : &sb[j].start;
+    const LIGOTimeGPS *end = XLALGPSCmp( &sa[i].end, &sb[j].end ) < 0 ? &sa[i].end : &sb[j].end;
+    if ( XLALGPSCmp( start, end ) < 0 ) {
+      segs[n].start = *start;
+      segs[n].end = *end;
+      segs[n].id = sa[i].id;
+      n++;
+    }
+    if ( XLALGPSCmp( &sa[i].end, &sb[j].end ) < 0 ) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+
+  XLALSegListClear( &workspace );
+  SegListReplace( seglist, segs, n );
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Remove from the segments in 'seglist' the intervals of time contained in
+ * the segments of 'other'.  The result is sorted and disjoint, and each of its
+ * segments is assigned the \c id value of the segment of 'seglist' it was
+ * taken from;  a segment of 'seglist' can be split into several.  Zero-length
+ * segments contain no time, and do not appear in the result.  This is the
+ * operation used to apply a list of vetoes to a list of analysis segments.
+ * Both lists are coalesced first if they are not already disjoint ('other' is
+ * not modified), after which the difference is computed by a single merge of
+ * the two lists.
+ */
+int
+XLALSegListSubtract( LALSegList *seglist, const LALSegList *other )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+  XLAL_CHECK( other->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  XLAL_CHECK( XLALSegListCoalesce( seglist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  LALSegList workspace;
+  const LALSegList *b = SegListDisjoint( other, &workspace );
+  XLAL_CHECK( b != NULL, XLAL_EFUNC );
+
+  const LALSeg *sa = seglist->segs, *sb = b->segs;
+  const UINT4 na = seglist->length, nb = b->length;
+  LALSeg *segs = NULL;
+  if ( na > 0 ) {
+    segs = LALMalloc( ( na + nb ) * sizeof(LALSeg) );
+    if ( segs == NULL ) {
+      XLALSegListClear( &workspace );
+      XLAL_ERROR( XLAL_ENOMEM );
+    }
+  }
+
+  UINT4 j = 0, n = 0;
+  for ( UINT4 i = 0; i < na; i++ ) {
+    LIGOTimeGPS start = sa[i].start;
+
+    /* Skip the segments of 'other' which end before this segment starts;
+       they also end before every later segment of 'seglist' starts */
+    while ( j < nb && XLALGPSCmp( &sb[j].end, &start ) <= 0 ) {
+      j++;
+    }
+
+    /* Cut out each segment of 'other' which overlaps this segment */
+    for ( UINT4 k = j; k < nb && XLALGPSCmp( &sb[k].start, &sa[i].end ) < 0; k++ ) {
+      if ( XLALGPSCmp( &sb[k].start, &start ) > 0 ) {
+        segs[n].start = start;
+        segs[n].end = sb[k].start;
+        segs[n].id = sa[i].id;
+        n++;
+      }
+      if ( XLALGPSCmp( &sb[k].end, &start ) > 0 ) {
+        start = sb[k].end;
+      }
+    }
+
+    if ( XLALGPSCmp( &start, &sa[i].end ) < 0 ) {
+      segs[n].start = start;
+      segs[n].end = sa[i].end;
+      segs[n].id = sa[i].id;
+      n++;
+    }
+  }
+
+  XLALSegListClear( &workspace );
+  SegListReplace( seglist, segs, n );
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Replace the segments in 'seglist' with their complement within the interval
+ * [start, end), i.e. with the intervals of time between 'start' and 'end'
+ * which are not contained in any segment of 'seglist'.  The result is sorted
+ * and disjoint, and the \c id value of each of its segments is set to 0.  The
+ * list is coalesced first if it is not already disjoint.
+ */
+int
+XLALSegListComplement( LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeGPS *end )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( start != NULL && end != NULL, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+  XLAL_CHECK( XLALGPSCmp( start, end ) <= 0, XLAL_EDOM, "Invalid interval (%d.%09d > %d.%09d)",
+              start->gpsSeconds, start->gpsNanoSeconds, end->gpsSeconds, end->gpsNanoSeconds );
+
+  XLAL_CHECK( XLALSegListCoalesce( seglist ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  const LALSeg *sa = seglist->segs;
+  const UINT4 na = seglist->length;
+  LALSeg *segs = LALMalloc( ( na + 1 ) * sizeof(LALSeg) );
+  XLAL_CHECK( segs != NULL, XLAL_ENOMEM );
+
+  LIGOTimeGPS t = *start;
+  UINT4 n = 0;
+  for ( UINT4 i = 0; i < na && XLALGPSCmp( &sa[i].start, end ) < 0; i++ ) {
+    if ( XLALGPSCmp( &sa[i].start, &t ) > 0 ) {
+      XLALSegSet( &segs[n++], &t, &sa[i].start, 0 );
+    }
+    if ( XLALGPSCmp( &sa[i].end, &t ) > 0 ) {
+      t = sa[i].end;
+    }
+  }
+  if ( XLALGPSCmp( &t, end ) < 0 ) {
+    XLALSegSet( &segs[n++], &t, end, 0 );
+  }
+
+  SegListReplace( seglist, segs, n );
+
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Determine which segment in the list, if any, contains each of the 'n' GPS
+ * times in the array 'gps'.  If 'index' is not NULL, then 'index[i]' is set
+ * to the position in the list of the segment containing 'gps[i]', or to -1 if
+ * there is no such segment.  Returns the number of times contained in a
+ * segment of the list.
+ *
+ * If the list is ``disjoint'', then the list is searched from the position
+ * of the segment found for the previous time, stepping forward in
+ * exponentially growing strides before finishing with a binary search, and
+ * starting a binary search from the beginning of the list only when the
+ * times go backwards.  A set of times in increasing order is therefore
+ * located in a single pass over the list, in a time proportional to
+ * n log(length/n) + n.  Otherwise, XLALSegListSearch() is called for each
+ * time.
+ */
+INT4
+XLALSegListSearchBatch( LALSegList *seglist, const LIGOTimeGPS *gps, UINT4 n, INT4 *index )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( gps != NULL || n == 0, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  const LALSeg *segs = seglist->segs;
+  const UINT4 length = seglist->length;
+  INT4 count = 0;
+
+  if ( ! seglist->disjoint ) {
+    for ( UINT4 i = 0; i < n; i++ ) {
+      const LALSeg *segp = XLALSegListSearch( seglist, &gps[i] );
+      if ( segp ) {
+        count++;
+      }
+      if ( index ) {
+        index[i] = segp ? (INT4) ( segp - segs ) : -1;
+      }
+    }
+    return count;
+  }
+
+  /* 'cursor' is the first segment which does not end at or before the
+     previous time; 'segs[hi]' (if hi < length) is always known not to end at
+     or before the current time, and the search finds the first such segment
+     in [lo, hi] */
+  UINT4 cursor = 0;
+  for ( UINT4 i = 0; i < n; i++ ) {
+    const LIGOTimeGPS *t = &gps[i];
+    UINT4 lo, hi;
+
+    if ( cursor > 0 && XLALGPSInSeg( t, &segs[cursor-1] ) <= 0 ) {
+      /* The times went backwards */
+      lo = 0;
+      hi = cursor - 1;
+    } else {
+      UINT4 step = 1;
+      lo = hi = cursor;
+      while ( hi < length && XLALGPSInSeg( t, &segs[hi] ) > 0 ) {
+        lo = hi + 1;
+        hi = ( length - hi > step ) ? hi + step : length;
+        step *= 2;
+      }
+    }
+    while ( lo < hi ) {
+      UINT4 mid = lo + ( hi - lo ) / 2;
+      if ( XLALGPSInSeg( t, &segs[mid] ) > 0 ) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    cursor = lo;
+
+    if ( cursor < length && XLALGPSInSeg( t, &segs[cursor] ) == 0 ) {
+      count++;
+      if ( index ) {
+        index[i] = cursor;
+      }
+    } else if ( index ) {
+      index[i] = -1;
+    }
+  }
+
+  return count;
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* A node of a segment list index.  The nodes are sorted by start time and
+   form an implicit binary tree, in which the node at position i is at level
+   k if the k lowest bits of i are 1 and the next is 0; its children are at
+   positions i - 2^(k-1) and i + 2^(k-1).  'max' is the latest end time of the
+   segments in the subtree rooted at the node. */
+struct SegListIndexNode {
+  INT8 start;
+  INT8 end;
+  INT8 max;
+  UINT4 pos;
+};
+
+/** Interval index of a segment list */
+struct tagLALSegListIndex {
+  UINT4 length;
+  INT4 levels;
+  struct SegListIndexNode *nodes;
+};
+
+
+static int
+SegListIndexNodeCmp( const void *a, const void *b )
+{
+  const struct SegListIndexNode *na = a, *nb = b;
+  if ( na->start != nb->start ) {
+    return na->start < nb->start ? -1 : +1;
+  }
+  return ( na->pos > nb->pos ) - ( na->pos < nb->pos );
+}
+
+
+/**
+ * Create an index of the segments in a segment list, which need not be sorted
+ * or disjoint, with which XLALSegListIndexQuery() can find all of the
+ * segments overlapping an interval of time in a time proportional to
+ * log(length) plus the number of segments found.  The index holds a copy of
+ * the segment times, and does not reflect later changes to the list.
+ */
+LALSegListIndex *
+XLALSegListIndexCreate( const LALSegList *seglist )
+{
+  XLAL_CHECK_NULL( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  LALSegListIndex *index = LALCalloc( 1, sizeof(*index) );
+  XLAL_CHECK_NULL( index != NULL, XLAL_ENOMEM );
+  if ( seglist->length > 0 ) {
+    index->nodes = LALMalloc( seglist->length * sizeof(*index->nodes) );
+    if ( index->nodes == NULL ) {
+      LALFree( index );
+      XLAL_ERROR_NULL( XLAL_ENOMEM );
+    }
+  }
+
+  /* Zero-length segments contain no time, and never overlap anything */
+  UINT4 n = 0;
+  for ( UINT4 i = 0; i < seglist->length; i++ ) {
+    INT8 start = XLALGPSToINT8NS( &seglist->segs[i].start );
+    INT8 end = XLALGPSToINT8NS( &seglist->segs[i].end );
+    if ( start < end ) {
+      index->nodes[n].start = start;
+      index->nodes[n].end = end;
+      index->nodes[n].pos = i;
+      n++;
+    }
+  }
+  if ( ! seglist->sorted ) {
+    qsort( index->nodes, n, sizeof(*index->nodes), SegListIndexNodeCmp );
+  }
+  index->length = n;
+
+  /* Compute the latest end time of each subtree, level by level.  A node
+     whose right child lies beyond the end of the array takes the maximum of
+     the last subtree instead, which is tracked in 'last'. */
+  struct SegListIndexNode *nodes = index->nodes;
+  INT8 last = 0;
+  size_t last_i = 0;
+  for ( size_t i = 0; i < n; i += 2 ) {
+    last_i = i;
+    last = nodes[i].max = nodes[i].end;
+  }
+  INT4 k;
+  for ( k = 1; ( (size_t) 1 << k ) <= n; k++ ) {
+    const size_t x = (size_t) 1 << ( k - 1 );
+    for ( size_t i = ( x << 1 ) - 1; i < n; i += x << 2 ) {
+      INT8 max = nodes[i].end;
+      if ( nodes[i - x].max > max ) {
+        max = nodes[i - x].max;
+      }
+      INT8 right = i + x < n ? nodes[i + x].max : last;
+      if ( right > max ) {
+        max = right;
+      }
+      nodes[i].max = max;
+    }
+    last_i = ( ( last_i >> k ) & 1 ) ? last_i - x : last_i + x;
+    if ( last_i < n && nodes[last_i].max > last ) {
+      last = nodes[last_i].max;
+    }
+  }
+  index->levels = k - 1;
+
+  return index;
+}
+
+
+/**
+ * Free a segment list index created by XLALSegListIndexCreate().
+ */
+void
+XLALSegListIndexDestroy( LALSegListIndex *index )
+{
+  if ( index ) {
+    LALFree( index->nodes );
+    LALFree( index );
+  }
+}
+
+
+/**
+ * Find the segments of an indexed segment list which overlap the interval
+ * [start, end), or, if 'start' equals 'end', which contain the time 'start'.
+ * The positions in the segment list of up to 'size' of these segments are
+ * stored in the array 'result', in order of start time.  Returns the total
+ * number of overlapping segments, which can exceed 'size';  'result' may be
+ * NULL if 'size' is 0, e.g. to count the segments before allocating the array.
+ */
+INT4
+XLALSegListIndexQuery( const LALSegListIndex *index, const LIGOTimeGPS *start, const LIGOTimeGPS *end, UINT4 *result, UINT4 size )
+{
+  XLAL_CHECK( index != NULL, XLAL_EFAULT );
+  XLAL_CHECK( start != NULL && end != NULL, XLAL_EFAULT );
+  XLAL_CHECK( result != NULL || size == 0, XLAL_EFAULT );
+  XLAL_CHECK( XLALGPSCmp( start, end ) <= 0, XLAL_EDOM, "Invalid interval (%d.%09d > %d.%09d)",
+              start->gpsSeconds, start->gpsNanoSeconds, end->gpsSeconds, end->gpsNanoSeconds );
+
+  const struct SegListIndexNode *nodes = index->nodes;
+  const size_t n = index->length;
+  const INT8 qs = XLALGPSToINT8NS( start );
+  /* A time is the interval which ends 1 ns later */
+  const INT8 qe = qs == XLALGPSToINT8NS( end ) ? qs + 1 : XLALGPSToINT8NS( end );
+  INT4 count = 0;
+
+  if ( n == 0 ) {
+    return 0;
+  }
+
+  /* Depth-first, in-order traversal of the tree, visiting only the subtrees
+     which can contain an overlapping segment.  Small subtrees are scanned
+     linearly. */
+  struct { INT4 k; size_t x; int visited; } stack[64];
+  int top = 0;
+  stack[top].k = index->levels;
+  stack[top].x = ( (size_t) 1 << index->levels ) - 1;
+  stack[top].visited = 0;
+  top++;
+  while ( top > 0 ) {
+    const INT4 k = stack[--top].k;
+    const size_t x = stack[top].x;
+    const int visited = stack[top].visited;
+    if ( k <= 3 ) {
+      const size_t i0 = x >> k << k;
+      size_t i1 = i0 + ( (size_t) 1 << ( k + 1 ) ) - 1;
+      if ( i1 > n ) {
+        i1 = n;
+      }
+      for ( size_t i = i0; i < i1 && nodes[i].start < qe; i++ ) {
+        if ( qs < nodes[i].end ) {
+          if ( (UINT4) count < size ) {
+            result[count] = nodes[i].pos;
+          }
+          count++;
+        }
+      }
+    } else if ( ! visited ) {
+      /* Revisit this node after its left subtree */
+      const size_t y = x - ( (size_t) 1 << ( k - 1 ) );
+      stack[top].k = k;
+      stack[top].x = x;
+      stack[top].visited = 1;
+      top++;
+      if ( y >= n || nodes[y].max > qs ) {
+        stack[top].k = k - 1;
+        stack[top].x = y;
+        stack[top].visited = 0;
+        top++;
+      }
+    } else if ( x < n && nodes[x].start < qe ) {
+      if ( qs < nodes[x].end ) {
+        if ( (UINT4) count < size ) {
+          result[count] = nodes[x].pos;
+        }
+        count++;
+      }
+      stack[top].k = k - 1;
+      stack[top].x = x + ( (size_t) 1 << ( k - 1 ) );
+      stack[top].visited = 0;
+      top++;
+    }
+  }
+
+  return count;
+}
@@ -131,6 +131,16 @@ extern "C" {
  *
  * Also all segments in a segment list can be time-shifted using \c XLALSegListShift().
  *
+ * Two segment lists can be combined with \c XLALSegListUnion(),
+ * \c XLALSegListIntersect() and \c XLALSegListSubtract(), and the gaps in a
+ * list can be found with \c XLALSegListComplement().  These operate on
+ * disjoint lists (coalescing them first if necessary) and merge the two lists
+ * in a single pass.  Many times can be looked up in one call with
+ * \c XLALSegListSearchBatch(), which is fastest if the times are in
+ * increasing order.  For lists which are not disjoint, an interval index made
+ * with \c XLALSegListIndexCreate() finds all of the segments overlapping an
+ * interval of time with \c XLALSegListIndexQuery().
+ *
  */
 /** @{ */
 
@@ -187,6 +197,12 @@ tagLALSegList
 }
 LALSegList;
 
+/**
+ * Interval index of a segment list, created by XLALSegListIndexCreate().
+ * This is an opaque type.
+ */
+typedef struct tagLALSegListIndex LALSegListIndex;
+
 /*----------------------- Function prototypes ----------------------*/
 int
 XLALSegSet( LALSeg *seg, const LIGOTimeGPS *start, const LIGOTimeGPS *end,
@@ -238,6 +254,34 @@ XLALSegListKeep(  LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeG
 LALSeg *
 XLALSegListGet( LALSegList *seglist, UINT4 indx );
 
+int
+XLALSegListUnion( LALSegList *seglist, const LALSegList *other );
+
+int
+XLALSegListIntersect( LALSegList *seglist, const LALSegList *other );
+
+int
+XLALSegListSubtract( LALSegList *seglist, const LALSegList *other );
+
+int
+XLALSegListComplement( LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeGPS *end );
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+INT4
+XLALSegListSearchBatch( LALSegList *seglist, const LIGOTimeGPS *gps, UINT4 n, INT4 *index );
+
+LALSegListIndex *
+XLALSegListIndexCreate( const LALSegList *seglist );
+
+void
+XLALSegListIndexDestroy( LALSegListIndex *index );
+
+INT4
+XLALSegListIndexQuery( const LALSegListIndex *index, const LIGOTimeGPS *start, const LIGOTimeGPS *end, UINT4 *result, UINT4 size );
+
+#endif /* SWIG */
+
 
 int XLALSegListIsInitialized ( const LALSegList *seglist );
 int XLALSegListInitSimpleSegments ( LALSegList *seglist, LIGOTimeGPS startTime, UINT4 Nseg, REAL8 Tseg );
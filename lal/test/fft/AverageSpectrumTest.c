@@ -26,6 +26,9 @@
 #include <lal/RealFFT.h>
 #include <lal/Window.h>
 #include <lal/Random.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
 
 #define TESTSTATUS( s ) \
   if ( (s)->statusCode ) { REPORTSTATUS( s ); exit( 1 ); } else \
@@ -94,6 +97,69 @@ int main( void )
   fprintf( stdout, "mean:\t%e\terror:\t%f%%\n", ave, fabs( ave - 2.0 ) / 0.02 );
 
 
+  /* the running median of the last m + 1 segments must agree with the
+   * median spectrum of those segments */
+  {
+    const UINT4 nseg = 2 * m - 1;
+    REAL8TimeSeries *dseries;
+    REAL8TimeSeries segment;
+    REAL8Vector segdata;
+    REAL8FrequencySeries *dspec;
+    REAL8FrequencySeries *rspec;
+    REAL8FFTPlan *dplan;
+    REAL8Window *dwindow;
+    LALPSDRunningMedian *runmed;
+    REAL8 maxerr = 0;
+    UINT4 seg;
+
+    dseries = XLALCreateREAL8TimeSeries( "test", &tseries.epoch, 0.0, 1.0, &lalDimensionlessUnit, n * (nseg + 1) / 2 );
+    dspec = XLALCreateREAL8FrequencySeries( "test", &tseries.epoch, 0.0, 0.0, &lalDimensionlessUnit, n / 2 + 1 );
+    dplan = XLALCreateForwardREAL8FFTPlan( n, 0 );
+    dwindow = XLALCreateHannREAL8Window( n );
+    runmed = XLALPSDRunningMedianNew( m + 1 );
+    if ( ! dseries || ! dspec || ! dplan || ! dwindow || ! runmed )
+      return 1;
+    for ( i = 0; i < dseries->data->length; ++i )
+      dseries->data->data[i] = tseries.data->data[i];
+
+    /* feed all segments at half-segment stride to the running median */
+    segment = *dseries;
+    segment.data = &segdata;
+    segdata.length = n;
+    for ( seg = 0; seg < nseg; ++seg )
+    {
+      segdata.data = dseries->data->data + seg * n / 2;
+      if ( XLALPSDRunningMedianAddSegment( runmed, &segment, dwindow, dplan ) )
+        return 1;
+    }
+    if ( XLALPSDRunningMedianGetNSamples( runmed ) != m + 1 )
+      return 1;
+    rspec = XLALPSDRunningMedianGetPSD( runmed );
+
+    /* batch median of the last m + 1 segments */
+    segdata.data = dseries->data->data + (nseg - m - 1) * n / 2;
+    segdata.length = n * (m + 2) / 2;
+    if ( ! rspec || XLALREAL8AverageSpectrumMedian( dspec, &segment, n, n / 2, dwindow, dplan ) )
+      return 1;
+
+    for ( i = 0; i < dspec->data->length; ++i )
+    {
+      REAL8 err = fabs( rspec->data->data[i] - dspec->data->data[i] ) / dspec->data->data[i];
+      if ( err > maxerr )
+        maxerr = err;
+    }
+    fprintf( stdout, "running median:\tmaximum fractional difference:\t%e\n", maxerr );
+    if ( maxerr > 1e-12 )
+      return 1;
+
+    XLALDestroyREAL8FrequencySeries( rspec );
+    XLALPSDRunningMedianFree( runmed );
+    XLALDestroyREAL8Window( dwindow );
+    XLALDestroyREAL8FFTPlan( dplan );
+    XLALDestroyREAL8FrequencySeries( dspec );
+    XLALDestroyREAL8TimeSeries( dseries );
+  }
+
   /* cleanup */
   XLALDestroyREAL4Window( window );
   XLALDestroyREAL4FFTPlan( plan );
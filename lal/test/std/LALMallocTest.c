@@ -54,6 +54,10 @@
 #include <signal.h>
 #include <lal/LALStdio.h>
 #include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
 
 /* never use this... never! */
 void XLALClobberDebugLevel(int);
@@ -325,6 +329,208 @@ static int stressTestRealloc( void )
   return 0;
 }
 
+/* test the lightweight accounting mode */
+static int testAccounting( void )
+{
+  const size_t nmax = 256;
+  int keep = lalDebugLevel;
+  size_t total;
+  size_t peak;
+  size_t count;
+
+  s = malloc( 4 * sizeof( *s ) );
+  v = malloc( nmax * sizeof( *v ) );
+
+  XLALClobberDebugLevel(lalDebugLevel | LALMEMACCTTRK);
+  XLALClobberDebugLevel(lalDebugLevel & ~LALMEMPADBIT);
+
+  /* totals */
+  trial( LALCheckMemoryLeaks(), 0, "" );
+  trial( p = LALMalloc( 4 * sizeof( *p ) ), 0, "" );
+  trial( q = LALCalloc( 2, sizeof( *q ) ), 0, "" );
+  if ( q[0] || q[1] ) die( calloc memory not zeroed );
+  XLALGetMemoryAccounting( &total, &peak, &count );
+  if ( total != 6 * sizeof( *p ) || count != 2 ) die( wrong totals );
+  if ( peak < total ) die( wrong peak );
+  trial( p = LALRealloc( p, 8 * sizeof( *p ) ), 0, "" );
+  XLALGetMemoryAccounting( &total, &peak, &count );
+  if ( total != 10 * sizeof( *p ) || count != 2 ) die( wrong totals after realloc );
+  trial( LALCheckMemoryLeaks(), SIGSEGV, "memory leak" );
+  trial( LALFree( p ), 0, "" );
+  trial( q = LALRealloc( q, 0 ), 0, "" );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+
+  /* wrong magic */
+  s[1] = 0;
+  trial( LALFree( s + 2 ), SIGSEGV, "wrong magic" );
+
+  /* sampled tracking */
+  for ( n = 0; n < nmax; ++n )
+    trial( v[n] = LALMalloc( ( n + 1 ) * sizeof( **v ) ), 0, "" );
+  XLALGetMemoryAccounting( &total, &peak, &count );
+  if ( total != nmax * ( nmax + 1 ) / 2 * sizeof( **v ) || count != nmax ) die( wrong sampled totals );
+  trial( XLALPrintMemoryAccounting(), 0, "" );
+  trial( LALCheckMemoryLeaks(), SIGSEGV, "memory leak" );
+  for ( n = 0; n < nmax; ++n )
+    trial( LALFree( v[n] ), 0, "" );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+
+  free( v );
+  free( s );
+  XLALClobberDebugLevel(keep);
+  return 0;
+}
+
+#ifdef LAL_PTHREAD_LOCK
+/* blocks allocated by one thread and freed by another; the total of each
+ * list is below the 64 KiB at which a thread adds its allocations to the
+ * running total */
+enum { acctThreadBlocks = 50, acctThreadBlockSize = 1000 };
+static void *acctThreadAlloc( void *blocks )
+{
+  for ( size_t k = 0; k < acctThreadBlocks; ++k )
+    ( (void **) blocks )[k] = LALMalloc( acctThreadBlockSize );
+  return NULL;
+}
+static void *acctThreadFree( void *blocks )
+{
+  for ( size_t k = 0; k < 2 * acctThreadBlocks; ++k )
+    LALFree( ( (void **) blocks )[k] );
+  return NULL;
+}
+
+/* test the lightweight accounting mode with frees made by another thread */
+static int testAccountingThreads( void )
+{
+  int keep = lalDebugLevel;
+  void *blocks[2 * acctThreadBlocks];
+  pthread_t thread;
+  size_t total;
+  size_t peak;
+  size_t peak0;
+  size_t count;
+
+  XLALClobberDebugLevel(lalDebugLevel | LALMEMACCT);
+  XLALClobberDebugLevel(lalDebugLevel & ~LALMEMPADBIT);
+  XLALGetMemoryAccounting( NULL, &peak0, NULL );
+
+  /* this thread and another each allocate half of the blocks */
+  acctThreadAlloc( blocks );
+  if ( pthread_create( &thread, NULL, acctThreadAlloc, blocks + acctThreadBlocks ) ) die( could not create thread );
+  pthread_join( thread, NULL );
+
+  /* a third thread frees all of them; its count goes negative and is added
+   * to the running total before the allocations of the other two are */
+  if ( pthread_create( &thread, NULL, acctThreadFree, blocks ) ) die( could not create thread );
+  pthread_join( thread, NULL );
+  if ( lalMallocTotal > 2 * acctThreadBlocks * acctThreadBlockSize ) die( wrapped total after threaded free );
+  XLALGetMemoryAccounting( &total, &peak, &count );
+  if ( total != 0 || count != 0 ) die( wrong totals after threaded free );
+  if ( peak > peak0 + 2 * acctThreadBlocks * acctThreadBlockSize ) die( wrong peak after threaded free );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+
+  XLALClobberDebugLevel(keep);
+  return 0;
+}
+#endif
+
+#ifdef LAL_PTHREAD_LOCK
+/* replacement for LALRaise in threads other than the main thread */
+int caughtSignal;
+static int RecordRaise( int sig, const char *fmt, ... )
+{
+  va_list ap;
+  va_start( ap, fmt );
+  vsnprintf( caughtMessage, sizeof( caughtMessage ), fmt, ap );
+  va_end( ap );
+  caughtSignal = sig;
+  return -1;
+}
+static void *poolThreadFree( void *block )
+{
+  LALFree( block );
+  return NULL;
+}
+#endif
+
+/* test the memory pools */
+static int testMemoryPool( void )
+{
+  REAL8Vector *vec;
+#ifdef LAL_PTHREAD_LOCK
+  pthread_t thread;
+#endif
+
+  /* without a pool, allocations are as usual */
+  trial( p = XLALPoolMalloc( 4 * sizeof( *p ) ), 0, "" );
+  trial( LALCheckMemoryLeaks(), SIGSEGV, "memory leak" );
+  trial( XLALFree( p ), 0, "" );
+
+  /* freed blocks are reused */
+  if ( XLALBeginMemoryPool() < 0 ) die( could not begin pool );
+  p = XLALPoolMalloc( 100 );
+  q = XLALPoolMalloc( 100 );
+  if ( ! p || ! q || p == q ) die( pool allocation failed );
+  if ( ( (size_t) p ) % 64 || ( (size_t) q ) % 64 ) die( pool allocation not aligned );
+  XLALFree( p );
+  r = XLALPoolMalloc( 80 );
+  if ( r != p ) die( pool block not reused );
+
+  /* resizing moves to a larger block and keeps the contents */
+  for ( i = 0; i < 10; ++i ) r[i] = i;
+  r = XLALRealloc( r, 10000 * sizeof( *r ) );
+  if ( ! r ) die( pool reallocation failed );
+  for ( i = 0; i < 10; ++i ) if ( r[i] != i ) die( wrong contents );
+  XLALFree( r );
+
+  /* factories draw from the pool and work with the destroy functions */
+  vec = XLALCreateREAL8Vector( 1000 );
+  if ( ! vec ) die( could not create vector );
+  vec = XLALResizeREAL8Vector( vec, 3000 );
+  if ( ! vec ) die( could not resize vector );
+  XLALDestroyREAL8Vector( vec );
+
+  /* a nested pool releases its memory when it ends */
+  if ( XLALBeginMemoryPool() < 0 ) die( could not begin nested pool );
+  s = XLALPoolMalloc( 100 );
+  XLALFree( q );
+  if ( XLALEndMemoryPool() < 0 ) die( could not end nested pool );
+
+  /* a reset makes the whole pool available again */
+  if ( XLALResetMemoryPool() < 0 ) die( could not reset pool );
+  r = XLALPoolMalloc( 100 );
+  if ( r != p ) die( pool not reset );
+
+  /* double frees, and frees of blocks allocated before a reset, are trapped */
+  trial( LALFree( r ), 0, "" );
+  trial( LALFree( r ), SIGSEGV, "is not allocated" );
+  r = XLALPoolMalloc( 100 );
+  if ( XLALResetMemoryPool() < 0 ) die( could not reset pool );
+  trial( LALFree( r ), SIGSEGV, "is not allocated" );
+
+#ifdef LAL_PTHREAD_LOCK
+  /* frees of pool blocks by another thread are trapped */
+  r = XLALPoolMalloc( 100 );
+  caughtSignal = 0;
+  lalRaiseHook = RecordRaise;
+  if ( pthread_create( &thread, NULL, poolThreadFree, r ) ) die( could not create thread );
+  pthread_join( thread, NULL );
+  lalRaiseHook = TestRaise;
+  if ( caughtSignal != SIGSEGV || ! strstr( caughtMessage, "another thread" ) ) die( foreign free not trapped );
+  trial( LALFree( r ), 0, "" );
+#endif
+
+  /* blocks not freed are released when the pool ends */
+  if ( XLALEndMemoryPool() < 0 ) die( could not end pool );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+
+  /* there is no pool left to end */
+  if ( XLALEndMemoryPool() == 0 ) die( ended nonexistent pool );
+  XLALClearErrno();
+
+  return 0;
+}
+
 
 int main( void )
 {
@@ -342,6 +548,11 @@ int main( void )
   if ( testPadding() ) return 1;
   if ( testAllocList() ) return 1;
   if ( stressTestRealloc() ) return 1;
+  if ( testAccounting() ) return 1;
+#ifdef LAL_PTHREAD_LOCK
+  if ( testAccountingThreads() ) return 1;
+#endif
+  if ( testMemoryPool() ) return 1;
 
   trial( LALCheckMemoryLeaks(), 0, "" );
 
@@ -0,0 +1,234 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
+#include <lal/ZPGFilter.h>
+#include <lal/IIRFilter.h>
+#include <lal/BandPassTimeSeries.h>
+
+/**
+ * \file
+ * \ingroup SOSFilter_c
+ *
+ * \brief Tests the second-order-section filter routines.
+ *
+ * Checks that a low-order filter gives the same output as the
+ * corresponding \c REAL8IIRFilter, that filtering a vector in pieces
+ * gives the same output as filtering it at once, that the sequence
+ * functions agree with the vector functions, and that the Butterworth
+ * SOS filters reproduce the \c REAL8IIRFilter implementation built
+ * independently from the poles of the filter.
+ */
+
+/** \cond DONT_DOXYGEN */
+
+#define NPTS 4096
+#define NCHAN 11
+#define TOL 1e-10
+
+#define CHECK( cond, msg ) \
+  do { if ( ! (cond) ) { fprintf( stderr, "FAIL: %s\n", (msg) ); return 1; } } while (0)
+
+static REAL8 maxdiff( const REAL8 *a, const REAL8 *b, UINT4 n )
+{
+  REAL8 d = 0.0;
+  UINT4 i;
+  for ( i = 0; i < n; ++i )
+    if ( fabs( a[i] - b[i] ) > d )
+      d = fabs( a[i] - b[i] );
+  return d;
+}
+
+static void fill( REAL8 *data, UINT4 n, UINT4 seed )
+{
+  UINT4 i;
+  for ( i = 0; i < n; ++i )
+    data[i] = sin( 0.01 * i * ( seed + 1 ) ) + ( i % ( 17 + seed ) == 0 ? 1.0 : 0.0 );
+}
+
+/* Apply an order n Butterworth filter of the given type (1 for low-pass,
+   2 for high-pass) and characteristic frequency wc in the w-plane, as
+   XLALButterworthREAL8TimeSeries() used to: each pair of poles, and the
+   unpaired pole, is transformed to the z-plane with its zeros and made
+   into a REAL8IIRFilter, which is applied forward and then in reverse. */
+static void butterworth_iir( REAL8Vector *data, INT4 type, REAL8 wc, INT4 n )
+{
+  INT4 i, j;
+  for ( i = 0, j = n - 1; i <= j; ++i, --j )
+  {
+    COMPLEX16ZPGFilter *zpg;
+    REAL8IIRFilter *iir;
+    if ( i < j )
+    {
+      REAL8 theta = LAL_PI * ( i + 0.5 ) / n;
+      zpg = XLALCreateCOMPLEX16ZPGFilter( type == 2 ? 2 : 0, 2 );
+      if ( type == 2 )
+      {
+        zpg->zeros->data[0] = zpg->zeros->data[1] = 0.0;
+        zpg->gain = 1.0;
+      }
+      else
+        zpg->gain = -wc * wc;
+      zpg->poles->data[0] = wc * cos( theta ) + I * wc * sin( theta );
+      zpg->poles->data[1] = -wc * cos( theta ) + I * wc * sin( theta );
+    }
+    else
+    {
+      zpg = XLALCreateCOMPLEX16ZPGFilter( type == 2 ? 1 : 0, 1 );
+      if ( type == 2 )
+      {
+        zpg->zeros->data[0] = 0.0;
+        zpg->gain = 1.0;
+      }
+      else
+        zpg->gain = -wc * I;
+      zpg->poles->data[0] = wc * I;
+    }
+    XLALWToZCOMPLEX16ZPGFilter( zpg );
+    iir = XLALCreateREAL8IIRFilter( zpg );
+    XLALIIRFilterREAL8Vector( data, iir );
+    XLALIIRFilterReverseREAL8Vector( data, iir );
+    XLALDestroyREAL8IIRFilter( iir );
+    XLALDestroyCOMPLEX16ZPGFilter( zpg );
+  }
+}
+
+int main( void )
+{
+  COMPLEX16ZPGFilter *zpg;
+  REAL8IIRFilter *iir;
+  REAL8SOSFilter *sos;
+  REAL8Vector *a;
+  REAL8Vector *b;
+  REAL8VectorSequence *seq;
+  PassBandParamStruc params;
+  UINT4 c;
+
+  XLALSetErrorHandler( XLALAbortErrorHandler );
+
+  /* A fourth-order filter in the z-plane with two conjugate pairs of
+     poles, a pair of real zeros and a conjugate pair of zeros. */
+  zpg = XLALCreateCOMPLEX16ZPGFilter( 4, 4 );
+  zpg->zeros->data[0] = -1.0;
+  zpg->zeros->data[1] = 0.5;
+  zpg->zeros->data[2] = cpolar( 1.0, 0.3 );
+  zpg->zeros->data[3] = cpolar( 1.0, -0.3 );
+  zpg->poles->data[0] = cpolar( 0.9, 0.1 );
+  zpg->poles->data[1] = cpolar( 0.9, -0.1 );
+  zpg->poles->data[2] = cpolar( 0.5, 1.0 );
+  zpg->poles->data[3] = cpolar( 0.5, -1.0 );
+  zpg->gain = 0.1;
+
+  iir = XLALCreateREAL8IIRFilter( zpg );
+  sos = XLALCreateREAL8SOSFilter( zpg );
+  CHECK( sos->numSections == 2, "number of sections" );
+
+  /* The SOS filter and the IIR filter agree. */
+  a = XLALCreateREAL8Vector( NPTS );
+  b = XLALCreateREAL8Vector( NPTS );
+  fill( a->data, NPTS, 0 );
+  fill( b->data, NPTS, 0 );
+  XLALIIRFilterREAL8Vector( a, iir );
+  XLALSOSFilterREAL8Vector( b, sos );
+  CHECK( maxdiff( a->data, b->data, NPTS ) < TOL, "SOS and IIR filters differ" );
+
+  /* Filtering in pieces carries the state across calls. */
+  fill( b->data, NPTS, 0 );
+  XLALResetREAL8SOSFilter( sos );
+  b->length = 1000;
+  XLALSOSFilterREAL8Vector( b, sos );
+  b->data += 1000;
+  b->length = NPTS - 1000;
+  XLALSOSFilterREAL8Vector( b, sos );
+  b->data -= 1000;
+  b->length = NPTS;
+  CHECK( maxdiff( a->data, b->data, NPTS ) < TOL, "SOS filter state not carried over" );
+
+  /* The sequence functions agree with the vector functions. */
+  seq = XLALCreateREAL8VectorSequence( NCHAN, NPTS );
+  for ( c = 0; c < NCHAN; ++c )
+    fill( seq->data + c * NPTS, NPTS, c );
+  XLALSOSFiltFiltREAL8VectorSequence( seq, sos );
+  for ( c = 0; c < NCHAN; ++c )
+  {
+    fill( a->data, NPTS, c );
+    XLALSOSFiltFiltREAL8Vector( a, sos );
+    CHECK( maxdiff( a->data, seq->data + c * NPTS, NPTS ) < TOL, "SOS sequence and vector filt-filt differ" );
+  }
+  for ( c = 0; c < NCHAN; ++c )
+    fill( seq->data + c * NPTS, NPTS, c );
+  XLALSOSFilterREAL8VectorSequence( seq, sos );
+  for ( c = 0; c < NCHAN; ++c )
+  {
+    fill( a->data, NPTS, c );
+    XLALResetREAL8SOSFilter( sos );
+    XLALSOSFilterREAL8Vector( a, sos );
+    CHECK( maxdiff( a->data, seq->data + c * NPTS, NPTS ) < TOL, "SOS sequence and vector filters differ" );
+  }
+
+  XLALDestroyREAL8VectorSequence( seq );
+  XLALDestroyREAL8SOSFilter( sos );
+  XLALDestroyREAL8IIRFilter( iir );
+  XLALDestroyCOMPLEX16ZPGFilter( zpg );
+
+  /* The Butterworth filters, low-pass and high-pass, match the
+     IIR filters built from their w-plane poles. */
+  for ( c = 0; c < 2; ++c )
+  {
+    REAL8TimeSeries series;
+    params.nMax = 7;
+    params.f1 = c ? -1 : 0.05;
+    params.a1 = c ? -1 : 0.9;
+    params.f2 = c ? 0.1 : -1;
+    params.a2 = c ? 0.9 : -1;
+    sos = XLALCreateButterworthREAL8SOSFilter( &params, 1.0 );
+    CHECK( sos->numSections == 4, "number of Butterworth sections" );
+    fill( a->data, NPTS, 1 );
+    fill( b->data, NPTS, 1 );
+    if ( c )
+      butterworth_iir( a, 2, tan( LAL_PI * 0.1 ) * pow( 1.0 / sqrt( 0.9 ) - 1.0, 0.5 / 7 ), 7 );
+    else
+      butterworth_iir( a, 1, tan( LAL_PI * 0.05 ) * pow( 1.0 / sqrt( 0.9 ) - 1.0, -0.5 / 7 ), 7 );
+    XLALSOSFiltFiltREAL8Vector( b, sos );
+    CHECK( maxdiff( a->data, b->data, NPTS ) < TOL, "Butterworth SOS and IIR filters differ" );
+
+    /* XLALButterworthREAL8TimeSeries() applies the same filter. */
+    series.deltaT = 1.0;
+    series.data = b;
+    fill( b->data, NPTS, 1 );
+    XLALButterworthREAL8TimeSeries( &series, &params );
+    CHECK( maxdiff( a->data, b->data, NPTS ) < TOL, "Butterworth time series differs" );
+
+    XLALDestroyREAL8SOSFilter( sos );
+  }
+
+  XLALDestroyREAL8Vector( a );
+  XLALDestroyREAL8Vector( b );
+  LALCheckMemoryLeaks();
+  return 0;
+}
+
+/** \endcond */
@@ -0,0 +1,158 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/**
+ * \file
+ * \ingroup ResampleTimeSeries_h
+ *
+ * \brief Tests the polyphase resampler in \ref ResampleTimeSeries_c.
+ *
+ * Resamples sinusoids by several rational ratios and compares the output
+ * with the sinusoid sampled at the new rate, away from the ends of the
+ * series; checks that a sinusoid above the new Nyquist frequency is
+ * suppressed; and checks that resampling a stream supplied in blocks of
+ * random length gives the same output as resampling it at once.
+ */
+
+/** \cond DONT_DOXYGEN */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/ResampleTimeSeries.h>
+
+#define NPTS 65536
+
+/* largest error in the middle half of a sinusoid of frequency f resampled
+ * from rate fin to rate fout; if stream is non-zero, also check that
+ * streaming the data through a resampler in random blocks gives the same
+ * output */
+static REAL8 test( UINT4 fin, UINT4 fout, REAL8 f, REAL8 expect, UINT4 up, UINT4 down, int stream )
+{
+  REAL8TimeSeries series;
+  REAL8Vector *input;
+  REAL8 err = 0.0;
+  UINT4 i;
+
+  series.deltaT = 1.0 / fin;
+  series.data = XLALCreateREAL8Vector( NPTS );
+  input = XLALCreateREAL8Vector( NPTS );
+  for ( i = 0; i < NPTS; ++i )
+    series.data->data[i] = input->data[i] = sin( LAL_TWOPI * f * i / fin );
+
+  if ( XLALPolyphaseResampleREAL8TimeSeries( &series, 1.0 / fout ) < 0 )
+  {
+    fprintf( stderr, "FAIL: resampling %u Hz to %u Hz failed\n", fin, fout );
+    exit( 1 );
+  }
+  if ( series.data->length != (UINT8)NPTS * fout / fin )
+  {
+    fprintf( stderr, "FAIL: resampling %u Hz to %u Hz gave %u samples\n", fin, fout, series.data->length );
+    exit( 1 );
+  }
+  for ( i = series.data->length / 4; i < 3 * series.data->length / 4; ++i )
+  {
+    REAL8 e = fabs( series.data->data[i] - expect * sin( LAL_TWOPI * f * i / fout ) );
+    if ( e > err )
+      err = e;
+  }
+
+  if ( stream )
+  {
+    LALResampler *resampler = XLALCreateResampler( up, down, 32 );
+    UINT4 total = NPTS + XLALResamplerGetDelay( resampler );
+    UINT4 pos = 0;
+    UINT4 outpos = 0;
+    srand( 1 );
+    while ( pos < total )
+    {
+      REAL8Vector *block = XLALCreateREAL8Vector( rand() % 3000 );
+      REAL8Vector *output;
+      for ( i = 0; i < block->length; ++i )
+        block->data[i] = pos + i < NPTS ? input->data[pos + i] : 0.0;
+      pos += block->length;
+      output = XLALResamplerProcessREAL8Vector( resampler, block );
+      for ( i = 0; i < output->length && outpos + i < series.data->length; ++i )
+        if ( output->data[i] != series.data->data[outpos + i] )
+        {
+          fprintf( stderr, "FAIL: streamed resampling %u Hz to %u Hz differs at sample %u\n", fin, fout, outpos + i );
+          exit( 1 );
+        }
+      outpos += output->length;
+      XLALDestroyREAL8Vector( output );
+      XLALDestroyREAL8Vector( block );
+    }
+    if ( outpos < series.data->length )
+    {
+      fprintf( stderr, "FAIL: streamed resampling %u Hz to %u Hz gave only %u samples\n", fin, fout, outpos );
+      exit( 1 );
+    }
+    XLALDestroyResampler( resampler );
+  }
+
+  XLALDestroyREAL8Vector( input );
+  XLALDestroyREAL8Vector( series.data );
+  return err;
+}
+
+int main( void )
+{
+  struct { UINT4 fin, fout; REAL8 f, expect; UINT4 up, down; int stream; REAL8 tol; } cases[] = {
+    { 16384, 4096, 1000.0, 1.0, 1, 4, 1, 1e-4 },
+    { 16384, 3072, 100.0, 1.0, 3, 16, 1, 1e-4 },
+    { 16384, 3072, 0.8 * 1536, 1.0, 3, 16, 0, 1e-3 },
+    { 4096, 16384, 1000.0, 1.0, 4, 1, 1, 1e-4 },
+    { 1000, 1001, 10.0, 1.0, 1001, 1000, 1, 1e-4 },
+    /* a sinusoid above the new Nyquist frequency is removed */
+    { 16384, 4096, 2300.0, 0.0, 1, 4, 0, 1e-3 },
+  };
+  UINT4 i;
+
+  XLALSetErrorHandler( XLALAbortErrorHandler );
+
+  for ( i = 0; i < sizeof( cases ) / sizeof( *cases ); ++i )
+  {
+    REAL8 err = test( cases[i].fin, cases[i].fout, cases[i].f, cases[i].expect, cases[i].up, cases[i].down, cases[i].stream );
+    if ( err > cases[i].tol )
+    {
+      fprintf( stderr, "FAIL: resampling %g Hz from %u Hz to %u Hz: error %g\n", cases[i].f, cases[i].fin, cases[i].fout, err );
+      return 1;
+    }
+  }
+
+  /* the delay of a NULL resampler is the documented error value */
+  {
+    UINT4 delay = 0;
+    int errnum;
+    XLAL_TRY_SILENT( delay = XLALResamplerGetDelay( NULL ), errnum );
+    if ( delay != (UINT4) XLAL_FAILURE || errnum != XLAL_EFAULT )
+    {
+      fprintf( stderr, "FAIL: delay of a NULL resampler: %u, error %d\n", delay, errnum );
+      return 1;
+    }
+  }
+
+  LALCheckMemoryLeaks();
+  return 0;
+}
+
+/** \endcond */
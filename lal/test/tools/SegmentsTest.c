@@ -1230,6 +1230,129 @@ int main( int argc, char *argv[] )
   XLALPrintInfo("Passed XLALSegListRange tests\n");
 
 
+  /*-------------------------------------------------------------------------*/
+  XLALPrintInfo("\n========== Segment list set operation, batch search and index tests \n");
+  /*-------------------------------------------------------------------------*/
+
+  {
+    /* Random lists of overlapping segments with integer times in [0, 200)
+       are checked against brute-force membership tests at every half
+       second */
+    const INT4 tmax = 200;
+    srand( 12345 );
+
+    for ( INT4 trial = 0; trial < 50; trial++ ) {
+      LALSegList a, b, r;
+      LIGOTimeGPS start, end;
+      XLAL_CHECK( XLALSegListInit( &a ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALSegListInit( &b ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( INT4 i = 0; i < 1 + trial % 20; i++ ) {
+        for ( INT4 l = 0; l < 2; l++ ) {
+          INT4 t0 = rand() % tmax;
+          INT4 t1 = t0 + rand() % 20;
+          XLALGPSSet( &start, t0, 0 );
+          XLALGPSSet( &end, t1 < tmax ? t1 : tmax, 0 );
+          XLAL_CHECK( XLALSegSet( &seg, &start, &end, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLAL_CHECK( XLALSegListAppend( l ? &b : &a, &seg ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+      }
+
+      for ( INT4 op = 0; op < 4; op++ ) {
+        XLAL_CHECK( XLALSegListInit( &r ) == XLAL_SUCCESS, XLAL_EFUNC );
+        for ( UINT4 i = 0; i < a.length; i++ ) {
+          XLAL_CHECK( XLALSegListAppend( &r, &a.segs[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+        XLALGPSSet( &start, 10, 0 );
+        XLALGPSSet( &end, tmax - 10, 0 );
+        switch ( op ) {
+        case 0: XLAL_CHECK( XLALSegListUnion( &r, &b ) == XLAL_SUCCESS, XLAL_EFUNC ); break;
+        case 1: XLAL_CHECK( XLALSegListIntersect( &r, &b ) == XLAL_SUCCESS, XLAL_EFUNC ); break;
+        case 2: XLAL_CHECK( XLALSegListSubtract( &r, &b ) == XLAL_SUCCESS, XLAL_EFUNC ); break;
+        case 3: XLAL_CHECK( XLALSegListComplement( &r, &start, &end ) == XLAL_SUCCESS, XLAL_EFUNC ); break;
+        }
+        XLAL_CHECK( r.sorted && r.disjoint, XLAL_EFAILED, "result of operation %d is not sorted and disjoint", op );
+        for ( UINT4 i = 1; i < r.length; i++ ) {
+          XLAL_CHECK( XLALGPSCmp( &r.segs[i-1].end, &r.segs[i].start ) <= 0, XLAL_EFAILED, "result of operation %d overlaps", op );
+        }
+        for ( INT4 t2 = -2; t2 < 2 * tmax + 2; t2++ ) {
+          LIGOTimeGPS t;
+          XLALGPSSet( &t, t2 / 2 - ( t2 < 0 ), t2 % 2 ? 500000000 : 0 );
+          int ina = 0, inb = 0, inr = 0, expected = 0;
+          for ( UINT4 i = 0; i < a.length; i++ ) ina |= XLALGPSInSeg( &t, &a.segs[i] ) == 0;
+          for ( UINT4 i = 0; i < b.length; i++ ) inb |= XLALGPSInSeg( &t, &b.segs[i] ) == 0;
+          for ( UINT4 i = 0; i < r.length; i++ ) inr |= XLALGPSInSeg( &t, &r.segs[i] ) == 0;
+          switch ( op ) {
+          case 0: expected = ina || inb; break;
+          case 1: expected = ina && inb; break;
+          case 2: expected = ina && ! inb; break;
+          case 3: expected = ! ina && XLALGPSCmp( &t, &start ) >= 0 && XLALGPSCmp( &t, &end ) < 0; break;
+          }
+          XLAL_CHECK( inr == expected, XLAL_EFAILED, "operation %d wrong at time %d.%09d", op, t.gpsSeconds, t.gpsNanoSeconds );
+        }
+        XLALSegListClear( &r );
+      }
+
+      /* Batch search of the coalesced list, with increasing and with
+         random times, against XLALSegListSearch() */
+      {
+        LIGOTimeGPS times[400];
+        INT4 index[400];
+        XLAL_CHECK( XLALSegListCoalesce( &b ) == XLAL_SUCCESS, XLAL_EFUNC );
+        for ( INT4 pass = 0; pass < 2; pass++ ) {
+          INT4 count = 0;
+          for ( INT4 i = 0; i < 400; i++ ) {
+            INT4 t2 = pass ? rand() % ( 2 * tmax ) : i;
+            XLALGPSSet( &times[i], t2 / 2, t2 % 2 ? 500000000 : 0 );
+          }
+          INT4 found = XLALSegListSearchBatch( &b, times, 400, index );
+          for ( INT4 i = 0; i < 400; i++ ) {
+            segptr = XLALSegListSearch( &b, &times[i] );
+            XLAL_CHECK( segptr ? index[i] == segptr - b.segs : index[i] == -1, XLAL_EFAILED, "batch search wrong for time %d", i );
+            count += segptr != NULL;
+          }
+          XLAL_CHECK( found == count, XLAL_EFAILED, "batch search count %d != %d", found, count );
+        }
+      }
+
+      /* Interval index queries of the uncoalesced list, against a
+         brute-force search */
+      {
+        LALSegListIndex *index = XLALSegListIndexCreate( &a );
+        UINT4 result[64];
+        XLAL_CHECK( index != NULL, XLAL_EFUNC );
+        for ( INT4 q = 0; q < 100; q++ ) {
+          INT4 t0 = rand() % tmax;
+          INT4 t1 = q % 4 ? t0 + rand() % 10 : t0;
+          INT4 count = 0;
+          XLALGPSSet( &start, t0, 0 );
+          XLALGPSSet( &end, t1, 0 );
+          INT4 found = XLALSegListIndexQuery( index, &start, &end, result, 64 );
+          for ( UINT4 i = 0; i < a.length; i++ ) {
+            const LALSeg *s = &a.segs[i];
+            int overlaps = t0 == t1 ? XLALGPSInSeg( &start, s ) == 0 : XLALGPSCmp( &s->start, &end ) < 0 && XLALGPSCmp( &start, &s->end ) < 0 && XLALGPSCmp( &s->start, &s->end ) < 0;
+            if ( overlaps ) {
+              INT4 k;
+              for ( k = 0; k < found && result[k] != i; k++ );
+              XLAL_CHECK( k < found, XLAL_EFAILED, "index query missed segment %u", i );
+              count++;
+            }
+          }
+          XLAL_CHECK( found == count, XLAL_EFAILED, "index query found %d segments, expected %d", found, count );
+          for ( INT4 k = 1; k < found; k++ ) {
+            XLAL_CHECK( XLALGPSCmp( &a.segs[result[k-1]].start, &a.segs[result[k]].start ) <= 0, XLAL_EFAILED, "index query results out of order" );
+          }
+        }
+        XLALSegListIndexDestroy( index );
+      }
+
+      XLALSegListClear( &a );
+      XLALSegListClear( &b );
+    }
+
+  }
+  XLALPrintInfo("Passed segment list set operation, batch search and index tests\n");
+
+
   /*-------------------------------------------------------------------------*/
   /* Clean up leftover seg lists */
   if ( seglist1.segs ) { XLALSegListClear( &seglist1 ); }
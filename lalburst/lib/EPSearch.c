@@ -378,7 +378,6 @@ typedef struct tagREAL8TimeFrequencyPlane {
 	double deltaF;			/**< TF plane's frequency resolution (channel spacing) */
 	double flow;			/**< low frequency boundary of TF plane */
 	gsl_matrix *channel_data;   	/**< channel data.  each channel is placed into its own column.  channel_data[i * channels + j] corresponds to time epoch + i * deltaT and the frequency band [flow + j * deltaF, flow + (j + 1) * deltaF) */
-	REAL8Sequence *channel_buffer;	/**< re-usable holding area for the data for a single channel */
 	REAL8Sequence *unwhitened_channel_buffer;	/**< UNDOCUMENTED */
 	REAL8TimeFrequencyPlaneTiles tiles;	/**< time-frequency plane's tiling information */
 	REAL8Window *window;		/**< time-domain window applied to input time series for tapering edges to 0 */
@@ -405,7 +404,6 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 {
 	REAL8TimeFrequencyPlane *plane;
 	gsl_matrix *channel_data;
-	REAL8Sequence *channel_buffer;
 	REAL8Sequence *unwhitened_channel_buffer;
 	REAL8Window *tukey;
 	REAL8Sequence *correlation;
@@ -506,7 +504,6 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 
 	plane = XLALMalloc(sizeof(*plane));
 	channel_data = gsl_matrix_alloc(tseries_length, channels);
-	channel_buffer = XLALCreateREAL8Sequence(tseries_length);
 	unwhitened_channel_buffer = XLALCreateREAL8Sequence(tseries_length);
 	tukey = XLALCreateTukeyREAL8Window(tseries_length, (tseries_length - tiling_length) / (double) tseries_length);
 	if(tukey)
@@ -514,11 +511,10 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 	else
 		/* error path */
 		correlation = NULL;
-	if(!plane || !channel_data || !channel_buffer || !unwhitened_channel_buffer || !tukey || !correlation) {
+	if(!plane || !channel_data || !unwhitened_channel_buffer || !tukey || !correlation) {
 		XLALFree(plane);
 		if(channel_data)
 			gsl_matrix_free(channel_data);
-		XLALDestroyREAL8Sequence(channel_buffer);
 		XLALDestroyREAL8Sequence(unwhitened_channel_buffer);
 		XLALDestroyREAL8Window(tukey);
 		XLALDestroyREAL8Sequence(correlation);
@@ -536,7 +532,6 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 	plane->deltaF = deltaF;
 	plane->flow = flow;
 	plane->channel_data = channel_data;
-	plane->channel_buffer = channel_buffer;
 	plane->unwhitened_channel_buffer = unwhitened_channel_buffer;
 	plane->tiles.max_length = max_length;
 	plane->tiles.min_channels = min_channels;
@@ -569,7 +564,6 @@ static void XLALDestroyTFPlane(
 	if(plane) {
 		if(plane->channel_data)
 			gsl_matrix_free(plane->channel_data);
-		XLALDestroyREAL8Sequence(plane->channel_buffer);
 		XLALDestroyREAL8Sequence(plane->unwhitened_channel_buffer);
 		XLALDestroyREAL8Window(plane->window);
 		XLALDestroyREAL8Sequence(plane->two_point_spectral_correlation);
@@ -638,8 +632,8 @@ static int XLALFreqSeriesToTFPlane(
 	const REAL8FFTPlan *reverseplan
 )
 {
-	COMPLEX16Sequence *fcorr;
-	unsigned i;
+	int errnum = 0;
+	int i;
 
 	/* check input parameters */
 	if((fmod(plane->deltaF, fseries->deltaF) != 0.0) ||
@@ -651,11 +645,6 @@ static int XLALFreqSeriesToTFPlane(
 	   (plane->flow + plane->channel_data->size2 * plane->deltaF > fseries->f0 + fseries->data->length * fseries->deltaF))
 		XLAL_ERROR(XLAL_EDATA);
 
-	/* create temporary vectors */
-	fcorr = XLALCreateCOMPLEX16Sequence(fseries->data->length);
-	if(!fcorr)
-		XLAL_ERROR(XLAL_EFUNC);
-
 #if 0
 	/* diagnostic code to dump data for the \hat{s}_{k} histogram */
 	{
@@ -691,27 +680,48 @@ static int XLALFreqSeriesToTFPlane(
 	}
 #endif
 
-	/* loop over the time-frequency plane's channels */
-	for(i = 0; i < plane->channel_data->size2; i++) {
-		unsigned j;
-		/* cross correlate the input data against the channel
-		 * filter by taking their product in the frequency domain
-		 * and then inverse transforming to the time domain to
-		 * obtain an SNR time series.  Note that
-		 * XLALREAL8ReverseFFT() omits the factor of 1 / (N Delta
-		 * t) in the inverse transform. */
-		apply_filter(fcorr, fseries, filter_bank->basis_filters[i].fseries);
-		if(XLALREAL8ReverseFFT(plane->channel_buffer, fcorr, reverseplan)) {
-			XLALDestroyCOMPLEX16Sequence(fcorr);
-			XLAL_ERROR(XLAL_EFUNC);
+	/* loop over the time-frequency plane's channels.  the channels are
+	 * independent, so they are distributed over threads, each with its
+	 * own work spaces;  the reverse plan is shared, as executing a plan
+	 * is thread-safe */
+#pragma omp parallel
+	{
+		COMPLEX16Sequence *fcorr = XLALCreateCOMPLEX16Sequence(fseries->data->length);
+		REAL8Sequence *channel_buffer = XLALCreateREAL8Sequence(plane->channel_data->size1);
+		if(!fcorr || !channel_buffer) {
+#pragma omp critical (XLALFreqSeriesToTFPlane)
+			errnum = XLAL_EFUNC;
+		}
+
+#pragma omp for schedule(dynamic)
+		for(i = 0; i < (int) plane->channel_data->size2; i++) {
+			unsigned j;
+			if(!fcorr || !channel_buffer)
+				continue;
+			/* cross correlate the input data against the channel
+			 * filter by taking their product in the frequency domain
+			 * and then inverse transforming to the time domain to
+			 * obtain an SNR time series.  Note that
+			 * XLALREAL8ReverseFFT() omits the factor of 1 / (N Delta
+			 * t) in the inverse transform. */
+			apply_filter(fcorr, fseries, filter_bank->basis_filters[i].fseries);
+			if(XLALREAL8ReverseFFT(channel_buffer, fcorr, reverseplan)) {
+#pragma omp critical (XLALFreqSeriesToTFPlane)
+				errnum = XLAL_EFUNC;
+				continue;
+			}
+			/* interleave the result into the channel_data array */
+			for(j = 0; j < channel_buffer->length; j++)
+				gsl_matrix_set(plane->channel_data, j, i, channel_buffer->data[j]);
 		}
-		/* interleave the result into the channel_data array */
-		for(j = 0; j < plane->channel_buffer->length; j++)
-			gsl_matrix_set(plane->channel_data, j, i, plane->channel_buffer->data[j]);
+
+		/* clean up */
+		XLALDestroyCOMPLEX16Sequence(fcorr);
+		XLALDestroyREAL8Sequence(channel_buffer);
 	}
 
-	/* clean up */
-	XLALDestroyCOMPLEX16Sequence(fcorr);
+	if(errnum)
+		XLAL_ERROR(errnum);
 
 	/* set the name and epoch of the TF plane */
 	strncpy(plane->name, fseries->name, LALNameLength);
@@ -731,6 +741,46 @@ static int XLALFreqSeriesToTFPlane(
  */
 
 
+/*
+ * Replace the samples with the cumulative sums of their squares, so that
+ * the sum of squares over the samples [start, last] of any tile can be
+ * read off by tile_sum_of_squares() at a cost that does not depend on the
+ * tile's duration.
+ *
+ * The tile sums are differences of running sums, so they are not rounded
+ * the same as sums accumulated sample by sample over each tile, as this
+ * code did before.  The terms are non-negative, so the difference is off
+ * by at most about (last + 1) * DBL_EPSILON times the running sum at last.
+ * For unit-variance samples and a few thousand samples per channel that
+ * is about 1e-9 at worst, negligible next to the chi-squared fluctuation
+ * of a tile's sum of squares, which is at least 2.
+ */
+
+
+static void cumulative_sum_of_squares(
+	double *data,
+	size_t length
+)
+{
+	size_t i;
+
+	for(i = 0; i < length; i++)
+		data[i] *= data[i];
+	for(i = 1; i < length; i++)
+		data[i] += data[i - 1];
+}
+
+
+static double tile_sum_of_squares(
+	const double *cumsumsq,
+	unsigned start,
+	unsigned last
+)
+{
+	return start ? cumsumsq[last] - cumsumsq[start - 1] : cumsumsq[last];
+}
+
+
 static double compute_unwhitened_mean_square(
 	const LALExcessPowerFilterBank *filter_bank,
 	unsigned channel,
@@ -793,162 +843,249 @@ static SnglBurst *XLALTFTileToBurstEvent(
 }
 
 
-static SnglBurst *XLALComputeExcessPower(
+/*
+ * Compute the excess power in the tiles of one (possibly multi-filter)
+ * channel, and prepend the tiles whose confidence is above threshold to
+ * the linked list *head.  channel_buffer and unwhitened_channel_buffer are
+ * work spaces large enough to hold the tiling.
+ */
+
+
+static int XLALComputeChannelExcessPower(
+	SnglBurst **head,
 	const REAL8TimeFrequencyPlane *plane,
 	const LALExcessPowerFilterBank *filter_bank,
-	SnglBurst *head,
-	double confidence_threshold
+	unsigned channel,
+	unsigned channels,
+	double confidence_threshold,
+	gsl_vector *channel_buffer,
+	gsl_vector *unwhitened_channel_buffer
 )
 {
+	const unsigned channel_end = channel + channels;
+	/* compute distance between "virtual pixels" for this (wide)
+	 * channel */
+	const unsigned stride = round(1.0 / (channels * plane->tiles.dof_per_pixel));
 	gsl_vector filter_output = {
 		.size = plane->tiles.tiling_end - plane->tiles.tiling_start,
 		.stride = plane->channel_data->size2,
-		.data = NULL,
+		.data = plane->channel_data->data + plane->channel_data->size2 * plane->tiles.tiling_start + channel,
 		.block = NULL,
 		.owner = 0
 	};
 	gsl_vector_view filter_output_view;
-	gsl_vector *channel_buffer;
-	gsl_vector *unwhitened_channel_buffer;
-	unsigned channel;
-	unsigned channels;
-	unsigned channel_end;
+	/* the root mean square of the "virtual channel", \sqrt{\mu^{2}} in
+	 * the algorithm description */
+	const double sample_rms = sqrt(channels * plane->deltaF / plane->fseries_deltaF + XLALREAL8SequenceSum(filter_bank->twice_channel_overlap, channel, channels - 1));
+	/* the root mean square of the "uwapprox" quantity computed below,
+	 * which is proportional to an approximation of the unwhitened time
+	 * series. */
+	double uwsample_rms;
+	/* true unwhitened root mean square for this channel.  the ratio of
+	 * this squared to uwsample_rms^2 is the correction factor to be
+	 * applied to uwapprox^2 to convert it to an approximation of the
+	 * square of the unwhitened channel */
+	const double strain_rms = sqrt(compute_unwhitened_mean_square(filter_bank, channel, channels) + XLALREAL8SequenceSum(filter_bank->unwhitened_cross, channel, channels - 1));
+	double *sumsq;
+	double *uwsumsq;
 	double h_rss;
 	double confidence;
-	/* number of degrees of freedom in tile = number of
-	 * "virtual pixels" in tile. */
+	/* number of degrees of freedom in tile = number of "virtual
+	 * pixels" in tile. */
 	double tile_dof;
 	unsigned i;
 
-	/*
-	 * create work spaces
-	 */
-
-	channel_buffer = gsl_vector_alloc(filter_output.size);
-	unwhitened_channel_buffer = gsl_vector_alloc(filter_output.size);
-	if(!channel_buffer || !unwhitened_channel_buffer) {
-		if(channel_buffer)
-			gsl_vector_free(channel_buffer);
-		if(unwhitened_channel_buffer)
-			gsl_vector_free(unwhitened_channel_buffer);
-		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	/* compute uwsample_rms */
+	uwsample_rms = compute_unwhitened_mean_square(filter_bank, channel, channels);
+	for(i = channel; i < channel_end - 1; i++)
+		uwsample_rms += filter_bank->twice_channel_overlap->data[i] * filter_bank->basis_filters[i].unwhitened_rms * filter_bank->basis_filters[i + 1].unwhitened_rms * plane->fseries_deltaF / plane->deltaF;
+	uwsample_rms = sqrt(uwsample_rms);
+
+	/* reconstruct the time series and unwhitened time series for this
+	 * (possibly multi-filter) channel.  both time series are
+	 * normalized so that each sample has a mean square of 1 */
+	filter_output_view = gsl_vector_subvector_with_stride(&filter_output, 0, stride, filter_output.size / stride);
+	channel_buffer->size = unwhitened_channel_buffer->size = filter_output_view.vector.size;
+	gsl_vector_set_zero(channel_buffer);
+	gsl_vector_set_zero(unwhitened_channel_buffer);
+	for(i = channel; i < channel_end; filter_output_view.vector.data++, i++) {
+		gsl_blas_daxpy(1.0 / sample_rms, &filter_output_view.vector, channel_buffer);
+		gsl_blas_daxpy(filter_bank->basis_filters[i].unwhitened_rms * sqrt(plane->fseries_deltaF / plane->deltaF) / uwsample_rms, &filter_output_view.vector, unwhitened_channel_buffer);
 	}
 
-	/*
-	 * enter loops.  note:  this is a quadruply-nested loop that is not
-	 * indented to help fit the code on a terminal display.
-	 */
-
-	for(channels = plane->tiles.min_channels; channels <= plane->tiles.max_channels; channels *= 2) {
-		/* compute distance between "virtual pixels" for this
-		 * (wide) channel */
-		const unsigned stride = round(1.0 / (channels * plane->tiles.dof_per_pixel));
-
-	for(channel_end = (channel = 0) + channels; channel_end <= plane->channel_data->size2; channel_end = (channel += channels / plane->tiles.inv_fractional_stride) + channels) {
-		/* the root mean square of the "virtual channel",
-		 * \sqrt{\mu^{2}} in the algorithm description */
-		const double sample_rms = sqrt(channels * plane->deltaF / plane->fseries_deltaF + XLALREAL8SequenceSum(filter_bank->twice_channel_overlap, channel, channels - 1));
-		/* the root mean square of the "uwapprox" quantity computed
-		 * below, which is proportional to an approximation of the
-		 * unwhitened time series. */
-		double uwsample_rms;
-		/* true unwhitened root mean square for this channel.  the
-		 * ratio of this squared to uwsample_rms^2 is the
-		 * correction factor to be applied to uwapprox^2 to convert
-		 * it to an approximation of the square of the unwhitened
-		 * channel */
-		const double strain_rms = sqrt(compute_unwhitened_mean_square(filter_bank, channel, channels) + XLALREAL8SequenceSum(filter_bank->unwhitened_cross, channel, channels - 1));
-
-		/* compute uwsample_rms */
-		uwsample_rms = compute_unwhitened_mean_square(filter_bank, channel, channels);
-		for(i = channel; i < channel_end - 1; i++)
-			uwsample_rms += filter_bank->twice_channel_overlap->data[i] * filter_bank->basis_filters[i].unwhitened_rms * filter_bank->basis_filters[i + 1].unwhitened_rms * plane->fseries_deltaF / plane->deltaF;
-		uwsample_rms = sqrt(uwsample_rms);
-
-		/* reconstruct the time series and unwhitened time series
-		 * for this (possibly multi-filter) channel.  both time
-		 * series are normalized so that each sample has a mean
-		 * square of 1 */
-		filter_output.data = plane->channel_data->data + filter_output.stride * plane->tiles.tiling_start + channel;
-		filter_output_view = gsl_vector_subvector_with_stride(&filter_output, 0, stride, filter_output.size / stride);
-		gsl_vector_set_zero(channel_buffer);
-		gsl_vector_set_zero(unwhitened_channel_buffer);
-		channel_buffer->size = unwhitened_channel_buffer->size = filter_output_view.vector.size;
-		for(i = channel; i < channel_end; filter_output_view.vector.data++, i++) {
-			gsl_blas_daxpy(1.0 / sample_rms, &filter_output_view.vector, channel_buffer);
-			gsl_blas_daxpy(filter_bank->basis_filters[i].unwhitened_rms * sqrt(plane->fseries_deltaF / plane->deltaF) / uwsample_rms, &filter_output_view.vector, unwhitened_channel_buffer);
-		}
-
 #if 0
-		/* diagnostic code to dump data for the s_{j} histogram */
-		{
-		FILE *f = fopen("sj.dat", "a");
-		for(i = 0; i < channel_buffer->size; i++)
-			fprintf(f, "%g\n", gsl_vector_get(unwhitened_channel_buffer, i));
-		fclose(f);
-		}
+	/* diagnostic code to dump data for the s_{j} histogram */
+	{
+	FILE *f = fopen("sj.dat", "a");
+	for(i = 0; i < channel_buffer->size; i++)
+		fprintf(f, "%g\n", gsl_vector_get(unwhitened_channel_buffer, i));
+	fclose(f);
+	}
 #endif
 
-		/* square the samples in the channel time series because
-		 * from now on that's all we'll need */
-		for(i = 0; i < channel_buffer->size; i++) {
-			gsl_vector_set(channel_buffer, i, pow(gsl_vector_get(channel_buffer, i), 2));
-			gsl_vector_set(unwhitened_channel_buffer, i, pow(gsl_vector_get(unwhitened_channel_buffer, i), 2));
-		}
+	/* from now on all we need are sums of squares of the samples over
+	 * tiles, so replace the samples with the cumulative sums of their
+	 * squares.  the work spaces were allocated by gsl_vector_alloc(),
+	 * so they are contiguous */
+	sumsq = channel_buffer->data;
+	uwsumsq = unwhitened_channel_buffer->data;
+	cumulative_sum_of_squares(sumsq, channel_buffer->size);
+	cumulative_sum_of_squares(uwsumsq, unwhitened_channel_buffer->size);
 
 	/* start with at least 2 degrees of freedom */
 	for(tile_dof = 2; tile_dof <= plane->tiles.max_length / stride; tile_dof *= 2) {
 		unsigned start;
-	for(start = 0; start + tile_dof <= channel_buffer->size; start += tile_dof / plane->tiles.inv_fractional_stride) {
-		/* compute sum of squares, and unwhitened sum of squares
-		 * (samples have already been squared) */
-		double sumsquares = 0;
-		double uwsumsquares = 0;
-		for(i = start; i < start + tile_dof; i++) {
-			sumsquares += gsl_vector_get(channel_buffer, i);
-			uwsumsquares += gsl_vector_get(unwhitened_channel_buffer, i);
+		for(start = 0; start + tile_dof <= channel_buffer->size; start += tile_dof / plane->tiles.inv_fractional_stride) {
+			/* compute sum of squares, and unwhitened sum of
+			 * squares */
+			const unsigned last = start + tile_dof - 1;
+			const double sumsquares = tile_sum_of_squares(sumsq, start, last);
+			const double uwsumsquares = tile_sum_of_squares(uwsumsq, start, last);
+
+			/* compute statistical confidence */
+			/* FIXME:  the 0.62 is an empirically determined
+			 * degree-of-freedom fudge factor.  figure out what
+			 * its origin is, and account for it correctly.
+			 * it's most likely due to the time-frequency plane
+			 * pixels not being independent of one another as a
+			 * consequence of a non-zero inner product of the
+			 * time-domain impulse response of the channel
+			 * filter for adjacent pixels */
+			confidence = -XLALLogChisqCCDF(sumsquares * .62, tile_dof * .62);
+			if(XLALIsREAL8FailNaN(confidence))
+				XLAL_ERROR(XLAL_EFUNC);
+
+			/* record tiles whose statistical confidence is
+			 * above threshold and that have real-valued h_rss */
+			if((confidence >= confidence_threshold) && (uwsumsquares >= tile_dof)) {
+				SnglBurst *event;
+
+				/* compute h_rss */
+				h_rss = sqrt((uwsumsquares - tile_dof) * (stride * plane->deltaT)) * strain_rms;
+
+				/* add new event to head of linked list */
+				event = XLALTFTileToBurstEvent(plane, plane->tiles.tiling_start + (start - 0.5) * stride, tile_dof * stride, plane->flow + (channel + .5 * channels) * plane->deltaF, channels * plane->deltaF, h_rss, sumsquares, tile_dof, confidence);
+				if(!event)
+					XLAL_ERROR(XLAL_EFUNC);
+				event->next = *head;
+				*head = event;
+			}
 		}
+	}
 
-		/* compute statistical confidence */
-		/* FIXME:  the 0.62 is an empirically determined
-		 * degree-of-freedom fudge factor.  figure out what its
-		 * origin is, and account for it correctly.  it's most
-		 * likely due to the time-frequency plane pixels not being
-		 * independent of one another as a consequence of a
-		 * non-zero inner product of the time-domain impulse
-		 * response of the channel filter for adjacent pixels */
-		confidence = -XLALLogChisqCCDF(sumsquares * .62, tile_dof * .62);
-		if(XLALIsREAL8FailNaN(confidence)) {
-			gsl_vector_free(channel_buffer);
-			gsl_vector_free(unwhitened_channel_buffer);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
+	return 0;
+}
+
+
+/*
+ * Compute the excess power for every tile of the time-frequency plane, and
+ * prepend the tiles whose confidence is above threshold to the linked list
+ * head.  The (possibly multi-filter) channels of every bandwidth are
+ * independent, so they are distributed over threads;  the events are
+ * spliced into the list in the same order as if the channels had been
+ * processed one after the other.
+ */
+
+
+static SnglBurst *XLALComputeExcessPower(
+	const REAL8TimeFrequencyPlane *plane,
+	const LALExcessPowerFilterBank *filter_bank,
+	SnglBurst *head,
+	double confidence_threshold
+)
+{
+	const unsigned tiling_length = plane->tiles.tiling_end - plane->tiles.tiling_start;
+	unsigned *first_channel;
+	unsigned *n_channels;
+	SnglBurst **events;
+	unsigned n_rows = 0;
+	unsigned channel;
+	unsigned channels;
+	unsigned channel_end;
+	int errnum = 0;
+	int i;
+
+	/*
+	 * list the (possibly multi-filter) channels of every bandwidth
+	 */
+
+	for(channels = plane->tiles.min_channels; channels <= plane->tiles.max_channels; channels *= 2)
+		for(channel_end = (channel = 0) + channels; channel_end <= plane->channel_data->size2; channel_end = (channel += channels / plane->tiles.inv_fractional_stride) + channels)
+			n_rows++;
+
+	first_channel = XLALMalloc(n_rows * sizeof(*first_channel));
+	n_channels = XLALMalloc(n_rows * sizeof(*n_channels));
+	events = XLALCalloc(n_rows, sizeof(*events));
+	if(!first_channel || !n_channels || !events) {
+		XLALFree(first_channel);
+		XLALFree(n_channels);
+		XLALFree(events);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+
+	n_rows = 0;
+	for(channels = plane->tiles.min_channels; channels <= plane->tiles.max_channels; channels *= 2)
+		for(channel_end = (channel = 0) + channels; channel_end <= plane->channel_data->size2; channel_end = (channel += channels / plane->tiles.inv_fractional_stride) + channels) {
+			first_channel[n_rows] = channel;
+			n_channels[n_rows] = channels;
+			n_rows++;
 		}
 
-		/* record tiles whose statistical confidence is above
-		 * threshold and that have real-valued h_rss */
-		if((confidence >= confidence_threshold) && (uwsumsquares >= tile_dof)) {
-			SnglBurst *oldhead = head;
+	/*
+	 * compute the tiles of each channel, with work spaces per thread
+	 */
 
-			/* compute h_rss */
-			h_rss = sqrt((uwsumsquares - tile_dof) * (stride * plane->deltaT)) * strain_rms;
+#pragma omp parallel
+	{
+		gsl_vector *channel_buffer = gsl_vector_alloc(tiling_length);
+		gsl_vector *unwhitened_channel_buffer = gsl_vector_alloc(tiling_length);
+		if(!channel_buffer || !unwhitened_channel_buffer) {
+#pragma omp critical (XLALComputeExcessPower)
+			errnum = XLAL_ENOMEM;
+		}
 
-			/* add new event to head of linked list */
-			head = XLALTFTileToBurstEvent(plane, plane->tiles.tiling_start + (start - 0.5) * stride, tile_dof * stride, plane->flow + (channel + .5 * channels) * plane->deltaF, channels * plane->deltaF, h_rss, sumsquares, tile_dof, confidence);
-			if(!head) {
-				gsl_vector_free(channel_buffer);
-				gsl_vector_free(unwhitened_channel_buffer);
-				XLAL_ERROR_NULL(XLAL_EFUNC);
+#pragma omp for schedule(dynamic)
+		for(i = 0; i < (int) n_rows; i++) {
+			if(!channel_buffer || !unwhitened_channel_buffer)
+				continue;
+			if(XLALComputeChannelExcessPower(&events[i], plane, filter_bank, first_channel[i], n_channels[i], confidence_threshold, channel_buffer, unwhitened_channel_buffer) < 0) {
+#pragma omp critical (XLALComputeExcessPower)
+				errnum = XLAL_EFUNC;
 			}
-			head->next = oldhead;
 		}
+
+		if(channel_buffer)
+			gsl_vector_free(channel_buffer);
+		if(unwhitened_channel_buffer)
+			gsl_vector_free(unwhitened_channel_buffer);
 	}
+
+	/*
+	 * splice the events onto the head of the list, the last channel's
+	 * first
+	 */
+
+	for(i = 0; i < (int) n_rows; i++) {
+		SnglBurst *tail = events[i];
+		if(!tail)
+			continue;
+		if(errnum) {
+			XLALDestroySnglBurstTable(events[i]);
+			continue;
+		}
+		while(tail->next)
+			tail = tail->next;
+		tail->next = head;
+		head = events[i];
 	}
-	}
-	}
+
+	XLALFree(first_channel);
+	XLALFree(n_channels);
+	XLALFree(events);
+	if(errnum)
+		XLAL_ERROR_NULL(errnum);
 
 	/* success */
-	gsl_vector_free(channel_buffer);
-	gsl_vector_free(unwhitened_channel_buffer);
 	return head;
 }
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+/*
+ * Tests the excess power tile sums read off the cumulative sums of
+ * squares against the sums accumulated sample by sample over each tile.
+ * The helpers are static, so EPSearch.c is compiled into this program.
+ */
+
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+
+#include "../lib/EPSearch.c"
+
+
+#define LENGTH 4096
+#define INV_FRACTIONAL_STRIDE 2
+
+
+int main(void)
+{
+	double *samples = malloc(LENGTH * sizeof(*samples));
+	double *cumsumsq = malloc(LENGTH * sizeof(*cumsumsq));
+	gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+	unsigned tile_dof;
+	unsigned i;
+
+	if(!samples || !cumsumsq || !rng) {
+		fprintf(stderr, "FAIL: out of memory\n");
+		return 1;
+	}
+
+	/* unit-variance samples, as in the normalized channels */
+	gsl_rng_set(rng, 20261019);
+	for(i = 0; i < LENGTH; i++)
+		samples[i] = gsl_ran_gaussian(rng, 1.0);
+	memcpy(cumsumsq, samples, LENGTH * sizeof(*samples));
+	cumulative_sum_of_squares(cumsumsq, LENGTH);
+
+	/* every tile of the tiling in XLALComputeChannelExcessPower() */
+	for(tile_dof = 2; tile_dof <= LENGTH; tile_dof *= 2) {
+		unsigned start;
+		for(start = 0; start + tile_dof <= LENGTH; start += tile_dof / INV_FRACTIONAL_STRIDE) {
+			const unsigned last = start + tile_dof - 1;
+			const double sumsquares = tile_sum_of_squares(cumsumsq, start, last);
+			const double tolerance = 2 * (last + 1) * DBL_EPSILON * cumsumsq[last];
+			double direct = 0;
+			for(i = start; i <= last; i++)
+				direct += samples[i] * samples[i];
+			if(fabs(sumsquares - direct) > tolerance || fabs(sumsquares - direct) > 1e-9) {
+				fprintf(stderr, "FAIL: tile [%u, %u]: sum of squares %.17g, direct sum %.17g\n", start, last, sumsquares, direct);
+				return 1;
+			}
+		}
+	}
+
+	gsl_rng_free(rng);
+	free(cumsumsq);
+	free(samples);
+	return 0;
+}
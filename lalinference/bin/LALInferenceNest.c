@@ -123,8 +123,12 @@ int main(int argc, char *argv[]){
 
      }
 
-  /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  /* Set up the threads, one for each live point replaced per iteration */
+  INT4 nthreads=1;
+  if (state && LALInferenceGetProcParamVal(state->commandLine,"--Nbatch"))
+    nthreads=atoi(LALInferenceGetProcParamVal(state->commandLine,"--Nbatch")->value);
+  if (nthreads<1) nthreads=1;
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
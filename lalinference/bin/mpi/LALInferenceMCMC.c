@@ -98,6 +98,8 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     --- Parallel Tempering Algorithm Parameters --\n\
     ----------------------------------------------\n\
     (--adapt-temps)     Adapt the spacing between temperatures for uniform swap acceptance\n\
+    (--async-swaps)     Swap between MPI processes without synchronising them\n\
+                            (incompatible with --adapt-temps)\n\
     (--temp-skip N)     Number of steps between temperature swap proposals (100)\n\
     (--tempKill N)      Iteration number to stop temperature swapping (Niter)\n\
     (--ntemps N)         Number of temperature chains in ladder (as many as needed)\n\
@@ -164,6 +166,9 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
         //runState->parallelSwap = &LALInferenceMCMCMCswap;
         fprintf(stderr, "ERROR: MCMCMC sampling hasn't been brought up-to-date since restructuring.\n");
         return XLAL_FAILURE;
+    } else if (LALInferenceGetProcParamVal(command_line, "--async-swaps")) {
+        /* Parallel tempering swap without global synchronisation */
+        runState->parallelSwap = &LALInferenceAsyncPTswap;
     } else {
         /* Standard parallel tempering swap. */
         runState->parallelSwap = &LALInferencePTswap;
@@ -239,6 +244,17 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     if (ppt)
         adapt_temps = 1;
 
+    /* Swap between MPI processes asynchronously.  Ladder adaptation gathers
+        every chain at once, so is disabled. */
+    INT4 async_swaps = 0;
+    if (LALInferenceGetProcParamVal(command_line, "--async-swaps")) {
+        async_swaps = 1;
+        if (adapt_temps) {
+            fprintf(stderr, "WARNING: --adapt-temps is incompatible with --async-swaps, not adapting temperatures.\n");
+            adapt_temps = 0;
+        }
+    }
+
     /* Starting temperature of the ladder */
     REAL8 tempMin = 1.0;
     ppt = LALInferenceGetProcParamVal(command_line, "--temp-min");
@@ -295,6 +311,7 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     LALInferenceAddINT4Variable(algorithm_params, "mpisize", mpi_size, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "ntemps", ntemps, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "adapt_temps", adapt_temps, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(algorithm_params, "async_swaps", async_swaps, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddREAL8Variable(algorithm_params, "temp_min", tempMin, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddREAL8Variable(algorithm_params, "temp_max", tempMax, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "de_buffer_limit", de_buffer_limit, LALINFERENCE_PARAM_OUTPUT);
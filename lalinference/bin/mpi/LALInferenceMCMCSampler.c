@@ -71,24 +71,17 @@ static void
 thinDifferentialEvolutionPoints(LALInferenceThreadState *thread) {
     size_t i;
     size_t newSize;
+    size_t dim = thread->differentialPointsDim;
 
-    /* Delete all the even-index points. */
-    for (i = 0; i < thread->differentialPointsLength; i += 2) {
-        LALInferenceClearVariables(thread->differentialPoints[i]);
-        XLALFree(thread->differentialPoints[i]);
-        thread->differentialPoints[i] = NULL;
-    }
-
-    /* Copy the odd points into the first part of the array. */
-    for (i = 1; i < thread->differentialPointsLength; i += 2) {
-        thread->differentialPoints[i/2] = thread->differentialPoints[i];
-        thread->differentialPoints[i] = NULL;
-    }
+    /* Keep only the odd-index points, in the first part of the buffer. */
+    for (i = 1; i < thread->differentialPointsLength; i += 2)
+        memcpy(thread->differentialPointsMatrix + (i/2)*dim,
+               thread->differentialPointsMatrix + i*dim, dim*sizeof(REAL8));
 
     newSize = thread->differentialPointsLength / 2;
 
     /* Now shrink the buffer down. */
-    thread->differentialPoints = XLALRealloc(thread->differentialPoints, 2*newSize*sizeof(LALInferenceVariables *));
+    thread->differentialPointsMatrix = XLALRealloc(thread->differentialPointsMatrix, 2*newSize*dim*sizeof(REAL8));
     thread->differentialPointsSize = 2*newSize;
     thread->differentialPointsLength = newSize;
     thread->differentialPointsSkip *= 2;
@@ -104,31 +97,47 @@ accumulateDifferentialEvolutionSample(LALInferenceThreadState *thread, size_t bu
             thinDifferentialEvolutionPoints(thread);
             return accumulateDifferentialEvolutionSample(thread, buffer_limit);
         } else {
-            thread->differentialPoints = XLALRealloc(thread->differentialPoints, newSize*sizeof(LALInferenceVariables *));
+            thread->differentialPointsMatrix = XLALRealloc(thread->differentialPointsMatrix, newSize*thread->differentialPointsDim*sizeof(REAL8));
             thread->differentialPointsSize = newSize;
         }
     }
 
-    thread->differentialPoints[thread->differentialPointsLength] = XLALCalloc(1, sizeof(LALInferenceVariables));
-    LALInferenceCopyVariables(thread->currentParams, thread->differentialPoints[thread->differentialPointsLength]);
+    LALInferenceCopyVariablesToDifferentialPoint(thread, thread->currentParams, thread->differentialPointsLength);
 
     thread->differentialPointsLength += 1;
 }
 
 static void
 resetDifferentialEvolutionBuffer(LALInferenceThreadState *thread) {
-    size_t i;
+    thread->differentialPointsLength = 0;
+    thread->differentialPointsSkip = LALInferenceGetINT4Variable(thread->proposalArgs, "de_skip");
+    if (!thread->differentialPointsMatrix)
+        return;
+
+    thread->differentialPointsMatrix = XLALRealloc(thread->differentialPointsMatrix, thread->differentialPointsDim*sizeof(REAL8));
+    thread->differentialPointsSize = 1;
+}
 
-    for (i = 0; i < thread->differentialPointsLength; i++) {
-        LALInferenceClearVariables(thread->differentialPoints[i]);
-        XLALFree(thread->differentialPoints[i]);
-        thread->differentialPoints[i] = NULL;
+/* Write the differential evolution buffer of thread to a checkpoint, in the
+ * format of an array of LALInferenceVariables */
+static void
+writeDifferentialEvolutionBuffer(LALH5File *group, LALInferenceThreadState *thread) {
+    size_t i, length = thread->differentialPointsMatrix ? thread->differentialPointsLength : 0;
+    LALInferenceVariables **points = XLALCalloc(length > 0 ? length : 1, sizeof(LALInferenceVariables *));
+
+    for (i = 0; i < length; i++) {
+        points[i] = XLALCalloc(1, sizeof(LALInferenceVariables));
+        LALInferenceCopyVariables(thread->currentParams, points[i]);
+        LALInferenceCopyDifferentialPointToVariables(thread, i, points[i]);
     }
 
-    thread->differentialPoints = XLALRealloc(thread->differentialPoints, sizeof(LALInferenceVariables *));
-    thread->differentialPointsLength = 0;
-    thread->differentialPointsSize = 1;
-    thread->differentialPointsSkip = LALInferenceGetINT4Variable(thread->proposalArgs, "de_skip");
+    LALInferenceH5VariablesArrayToDataset(group, points, length, "differential_points");
+
+    for (i = 0; i < length; i++) {
+        LALInferenceClearVariables(points[i]);
+        XLALFree(points[i]);
+    }
+    XLALFree(points);
 }
 
 /* This is checked by the main loop to determine when to checkpoint */
@@ -197,6 +206,39 @@ static void install_resume_handler(int checkpoint_exit)
        *I think condor handles this, so didn't add a handler CHECK */
   }
 
+/* With asynchronous swaps, the root process broadcasts the checkpoint,
+ * exit and completion flags with MPI_Ibcast only when one of them is set,
+ * and every other process keeps a matching MPI_Ibcast posted and tests it
+ * between swap proposals, so that no process waits for the others. */
+static void post_async_control(INT4 *control, MPI_Request *request, INT4 saveState, INT4 exitFlag, INT4 complete)
+{
+    MPI_Wait(request, MPI_STATUS_IGNORE);
+    control[0] = saveState;
+    control[1] = exitFlag;
+    control[2] = complete;
+    MPI_Ibcast(control, 3, MPI_INT, 0, MPI_COMM_WORLD, request);
+}
+
+static void test_async_control(INT4 *control, MPI_Request *request, INT4 *saveState, INT4 *exitFlag, INT4 *complete)
+{
+    int done = 0;
+
+    if (*request == MPI_REQUEST_NULL)
+        return;
+    MPI_Test(request, &done, MPI_STATUS_IGNORE);
+    if (!done)
+        return;
+
+    *saveState = control[0];
+    *exitFlag = control[1];
+    if (control[2])
+        *complete = 1;
+
+    /* Wait for the next broadcast unless this was the last */
+    if (!control[1] && !control[2])
+        MPI_Ibcast(control, 3, MPI_INT, 0, MPI_COMM_WORLD, request);
+}
+
 void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 t=0; //indexes for for() loops
     INT4 runComplete = 0;
@@ -211,6 +253,8 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 	ProcessParamsTable *ppt=NULL;
 	int local_exitFlag=0;
 	int local_saveStateFlag=0;
+    INT4 control[3] = {0, 0, 0};
+    MPI_Request control_request = MPI_REQUEST_NULL;
 
     memset(&status, 0, sizeof(status));
 
@@ -230,6 +274,7 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 Nskip = LALInferenceGetINT4Variable(algorithm_params, "skip");
     INT4 temp_skip = LALInferenceGetINT4Variable(algorithm_params, "tskip");
     INT4 adapt_temps = LALInferenceGetINT4Variable(algorithm_params, "adapt_temps");
+    INT4 async_swaps = LALInferenceGetINT4Variable(algorithm_params, "async_swaps");
     INT4 de_buffer_limit = LALInferenceGetINT4Variable(algorithm_params, "de_buffer_limit");
     INT4 randomseed = LALInferenceGetINT4Variable(algorithm_params, "random_seed");
 
@@ -331,6 +376,12 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     }
     LALInferenceNameOutputs(runState);
     LALInferenceResumeMCMC(runState);
+
+    /* Keep the differential evolution buffers, including any points read
+     * from a checkpoint, as contiguous matrices */
+    if (diffEvo)
+        for (t = 0; t < n_local_threads; t++)
+            LALInferenceSetupDifferentialPointsMatrix(&runState->threads[t], runState->threads[t].currentParams);
     
     if (benchmark) {
         struct timeval start_tv;
@@ -371,6 +422,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     fflush(stdout);
     MPI_Barrier(MPI_COMM_WORLD);
 
+    if (async_swaps && MPIrank != 0)
+        MPI_Ibcast(control, 3, MPI_INT, 0, MPI_COMM_WORLD, &control_request);
+
     // iterate:
     step_last_acl_check = runState->threads[0].step;
     while (!runComplete) {
@@ -460,8 +514,16 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
                     local_saveStateFlag=__master_saveStateFlag;
                     local_exitFlag=__master_exitFlag;
 		}
-		MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
-		MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (async_swaps) {
+            if (MPIrank == 0) {
+                if (local_saveStateFlag || local_exitFlag)
+                    post_async_control(control, &control_request, local_saveStateFlag, local_exitFlag, 0);
+            } else
+                test_async_control(control, &control_request, &local_saveStateFlag, &local_exitFlag, &runComplete);
+        } else {
+            MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+            MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        }
         INT4 saveattempts=0;
         INT4 retrydelay=5; /* 5 seconds before initial retry */
         INT4 retcode=XLAL_SUCCESS;
@@ -496,11 +558,16 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
             } while (retcode!=XLAL_SUCCESS && saveattempts<10);
             if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
             /* Wait for all processes to save */
-			MPI_Barrier(MPI_COMM_WORLD);
+            if (!async_swaps)
+                MPI_Barrier(MPI_COMM_WORLD);
 			__master_saveStateFlag=0;
             local_saveStateFlag=0;
 		}
 		if(local_exitFlag) {
+				if (async_swaps) {
+					MPI_Wait(&control_request, MPI_STATUS_IGNORE);
+					LALInferenceFinishAsyncPTswap(runState);
+				}
 				/* Wait for all processes to be ready to exit */
 				MPI_Barrier(MPI_COMM_WORLD);
 				exit(CondorExitCode);
@@ -523,8 +590,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         if (tempVerbose)
             fclose(verbose_file);
 
-        /* Check if run should end */
-        if (runState->threads[0].step > Niter)
+        /* Check if run should end.  With asynchronous swaps only the root
+         * decides, as the processes are at different steps. */
+        if ((!async_swaps || MPIrank == 0) && runState->threads[0].step > Niter)
             runComplete=1;
 
         /* Have the cold chain decide when to compute ACLs, and calculate for all chains.  This is done
@@ -561,8 +629,15 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         }
 
         /* Broadcast the root's decision on run completion */
-        MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (!async_swaps)
+            MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        else if (MPIrank == 0 && runComplete)
+            post_async_control(control, &control_request, 0, 0, 1);
     }// while (!runComplete)
+    if (async_swaps) {
+        MPI_Wait(&control_request, MPI_STATUS_IGNORE);
+        LALInferenceFinishAsyncPTswap(runState);
+    }
     LALInferenceWriteMCMCSamples(runState);
     MPI_Barrier(MPI_COMM_WORLD);
 }
@@ -765,6 +840,55 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
 //-----------------------------------------
 // Swap routines:
 //-----------------------------------------
+
+/* Propose a swap between two chains handled by this process */
+static void local_swap(LALInferenceRunState *runState, INT4 cold_ind, INT4 hot_ind, FILE *swapfile) {
+    INT4 n_local_threads = runState->nthreads;
+    INT4 swapAccepted;
+    REAL8 logThreadSwap, temp_prior, temp_like;
+    LALInferenceVariables *temp_params;
+    LALInferenceThreadState *cold_thread = &runState->threads[cold_ind % n_local_threads];
+    LALInferenceThreadState *hot_thread = &runState->threads[hot_ind % n_local_threads];
+
+    /* Determine if swap is accepted and tell the other chain */
+    logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
+    logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
+
+    if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+        swapAccepted = 1;
+    else
+        swapAccepted = 0;
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+    /* Print to file if verbose is chosen */
+    if (swapfile != NULL) {
+        REAL8 acc_frac = 0.0;
+        for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+            acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+        cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
+        fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+                cold_thread->step, cold_ind, cold_thread->temperature,
+                hot_ind, hot_thread->temperature,
+                logThreadSwap, cold_thread->currentLikelihood,
+                hot_thread->currentLikelihood, swapAccepted, acc_frac);
+    }
+
+    if (swapAccepted) {
+        temp_params = hot_thread->currentParams;
+        temp_prior = hot_thread->currentPrior;
+        temp_like = hot_thread->currentLikelihood;
+
+        hot_thread->currentParams = cold_thread->currentParams;
+        hot_thread->currentPrior = cold_thread->currentPrior;
+        hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+
+        cold_thread->currentParams = temp_params;
+        cold_thread->currentPrior = temp_prior;
+        cold_thread->currentLikelihood = temp_like;
+    }
+}
+
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 MPIrank, MPIsize;
     MPI_Status MPIstatus;
@@ -775,10 +899,9 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 swapAccepted;
     INT4 *cold_inds;
     REAL8 adjCurrentLikelihood, adjCurrentPrior;
-    REAL8 logThreadSwap, temp_prior, temp_like, cold_temp;
+    REAL8 logThreadSwap, cold_temp;
     LALInferenceThreadState *cold_thread = &runState->threads[0];
     LALInferenceThreadState *hot_thread;
-    LALInferenceVariables *temp_params;
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
     MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
@@ -811,49 +934,8 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
         hot_rank = hot_ind/n_local_threads;
 
         if (cold_rank == hot_rank) {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
-
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    REAL8 acc_frac = 0.0;
-                    for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
-                        acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
-                    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
-                    fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
-                            cold_thread->step, cold_ind, cold_thread->temperature,
-                            hot_ind, hot_thread->temperature,
-                            logThreadSwap, cold_thread->currentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted, acc_frac);
-                }
-
-                if (swapAccepted) {
-                    temp_params = hot_thread->currentParams;
-                    temp_prior = hot_thread->currentPrior;
-                    temp_like = hot_thread->currentLikelihood;
-
-                    hot_thread->currentParams = cold_thread->currentParams;
-                    hot_thread->currentPrior = cold_thread->currentPrior;
-                    hot_thread->currentLikelihood = cold_thread->currentLikelihood;
-
-                    cold_thread->currentParams = temp_params;
-                    cold_thread->currentPrior = temp_prior;
-                    cold_thread->currentLikelihood = temp_like;
-                }
-
-            }
+            if (MPIrank == cold_rank)
+                local_swap(runState, cold_ind, hot_ind, swapfile);
         } else {
             if (MPIrank == cold_rank) {
                 cold_thread = &runState->threads[cold_ind % n_local_threads];
@@ -961,6 +1043,213 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     return;
 }
 
+/* Asynchronous swaps between MPI processes.  The chains of each process
+ * occupy a contiguous range of the temperature ladder, so each process
+ * swaps with at most two neighbours: its coldest chain with the hottest
+ * chain of process MPIrank-1, and its hottest chain with the coldest chain
+ * of process MPIrank+1.  At each swap point a process offers the state of
+ * its coldest chain to its colder neighbour, unless an earlier offer is
+ * still unanswered, and answers an offer from its hotter neighbour if one
+ * has arrived.  Neither process waits for the other, and both chains keep
+ * evolving while an offer is in flight.
+ *
+ * The swap is decided by the colder chain, against its current state and
+ * the offered state of the hotter chain.  The hotter chain, if the swap is
+ * accepted, continues from the state of the colder chain at the time of the
+ * answer, discarding the steps it took while the offer was in flight.  The
+ * colder chain therefore only ever jumps to a state drawn by its hotter
+ * neighbour, and the approximation of the asynchronous exchange is confined
+ * to the hotter chains. */
+static struct {
+    REAL8 *offer;                /* state offered to the colder neighbour */
+    REAL8 *reply;                /* answer sent to the hotter neighbour */
+    INT4 offer_length, reply_length;
+    MPI_Request offer_request, reply_request;
+    INT4 offer_pending;          /* waiting for the colder neighbour's answer */
+    INT4 offers_sent, offers_answered;
+} async_pt = {NULL, NULL, 0, 0, MPI_REQUEST_NULL, MPI_REQUEST_NULL, 0, 0, 0};
+
+/* Offer the state of this process' coldest chain to process MPIrank-1 */
+static void async_make_offer(LALInferenceRunState *runState, INT4 MPIrank) {
+    LALInferenceThreadState *hot_thread = &runState->threads[0];
+    INT4 nPar = LALInferenceGetVariableDimensionNonFixed(hot_thread->currentParams);
+
+    /* The previous offer has been answered, so has been received */
+    MPI_Wait(&async_pt.offer_request, MPI_STATUS_IGNORE);
+    if (async_pt.offer_length < nPar + 3) {
+        async_pt.offer_length = nPar + 3;
+        async_pt.offer = XLALRealloc(async_pt.offer, async_pt.offer_length * sizeof(REAL8));
+    }
+
+    async_pt.offer[0] = hot_thread->temperature;
+    async_pt.offer[1] = hot_thread->currentLikelihood;
+    async_pt.offer[2] = hot_thread->currentPrior;
+    LALInferenceCopyVariablesToArray(hot_thread->currentParams, async_pt.offer + 3);
+    MPI_Isend(async_pt.offer, nPar + 3, MPI_DOUBLE, MPIrank-1, PT_ASYNC_OFFER, MPI_COMM_WORLD, &async_pt.offer_request);
+
+    async_pt.offer_pending = 1;
+    async_pt.offers_sent++;
+}
+
+/* Receive the answer of process MPIrank-1 to the pending offer */
+static void async_receive_answer(LALInferenceRunState *runState, INT4 MPIrank, MPI_Status *status) {
+    LALInferenceThreadState *hot_thread = &runState->threads[0];
+    INT4 count;
+
+    MPI_Get_count(status, MPI_DOUBLE, &count);
+    REAL8 *answer = XLALMalloc(count * sizeof(REAL8));
+    MPI_Recv(answer, count, MPI_DOUBLE, MPIrank-1, PT_ASYNC_ANSWER, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    if (answer[0] != 0.0) {
+        hot_thread->currentLikelihood = answer[1];
+        hot_thread->currentPrior = answer[2];
+        LALInferenceCopyArrayToVariables(answer + 3, hot_thread->currentParams);
+    }
+
+    XLALFree(answer);
+    async_pt.offer_pending = 0;
+}
+
+/* Answer an offer from process MPIrank+1 with this process' hottest chain */
+static void async_answer_offer(LALInferenceRunState *runState, INT4 MPIrank, MPI_Status *status, FILE *swapfile) {
+    INT4 n_local_threads = runState->nthreads;
+    LALInferenceThreadState *cold_thread = &runState->threads[n_local_threads-1];
+    INT4 count, nPar, swapAccepted;
+    REAL8 hot_temp, hot_like, hot_prior, logThreadSwap;
+
+    MPI_Get_count(status, MPI_DOUBLE, &count);
+    REAL8 *offer = XLALMalloc(count * sizeof(REAL8));
+    MPI_Recv(offer, count, MPI_DOUBLE, MPIrank+1, PT_ASYNC_OFFER, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    hot_temp = offer[0];
+    hot_like = offer[1];
+    hot_prior = offer[2];
+
+    /* Determine if swap is accepted */
+    logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_temp;
+    logThreadSwap *= hot_like - cold_thread->currentLikelihood;
+    if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+        swapAccepted = 1;
+    else
+        swapAccepted = 0;
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+    /* Print to file if verbose is chosen */
+    if (swapfile != NULL) {
+        REAL8 acc_frac = 0.0;
+        for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+            acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+        fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+                cold_thread->step, cold_thread->id, cold_thread->temperature,
+                cold_thread->id+1, hot_temp,
+                logThreadSwap, cold_thread->currentLikelihood,
+                hot_like, swapAccepted, acc_frac);
+    }
+
+    /* Send the answer, with the current state if the swap was accepted */
+    MPI_Wait(&async_pt.reply_request, MPI_STATUS_IGNORE);
+    nPar = LALInferenceGetVariableDimensionNonFixed(cold_thread->currentParams);
+    if (async_pt.reply_length < nPar + 3) {
+        async_pt.reply_length = nPar + 3;
+        async_pt.reply = XLALRealloc(async_pt.reply, async_pt.reply_length * sizeof(REAL8));
+    }
+    async_pt.reply[0] = swapAccepted;
+    if (swapAccepted) {
+        async_pt.reply[1] = cold_thread->currentLikelihood;
+        async_pt.reply[2] = cold_thread->currentPrior;
+        LALInferenceCopyVariablesToArray(cold_thread->currentParams, async_pt.reply + 3);
+    }
+    MPI_Isend(async_pt.reply, swapAccepted ? nPar + 3 : 1, MPI_DOUBLE, MPIrank+1, PT_ASYNC_ANSWER, MPI_COMM_WORLD, &async_pt.reply_request);
+
+    /* Perform Swap */
+    if (swapAccepted) {
+        cold_thread->currentLikelihood = hot_like;
+        cold_thread->currentPrior = hot_prior;
+        LALInferenceCopyArrayToVariables(offer + 3, cold_thread->currentParams);
+    }
+
+    XLALFree(offer);
+    async_pt.offers_answered++;
+}
+
+void LALInferenceAsyncPTswap(LALInferenceRunState *runState, FILE *swapfile) {
+    INT4 MPIrank, MPIsize;
+    INT4 n_local_threads = runState->nthreads;
+    INT4 low, flag;
+    MPI_Status MPIstatus;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+
+    /* Swaps between the chains of this process, in random order */
+    if (n_local_threads > 1) {
+        INT4 *cold_inds = XLALCalloc(n_local_threads-1, sizeof(INT4));
+        for (low = 0; low < n_local_threads-1; low++)
+            cold_inds[low] = low;
+        gsl_ran_shuffle(runState->GSLrandom, cold_inds, n_local_threads-1, sizeof(INT4));
+
+        for (low = 0; low < n_local_threads-1; low++)
+            local_swap(runState, cold_inds[low], cold_inds[low]+1, swapfile);
+        XLALFree(cold_inds);
+    }
+
+    /* Answer the hotter neighbour, if it is waiting */
+    if (MPIrank < MPIsize-1) {
+        MPI_Iprobe(MPIrank+1, PT_ASYNC_OFFER, MPI_COMM_WORLD, &flag, &MPIstatus);
+        if (flag)
+            async_answer_offer(runState, MPIrank, &MPIstatus, swapfile);
+    }
+
+    /* Collect the colder neighbour's answer, and make a new offer */
+    if (MPIrank > 0) {
+        if (async_pt.offer_pending) {
+            MPI_Iprobe(MPIrank-1, PT_ASYNC_ANSWER, MPI_COMM_WORLD, &flag, &MPIstatus);
+            if (flag)
+                async_receive_answer(runState, MPIrank, &MPIstatus);
+        }
+        if (!async_pt.offer_pending)
+            async_make_offer(runState, MPIrank);
+    }
+}
+
+void LALInferenceFinishAsyncPTswap(LALInferenceRunState *runState) {
+    INT4 MPIrank, MPIsize;
+    INT4 offers_sent = async_pt.offers_sent, offers_received;
+    MPI_Request count_request = MPI_REQUEST_NULL;
+    MPI_Status MPIstatus;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+
+    /* Tell the colder neighbour how many offers to expect, answer all of
+     * the hotter neighbour's offers, then wait for the last answer */
+    if (MPIrank > 0)
+        MPI_Isend(&offers_sent, 1, MPI_INT, MPIrank-1, PT_ASYNC_COUNT, MPI_COMM_WORLD, &count_request);
+
+    if (MPIrank < MPIsize-1) {
+        MPI_Recv(&offers_received, 1, MPI_INT, MPIrank+1, PT_ASYNC_COUNT, MPI_COMM_WORLD, &MPIstatus);
+        while (async_pt.offers_answered < offers_received) {
+            MPI_Probe(MPIrank+1, PT_ASYNC_OFFER, MPI_COMM_WORLD, &MPIstatus);
+            async_answer_offer(runState, MPIrank, &MPIstatus, NULL);
+        }
+    }
+
+    if (MPIrank > 0 && async_pt.offer_pending) {
+        MPI_Probe(MPIrank-1, PT_ASYNC_ANSWER, MPI_COMM_WORLD, &MPIstatus);
+        async_receive_answer(runState, MPIrank, &MPIstatus);
+    }
+
+    MPI_Wait(&count_request, MPI_STATUS_IGNORE);
+    MPI_Wait(&async_pt.offer_request, MPI_STATUS_IGNORE);
+    MPI_Wait(&async_pt.reply_request, MPI_STATUS_IGNORE);
+
+    XLALFree(async_pt.offer);
+    XLALFree(async_pt.reply);
+    async_pt.offer = async_pt.reply = NULL;
+    async_pt.offer_length = async_pt.reply_length = 0;
+    async_pt.offers_sent = async_pt.offers_answered = 0;
+}
+
 
 // UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile) {
 //     INT4 MPIrank;
@@ -1339,7 +1628,7 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
         */
 
         /* Create run identifier group */
-        LALInferenceH5VariablesArrayToDataset(chain_group, thread->differentialPoints, thread->differentialPointsLength, "differential_points");
+        writeDifferentialEvolutionBuffer(chain_group, thread);
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->proposalArgs), 1, "proposal_arguments");
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->currentParams), 1, "current_parameters");
         XLALH5FileAddScalarAttribute(chain_group, "temperature", &(thread->temperature), LAL_D_TYPE_CODE);
@@ -1971,7 +2260,7 @@ void LALInferencePrintAdaptationSettings(FILE *outfile, LALInferenceThreadState
 void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     char filename[FILENAME_MAX];
     FILE *out;
-    UINT4 ui;
+    UINT4 ui, ifo = 0;
 
     snprintf(filename, sizeof(filename), "freqTemplatehPlus.dat");
     out = fopen(filename, "w");
@@ -1994,13 +2283,17 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     fclose(out);
 
     while (data != NULL) {
+        REAL8 fPlus = model->ifo_fPlus[ifo];
+        REAL8 fCross = model->ifo_fCross[ifo];
+        REAL8 timeshift = model->ifo_timeshifts[ifo];
+
         snprintf(filename, sizeof(filename), "%s-freqTemplateStrain.dat", data->name);
         out = fopen(filename, "w");
         for (ui = 0; ui < model->freqhCross->data->length; ui++) {
             REAL8 f = model->freqhCross->deltaF * ui;
             COMPLEX16 d;
-            d = data->fPlus * model->freqhPlus->data->data[ui] +
-            data->fCross * model->freqhCross->data->data[ui];
+            d = fPlus * model->freqhPlus->data->data[ui] +
+            fCross * model->freqhCross->data->data[ui];
 
             fprintf(out, "%g %g %g\n", f, creal(d), cimag(d) );
         }
@@ -2010,9 +2303,9 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         out = fopen(filename, "w");
         for (ui = 0; ui < model->timehCross->data->length; ui++) {
             REAL8 tt = XLALGPSGetREAL8(&(model->timehCross->epoch)) +
-            data->timeshift + ui*model->timehCross->deltaT;
-            REAL8 d = data->fPlus*model->timehPlus->data->data[ui] +
-            data->fCross*model->timehCross->data->data[ui];
+            timeshift + ui*model->timehCross->deltaT;
+            REAL8 d = fPlus*model->timehPlus->data->data[ui] +
+            fCross*model->timehCross->data->data[ui];
 
             fprintf(out, "%.6f %g\n", tt, d);
         }
@@ -2041,6 +2334,7 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         fclose(out);
 
         data = data->next;
+        ifo++;
     }
 }
 
@@ -54,7 +54,10 @@ typedef enum {
     PT_COM,          /** Parallel tempering communications */
     LADDER_UPDATE_COM,    /** Update positions across the ladder */
     RUN_PHASE_COM,   /** runPhase passing */
-    RUN_COMPLETE       /** Run complete */
+    RUN_COMPLETE,      /** Run complete */
+    PT_ASYNC_OFFER,    /** Asynchronous swap offer to the colder neighbour */
+    PT_ASYNC_ANSWER,   /** Answer to an asynchronous swap offer */
+    PT_ASYNC_COUNT     /** Number of asynchronous swap offers made */
 } LALInferenceMPIcomm;
 
 /* Temperature ladder adaptation */
@@ -63,6 +66,13 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState);
 /* Standard parallel temperature swap proposal function */
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile);
 
+/* Parallel temperature swap proposal function exchanging states between MPI
+   processes with non-blocking messages, without synchronising the processes */
+void LALInferenceAsyncPTswap(LALInferenceRunState *runState, FILE *swapfile);
+
+/* Complete the outstanding asynchronous swaps before the run ends */
+void LALInferenceFinishAsyncPTswap(LALInferenceRunState *runState);
+
 /* Metropolis-coupled MCMC swap proposal, when the likelihood is not identical between chains */
 //UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile);
 
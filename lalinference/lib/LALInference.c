@@ -130,6 +130,10 @@ LALInferenceThreadState *LALInferenceInitThread(LALInferenceThreadState *thread)
     thread->differentialPointsLength = 0;
     thread->differentialPointsSize = 1;
     thread->differentialPointsSkip = 1;
+    thread->differentialPointsMatrix = NULL;
+    thread->differentialPointsDim = 0;
+    thread->differentialPointsNames = NULL;
+    thread->differentialPointsColumns = NULL;
 
     return thread;
 }
@@ -1587,12 +1591,105 @@ int LALInferenceCompareVariables(LALInferenceVariables *var1, LALInferenceVariab
 }
 
 
+int LALInferenceSetupDifferentialPointsMatrix(LALInferenceThreadState *thread, LALInferenceVariables *params) {
+    LALInferenceVariableItem *ptr;
+    size_t i, dim = 0;
+
+    LALInferenceDestroyDifferentialPointsMatrix(thread);
+
+    /* Fix the columns once, from the non-fixed REAL8 parameters */
+    for (ptr = params->head; ptr; ptr = ptr->next)
+        if (LALInferenceCheckVariableNonFixed(params, ptr->name) && ptr->type == LALINFERENCE_REAL8_t)
+            dim++;
+
+    thread->differentialPointsNames = XLALCalloc(dim > 0 ? dim : 1, sizeof(char *));
+    thread->differentialPointsColumns = XLALCalloc(1, sizeof(LALInferenceVariables));
+    if (!thread->differentialPointsNames || !thread->differentialPointsColumns)
+        XLAL_ERROR(XLAL_ENOMEM);
+    dim = 0;
+    for (ptr = params->head; ptr; ptr = ptr->next)
+        if (LALInferenceCheckVariableNonFixed(params, ptr->name) && ptr->type == LALINFERENCE_REAL8_t) {
+            /* The proposals look the columns up by name, so map the names to columns once */
+            LALInferenceAddINT4Variable(thread->differentialPointsColumns, ptr->name, dim, LALINFERENCE_PARAM_FIXED);
+            thread->differentialPointsNames[dim++] = XLALStringDuplicate(ptr->name);
+        }
+    thread->differentialPointsDim = dim;
+
+    /* Move any points already in the buffer into the matrix */
+    size_t length = thread->differentialPoints ? thread->differentialPointsLength : 0;
+    size_t size = length > 0 ? length : 1;
+    thread->differentialPointsMatrix = XLALMalloc(size * (dim > 0 ? dim : 1) * sizeof(REAL8));
+    if (!thread->differentialPointsMatrix)
+        XLAL_ERROR(XLAL_ENOMEM);
+
+    for (i = 0; i < length; i++) {
+        LALInferenceCopyVariablesToDifferentialPoint(thread, thread->differentialPoints[i], i);
+        LALInferenceClearVariables(thread->differentialPoints[i]);
+        XLALFree(thread->differentialPoints[i]);
+    }
+    XLALFree(thread->differentialPoints);
+    thread->differentialPoints = NULL;
+    thread->differentialPointsLength = length;
+    thread->differentialPointsSize = size;
+
+    return XLAL_SUCCESS;
+}
+
+void LALInferenceDestroyDifferentialPointsMatrix(LALInferenceThreadState *thread) {
+    size_t i;
+
+    if (thread->differentialPointsNames)
+        for (i = 0; i < thread->differentialPointsDim; i++)
+            XLALFree(thread->differentialPointsNames[i]);
+    XLALFree(thread->differentialPointsNames);
+    if (thread->differentialPointsColumns)
+        LALInferenceClearVariables(thread->differentialPointsColumns);
+    XLALFree(thread->differentialPointsColumns);
+    XLALFree(thread->differentialPointsMatrix);
+    thread->differentialPointsNames = NULL;
+    thread->differentialPointsColumns = NULL;
+    thread->differentialPointsMatrix = NULL;
+    thread->differentialPointsDim = 0;
+}
+
+INT4 LALInferenceDifferentialPointsColumn(const LALInferenceThreadState *thread, const char *name) {
+    LALInferenceVariableItem *item;
+
+    if (!thread->differentialPointsColumns)
+        return -1;
+    item = LALInferenceGetItem(thread->differentialPointsColumns, name);
+    return item ? *(INT4 *) item->value : -1;
+}
+
+void LALInferenceCopyVariablesToDifferentialPoint(LALInferenceThreadState *thread, LALInferenceVariables *params, size_t i) {
+    REAL8 *row = thread->differentialPointsMatrix + i*thread->differentialPointsDim;
+    size_t k;
+
+    for (k = 0; k < thread->differentialPointsDim; k++)
+        row[k] = LALInferenceGetREAL8Variable(params, thread->differentialPointsNames[k]);
+}
+
+void LALInferenceCopyDifferentialPointToVariables(const LALInferenceThreadState *thread, size_t i, LALInferenceVariables *params) {
+    const REAL8 *row = thread->differentialPointsMatrix + i*thread->differentialPointsDim;
+    size_t k;
+
+    for (k = 0; k < thread->differentialPointsDim; k++)
+        LALInferenceSetREAL8Variable(params, thread->differentialPointsNames[k], row[k]);
+}
+
+
 /* Move every *step* entry from the buffer to an array */
 INT4 LALInferenceThinnedBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray, INT4 step) {
     LALInferenceVariableItem *ptr;
     INT4 i=0, p=0;
 
     INT4 nPoints = thread->differentialPointsLength;
+    if (thread->differentialPointsMatrix) {
+        for (i = 0; i < nPoints; i+=step)
+            memcpy(DEarray[i/step], thread->differentialPointsMatrix + i*thread->differentialPointsDim, thread->differentialPointsDim*sizeof(REAL8));
+        return nPoints/step;
+    }
+
     for (i = 0; i < nPoints; i+=step) {
         ptr=thread->differentialPoints[i]->head;
         p=0;
@@ -4428,6 +4525,190 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
   }
 }
 
+/* The natural cubic spline through (x_k, y_k), k = 0 ... N-1, is, for x_k <=
+ * x <= x_{k+1},
+ *
+ *   s(x) = A y_k + B y_{k+1} + C M_k + D M_{k+1},
+ *
+ * with h = x_{k+1} - x_k, A = (x_{k+1} - x) / h, B = 1 - A, C = (A^3 - A) h^2
+ * / 6 and D = (B^3 - B) h^2 / 6, where the second derivatives M are a linear
+ * function, M = R y, of the node values (the same spline as
+ * gsl_interp_cspline).  The basis stores R and, for each output frequency,
+ * k and the coefficients A, B, C and D, so that evaluating the spline costs
+ * one N x N matrix-vector product plus four multiply-adds per frequency. */
+struct tagLALInferenceSplineCalibrationBasis {
+  UINT4 nnodes;     /* number of spline nodes */
+  REAL8 *logfreqs;  /* log-frequencies of the nodes */
+  REAL8 *R;         /* nnodes x nnodes map from node values to second derivatives */
+  UINT4 length;     /* number of output frequencies */
+  INT4 *interval;   /* node interval containing each frequency, or -1 if outside the nodes */
+  REAL8 *coeffs;    /* A, B, C, D for each frequency */
+  REAL8 *work;      /* second derivatives of the amplitude and phase splines */
+};
+
+static LALInferenceSplineCalibrationBasis *create_spline_calibration_basis(const REAL8Vector *logfreqs, const REAL8 *freqs, REAL8 deltaF, UINT4 length) {
+  LALInferenceSplineCalibrationBasis *basis = NULL;
+  REAL8 *h = NULL, *diag = NULL, *rhs = NULL;
+  UINT4 N, i, j, k;
+
+  if (logfreqs == NULL) XLAL_ERROR_NULL(XLAL_EFAULT);
+  N = logfreqs->length;
+  if (N < 3) XLAL_ERROR_NULL(XLAL_EINVAL, "need at least 3 spline nodes");
+  for (k = 0; k + 1 < N; k++)
+    if (!(logfreqs->data[k] < logfreqs->data[k+1]))
+      XLAL_ERROR_NULL(XLAL_EINVAL, "spline node frequencies must be increasing");
+
+  basis = XLALCalloc(1, sizeof(*basis));
+  if (basis == NULL) XLAL_ERROR_NULL(XLAL_ENOMEM);
+  basis->nnodes = N;
+  basis->length = length;
+  basis->logfreqs = XLALMalloc(N * sizeof(REAL8));
+  basis->R = XLALCalloc(N * N, sizeof(REAL8));
+  basis->interval = XLALMalloc((length ? length : 1) * sizeof(INT4));
+  basis->coeffs = XLALMalloc(4 * (length ? length : 1) * sizeof(REAL8));
+  basis->work = XLALMalloc(2 * N * sizeof(REAL8));
+  h = XLALMalloc(N * sizeof(REAL8));
+  diag = XLALMalloc(N * sizeof(REAL8));
+  rhs = XLALMalloc(N * sizeof(REAL8));
+  if (!basis->logfreqs || !basis->R || !basis->interval || !basis->coeffs || !basis->work || !h || !diag || !rhs) {
+    XLALFree(h);
+    XLALFree(diag);
+    XLALFree(rhs);
+    LALInferenceDestroySplineCalibrationBasis(basis);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  memcpy(basis->logfreqs, logfreqs->data, N * sizeof(REAL8));
+  for (k = 0; k + 1 < N; k++) h[k] = logfreqs->data[k+1] - logfreqs->data[k];
+
+  /* Column j of R is the vector of second derivatives of the spline through
+   * the unit vector e_j, found by solving the tridiagonal system
+   * h_{k-1} M_{k-1} + 2 (h_{k-1} + h_k) M_k + h_k M_{k+1} = 6 ((y_{k+1} - y_k)
+   * / h_k - (y_k - y_{k-1}) / h_{k-1}), k = 1 ... N-2, with M_0 = M_{N-1} = 0
+   * (Thomas algorithm). */
+  for (j = 0; j < N; j++) {
+    for (k = 1; k + 1 < N; k++) {
+      REAL8 y0 = (k - 1 == j), y1 = (k == j), y2 = (k + 1 == j);
+      rhs[k] = 6.0 * ((y2 - y1) / h[k] - (y1 - y0) / h[k-1]);
+      diag[k] = 2.0 * (h[k-1] + h[k]);
+    }
+    for (k = 2; k + 1 < N; k++) {
+      REAL8 w = h[k-1] / diag[k-1];
+      diag[k] -= w * h[k-1];
+      rhs[k] -= w * rhs[k-1];
+    }
+    for (k = N - 2; k >= 1; k--) {
+      REAL8 Mnext = (k + 2 < N) ? basis->R[(k+1) * N + j] : 0.0;
+      basis->R[k * N + j] = (rhs[k] - h[k] * Mnext) / diag[k];
+    }
+  }
+  XLALFree(h);
+  XLALFree(diag);
+  XLALFree(rhs);
+
+  /* Locate each frequency among the nodes.  Frequencies outside the nodes
+   * have no calibration correction. */
+  REAL8 lowf = exp(logfreqs->data[0]);
+  REAL8 highf = exp(logfreqs->data[N-1]);
+  for (i = 0, k = 0; i < length; i++) {
+    REAL8 f = freqs ? freqs[i] : deltaF * i;
+    REAL8 *c = &basis->coeffs[4*i];
+    if (f < lowf || f > highf) {
+      basis->interval[i] = -1;
+      c[0] = c[1] = c[2] = c[3] = 0.0;
+      continue;
+    }
+    REAL8 x = log(f);
+    /* Frequencies are usually increasing, so start from the last interval */
+    if (k > 0 && x < logfreqs->data[k]) k = 0;
+    while (k + 2 < N && x >= logfreqs->data[k+1]) k++;
+    REAL8 hk = logfreqs->data[k+1] - logfreqs->data[k];
+    REAL8 A = (logfreqs->data[k+1] - x) / hk;
+    REAL8 B = 1.0 - A;
+    basis->interval[i] = k;
+    c[0] = A;
+    c[1] = B;
+    c[2] = (A*A*A - A) * hk*hk / 6.0;
+    c[3] = (B*B*B - B) * hk*hk / 6.0;
+  }
+
+  return basis;
+}
+
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasis(const REAL8Vector *logfreqs,
+                                                                             REAL8 deltaF,
+                                                                             UINT4 length) {
+  LALInferenceSplineCalibrationBasis *basis = create_spline_calibration_basis(logfreqs, NULL, deltaF, length);
+  if (basis == NULL) XLAL_ERROR_NULL(XLAL_EFUNC);
+  return basis;
+}
+
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasisNodes(const REAL8Vector *logfreqs,
+                                                                                  const REAL8Sequence *freqNodes) {
+  if (freqNodes == NULL) XLAL_ERROR_NULL(XLAL_EFAULT);
+  LALInferenceSplineCalibrationBasis *basis = create_spline_calibration_basis(logfreqs, freqNodes->data, 0.0, freqNodes->length);
+  if (basis == NULL) XLAL_ERROR_NULL(XLAL_EFUNC);
+  return basis;
+}
+
+void LALInferenceDestroySplineCalibrationBasis(LALInferenceSplineCalibrationBasis *basis) {
+  if (basis == NULL) return;
+  XLALFree(basis->logfreqs);
+  XLALFree(basis->R);
+  XLALFree(basis->interval);
+  XLALFree(basis->coeffs);
+  XLALFree(basis->work);
+  XLALFree(basis);
+}
+
+int LALInferenceSplineCalibrationBasisMatches(const LALInferenceSplineCalibrationBasis *basis,
+                                              const REAL8Vector *logfreqs,
+                                              UINT4 length) {
+  if (basis == NULL || logfreqs == NULL) return 0;
+  if (basis->nnodes != logfreqs->length || basis->length != length) return 0;
+  return memcmp(basis->logfreqs, logfreqs->data, basis->nnodes * sizeof(REAL8)) == 0;
+}
+
+int LALInferenceSplineCalibrationFactorFromBasis(LALInferenceSplineCalibrationBasis *basis,
+                                                 const REAL8Vector *deltaAmps,
+                                                 const REAL8Vector *deltaPhases,
+                                                 COMPLEX16 *calFactor) {
+  if (basis == NULL || deltaAmps == NULL || deltaPhases == NULL || (calFactor == NULL && basis->length > 0))
+    XLAL_ERROR(XLAL_EFAULT);
+  if (deltaAmps->length != basis->nnodes || deltaPhases->length != basis->nnodes)
+    XLAL_ERROR(XLAL_EINVAL, "input lengths differ");
+
+  const UINT4 N = basis->nnodes;
+  const REAL8 *a = deltaAmps->data, *p = deltaPhases->data;
+  REAL8 *Ma = basis->work, *Mp = basis->work + N;
+
+  for (UINT4 k = 0; k < N; k++) {
+    const REAL8 *row = &basis->R[k * N];
+    REAL8 sa = 0.0, sp = 0.0;
+    for (UINT4 j = 0; j < N; j++) {
+      sa += row[j] * a[j];
+      sp += row[j] * p[j];
+    }
+    Ma[k] = sa;
+    Mp[k] = sp;
+  }
+
+  for (UINT4 i = 0; i < basis->length; i++) {
+    const INT4 k = basis->interval[i];
+    if (k < 0) {
+      calFactor[i] = 1.0;
+      continue;
+    }
+    const REAL8 *c = &basis->coeffs[4*i];
+    REAL8 dA = c[0]*a[k] + c[1]*a[k+1] + c[2]*Ma[k] + c[3]*Ma[k+1];
+    REAL8 dPhi = c[0]*p[k] + c[1]*p[k+1] + c[2]*Mp[k] + c[3]*Mp[k+1];
+    /* (2 + i dPhi) / (2 - i dPhi), without a complex division */
+    REAL8 norm = (1.0 + dA) / (4.0 + dPhi*dPhi);
+    calFactor[i] = crect(norm * (4.0 - dPhi*dPhi), norm * 4.0 * dPhi);
+  }
+
+  return XLAL_SUCCESS;
+}
+
 void LALInferenceFprintSplineCalibrationHeader(FILE *output, LALInferenceThreadState *thread) {
     INT4 i, nifo;
     char **ifo_names = NULL;
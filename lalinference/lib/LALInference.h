@@ -366,6 +366,54 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
 					REAL8Sequence *freqNodesQuad,
 					COMPLEX16Sequence **calFactorROQQuad);
 
+/**
+ * Precomputed basis of the spline calibration model of
+ * LALInferenceSplineCalibrationFactor() for a fixed set of spline nodes
+ * and output frequencies.  The calibration curves are linear in the
+ * amplitude and phase values at the nodes, so the basis holds the matrix
+ * mapping node values to the second derivatives of the splines, and the
+ * position of every output frequency among the nodes.  This is an opaque
+ * type.
+ */
+typedef struct tagLALInferenceSplineCalibrationBasis LALInferenceSplineCalibrationBasis;
+
+/**
+ * Create a spline calibration basis for the nodes at logfreqs (at least 3,
+ * increasing) and the frequencies 0, deltaF, ..., (length - 1) deltaF.
+ */
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasis(const REAL8Vector *logfreqs,
+                                                                             REAL8 deltaF,
+                                                                             UINT4 length);
+
+/**
+ * Create a spline calibration basis for the nodes at logfreqs and the
+ * frequencies in freqNodes, e.g. the nodes of a Reduced Order Quadrature.
+ */
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasisNodes(const REAL8Vector *logfreqs,
+                                                                                  const REAL8Sequence *freqNodes);
+
+/** Free a spline calibration basis. */
+void LALInferenceDestroySplineCalibrationBasis(LALInferenceSplineCalibrationBasis *basis);
+
+/**
+ * Returns non-zero if basis was created for the nodes at logfreqs and
+ * length output frequencies.
+ */
+int LALInferenceSplineCalibrationBasisMatches(const LALInferenceSplineCalibrationBasis *basis,
+                                              const REAL8Vector *logfreqs,
+                                              UINT4 length);
+
+/**
+ * Compute the calibration factors of LALInferenceSplineCalibrationFactor()
+ * at the output frequencies of basis into the array calFactor, without
+ * allocating memory.  The basis holds scratch space, so must not be used
+ * by several threads at once.
+ */
+int LALInferenceSplineCalibrationFactorFromBasis(LALInferenceSplineCalibrationBasis *basis,
+                                                 const REAL8Vector *deltaAmps,
+                                                 const REAL8Vector *deltaPhases,
+                                                 COMPLEX16 *calFactor);
+
 
 //Wrapper for template computation
 //(relies on LAL libraries for implementation) <- could be a #DEFINE ?
@@ -444,6 +492,9 @@ typedef struct tagLALInferenceModel
   REAL8                        SNR; /** Network SNR at *params* */
   REAL8*                       ifo_loglikelihoods; /** Array of single-IFO likelihoods at *params* */
   REAL8*                       ifo_SNRs; /** Array of single-IFO SNRs at *params* */
+  REAL8*                       ifo_fPlus; /** Array of single-IFO plus responses at *params*, set by the likelihood */
+  REAL8*                       ifo_fCross; /** Array of single-IFO cross responses at *params*, set by the likelihood */
+  REAL8*                       ifo_timeshifts; /** Array of single-IFO template time shifts at *params*, set by the likelihood */
 
   REAL8                        fLow;   /** Start frequency for waveform generation */
   REAL8                        fHigh;   /** End frequency for waveform generation */
@@ -463,6 +514,10 @@ typedef struct tagLALInferenceModel
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
+  struct tagLALInferenceSplineCalibrationBasis **calBasis; /** Per-IFO spline calibration bases on the frequency bins of the data, created by the likelihood on first use */
+  struct tagLALInferenceSplineCalibrationBasis **calBasisROQLinear, **calBasisROQQuadratic; /** Per-IFO spline calibration bases on the ROQ nodes */
+  struct tagLALInferenceTemplateCache *templateCache; /** Intrinsic parameters and polarisation inner products of the template in the frequency-domain buffers, created by the likelihood on first use */
+  struct tagLALInferenceRelBinModel *relbin; /** Relative binning bin edges and waveform, NULL unless relative binning is enabled */
 
 } LALInferenceModel;
 
@@ -565,6 +620,15 @@ tagLALInferenceThreadState
                                         Can also be removed. */
     size_t differentialPointsSkip; /** When the DE buffer gets too long, start storing
                                        only every n-th output point; this counter stores n */
+    REAL8 *differentialPointsMatrix; /** If not NULL, the differential points are stored here
+                                         instead of in differentialPoints, as a row-major matrix
+                                         with one row of differentialPointsDim values per point */
+    size_t differentialPointsDim; /** Number of columns of differentialPointsMatrix */
+    char **differentialPointsNames; /** Names of the parameters in the columns of
+                                        differentialPointsMatrix */
+    LALInferenceVariables *differentialPointsColumns; /** Column of differentialPointsMatrix
+                                                          holding each parameter, as INT4
+                                                          variables named after the parameters */
     REAL8 *currentIFOSNRs; /** Array storing single-IFO SNRs of current sample */
     REAL8 *currentIFOLikelihoods; /** Array storing single-IFO likelihoods of current sample */
     REAL8 currentSNR; /** Array storing network SNR of current sample */
@@ -655,6 +719,7 @@ tagLALInferenceIFOData
   UINT4                     likeli_counter; /** counts how many time the likelihood has been calculated */
   UINT4                     templa_counter; /** counts how many time the template has been calculated */
   struct tagLALInferenceROQData *roq; /** ROQ data */
+  struct tagLALInferenceRelBinData *relbin; /** Relative binning summary data */
 
   struct tagLALInferenceIFOData      *next;     /** A pointer to the next set of data for linked list */
 } LALInferenceIFOData;
@@ -673,6 +738,15 @@ tagLALInferenceROQData
 
   struct tagLALInferenceROQSplineWeightsLinear *weights_linear;
 
+  /* The linear weights on a uniform grid of time shifts, stored time-major
+     so that the weights of all nodes at one time shift are interpolated
+     together.  NULL if the time shifts are not uniformly spaced. */
+  COMPLEX16 *weightsLinearGrid; /** weight of node n at time sample k is element k*n_basis_linear + n */
+  COMPLEX16 *weightsLinearGridD2; /** second time derivatives of the natural cubic splines through the weights, same layout */
+  REAL8 time_grid_start; /** time shift of sample 0 */
+  REAL8 time_grid_step; /** spacing of the time samples */
+  UINT4 n_basis_linear; /** number of linear ROQ nodes */
+
  
   /* Deprecated functions that should be removed at some point */ 
   gsl_matrix_complex *weights; /** weights for the likelihood: NOTE: needs to be stored from data read from command line */
@@ -730,6 +804,37 @@ tagLALInferenceROQModel
 
 } LALInferenceROQModel;
 
+/**
+ * Structure to contain model-related relative binning quantities: the edges
+ * of the frequency bins, on the frequency grid of the data, and the
+ * polarisations of the current template at the edges.
+ */
+typedef struct
+tagLALInferenceRelBinModel
+{
+  REAL8Sequence *frequencies; /** bin edges, one more than the number of bins */
+  COMPLEX16FrequencySeries *hptilde; /** plus polarisation at the bin edges */
+  COMPLEX16FrequencySeries *hctilde; /** cross polarisation at the bin edges */
+} LALInferenceRelBinModel;
+
+/**
+ * Structure to contain data-related relative binning quantities: the summary
+ * data of one detector against the fiducial waveform h0.  With the weight
+ * w = 2 deltaF / S(f) of each frequency bin of the data and fc the centre of
+ * relative binning bin b, the sums over the data bins in bin b are
+ * A0 = sum w d conj(h0), A1 = sum w d conj(h0) (f-fc), B0 = sum w |h0|^2 and
+ * B1 = sum w |h0|^2 (f-fc).
+ */
+typedef struct
+tagLALInferenceRelBinData
+{
+  UINT4 nbins; /** number of bins */
+  COMPLEX16 *A0, *A1; /** summary data for <d|h> */
+  REAL8 *B0, *B1; /** summary data for <h|h> */
+  COMPLEX16 *h0; /** response of the detector to the fiducial waveform at the bin edges */
+  REAL8 dd; /** sum of w |d|^2 over the band of the detector */
+} LALInferenceRelBinData;
+
 /**
  * Structure to contain data-related Reduced Order Quadrature quantities
  */
@@ -841,6 +946,27 @@ void LALInferenceSortVariablesByName(LALInferenceVariables *vars);
 INT4 LALInferenceThinnedBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray, INT4 step);
 INT4 LALInferenceBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray);
 
+/**
+ * Store the differential points of thread in a contiguous matrix, with one
+ * column for each non-fixed REAL8 parameter of params.  Points already in
+ * thread->differentialPoints (e.g. read from a checkpoint) are moved into
+ * the matrix, and thread->differentialPoints is freed and set to NULL.
+ */
+int LALInferenceSetupDifferentialPointsMatrix(LALInferenceThreadState *thread, LALInferenceVariables *params);
+
+/** Free the differential points matrix of thread */
+void LALInferenceDestroyDifferentialPointsMatrix(LALInferenceThreadState *thread);
+
+/** Column of the differential points matrix holding parameter name, or -1;
+ * looked up in thread->differentialPointsColumns */
+INT4 LALInferenceDifferentialPointsColumn(const LALInferenceThreadState *thread, const char *name);
+
+/** Copy the parameters in params to row i of the differential points matrix */
+void LALInferenceCopyVariablesToDifferentialPoint(LALInferenceThreadState *thread, LALInferenceVariables *params, size_t i);
+
+/** Set the parameters in params to the values in row i of the differential points matrix */
+void LALInferenceCopyDifferentialPointToVariables(const LALInferenceThreadState *thread, size_t i, LALInferenceVariables *params);
+
 /** LALInference variables to an array, and vica versa */
 void LALInferenceCopyVariablesToArray(LALInferenceVariables *origin, REAL8 *target);
 
@@ -299,9 +299,17 @@ LALInferenceTemplateFunction LALInferenceInitCBCTemplate(LALInferenceRunState *r
                     --template LAL (for frequency-domain templates)\n");
   }
   else if(LALInferenceGetProcParamVal(commandLine,"--roqtime_steps")){
+  if(LALInferenceGetProcParamVal(commandLine,"--relative-binning")){
+    fprintf(stderr,"ERROR: --relative-binning cannot be used with ROQ (--roqtime_steps). Exiting...\n");
+    exit(1);
+  }
   templt=&LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence;
         fprintf(stderr, "template is \"LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence\"\n");
   }
+  else if(LALInferenceGetProcParamVal(commandLine,"--relative-binning")){
+    templt=&LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence;
+    fprintf(stderr, "template is \"LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence\"\n");
+  }
   else {
     fprintf(stdout,"Template function called is \"LALInferenceTemplateXLALSimInspiralChooseWaveform\"\n");
   }
@@ -943,7 +951,7 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
     return(LALInferenceInitModelReviewEvidence(state)); /* CHECKME: Use the default prior for unimodal */
   }
 
-  LALInferenceModel *model = XLALMalloc(sizeof(LALInferenceModel));
+  LALInferenceModel *model = XLALCalloc(1, sizeof(LALInferenceModel));
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
   model->eos_fam = NULL;
@@ -1664,6 +1672,9 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   /* Choose proper template */
   model->templt = LALInferenceInitCBCTemplate(state);
@@ -1712,6 +1723,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence(LALInferenceRunState *sta
     /* Create arrays for holding single-IFO likelihoods, etc. */
     model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
     model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
 	i=0;
 
@@ -1758,6 +1772,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_bimod(LALInferenceRunStat
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
@@ -1803,6 +1820,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_banana(LALInferenceRunSta
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
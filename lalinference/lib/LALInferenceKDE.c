@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include <gsl/gsl_randist.h>
@@ -41,6 +42,38 @@
 #define omp ignore
 #endif
 
+/* Maximum number of points in a leaf of the k-d tree */
+#define KDE_TREE_LEAF_SIZE 16
+
+/* Default maximum relative error of the PDF allowed when pruning the tree */
+#define KDE_DEFAULT_TOLERANCE 1e-4
+
+/* A node of the k-d tree.  The points of the node are points[start] to
+ * points[start + count - 1] of the tree; leaves have left = right = -1. */
+typedef struct tagKDETreeNode {
+    INT4 start;
+    INT4 count;
+    INT4 left;
+    INT4 right;
+} KDETreeNode;
+
+/* k-d tree over the whitened points of a KDE.  Bounding boxes of node i are
+ * lower[i*dim ...] and upper[i*dim ...]. */
+struct tagLALInferenceKDETree {
+    INT4 dim;
+    INT4 npts;
+    INT4 nnodes;
+    INT4 size;
+    KDETreeNode *nodes;
+    REAL8 *lower;
+    REAL8 *upper;
+    REAL8 *points;
+};
+
+static struct tagLALInferenceKDETree *kde_tree_build(gsl_matrix *data, gsl_matrix *chol_lower);
+static void kde_tree_destroy(struct tagLALInferenceKDETree *tree);
+static REAL8 kde_tree_log_sum(const struct tagLALInferenceKDETree *tree, const REAL8 *y, REAL8 tol);
+
 
 
 /**
@@ -172,6 +205,9 @@ LALInferenceKDE *LALInferenceInitKDE(INT4 npts, INT4 dim) {
         kde->upper_bound_types[p] = LALINFERENCE_PARAM_OUTPUT;
     }
 
+    kde->tree = NULL;
+    kde->tolerance = KDE_DEFAULT_TOLERANCE;
+
     if (npts > 0)
         kde->data = gsl_matrix_alloc(npts, dim);
 
@@ -195,6 +231,8 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde) {
 
         if (kde->npts > 0) gsl_matrix_free(kde->data);
 
+        kde_tree_destroy(kde->tree);
+
         XLALFree(kde->lower_bound_types);
         XLALFree(kde->upper_bound_types);
         XLALFree(kde->lower_bounds);
@@ -284,6 +322,11 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     kde->log_norm_factor =
         log(kde->npts * sqrt(pow(2*LAL_PI, kde->dim) * det_cov));
 
+    /* Build a tree of the points in coordinates where the kernel is a unit
+     * Gaussian, replacing any tree from a previous bandwidth */
+    kde_tree_destroy(kde->tree);
+    kde->tree = kde_tree_build(kde->data, kde->cholesky_decomp_cov_lower);
+
     return;
 }
 
@@ -292,20 +335,22 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
  * Evaluate the (log) PDF from a KDE at a single point.
  *
  * Calculate the (log) value of the probability density function estimate from
- * a kernel density estimate at a single point.
+ * a kernel density estimate at a single point.  The kernels are summed using
+ * a k-d tree of the whitened points, in which groups of points whose kernels
+ * vary by less than \a kde->tolerance times the PDF are summed approximately,
+ * so that the relative error of the result is at most \a kde->tolerance.
  * @param[in] kde   The kernel density estimate to evaluate.
  * @param[in] point An array containing the point to evaluate the PDF at.
  * @return The value of the estimated probability density function at \a point.
  */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
     INT4 dim = kde->dim;
-    INT4 npts = kde->npts;
-    INT4 i, j, p;
+    INT4 i, p;
     INT4 n_evals = 1;  // Number of evaluations to be done
     REAL8 min, max, width, val;
 
     /* If the normalization is infinite, don't bother calculating anything */
-    if (isinf(kde->log_norm_factor))
+    if (isinf(kde->log_norm_factor) || kde->tree == NULL)
         return -INFINITY;
 
     gsl_vector_view x = gsl_vector_view_array(point, dim);
@@ -368,56 +413,54 @@ REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
         }
     }
 
-    /* Loop over list of reflected and cycled points */
-    REAL8* results = XLALMalloc(npts * sizeof(REAL8));
     REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
 
     /* Loop over reflected and cycled set of points */
     for (i = 0; i < n_evals; i++) {
         gsl_vector_view pt = gsl_matrix_row(points, i);
 
-        /* Loop over points in KDE dataset, using the Cholesky decomposition
-         * of the covariance to avoid ever inverting the covariance matrix */
-        #pragma omp parallel
-        {
-            /* Vectors that will hold the difference and transformed distance */
-            gsl_vector *diff = gsl_vector_alloc(dim);
-            gsl_vector *tdiff = gsl_vector_alloc(dim);
-
-            #pragma omp for schedule(static)
-            for (j = 0; j < npts; j++) {
-                gsl_vector_view d = gsl_matrix_row(kde->data, j);
-                gsl_vector_memcpy(diff, &d.vector);
-
-                gsl_vector_sub(diff, &pt.vector);
-                gsl_linalg_cholesky_solve(kde->cholesky_decomp_cov, diff, tdiff);
-                gsl_vector_mul(diff, tdiff);
-
-                REAL8 energy = 0.;
-                for (INT4 k=0; k<dim; k++)
-                    energy += gsl_vector_get(diff, k);
-                results[j] = -energy/2.;
-            }
-
-            gsl_vector_free(diff);
-            gsl_vector_free(tdiff);
-        }
+        /* Whiten the point using the Cholesky decomposition of the
+         * covariance, so the kernels are unit Gaussians */
+        gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                       kde->cholesky_decomp_cov_lower, &pt.vector);
 
         /* Normalize the result */
-        eval_results[i] = log_add_exps(results, npts) - kde->log_norm_factor;
+        eval_results[i] = kde_tree_log_sum(kde->tree, pt.vector.data, kde->tolerance) - kde->log_norm_factor;
     }
 
     /* Accumulate probability after accounting for all boundaries */
     REAL8 result = log_add_exps(eval_results, n_evals);
 
     gsl_matrix_free(points);
-    XLALFree(results);
     XLALFree(eval_results);
 
     return result;
 }
 
 
+/**
+ * Evaluate the (log) PDF from a KDE at a set of points.
+ *
+ * Calculate the (log) value of the probability density function estimate from
+ * a kernel density estimate at each of a set of points, in parallel.
+ * @param[in]  kde     The kernel density estimate to evaluate.
+ * @param[in]  points  Array with rows containing the points to evaluate the PDF at.
+ * @param[in]  npoints The number of points (rows) in \a points.
+ * @param[out] results Array of \a npoints values of the PDF at \a points.
+ * \sa LALInferenceKDEEvaluatePoint()
+ */
+void LALInferenceKDEEvaluatePoints(LALInferenceKDE *kde,
+                                   REAL8 *points,
+                                   INT4 npoints,
+                                   REAL8 *results) {
+    INT4 i;
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (i = 0; i < npoints; i++)
+        results[i] = LALInferenceKDEEvaluatePoint(kde, points + i*kde->dim);
+}
+
+
 /**
  * Draw a sample from a kernel density estimate.
  *
@@ -614,3 +657,240 @@ REAL8 log_add_exps(REAL8 *vals, INT4 size) {
 
     return result;
 }
+
+
+/* Partially sort the points perm[lo..hi] along coordinate axis, so that
+ * perm[k] is the median with smaller coordinates before and larger after */
+static void kde_tree_select(const REAL8 *points, INT4 dim, INT4 axis, INT4 *perm, INT4 lo, INT4 hi, INT4 k) {
+    while (lo < hi) {
+        REAL8 pivot = points[perm[(lo + hi)/2]*dim + axis];
+        INT4 i = lo, j = hi, tmp;
+        while (i <= j) {
+            while (points[perm[i]*dim + axis] < pivot) i++;
+            while (points[perm[j]*dim + axis] > pivot) j--;
+            if (i <= j) {
+                tmp = perm[i]; perm[i] = perm[j]; perm[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j)
+            hi = j;
+        else if (k >= i)
+            lo = i;
+        else
+            return;
+    }
+}
+
+
+/* Recursively build the node containing points perm[start..start+count-1],
+ * returning its index */
+static INT4 kde_tree_build_node(struct tagLALInferenceKDETree *tree, const REAL8 *points, INT4 *perm, INT4 start, INT4 count) {
+    INT4 dim = tree->dim;
+    INT4 i, p, node, axis = 0;
+    REAL8 *lower, *upper;
+
+    if (tree->nnodes == tree->size) {
+        tree->size *= 2;
+        tree->nodes = XLALRealloc(tree->nodes, tree->size * sizeof(KDETreeNode));
+        tree->lower = XLALRealloc(tree->lower, tree->size * dim * sizeof(REAL8));
+        tree->upper = XLALRealloc(tree->upper, tree->size * dim * sizeof(REAL8));
+    }
+    node = tree->nnodes++;
+    tree->nodes[node].start = start;
+    tree->nodes[node].count = count;
+    tree->nodes[node].left = tree->nodes[node].right = -1;
+
+    /* Bounding box of the points */
+    lower = tree->lower + node*dim;
+    upper = tree->upper + node*dim;
+    for (p = 0; p < dim; p++)
+        lower[p] = upper[p] = points[perm[start]*dim + p];
+    for (i = start + 1; i < start + count; i++) {
+        for (p = 0; p < dim; p++) {
+            REAL8 val = points[perm[i]*dim + p];
+            if (val < lower[p]) lower[p] = val;
+            if (val > upper[p]) upper[p] = val;
+        }
+    }
+
+    if (count <= KDE_TREE_LEAF_SIZE)
+        return node;
+
+    /* Split at the median of the widest dimension */
+    for (p = 1; p < dim; p++)
+        if (upper[p] - lower[p] > upper[axis] - lower[axis])
+            axis = p;
+    if (!(upper[axis] > lower[axis]))
+        return node;
+    kde_tree_select(points, dim, axis, perm, start, start + count - 1, start + count/2);
+
+    INT4 left = kde_tree_build_node(tree, points, perm, start, count/2);
+    INT4 right = kde_tree_build_node(tree, points, perm, start + count/2, count - count/2);
+    tree->nodes[node].left = left;
+    tree->nodes[node].right = right;
+
+    return node;
+}
+
+
+/* Whiten the rows of data by the lower-triangular matrix chol_lower and
+ * build a k-d tree of them */
+static struct tagLALInferenceKDETree *kde_tree_build(gsl_matrix *data, gsl_matrix *chol_lower) {
+    INT4 npts = data->size1;
+    INT4 dim = data->size2;
+    INT4 i;
+
+    if (npts == 0)
+        return NULL;
+
+    struct tagLALInferenceKDETree *tree = XLALCalloc(1, sizeof(*tree));
+    REAL8 *whitened = XLALMalloc(npts * dim * sizeof(REAL8));
+    INT4 *perm = XLALMalloc(npts * sizeof(INT4));
+
+    for (i = 0; i < npts; i++) {
+        gsl_vector_view row = gsl_vector_view_array(whitened + i*dim, dim);
+        gsl_vector_const_view d = gsl_matrix_const_row(data, i);
+        gsl_vector_memcpy(&row.vector, &d.vector);
+        gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, chol_lower, &row.vector);
+        perm[i] = i;
+    }
+
+    tree->dim = dim;
+    tree->npts = npts;
+    tree->size = 2*(npts/KDE_TREE_LEAF_SIZE) + 1;
+    tree->nodes = XLALMalloc(tree->size * sizeof(KDETreeNode));
+    tree->lower = XLALMalloc(tree->size * dim * sizeof(REAL8));
+    tree->upper = XLALMalloc(tree->size * dim * sizeof(REAL8));
+    kde_tree_build_node(tree, whitened, perm, 0, npts);
+
+    /* Store the points in tree order so that each node is contiguous */
+    tree->points = XLALMalloc(npts * dim * sizeof(REAL8));
+    for (i = 0; i < npts; i++)
+        memcpy(tree->points + i*dim, whitened + perm[i]*dim, dim * sizeof(REAL8));
+
+    XLALFree(whitened);
+    XLALFree(perm);
+    return tree;
+}
+
+
+static void kde_tree_destroy(struct tagLALInferenceKDETree *tree) {
+    if (tree) {
+        XLALFree(tree->nodes);
+        XLALFree(tree->lower);
+        XLALFree(tree->upper);
+        XLALFree(tree->points);
+        XLALFree(tree);
+    }
+}
+
+
+/* Smallest and largest squared distances from y to the box of a node */
+static void kde_tree_box_dist2(const struct tagLALInferenceKDETree *tree, INT4 node, const REAL8 *y, REAL8 *dmin2, REAL8 *dmax2) {
+    const REAL8 *lower = tree->lower + node*tree->dim;
+    const REAL8 *upper = tree->upper + node*tree->dim;
+    REAL8 near, far;
+    INT4 p;
+
+    *dmin2 = *dmax2 = 0.;
+    for (p = 0; p < tree->dim; p++) {
+        REAL8 dl = y[p] - lower[p], du = upper[p] - y[p];
+        near = dl < 0. ? -dl : (du < 0. ? -du : 0.);
+        far = dl > du ? dl : du;
+        *dmin2 += near*near;
+        *dmax2 += far*far;
+    }
+}
+
+
+static REAL8 kde_tree_point_dist2(const REAL8 *a, const REAL8 *b, INT4 dim) {
+    REAL8 d2 = 0.;
+    for (INT4 p = 0; p < dim; p++)
+        d2 += (a[p] - b[p])*(a[p] - b[p]);
+    return d2;
+}
+
+
+/* Squared distance from y to the nearest point below node, if less than best */
+static REAL8 kde_tree_nearest(const struct tagLALInferenceKDETree *tree, INT4 node, const REAL8 *y, REAL8 best) {
+    const KDETreeNode *n = tree->nodes + node;
+    REAL8 dmax2, lmin2, rmin2;
+
+    if (n->left < 0) {
+        for (INT4 i = n->start; i < n->start + n->count; i++) {
+            REAL8 d2 = kde_tree_point_dist2(tree->points + i*tree->dim, y, tree->dim);
+            if (d2 < best) best = d2;
+        }
+        return best;
+    }
+
+    kde_tree_box_dist2(tree, n->left, y, &lmin2, &dmax2);
+    kde_tree_box_dist2(tree, n->right, y, &rmin2, &dmax2);
+    if (lmin2 <= rmin2) {
+        if (lmin2 < best) best = kde_tree_nearest(tree, n->left, y, best);
+        if (rmin2 < best) best = kde_tree_nearest(tree, n->right, y, best);
+    } else {
+        if (rmin2 < best) best = kde_tree_nearest(tree, n->right, y, best);
+        if (lmin2 < best) best = kde_tree_nearest(tree, n->left, y, best);
+    }
+    return best;
+}
+
+
+/* Accumulate the kernels exp(-(d^2 - d2ref)/2) of the points below node into
+ * *sum, and a lower bound on them into *sum_lower.  Nodes whose kernels
+ * differ by less than 2 tol max(*sum_lower, 1) / npts are summed using the
+ * mean of their extreme values; since the nearest point contributes 1,
+ * the total error is less than tol times the sum. */
+static void kde_tree_sum(const struct tagLALInferenceKDETree *tree, INT4 node, const REAL8 *y, REAL8 d2ref, REAL8 tol, REAL8 *sum, REAL8 *sum_lower) {
+    const KDETreeNode *n = tree->nodes + node;
+    REAL8 dmin2, dmax2, kmax, kmin;
+
+    kde_tree_box_dist2(tree, node, y, &dmin2, &dmax2);
+    kmax = exp(-(dmin2 - d2ref)/2.);
+    kmin = exp(-(dmax2 - d2ref)/2.);
+
+    if (kmax - kmin <= 2.*tol*(*sum_lower > 1. ? *sum_lower : 1.)/tree->npts) {
+        *sum += n->count*(kmax + kmin)/2.;
+        *sum_lower += n->count*kmin;
+        return;
+    }
+
+    if (n->left < 0) {
+        for (INT4 i = n->start; i < n->start + n->count; i++) {
+            REAL8 k = exp(-(kde_tree_point_dist2(tree->points + i*tree->dim, y, tree->dim) - d2ref)/2.);
+            *sum += k;
+            *sum_lower += k;
+        }
+        return;
+    }
+
+    /* Visit the nearer child first to tighten the lower bound sooner */
+    REAL8 lmin2, rmin2;
+    kde_tree_box_dist2(tree, n->left, y, &lmin2, &dmax2);
+    kde_tree_box_dist2(tree, n->right, y, &rmin2, &dmax2);
+    if (lmin2 <= rmin2) {
+        kde_tree_sum(tree, n->left, y, d2ref, tol, sum, sum_lower);
+        kde_tree_sum(tree, n->right, y, d2ref, tol, sum, sum_lower);
+    } else {
+        kde_tree_sum(tree, n->right, y, d2ref, tol, sum, sum_lower);
+        kde_tree_sum(tree, n->left, y, d2ref, tol, sum, sum_lower);
+    }
+}
+
+
+/* Log of the sum of unit Gaussian kernels centred on the points of the tree,
+ * evaluated at the whitened point y */
+static REAL8 kde_tree_log_sum(const struct tagLALInferenceKDETree *tree, const REAL8 *y, REAL8 tol) {
+    REAL8 sum = 0., sum_lower = 0.;
+
+    /* Scale by the kernel of the nearest point to avoid underflow */
+    REAL8 d2ref = kde_tree_nearest(tree, 0, y, INFINITY);
+    if (!isfinite(d2ref))
+        return -INFINITY;
+
+    kde_tree_sum(tree, 0, y, d2ref, tol, &sum, &sum_lower);
+    return log(sum) - d2ref/2.;
+}
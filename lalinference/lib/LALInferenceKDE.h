@@ -28,6 +28,7 @@
 #include <lal/LALInference.h>
 
 struct tagkmeans;
+struct tagLALInferenceKDETree;
 
 /**
  * Structure containing the Guassian kernel density of a set of samples.
@@ -51,6 +52,11 @@ tagKDE
     LALInferenceParamVaryType * upper_bound_types; /**< Array of param boundary types */
     REAL8 * lower_bounds;              /**< Lower param bounds */
     REAL8 * upper_bounds;              /**< Upper param bounds */
+
+    struct tagLALInferenceKDETree *tree; /**< k-d tree of the points in \a data,
+                                              whitened by \a cholesky_decomp_cov_lower. */
+    REAL8 tolerance;                        /**< Maximum relative error in the PDF
+                                                  allowed when pruning the tree. */
 } LALInferenceKDE;
 
 /* Allocate, fill, and tune a Gaussian kernel density estimate given an array of points. */
@@ -71,6 +77,9 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde);
 /* Evaluate the (log) PDF from a KDE at a single point. */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point);
 
+/* Evaluate the (log) PDF from a KDE at a set of points. */
+void LALInferenceKDEEvaluatePoints(LALInferenceKDE *kde, REAL8 *points, INT4 npoints, REAL8 *results);
+
 /* Draw a sample from a kernel density estimate. */
 REAL8 *LALInferenceDrawKDESample(LALInferenceKDE *kde, gsl_rng *rng);
 
@@ -22,6 +22,7 @@
  */
 
 #include <complex.h>
+#include <string.h>
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferencePrior.h>
 #include <lal/LALInference.h>
@@ -33,6 +34,9 @@
 #include <lal/FrequencySeries.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/LALInferenceDistanceMarg.h>
+#include <lal/LALInferenceMultibanding.h>
+#include <lal/LALInferenceReadData.h>
+#include <lal/LIGOLwXMLInspiralRead.h>
 
 #include <gsl/gsl_sf_bessel.h>
 #include <gsl/gsl_sf_dawson.h>
@@ -65,6 +69,13 @@ typedef enum
 #define omp ignore
 #endif
 
+/* The frequency-domain likelihoods sum the bins in blocks of this length,
+ * each seeding its own time-shift phasor recurrence, so that the blocks can
+ * be summed on separate threads.  The block boundaries do not depend on the
+ * number of threads, and the blocks are added in order, so neither does the
+ * result. */
+#define FREQ_BLOCK_LENGTH 4096
+
 static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *currentParams,
                                                LALInferenceIFOData *data,
                                                LALInferenceModel *model,
@@ -99,6 +110,83 @@ static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, RE
   return(XLAL_SUCCESS);
 }
 
+/* Return the spline calibration basis of IFO number ifo from the per-IFO
+ * array *cache, which is allocated on first use, (re)creating the basis if
+ * it does not exist or was made for different nodes.  The output
+ * frequencies are freqNodes if not NULL, otherwise length bins of width
+ * deltaF. */
+static LALInferenceSplineCalibrationBasis *get_calib_basis(LALInferenceSplineCalibrationBasis ***cache, LALInferenceIFOData *data, int ifo, REAL8Vector *logfreqs, REAL8Sequence *freqNodes, REAL8 deltaF, UINT4 length)
+{
+  if(!*cache)
+  {
+    UINT4 nifo = 0;
+    for(LALInferenceIFOData *d = data; d; d = d->next) nifo++;
+    *cache = XLALCalloc(nifo, sizeof(**cache));
+    if(!*cache) XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  LALInferenceSplineCalibrationBasis **basis = &(*cache)[ifo];
+  if(freqNodes) length = freqNodes->length;
+  if(!LALInferenceSplineCalibrationBasisMatches(*basis, logfreqs, length))
+  {
+    LALInferenceDestroySplineCalibrationBasis(*basis);
+    if(freqNodes) *basis = LALInferenceCreateSplineCalibrationBasisNodes(logfreqs, freqNodes);
+    else *basis = LALInferenceCreateSplineCalibrationBasis(logfreqs, deltaF, length);
+    if(!*basis) XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+  return *basis;
+}
+
+COMPLEX16 LALInferenceROQLinearInnerProduct(const LALInferenceROQData *roq, UINT4 n, REAL8 t, const COMPLEX16 *cal, const COMPLEX16 *hplus, const COMPLEX16 *hcross, REAL8 fplus, REAL8 fcross)
+{
+  REAL8 dh_re = 0.0, dh_im = 0.0;
+  const REAL8 h = roq->time_grid_step;
+  const REAL8 x = roq->weightsLinearGrid ? (t - roq->time_grid_start) / h : -1.0;
+
+  if(roq->weightsLinearGrid && n == roq->n_basis_linear && x >= 0.0 && x <= roq->n_time_steps - 1)
+  {
+    UINT4 k = (UINT4) x;
+    if(k > (UINT4) roq->n_time_steps - 2) k = roq->n_time_steps - 2;
+    const REAL8 B = x - k;
+    const REAL8 A = 1.0 - B;
+    const REAL8 C = (A*A*A - A) * h*h / 6.0;
+    const REAL8 D = (B*B*B - B) * h*h / 6.0;
+    const REAL8 *y0 = (const REAL8 *) &roq->weightsLinearGrid[k*n];
+    const REAL8 *y1 = (const REAL8 *) &roq->weightsLinearGrid[(k+1)*n];
+    const REAL8 *m0 = (const REAL8 *) &roq->weightsLinearGridD2[k*n];
+    const REAL8 *m1 = (const REAL8 *) &roq->weightsLinearGridD2[(k+1)*n];
+    const REAL8 *hp = (const REAL8 *) hplus;
+    const REAL8 *hc = (const REAL8 *) hcross;
+    const REAL8 *c = (const REAL8 *) cal;
+
+    for(UINT4 i = 0; i < 2*n; i += 2)
+    {
+      const REAL8 w_re = A*y0[i] + B*y1[i] + C*m0[i] + D*m1[i];
+      const REAL8 w_im = A*y0[i+1] + B*y1[i+1] + C*m0[i+1] + D*m1[i+1];
+      REAL8 T_re = fplus*hp[i] + fcross*hc[i];
+      REAL8 T_im = fplus*hp[i+1] + fcross*hc[i+1];
+      if(c)
+      {
+        const REAL8 re = c[i]*T_re - c[i+1]*T_im;
+        T_im = c[i]*T_im + c[i+1]*T_re;
+        T_re = re;
+      }
+      dh_re += w_re*T_re + w_im*T_im;
+      dh_im += w_im*T_re - w_re*T_im;
+    }
+    return crect(dh_re, dh_im);
+  }
+
+  COMPLEX16 dh = 0.0;
+  for(UINT4 i = 0; i < n; i++)
+  {
+    COMPLEX16 template_EI = fplus*hplus[i] + fcross*hcross[i];
+    if(cal) template_EI *= cal[i];
+    COMPLEX16 weight = gsl_spline_eval(roq->weights_linear[i].spline_real_weight_linear, t, roq->weights_linear[i].acc_real_weight_linear) + I*gsl_spline_eval(roq->weights_linear[i].spline_imag_weight_linear, t, roq->weights_linear[i].acc_imag_weight_linear);
+    dh += weight*conj(template_EI);
+  }
+  return dh;
+}
+
 void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 {
     char help[]="\
@@ -116,6 +204,9 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
     (--margtimephi)                  Using marginalised in time and phase likelihood\n\
     (--margdist)                     Using marginalisation in distance with d^2 prior (compatible with --margphi and --margtimephi)\n\
     (--margdist-comoving)            Using marginalisation in distance with uniform-in-comoving-volume prior (compatible with --margphi and --margtimephi)\n\
+    (--relative-binning)             Using relative binning against a fiducial waveform (compatible with --margphi and --margdist)\n\
+    (--relbin-epsilon eps)           Maximum phase change, in radians, of perturbations to the fiducial waveform in one bin (default 0.1)\n\
+    (--relbin-fiducial file.xml)     Take the fiducial parameters from the first row of the sim_inspiral table (default: the --inj row selected by --event)\n\
     \n";
 
     /* Print command line arguments if help requested */
@@ -155,6 +246,7 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 
     /* Set the noise model evidence to the student t model value */
     LALInferenceTemplateNullFreqdomain(thread->model);
+    LALInferenceInvalidateTemplateCache(thread->model);
     LALInferenceTemplateFunction temp = thread->model->templt;
     thread->model->templt = &LALInferenceTemplateNullFreqdomain;
     REAL8 noiseZ = LALInferenceFreqDomainStudentTLogLikelihood(thread->currentParams, runState->data, thread->model);
@@ -176,6 +268,10 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
      else if (LALInferenceGetProcParamVal(commandLine, "--roqtime_steps")) {
      fprintf(stderr, "Using ROQ in likelihood.\n");
      runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
+    }
+     else if (LALInferenceGetProcParamVal(commandLine, "--relative-binning")) {
+     fprintf(stderr, "Using relative binning in likelihood.\n");
+     runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
     }
      else if (LALInferenceGetProcParamVal(commandLine, "--fastSineGaussianLikelihood")){
       fprintf(stderr, "WARNING: Using Fast SineGaussian likelihood and WF for LIB.\n");
@@ -184,6 +280,73 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
       runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
    }
 
+   /* Precompute the relative binning summary data against the fiducial
+      waveform, whose parameters are taken from the --relbin-fiducial file
+      or the --inj event.  Parameters not in the sim_inspiral table keep
+      the values of the starting point of the first thread */
+   if (LALInferenceGetProcParamVal(commandLine, "--relative-binning")) {
+     ProcessParamsTable *ppt=NULL;
+     REAL8 epsilon=0.1;
+     const char *fiducialFile=NULL;
+     INT4 fiducialEvent=0;
+     SimInspiralTable *fiducialTable=NULL, *fiducialRow=NULL;
+     LALInferenceVariables fiducial, injParams;
+     memset(&fiducial,0,sizeof(fiducial));
+     memset(&injParams,0,sizeof(injParams));
+
+     if (runState->likelihood!=&LALInferenceUndecomposedFreqDomainLogLikelihood &&
+         runState->likelihood!=&LALInferenceMarginalisedPhaseLogLikelihood) {
+       fprintf(stderr,"ERROR: --relative-binning can only be used with the Gaussian or phase-marginalised likelihood. Exiting...\n");
+       exit(1);
+     }
+     if (LALInferenceGetProcParamVal(commandLine,"--roq") || LALInferenceGetProcParamVal(commandLine,"--roqtime_steps")) {
+       fprintf(stderr,"ERROR: --relative-binning cannot be used with ROQ (--roq, --roqtime_steps). Exiting...\n");
+       exit(1);
+     }
+     if ((ppt=LALInferenceGetProcParamVal(commandLine,"--relbin-epsilon")))
+       epsilon=atof(ppt->value);
+     if ((ppt=LALInferenceGetProcParamVal(commandLine,"--relbin-fiducial")))
+       fiducialFile=ppt->value;
+     else if ((ppt=LALInferenceGetProcParamVal(commandLine,"--inj"))) {
+       fiducialFile=ppt->value;
+       if ((ppt=LALInferenceGetProcParamVal(commandLine,"--event")))
+         fiducialEvent=atoi(ppt->value);
+     }
+     else {
+       fprintf(stderr,"ERROR: --relative-binning needs the parameters of the fiducial waveform, from --relbin-fiducial or --inj. Exiting...\n");
+       exit(1);
+     }
+     SimInspiralTableFromLIGOLw(&fiducialTable,fiducialFile,0,0);
+     for (fiducialRow=fiducialTable; fiducialRow && fiducialEvent>0; fiducialEvent--)
+       fiducialRow=fiducialRow->next;
+     if (!fiducialRow) {
+       fprintf(stderr,"ERROR: unable to read the fiducial waveform from %s. Exiting...\n",fiducialFile);
+       exit(1);
+     }
+     LALInferenceCopyVariables(thread->currentParams,&fiducial);
+     LALInferenceInjectionToVariables(fiducialRow,&injParams);
+     for (LALInferenceVariableItem *item=injParams.head; item; item=item->next)
+       if (item->type==LALINFERENCE_REAL8_t && LALInferenceCheckVariable(&fiducial,item->name)
+           && LALInferenceGetVariableType(&fiducial,item->name)==LALINFERENCE_REAL8_t)
+         LALInferenceSetVariable(&fiducial,item->name,item->value);
+     LALInferenceClearVariables(&injParams);
+     while (fiducialTable) {
+       SimInspiralTable *next=fiducialTable->next;
+       XLALFree(fiducialTable);
+       fiducialTable=next;
+     }
+     if (LALInferenceSetupRelativeBinning(runState->data,thread->model,&fiducial,epsilon)!=XLAL_SUCCESS) {
+       fprintf(stderr,"ERROR: could not set up relative binning. Exiting...\n");
+       exit(1);
+     }
+     LALInferenceClearVariables(&fiducial);
+     for (INT4 t=1; t<runState->nthreads; t++) {
+       LALInferenceModel *model=runState->threads[t].model;
+       model->relbin=XLALCalloc(1,sizeof(LALInferenceRelBinModel));
+       model->relbin->frequencies=XLALCopyREAL8Sequence(thread->model->relbin->frequencies);
+     }
+   }
+
    /* Try to determine a model-less likelihood, if such a thing makes sense */
    if (runState->likelihood==&LALInferenceUndecomposedFreqDomainLogLikelihood || runState->likelihood==&LALInferenceMarginalisedPhaseLogLikelihood ){
 
@@ -273,6 +436,276 @@ static int checkItemAndAdd(void *item, void **array)
   return 0;
 }
 
+/* The template held in the frequency-domain buffers of a model.  The
+ * polarisations depend only on the intrinsic parameters, and the distance
+ * only sets their amplitude, so a template can be reused, together with the
+ * inner products of the polarisations with themselves in each IFO, when a
+ * proposal moves only the extrinsic parameters. */
+typedef struct tagLALInferenceTemplateCache
+{
+  LALInferenceTemplateFunction templt; /* template function that filled the buffers, NULL if they hold no known template */
+  LALInferenceVariables params;        /* parameters of that template that affect the polarisations */
+  REAL8 distance;                      /* its distance in Mpc, or 0 if it has none */
+  LALInferenceIFOData *data;           /* data on which hh is computed */
+  UINT4 nifo;
+  REAL8 *hh;                           /* <h+|h+>, <hx|hx> and Re <h+|hx> in each IFO, NaN until computed */
+} LALInferenceTemplateCache;
+
+/* Return 1 if item affects the polarisations made by the template function,
+ * 0 if it does not (extrinsic, calibration and output parameters, and the
+ * distance, which is handled by rescaling), and -1 if it cannot be compared
+ * cheaply, in which case templates are never reused. */
+static int template_cache_key(const LALInferenceVariableItem *item)
+{
+  const char **name;
+  if(item->vary==LALINFERENCE_PARAM_OUTPUT) return 0;
+  if(item->type>LALINFERENCE_COMPLEX16_t) return -1;
+  for(name=non_intrinsic_params; *name; name++)
+    if(!strcmp(item->name, *name)) return 0;
+  if(!strcmp(item->name, "logdistance") || strstr(item->name, "_spcal_")
+     || !strncmp(item->name, "calamp_", 7) || !strncmp(item->name, "calpha_", 7))
+    return 0;
+  return 1;
+}
+
+/* Record that the buffers hold the template made by templt for params, or
+ * that they hold no known template if templt is NULL. */
+static void template_cache_store(LALInferenceTemplateCache *cache, LALInferenceTemplateFunction templt, LALInferenceVariables *params)
+{
+  LALInferenceVariableItem *item;
+  UINT4 i;
+
+  LALInferenceClearVariables(&cache->params);
+  for(i=0; i<3*cache->nifo; i++) cache->hh[i] = NAN;
+  cache->templt = templt;
+  cache->distance = 0.0;
+  if(!templt) return;
+
+  for(item=params->head; item; item=item->next)
+    if(template_cache_key(item) > 0)
+      LALInferenceAddVariable(&cache->params, item->name, item->value, item->type, item->vary);
+  if(LALInferenceCheckVariable(params, "logdistance"))
+    cache->distance = exp(LALInferenceGetREAL8Variable(params, "logdistance"));
+}
+
+/* Return the template cache of model, creating it on first use, with room
+ * for the inner products in each IFO of data. */
+static LALInferenceTemplateCache *get_template_cache(LALInferenceModel *model, LALInferenceIFOData *data)
+{
+  LALInferenceTemplateCache *cache = model->templateCache;
+  if(!cache)
+  {
+    cache = model->templateCache = XLALCalloc(1, sizeof(*cache));
+    if(!cache) XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  if(cache->data != data)
+  {
+    UINT4 nifo = 0;
+    for(LALInferenceIFOData *d = data; d; d = d->next) nifo++;
+    REAL8 *hh = XLALRealloc(cache->hh, 3*nifo*sizeof(*hh));
+    if(!hh) XLAL_ERROR_NULL(XLAL_ENOMEM);
+    cache->hh = hh;
+    cache->nifo = nifo;
+    cache->data = data;
+    template_cache_store(cache, NULL, NULL);
+  }
+  return cache;
+}
+
+void LALInferenceInvalidateTemplateCache(LALInferenceModel *model)
+{
+  if(model->templateCache) template_cache_store(model->templateCache, NULL, NULL);
+}
+
+/* Return 1 if the buffers hold the template that templt makes for params. */
+static int template_cache_matches(const LALInferenceTemplateCache *cache, LALInferenceTemplateFunction templt, const LALInferenceVariables *params)
+{
+  LALInferenceVariableItem *item, *cached;
+  INT4 n = 0;
+
+  if(!cache->templt || cache->templt != templt) return 0;
+  for(item=params->head; item; item=item->next)
+  {
+    int key = template_cache_key(item);
+    if(key < 0) return 0;
+    if(!key) continue;
+    cached = LALInferenceGetItem(&cache->params, item->name);
+    if(!cached || cached->type != item->type
+       || memcmp(cached->value, item->value, LALInferenceTypeSize[item->type]))
+      return 0;
+    n++;
+  }
+  return n == cache->params.dimension;
+}
+
+/* Compute the inner products <h+|h+>, <hx|hx> and Re <h+|hx> of the
+ * polarisations in the buffers of model over frequency bins lower to upper
+ * of dataPtr, normalised as in the likelihood below. */
+static void template_cache_inner_products(const LALInferenceIFOData *dataPtr, const LALInferenceModel *model, int lower, int upper, REAL8 TwoDeltaToverN, REAL8 *hh)
+{
+  const REAL8 deltaT = dataPtr->timeData->deltaT;
+  const REAL8 *psd = dataPtr->oneSidedNoisePowerSpectrum->data->data;
+  const COMPLEX16 *hptilde = model->freqhPlus->data->data;
+  const COMPLEX16 *hctilde = model->freqhCross->data->data;
+  const INT4 nblocks = (upper - lower)/FREQ_BLOCK_LENGTH + 1;
+  REAL8 block[nblocks][3];
+  INT4 b;
+
+  #pragma omp parallel for if(nblocks>1)
+  for(b=0; b<nblocks; b++)
+  {
+    const INT4 start = lower + b*FREQ_BLOCK_LENGTH;
+    const INT4 end = (upper - start < FREQ_BLOCK_LENGTH) ? upper : start + FREQ_BLOCK_LENGTH - 1;
+    REAL8 hphp = 0.0, hchc = 0.0, hphc = 0.0;
+    for(INT4 i=start; i<=end; i++)
+    {
+      REAL8 w = TwoDeltaToverN/(psd[i]*deltaT*deltaT);
+      hphp += w*(creal(hptilde[i])*creal(hptilde[i]) + cimag(hptilde[i])*cimag(hptilde[i]));
+      hchc += w*(creal(hctilde[i])*creal(hctilde[i]) + cimag(hctilde[i])*cimag(hctilde[i]));
+      hphc += w*(creal(hptilde[i])*creal(hctilde[i]) + cimag(hptilde[i])*cimag(hctilde[i]));
+    }
+    block[b][0] = hphp;
+    block[b][1] = hchc;
+    block[b][2] = hphc;
+  }
+
+  hh[0] = hh[1] = hh[2] = 0.0;
+  for(b=0; b<nblocks; b++)
+  {
+    hh[0] += block[b][0];
+    hh[1] += block[b][1];
+    hh[2] += block[b][2];
+  }
+}
+
+/* Response of a detector to the polarisations hp, hc at frequency f, shifted
+   by timeshift, relative to its response h0 to the fiducial waveform */
+static COMPLEX16 relbin_ratio(REAL8 f, COMPLEX16 hp, COMPLEX16 hc, REAL8 fplus, REAL8 fcross, REAL8 timeshift, COMPLEX16 h0)
+{
+  if(h0==0.0) return 0.0;
+  return (fplus*hp + fcross*hc)*cexp(-I*LAL_TWOPI*f*timeshift)/h0;
+}
+
+int LALInferenceSetupRelativeBinning(LALInferenceIFOData *data, LALInferenceModel *model, LALInferenceVariables *fiducial, REAL8 epsilon)
+{
+  LALInferenceIFOData *dataPtr;
+  REAL8 deltaF=0.0, f_min=INFINITY, f_max=0.0;
+  INT4 errnum=0;
+  UINT4 j, b;
+
+  XLAL_CHECK(data && model && model->templt && fiducial, XLAL_EFAULT);
+  for(dataPtr=data; dataPtr; dataPtr=dataPtr->next)
+  {
+    REAL8 df = 1.0/(dataPtr->timeData->data->length*dataPtr->timeData->deltaT);
+    if(deltaF==0.0) deltaF=df;
+    else if(fabs(df-deltaF)>1e-9*deltaF)
+      XLAL_ERROR(XLAL_EINVAL, "Relative binning needs the same frequency resolution in all detectors");
+    if(dataPtr->fLow<f_min) f_min=dataPtr->fLow;
+    if(dataPtr->fHigh>f_max) f_max=dataPtr->fHigh;
+  }
+  const char *extrinsic[]={"rightascension","declination","polarisation","time",NULL};
+  for(j=0; extrinsic[j]; j++)
+    if(!LALInferenceCheckVariable(fiducial, extrinsic[j]))
+      XLAL_ERROR(XLAL_EINVAL, "The fiducial waveform for relative binning has no \"%s\"", extrinsic[j]);
+
+  REAL8Sequence *edges = LALInferenceRelativeBinningFrequencies(f_min, f_max, deltaF, epsilon);
+  XLAL_CHECK(edges, XLAL_EFUNC);
+  const UINT4 nbins = edges->length-1;
+  const UINT4 k_min = (UINT4)lround(edges->data[0]/deltaF);
+  const UINT4 k_max = (UINT4)lround(edges->data[nbins]/deltaF);
+  UINT4 k_edge[nbins+1];
+  for(j=0; j<=nbins; j++) k_edge[j] = (UINT4)lround(edges->data[j]/deltaF);
+
+  /* The summary data need the fiducial waveform at every frequency of the
+     band, and the ratios in the likelihood need it at the bin edges */
+  REAL8Sequence *grid = XLALCreateREAL8Sequence(k_max-k_min+1);
+  XLAL_CHECK(grid, XLAL_EFUNC);
+  for(j=0; j<grid->length; j++) grid->data[j] = (k_min+j)*deltaF;
+
+  if(!model->relbin) model->relbin = XLALCalloc(1, sizeof(LALInferenceRelBinModel));
+  else if(model->relbin->frequencies) XLALDestroyREAL8Sequence(model->relbin->frequencies);
+  LALInferenceInvalidateTemplateCache(model);
+  LALInferenceCopyVariables(fiducial, model->params);
+
+  model->relbin->frequencies = grid;
+  XLAL_TRY(model->templt(model), errnum);
+  COMPLEX16FrequencySeries *hpgrid = model->relbin->hptilde, *hcgrid = model->relbin->hctilde;
+  model->relbin->hptilde = model->relbin->hctilde = NULL;
+  model->relbin->frequencies = edges;
+  if(errnum==XLAL_SUCCESS) XLAL_TRY(model->templt(model), errnum);
+  XLALDestroyREAL8Sequence(grid);
+  if(errnum!=XLAL_SUCCESS || !hpgrid || !hcgrid || !model->relbin->hptilde || !model->relbin->hctilde)
+  {
+    if(hpgrid) XLALDestroyCOMPLEX16FrequencySeries(hpgrid);
+    if(hcgrid) XLALDestroyCOMPLEX16FrequencySeries(hcgrid);
+    XLAL_ERROR(XLAL_EFUNC, "Could not generate the fiducial waveform for relative binning");
+  }
+  const COMPLEX16 *hp0 = hpgrid->data->data, *hc0 = hcgrid->data->data;
+  const COMPLEX16 *hpedge = model->relbin->hptilde->data->data, *hcedge = model->relbin->hctilde->data->data;
+
+  REAL8 ra = LALInferenceGetREAL8Variable(fiducial, "rightascension");
+  REAL8 dec = LALInferenceGetREAL8Variable(fiducial, "declination");
+  REAL8 psi = LALInferenceGetREAL8Variable(fiducial, "polarisation");
+  REAL8 GPSdouble = LALInferenceGetREAL8Variable(fiducial, "time");
+  REAL8 templateTime = LALInferenceGetREAL8Variable(model->params, "time");
+  LIGOTimeGPS GPSlal;
+  XLALGPSSetREAL8(&GPSlal, GPSdouble);
+  REAL8 gmst = XLALGreenwichMeanSiderealTime(&GPSlal);
+
+  for(dataPtr=data; dataPtr; dataPtr=dataPtr->next)
+  {
+    double Fplus, Fcross;
+    LALInferenceRelBinData *relbin = dataPtr->relbin;
+    if(relbin)
+    {
+      XLALFree(relbin->A0); XLALFree(relbin->A1);
+      XLALFree(relbin->B0); XLALFree(relbin->B1);
+      XLALFree(relbin->h0);
+    }
+    else relbin = dataPtr->relbin = XLALCalloc(1, sizeof(LALInferenceRelBinData));
+    relbin->nbins = nbins;
+    relbin->A0 = XLALCalloc(nbins, sizeof(COMPLEX16));
+    relbin->A1 = XLALCalloc(nbins, sizeof(COMPLEX16));
+    relbin->B0 = XLALCalloc(nbins, sizeof(REAL8));
+    relbin->B1 = XLALCalloc(nbins, sizeof(REAL8));
+    relbin->h0 = XLALCalloc(nbins+1, sizeof(COMPLEX16));
+    relbin->dd = 0.0;
+
+    /* Same response and time shift as the likelihood */
+    XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])dataPtr->detector->response, ra, dec, psi, gmst);
+    REAL8 timeshift = (GPSdouble - templateTime) + XLALTimeDelayFromEarthCenter(dataPtr->detector->location, ra, dec, &GPSlal);
+    for(j=0; j<=nbins; j++)
+      relbin->h0[j] = (Fplus*hpedge[j] + Fcross*hcedge[j])*cexp(-I*LAL_TWOPI*edges->data[j]*timeshift);
+
+    const REAL8 deltaT = dataPtr->timeData->deltaT;
+    const REAL8 TwoDeltaToverN = 2.0 * deltaT / ((double) dataPtr->timeData->data->length);
+    const UINT4 lower = (UINT4)ceil(dataPtr->fLow / deltaF);
+    const UINT4 upper = (UINT4)floor(dataPtr->fHigh / deltaF);
+    for(b=0; b+1<nbins && k_edge[b+1]<=lower; b++);
+    for(UINT4 k=lower; k<=upper; k++)
+    {
+      /* The last bin includes its upper edge */
+      if(b+1<nbins && k>=k_edge[b+1]) b++;
+      REAL8 f = k*deltaF;
+      REAL8 df = f - 0.5*(edges->data[b]+edges->data[b+1]);
+      COMPLEX16 d = dataPtr->freqData->data->data[k];
+      COMPLEX16 h0 = (Fplus*hp0[k-k_min] + Fcross*hc0[k-k_min])*cexp(-I*LAL_TWOPI*f*timeshift);
+      REAL8 w = TwoDeltaToverN/(dataPtr->oneSidedNoisePowerSpectrum->data->data[k]*deltaT*deltaT);
+      COMPLEX16 dh0 = w*d*conj(h0);
+      REAL8 h0h0 = w*(creal(h0)*creal(h0)+cimag(h0)*cimag(h0));
+      relbin->dd += w*(creal(d)*creal(d)+cimag(d)*cimag(d));
+      relbin->A0[b] += dh0;
+      relbin->A1[b] += dh0*df;
+      relbin->B0[b] += h0h0;
+      relbin->B1[b] += h0h0*df;
+    }
+  }
+
+  XLALDestroyCOMPLEX16FrequencySeries(hpgrid);
+  XLALDestroyCOMPLEX16FrequencySeries(hcgrid);
+  return XLAL_SUCCESS;
+}
+
 /* ============ Likelihood computations: ========== */
 
 /**
@@ -339,10 +772,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   double Fplus, Fcross;
   //double diffRe, diffIm;
   //double dataReal, dataImag;
-  double glitchReal=0.0, glitchImag=0.0;
   //REAL8 plainTemplateReal, plainTemplateImag;
   //REAL8 templateReal=0.0, templateImag=0.0;
-  int i, j, lower, upper, ifo;
+  int i, lower, upper, ifo;
   LALInferenceIFOData *dataPtr;
   double ra=0.0, dec=0.0, psi=0.0, gmst=0.0;
   double GPSdouble=0.0, t0=0.0;
@@ -350,14 +782,13 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   //double chisquared;
   double timedelay;  /* time delay b/w iterferometer & geocenter w.r.t. sky location */
   double timeshift=0;  /* time shift (not necessarily same as above)                   */
-  double deltaT, TwoDeltaToverN, deltaF, twopit=0.0, re, im, dre, dim, newRe, newIm;
+  double deltaT, TwoDeltaToverN, deltaF, twopit=0.0, dre, dim;
   double timeTmp;
   double mc;
   /* Burst templates are generated at hrss=1, thus need to rescale amplitude */
   double amp_prefactor=1.0;
 
   COMPLEX16FrequencySeries *calFactor = NULL;
-  COMPLEX16 calF = 0.0;
 
   REAL8Vector *logfreqs = NULL;
   REAL8Vector *amps = NULL;
@@ -371,6 +802,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   UINT4 constantcal_active=0;
   INT4 errnum=0;
 
+  LALInferenceTemplateCache *templateCache=NULL;
+  int hhCached=0;
+
   /* ROQ likelihood stuff */
   REAL8 d_inner_h=0.0;
   double dist_min, dist_max;
@@ -403,7 +837,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   }
 
   REAL8 degreesOfFreedom=2.0;
-  REAL8 chisq=0.0;
   /* margphi params */
   //REAL8 Rre=0.0,Rim=0.0;
   REAL8 D=0.0,S=0.0;
@@ -475,6 +908,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   if(LALInferenceCheckVariable(currentParams, "signalModelFlag"))
     signalFlag = *((INT4 *)LALInferenceGetVariable(currentParams, "signalModelFlag"));
 
+  if(model->relbin && signalFlag && (margtime || marginalisationflags==STUDENTT || spcal_active || constantcal_active || psdFlag || glitchFlag))
+    XLAL_ERROR_REAL8(XLAL_EINVAL,"Relative binning supports only the Gaussian likelihood, marginalised over phase or distance");
+
   int freq_length=0,time_length=0;
   COMPLEX16Vector * dh_S_tilde=NULL;
   COMPLEX16Vector * dh_S_phase_tilde = NULL;
@@ -549,6 +985,16 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     }
   }
 
+  /* Reuse the template, and the inner products of its polarisations, while
+     only the extrinsic parameters change.  The ROQ templates are not kept
+     between calls. */
+  if(signalFlag && !model->roq_flag)
+  {
+    templateCache = get_template_cache(model, data);
+    if(!templateCache) XLAL_ERROR_REAL8(XLAL_EFUNC);
+    hhCached = !spcal_active && !constantcal_active && !psdFlag && !glitchFlag
+               && (marginalisationflags==GAUSSIAN || marginalisationflags==MARGPHI);
+  }
 
   if(margtime)
   {
@@ -627,52 +1073,65 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
        calls to template */
       if(!checkItemAndAdd((void *)(model->freqhPlus), generatedFreqModels))
       {
-        /* Compare parameter values with parameter values corresponding  */
-        /* to currently stored template; ignore "time" variable:         */
-        if (LALInferenceCheckVariable(model->params, "time")) {
-          timeTmp = *(REAL8 *) LALInferenceGetVariable(model->params, "time");
-          LALInferenceRemoveVariable(model->params, "time");
+        if(templateCache && template_cache_matches(templateCache, model->templt, currentParams))
+        {
+          /* Only the extrinsic parameters have changed: the buffers and */
+          /* model->params still hold the template, which is rescaled to */
+          /* the new distance along with the beam pattern below.         */
+          if(templateCache->distance>0.0 && LALInferenceCheckVariable(currentParams, "logdistance"))
+            amp_prefactor *= templateCache->distance/exp(LALInferenceGetREAL8Variable(currentParams, "logdistance"));
         }
-        else timeTmp = GPSdouble;
+        else
+        {
+          /* Compare parameter values with parameter values corresponding  */
+          /* to currently stored template; ignore "time" variable:         */
+          if (LALInferenceCheckVariable(model->params, "time")) {
+            timeTmp = *(REAL8 *) LALInferenceGetVariable(model->params, "time");
+            LALInferenceRemoveVariable(model->params, "time");
+          }
+          else timeTmp = GPSdouble;
 
-        LALInferenceCopyVariables(currentParams, model->params);
-        // Remove time variable so it can be over-written (if it was pinned)
-        if(LALInferenceCheckVariable(model->params,"time")) LALInferenceRemoveVariable(model->params,"time");
-        LALInferenceAddVariable(model->params, "time", &timeTmp, LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_LINEAR);
+          LALInferenceCopyVariables(currentParams, model->params);
+          // Remove time variable so it can be over-written (if it was pinned)
+          if(LALInferenceCheckVariable(model->params,"time")) LALInferenceRemoveVariable(model->params,"time");
+          LALInferenceAddVariable(model->params, "time", &timeTmp, LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_LINEAR);
 
-        XLAL_TRY(model->templt(model),errnum);
-        errnum&=~XLAL_EFUNC;
-        if(errnum!=XLAL_SUCCESS)
-        {
-          switch(errnum)
+          XLAL_TRY(model->templt(model),errnum);
+          errnum&=~XLAL_EFUNC;
+          if(errnum!=XLAL_SUCCESS)
           {
-            case XLAL_EUSR0: /* Template generation failed in a known way, set -Inf likelihood */
-		      /* Free up allocated vectors */
-              if(dh_S_tilde) XLALDestroyCOMPLEX16Vector(dh_S_tilde);
-              if(dh_S) XLALDestroyREAL8Vector(dh_S);
-              if(dh_S_phase_tilde) XLALDestroyCOMPLEX16Vector(dh_S_phase_tilde);
-              if(dh_S_phase) XLALDestroyREAL8Vector(dh_S_phase);
-              if(model->roq_flag)
-              {
-                if ( model->roq->hptildeLinear ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hptildeLinear);
-                if ( model->roq->hctildeLinear ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hctildeLinear);
-                if ( model->roq->hptildeQuadratic ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hptildeQuadratic);
-                if ( model->roq->hctildeQuadratic ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hctildeQuadratic);
-              }
-              return (-INFINITY);
-              break;
-            default: /* Panic! */
-              fprintf(stderr,"Unhandled error in template generation - exiting!\n");
-              fprintf(stderr,"XLALError: %d, %s\n",errnum,XLALErrorString(errnum));
-              exit(1);
-              break;
-          }
+            if(templateCache) template_cache_store(templateCache, NULL, NULL);
+            switch(errnum)
+            {
+              case XLAL_EUSR0: /* Template generation failed in a known way, set -Inf likelihood */
+  		      /* Free up allocated vectors */
+                if(dh_S_tilde) XLALDestroyCOMPLEX16Vector(dh_S_tilde);
+                if(dh_S) XLALDestroyREAL8Vector(dh_S);
+                if(dh_S_phase_tilde) XLALDestroyCOMPLEX16Vector(dh_S_phase_tilde);
+                if(dh_S_phase) XLALDestroyREAL8Vector(dh_S_phase);
+                if(model->roq_flag)
+                {
+                  if ( model->roq->hptildeLinear ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hptildeLinear);
+                  if ( model->roq->hctildeLinear ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hctildeLinear);
+                  if ( model->roq->hptildeQuadratic ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hptildeQuadratic);
+                  if ( model->roq->hctildeQuadratic ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hctildeQuadratic);
+                }
+                return (-INFINITY);
+                break;
+              default: /* Panic! */
+                fprintf(stderr,"Unhandled error in template generation - exiting!\n");
+                fprintf(stderr,"XLALError: %d, %s\n",errnum,XLALErrorString(errnum));
+                exit(1);
+                break;
+            }
 
-        }
+          }
 
-        if (model->domain == LAL_SIM_DOMAIN_TIME) {
-          /* TD --> FD. */
-          LALInferenceExecuteFT(model);
+          if (model->domain == LAL_SIM_DOMAIN_TIME) {
+            /* TD --> FD. */
+            LALInferenceExecuteFT(model);
+          }
+          if(templateCache) template_cache_store(templateCache, model->templt, currentParams);
         }
       }
 
@@ -687,12 +1146,12 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 	  /* get_calib_spline creates and fills the logfreqs, amps, phases arrays */
 	  get_calib_spline(currentParams, dataPtr->name, &logfreqs, &amps, &phases);
 	  if (model->roq_flag) {
-
-             LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases,
-						model->roq->frequencyNodesLinear,
-						&(model->roq->calFactorLinear),
-						model->roq->frequencyNodesQuadratic,
-						&(model->roq->calFactorQuadratic));
+	    LALInferenceSplineCalibrationBasis *basisLinear = get_calib_basis(&model->calBasisROQLinear, data, ifo, logfreqs, model->roq->frequencyNodesLinear, 0.0, 0);
+	    LALInferenceSplineCalibrationBasis *basisQuadratic = get_calib_basis(&model->calBasisROQQuadratic, data, ifo, logfreqs, model->roq->frequencyNodesQuadratic, 0.0, 0);
+	    XLAL_CHECK_REAL8(basisLinear && basisQuadratic, XLAL_EFUNC);
+	    XLAL_CHECK_REAL8(model->roq->calFactorLinear->length == model->roq->frequencyNodesLinear->length && model->roq->calFactorQuadratic->length == model->roq->frequencyNodesQuadratic->length, XLAL_EINVAL, "input lengths differ");
+	    LALInferenceSplineCalibrationFactorFromBasis(basisLinear, amps, phases, model->roq->calFactorLinear->data);
+	    LALInferenceSplineCalibrationFactorFromBasis(basisQuadratic, amps, phases, model->roq->calFactorQuadratic->data);
 	  }
 
 	  else{
@@ -703,7 +1162,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
                        &lalDimensionlessUnit,
                        dataPtr->freqData->data->length);
 	    }
-          LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+	    LALInferenceSplineCalibrationBasis *basis = get_calib_basis(&model->calBasis, data, ifo, logfreqs, NULL, calFactor->deltaF, calFactor->data->length);
+	    XLAL_CHECK_REAL8(basis, XLAL_EFUNC);
+	    LALInferenceSplineCalibrationFactorFromBasis(basis, amps, phases, calFactor->data->data);
 	}
 	if(logfreqs) XLALDestroyREAL8Vector(logfreqs);
 	if(amps) XLALDestroyREAL8Vector(amps);
@@ -747,9 +1208,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         Fplus*=amp_prefactor;
         Fcross*=amp_prefactor;
 
-        dataPtr->fPlus = Fplus;
-        dataPtr->fCross = Fcross;
-        dataPtr->timeshift = timeshift;
+        if(model->ifo_fPlus) model->ifo_fPlus[ifo] = Fplus;
+        if(model->ifo_fCross) model->ifo_fCross[ifo] = Fcross;
+        if(model->ifo_timeshifts) model->ifo_timeshifts[ifo] = timeshift;
     }//end signalFlag condition
 
     /* determine frequency range & loop over frequency bins: */
@@ -798,36 +1259,19 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
     if (model->roq_flag) {
 
-	double complex weight_iii;
-
 	if (spcal_active){
 
-	    for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = model->roq->calFactorLinear->data[iii] * (dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii] );
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += ( weight_iii * ( conj( template_EI ) ) );
-		}
+	    this_ifo_d_inner_h += LALInferenceROQLinearInnerProduct(dataPtr->roq, model->roq->frequencyNodesLinear->length, timeshift, model->roq->calFactorLinear->data, model->roq->hptildeLinear->data->data, model->roq->hctildeLinear->data->data, Fplus, Fcross);
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 
-			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) );
+			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) );
 		}
 	}
 
 	else{
 
-		for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii];
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += weight_iii*conj(template_EI) ;
-
-		}
+		this_ifo_d_inner_h += LALInferenceROQLinearInnerProduct(dataPtr->roq, model->roq->frequencyNodesLinear->length, timeshift, NULL, model->roq->hptildeLinear->data->data, model->roq->hctildeLinear->data->data, Fplus, Fcross);
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 			complex double template_EI = model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross;
@@ -887,28 +1331,122 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
     }
     else{
-    REAL8 *psd=&(dataPtr->oneSidedNoisePowerSpectrum->data->data[lower]);
-    COMPLEX16 *dtilde=&(dataPtr->freqData->data->data[lower]);
-    COMPLEX16 *hptilde=&(model->freqhPlus->data->data[lower]);
-    COMPLEX16 *hctilde=&(model->freqhCross->data->data[lower]);
-    COMPLEX16 diff=0.0;
-    COMPLEX16 template=0.0;
-    REAL8 templatesq=0.0;
+    const INT4 nblocks=(upper-lower)/FREQ_BLOCK_LENGTH+1;
     REAL8 this_ifo_S=0.0;
     COMPLEX16 this_ifo_Rcplx=0.0;
 
-    for (i=lower,chisq=0.0,re = cos(twopit*deltaF*i),im = -sin(twopit*deltaF*i);
-         i<=upper;
-         i++, psd++, hptilde++, hctilde++, dtilde++,
-         newRe = re + re*dre - im*dim,
-         newIm = im + re*dim + im*dre,
-         re = newRe, im = newIm)
+    if(model->relbin && signalFlag)
     {
+      /* Relative binning: the ratio of the template to the fiducial       */
+      /* waveform is taken to be linear in f across each bin, through its  */
+      /* values at the edges, so that the sums over the bins of the data   */
+      /* reduce to the summary data of the fiducial waveform.              */
+      const LALInferenceRelBinData *relbin=dataPtr->relbin;
+      const REAL8 *fedge=model->relbin->frequencies->data;
+      const COMPLEX16 *hpedge=model->relbin->hptilde->data->data;
+      const COMPLEX16 *hcedge=model->relbin->hctilde->data->data;
+      if(!relbin) XLAL_ERROR_REAL8(XLAL_EFAULT,"No relative binning summary data for %s",dataPtr->name);
+
+      COMPLEX16 rlow=relbin_ratio(fedge[0], hpedge[0], hcedge[0], Fplus, Fcross, timeshift, relbin->h0[0]);
+      for(UINT4 b=0; b<relbin->nbins; b++)
+      {
+        COMPLEX16 rhigh=relbin_ratio(fedge[b+1], hpedge[b+1], hcedge[b+1], Fplus, Fcross, timeshift, relbin->h0[b+1]);
+        COMPLEX16 r0=0.5*(rlow+rhigh);
+        COMPLEX16 r1=(rhigh-rlow)/(fedge[b+1]-fedge[b]);
+        this_ifo_Rcplx+=conj(r0)*relbin->A0[b] + conj(r1)*relbin->A1[b];
+        this_ifo_S+=(creal(r0)*creal(r0)+cimag(r0)*cimag(r0))*relbin->B0[b] + 2.0*creal(r0*conj(r1))*relbin->B1[b];
+        rlow=rhigh;
+      }
+      D+=relbin->dd;
+      Rcplx+=this_ifo_Rcplx;
+      if(marginalisationflags==GAUSSIAN)
+        model->ifo_loglikelihoods[ifo] = -(relbin->dd + this_ifo_S - 2.0*creal(this_ifo_Rcplx));
+    }
+    else if(hhCached)
+    {
+      /* <h|h> follows from the stored inner products of the polarisations */
+      /* and the beam pattern, leaving a single pass over the bins for     */
+      /* <d|h> and <d|d>, with the same normalisation as the loop below.   */
+      REAL8 *hh=&(templateCache->hh[3*ifo]);
+      REAL8 this_ifo_D=0.0;
+      COMPLEX16 dhp=0.0, dhc=0.0;
+      REAL8 blockD[nblocks];
+      COMPLEX16 blockdhp[nblocks], blockdhc[nblocks];
+
+      if(isnan(hh[0])) template_cache_inner_products(dataPtr, model, lower, upper, TwoDeltaToverN, hh);
+      this_ifo_S = Fplus*Fplus*hh[0] + Fcross*Fcross*hh[1] + 2.0*Fplus*Fcross*hh[2];
+
+      #pragma omp parallel for if(nblocks>1)
+      for(INT4 b=0; b<nblocks; b++)
+      {
+        const INT4 start=lower+b*FREQ_BLOCK_LENGTH;
+        const INT4 end=(upper-start<FREQ_BLOCK_LENGTH) ? upper : start+FREQ_BLOCK_LENGTH-1;
+        const REAL8 *psd=dataPtr->oneSidedNoisePowerSpectrum->data->data;
+        const COMPLEX16 *dtilde=dataPtr->freqData->data->data;
+        const COMPLEX16 *hptilde=model->freqhPlus->data->data;
+        const COMPLEX16 *hctilde=model->freqhCross->data->data;
+        REAL8 bre=cos(twopit*deltaF*start), bim=-sin(twopit*deltaF*start);
+        REAL8 bD=0.0;
+        COMPLEX16 bdhp=0.0, bdhc=0.0;
+
+        for(INT4 k=start; k<=end; k++)
+        {
+          COMPLEX16 d=dtilde[k];
+          REAL8 w=TwoDeltaToverN/(psd[k]*deltaT*deltaT);
+          COMPLEX16 dw=w*d*(bre - I*bim);
+          bD+=w*(creal(d)*creal(d)+cimag(d)*cimag(d));
+          bdhp+=dw*conj(hptilde[k]);
+          bdhc+=dw*conj(hctilde[k]);
+
+          REAL8 bre_next = bre + bre*dre - bim*dim;
+          bim = bim + bre*dim + bim*dre;
+          bre = bre_next;
+        }
+        blockD[b]=bD;
+        blockdhp[b]=bdhp;
+        blockdhc[b]=bdhc;
+      }
+      for(INT4 b=0; b<nblocks; b++)
+      {
+        this_ifo_D+=blockD[b];
+        dhp+=blockdhp[b];
+        dhc+=blockdhc[b];
+      }
+      this_ifo_Rcplx=Fplus*dhp+Fcross*dhc;
+      D+=this_ifo_D;
+      Rcplx+=this_ifo_Rcplx;
+      if(marginalisationflags==GAUSSIAN)
+        model->ifo_loglikelihoods[ifo] = -(this_ifo_D + this_ifo_S - 2.0*creal(this_ifo_Rcplx));
+    }
+    else
+    {
+    /* Partial sums of each block: <d|d>, <h|h>, <d|h>, the terms of     */
+    /* this detector's log(L) and the terms of the network log(L).       */
+    REAL8 blockD[nblocks], blockS[nblocks], blockIfoLogL[nblocks], blockLogL[nblocks];
+    COMPLEX16 blockR[nblocks];
 
-      COMPLEX16 d=*dtilde;
+    #pragma omp parallel for if(nblocks>1)
+    for(INT4 b=0; b<nblocks; b++)
+    {
+      const INT4 start=lower+b*FREQ_BLOCK_LENGTH;
+      const INT4 end=(upper-start<FREQ_BLOCK_LENGTH) ? upper : start+FREQ_BLOCK_LENGTH-1;
+      const REAL8 *psd=dataPtr->oneSidedNoisePowerSpectrum->data->data;
+      const COMPLEX16 *dtilde=dataPtr->freqData->data->data;
+      const COMPLEX16 *hptilde=model->freqhPlus->data->data;
+      const COMPLEX16 *hctilde=model->freqhCross->data->data;
+      REAL8 bre=cos(twopit*deltaF*start), bim=-sin(twopit*deltaF*start);
+      REAL8 bD=0.0, bS=0.0, bIfoLogL=0.0, bLogL=0.0;
+      COMPLEX16 bR=0.0;
+
+    for (INT4 k=start; k<=end; k++)
+    {
+
+      COMPLEX16 d=dtilde[k];
+      COMPLEX16 template=0.0;
+      COMPLEX16 diff;
       /* Normalise PSD to our funny standard (see twoDeltaTOverN
 	 below). */
-      REAL8 sigmasq=(*psd)*deltaT*deltaT;
+      REAL8 sigmasq=psd[k]*deltaT*deltaT;
 
       if (constantcal_active) {
         REAL8 dre_tmp= creal(d)*cos_calpha - cimag(d)*sin_calpha;
@@ -926,12 +1464,12 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       /* Add noise PSD parameters to the model */
       if(psdFlag)
       {
-        for(j=0; j<Nblock; j++)
+        for(INT4 n=0; n<Nblock; n++)
         {
-          if (i >= psdBandsMin_array[j] && i <= psdBandsMax_array[j])
+          if (k >= psdBandsMin_array[n] && k <= psdBandsMax_array[n])
           {
-            sigmasq  *= alpha[j];
-            loglikelihood -= lnalpha[j];
+            sigmasq  *= alpha[n];
+            bLogL -= lnalpha[n];
           }
         }
       }
@@ -941,14 +1479,13 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
       if(signalFlag){
       /* derive template (involving location/orientation parameters) from given plus/cross waveforms: */
-      COMPLEX16 plainTemplate = Fplus*(*hptilde)+Fcross*(*hctilde);
+      COMPLEX16 plainTemplate = Fplus*hptilde[k]+Fcross*hctilde[k];
 
       /* Do time shifting */
-      template = plainTemplate * (re + I*im);
+      template = plainTemplate * (bre + I*bim);
 
       if (spcal_active) {
-          calF = calFactor->data->data[i];
-          template = template*calF;
+          template = template*calFactor->data->data[k];
       }
 
       diff -= template;
@@ -959,55 +1496,51 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       if(glitchFlag)
       {
         /* fourier amplitudes of glitches */
-        glitchReal = gsl_matrix_get(glitchFD,ifo,2*i);
-        glitchImag = gsl_matrix_get(glitchFD,ifo,2*i+1);
+        REAL8 glitchReal = gsl_matrix_get(glitchFD,ifo,2*k);
+        REAL8 glitchImag = gsl_matrix_get(glitchFD,ifo,2*k+1);
         COMPLEX16 glitch = glitchReal + I*glitchImag;
         diff -=glitch*deltaT;
 
       }//end glitch subtraction
 
-      templatesq=creal(template)*creal(template) + cimag(template)*cimag(template);
+      REAL8 templatesq=creal(template)*creal(template) + cimag(template)*cimag(template);
       REAL8 datasq = creal(d)*creal(d)+cimag(d)*cimag(d);
-      D+=TwoDeltaToverN*datasq/sigmasq;
-      this_ifo_S+=TwoDeltaToverN*templatesq/sigmasq;
-      COMPLEX16 dhstar = TwoDeltaToverN*d*conj(template)/sigmasq;
-      this_ifo_Rcplx+=dhstar;
-      Rcplx+=dhstar;
+      bD+=TwoDeltaToverN*datasq/sigmasq;
+      bS+=TwoDeltaToverN*templatesq/sigmasq;
+      bR+=TwoDeltaToverN*d*conj(template)/sigmasq;
 
       switch(marginalisationflags)
       {
         case GAUSSIAN:
         {
           REAL8 diffsq = creal(diff)*creal(diff)+cimag(diff)*cimag(diff);
-          chisq = TwoDeltaToverN*diffsq/sigmasq;
+          REAL8 chisq = TwoDeltaToverN*diffsq/sigmasq;
           singleFreqBinTerm = chisq;
-          //chisquared  += singleFreqBinTerm;
-          model->ifo_loglikelihoods[ifo] -= singleFreqBinTerm;
+          bIfoLogL -= singleFreqBinTerm;
           break;
         }
         case STUDENTT:
         {
           REAL8 diffsq = creal(diff)*creal(diff)+cimag(diff)*cimag(diff);
-          chisq = TwoDeltaToverN*diffsq/sigmasq;
+          REAL8 chisq = TwoDeltaToverN*diffsq/sigmasq;
           singleFreqBinTerm = ((degreesOfFreedom+2.0)/2.0) * log(1.0 + chisq/degreesOfFreedom) ;
-          //chisquared  += singleFreqBinTerm;
-          model->ifo_loglikelihoods[ifo] -= singleFreqBinTerm;
+          bIfoLogL -= singleFreqBinTerm;
           break;
         }
         case MARGTIME:
         case MARGTIMEPHI:
         {
-          loglikelihood+=-TwoDeltaToverN*(templatesq+datasq)/sigmasq;
+          bLogL+=-TwoDeltaToverN*(templatesq+datasq)/sigmasq;
 
           /* Note: No Factor of 2 here, since we are using the 2-sided
 	     COMPLEX16FFT.  Also, we use d*conj(h) because we are
 	     using a complex->real *inverse* FFT to compute the
 	     time-series of likelihoods. */
-          dh_S_tilde->data[i] += TwoDeltaToverN * d * conj(template) / sigmasq;
+          dh_S_tilde->data[k] += TwoDeltaToverN * d * conj(template) / sigmasq;
 
           if (margphi) {
             /* This is the other phase quadrature */
-            dh_S_phase_tilde->data[i] += TwoDeltaToverN * d * conj(I*template) / sigmasq;
+            dh_S_phase_tilde->data[k] += TwoDeltaToverN * d * conj(I*template) / sigmasq;
           }
 
           break;
@@ -1020,9 +1553,31 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
           break;
       }
 
-
+      /* Advance the time-shift phasor to the next bin */
+      REAL8 bre_next = bre + bre*dre - bim*dim;
+      bim = bim + bre*dim + bim*dre;
+      bre = bre_next;
 
     } /* End loop over freq bins */
+      blockD[b]=bD;
+      blockS[b]=bS;
+      blockR[b]=bR;
+      blockIfoLogL[b]=bIfoLogL;
+      blockLogL[b]=bLogL;
+    } /* End loop over blocks */
+
+    /* Sum the blocks in order, so that the result does not depend on
+       the number of threads */
+    for(INT4 b=0; b<nblocks; b++)
+    {
+      D+=blockD[b];
+      this_ifo_S+=blockS[b];
+      this_ifo_Rcplx+=blockR[b];
+      model->ifo_loglikelihoods[ifo]+=blockIfoLogL[b];
+      loglikelihood+=blockLogL[b];
+    }
+    Rcplx+=this_ifo_Rcplx;
+    }
     switch(marginalisationflags)
     {
     case GAUSSIAN:
@@ -1768,6 +2323,7 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
       LALInferenceAddVariable(model->params, "time", &timeTmp, LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_LINEAR);
 
       INT4 errnum=0;
+      LALInferenceInvalidateTemplateCache(model);
       XLAL_TRY(model->templt(model),errnum);
       errnum&=~XLAL_EFUNC;
       if(errnum!=XLAL_SUCCESS)
@@ -1802,9 +2358,9 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
       Fplus*=amp_prefactor;
       Fcross*=amp_prefactor;
 
-      dataPtr->fPlus = Fplus;
-      dataPtr->fCross = Fcross;
-      dataPtr->timeshift = timeshift;
+      if(model->ifo_fPlus) model->ifo_fPlus[ifo] = Fplus;
+      if(model->ifo_fCross) model->ifo_fCross[ifo] = Fcross;
+      if(model->ifo_timeshifts) model->ifo_timeshifts[ifo] = timeshift;
 
 
       /* determine frequency range & loop over frequency bins: */
@@ -1999,6 +2555,7 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
         LALInferenceAddVariable(model->params, "phase", &pi2, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_LINEAR);
       }
       INT4 errnum=0;
+      LALInferenceInvalidateTemplateCache(model);
       XLAL_TRY(model->templt(model),errnum);
       errnum&=~XLAL_EFUNC;
       if(errnum!=XLAL_SUCCESS)
@@ -2028,8 +2585,8 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
     /* determine beam pattern response (F_plus and F_cross) for given Ifo: */
     XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])dataPtr->detector->response, ra, dec, psi, gmst);
 
-    dataPtr->fPlus = Fplus;
-    dataPtr->fCross = Fcross;
+    if(model->ifo_fPlus) model->ifo_fPlus[ifo] = Fplus;
+    if(model->ifo_fCross) model->ifo_fCross[ifo] = Fcross;
 
     /* determine frequency range & loop over frequency bins: */
     deltaT = dataPtr->timeData->deltaT;
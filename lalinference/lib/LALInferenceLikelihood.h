@@ -96,6 +96,21 @@ extern const REAL8 CM[15][15];
  *   - "polarisation"    (REAL8, radian, 0 <= psi <= ?)        
  *   - "distance"        (REAL8, Mpc, >0)                      
  *   - "time"            (REAL8, GPS sec.)                     
+ *
+ * The template is regenerated only when a parameter other than the sky
+ * location, polarisation, time, distance and calibration parameters has
+ * changed (or when another function has filled the model buffers);
+ * otherwise the stored polarisations are reused, rescaled to the new
+ * distance.  Without calibration, noise or glitch models, the inner
+ * products of the polarisations with themselves are also kept for each
+ * detector, so that only <d|h> needs a pass over the frequency bins.
+ * The bins are summed in fixed blocks, which are spread over the OpenMP
+ * threads when OpenMP is enabled; the result does not depend on the number
+ * of threads.
+ *
+ * When \c model->relbin is set up (see LALInferenceSetupRelativeBinning()),
+ * <d|h> and <h|h> are instead computed from the template at the relative
+ * binning bin edges and the summary data of each detector.
  ***************************************************************/
 REAL8 LALInferenceUndecomposedFreqDomainLogLikelihood(LALInferenceVariables *currentParams, LALInferenceIFOData *data, LALInferenceModel *model);
 
@@ -199,6 +214,39 @@ REAL8 LALInferenceMarginalisedTimeLogLikelihood(LALInferenceVariables *currentPa
  */
 void LALInferenceInitLikelihood(LALInferenceRunState *runState);
 
+/**
+ * Set up the relative binning likelihood.  Chooses the frequency bins with
+ * LALInferenceRelativeBinningFrequencies(), stores them in \c model->relbin,
+ * and computes the summary data of each detector in \c data against the
+ * fiducial waveform with parameters \c fiducial, which must include the
+ * sky position, polarisation and time.  \c model->templt must fill
+ * \c model->relbin with the polarisations at \c model->relbin->frequencies,
+ * as LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence()
+ * does.  Called by LALInferenceInitLikelihood() with --relative-binning.
+ */
+int LALInferenceSetupRelativeBinning(LALInferenceIFOData *data, LALInferenceModel *model, LALInferenceVariables *fiducial, REAL8 epsilon);
+
+/**
+ * Forget the template held in the buffers of \c model by
+ * LALInferenceUndecomposedFreqDomainLogLikelihood().  Must be called
+ * whenever the buffers are filled other than through the likelihood,
+ * e.g. by calling \c model->templt directly, so that the next likelihood
+ * call does not reuse them for the parameters of its last template.
+ */
+void LALInferenceInvalidateTemplateCache(LALInferenceModel *model);
+
+/**
+ * Return sum_n w_n(t) conj(cal_n (fplus hplus_n + fcross hcross_n)) over the
+ * \c n linear ROQ nodes, where w_n(t) are the linear ROQ weights of \c roq
+ * interpolated to the time shift \c t, and \c cal may be NULL.  When the
+ * weights are held on a uniform time grid (see LALInferenceSetupROQWeightGrid()),
+ * the cubic spline coefficients depend only on \c t and are shared by all of
+ * the nodes, so the weights are evaluated in one pass over the grid rows
+ * either side of \c t; otherwise, or if \c t is outside the grid, each
+ * weight is interpolated by its own gsl spline.
+ */
+COMPLEX16 LALInferenceROQLinearInnerProduct(const LALInferenceROQData *roq, UINT4 n, REAL8 t, const COMPLEX16 *cal, const COMPLEX16 *hplus, const COMPLEX16 *hcross, REAL8 fplus, REAL8 fcross);
+
 /** Get the intrinsic parameters from currentParams */
 LALInferenceVariables LALInferenceGetInstrinsicParams(LALInferenceVariables *currentParams);
 
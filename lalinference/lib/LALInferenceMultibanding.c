@@ -21,6 +21,8 @@
 
 /** F(t) and T(f) for newtonian waveform */
 static double LALInferenceTimeFrequencyRelation(double mc, double inPar, UINT4 flag_f);
+/** Phase of the relative binning perturbations at f */
+static double LALInferenceRelativeBinningPhase(double f, double f_min, double f_max);
 
 
 static double LALInferenceTimeFrequencyRelation(double mc, double inPar, UINT4 flag_f)
@@ -136,3 +138,65 @@ REAL8Sequence *LALInferenceMultibandFrequencies(int NBands, double f_min, double
     return(Frequencies);
     
 }
+
+
+static double LALInferenceRelativeBinningPhase(double f, double f_min, double f_max)
+{
+    /* Powers of f in the post-Newtonian phase, each scaled to change by
+       2 pi across the band */
+    const double gammas[] = {-5./3., -2./3., 1., 5./3., 7./3.};
+    double phase = 0.0;
+    for (UINT4 i=0; i<sizeof(gammas)/sizeof(gammas[0]); i++){
+        if (gammas[i] < 0.0)
+            phase -= LAL_TWOPI*pow(f/f_min, gammas[i]);
+        else
+            phase += LAL_TWOPI*pow(f/f_max, gammas[i]);
+    }
+    return (phase);
+}
+
+REAL8Sequence *LALInferenceRelativeBinningFrequencies(double f_min, double f_max, double deltaF0, double epsilon)
+{
+    if (!(epsilon > 0.0) || !(deltaF0 > 0.0))
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Relative binning needs positive epsilon and deltaF");
+
+    /* Same frequency bins as the likelihood integrates over */
+    UINT4 k_min = (UINT4)ceil(f_min/deltaF0);
+    UINT4 k_max = (UINT4)floor(f_max/deltaF0);
+    if (k_min == 0 || k_max <= k_min)
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid frequency range %g-%g Hz for relative binning", f_min, f_max);
+    f_min = k_min*deltaF0;
+    f_max = k_max*deltaF0;
+
+    double phase_min = LALInferenceRelativeBinningPhase(f_min, f_min, f_max);
+    double phase_max = LALInferenceRelativeBinningPhase(f_max, f_min, f_max);
+    UINT4 NBins = (UINT4)ceil((phase_max - phase_min)/epsilon);
+    if (NBins < 1) NBins = 1;
+
+    REAL8Sequence *Frequencies = XLALCreateREAL8Sequence(NBins + 1);
+    if (Frequencies == NULL)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+
+    /* Place each edge at the first frequency of the grid where the phase
+       reaches the next multiple of the bin width.  Where the grid is
+       coarser than the bins, at low frequencies, edges are merged. */
+    UINT4 nC = 0;
+    UINT4 k = k_min;
+    Frequencies->data[nC++] = f_min;
+    for (UINT4 j=1; j<NBins; j++) {
+        double phase = phase_min + j*(phase_max - phase_min)/NBins;
+        while (k < k_max && LALInferenceRelativeBinningPhase(k*deltaF0, f_min, f_max) < phase)
+            k++;
+        if (k >= k_max) break;
+        if (k*deltaF0 > Frequencies->data[nC - 1])
+            Frequencies->data[nC++] = k*deltaF0;
+    }
+    Frequencies->data[nC++] = f_max;
+
+    Frequencies = XLALShrinkREAL8Sequence(Frequencies, 0, nC);
+    if (Frequencies == NULL)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    printf("RELATIVE BINNING ACTIVATED: %u bins between %g and %g Hz\n", nC - 1, f_min, f_max);
+
+    return(Frequencies);
+}
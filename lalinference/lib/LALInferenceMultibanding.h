@@ -13,4 +13,9 @@
  mc is minimum allowable chirp mass (sets freq evolution assumption ) */
 REAL8Sequence *LALInferenceMultibandFrequencies(int NBands, double f_min, double f_max, double deltaF0, double mc);
 
+/** Create the edges of the relative binning frequency bins between f_min and f_max, on the grid of
+ frequencies spaced by deltaF0. The bins are chosen so that the phase of any perturbation to the fiducial
+ waveform following the powers of f of post-Newtonian theory changes by at most epsilon radians in a bin */
+REAL8Sequence *LALInferenceRelativeBinningFrequencies(double f_min, double f_max, double deltaF0, double epsilon);
+
 #endif
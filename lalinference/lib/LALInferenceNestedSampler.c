@@ -43,6 +43,10 @@
 #define UNUSED
 #endif
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 static int __chainfile_iter;
 
 /**
@@ -312,6 +316,10 @@ static double logsubexp(double a, double b)
 }
 
 static void SetupEigenProposals(LALInferenceRunState *runState);
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState);
+
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, LALInferenceVariables *algParams, gsl_rng *RNG);
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, LALInferenceVariables *algParams, gsl_rng *RNG);
 
 /**
  * Update the internal state of the integrator after receiving the lowest logL
@@ -435,9 +443,9 @@ static UINT4 UpdateNMCMC(LALInferenceRunState *runState){
         }
         LALInferenceSetVariable(runState->algorithmParams,"Nmcmc",&max);
     }
-    /* Single threaded here */
     if (LALInferenceGetProcParamVal(runState->commandLine,"--proposal-kde"))
-        LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[0]);
+        for(INT4 t=0;t<runState->nthreads;t++)
+            LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[t]);
     return(max);
 }
 
@@ -586,6 +594,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     (--sloppyratio S)                Number of sub-samples of the prior for every sample from the\n\
                                      limited prior\n\
     (--Nruns R)                      Number of parallel samples from logt to use(1)\n\
+    (--Nbatch K)                     Replace the K lowest-likelihood live points at each iteration,\n\
+                                     evolving the K replacements in parallel threads (1)\n\
     (--tolerance dZ)                 Tolerance of nested sampling algorithm (0.1)\n\
     (--randomseed seed)              Random seed of sampling distribution\n\
     (--prior )                       Set the prior to use (InspiralNormalised,SkyLoc,malmquist)\n\
@@ -640,15 +650,13 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   INT4 tmpi=0;
   REAL8 tmp=0;
 
-  /* Single thread only */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-
   /* Set up the appropriate functions for the nested sampling algorithm */
   runState->algorithm=&LALInferenceNestedSamplingAlgorithm;
   runState->evolve=&LALInferenceNestedSamplingOneStep;
 
   /* use the ptmcmc proposal to sample prior */
-  threadState->proposal=&LALInferenceCyclicProposal;
+  for(INT4 t=0;t<runState->nthreads;t++)
+    runState->threads[t].proposal=&LALInferenceCyclicProposal;
   REAL8 temp=1.0;
   LALInferenceAddVariable(runState->proposalArgs,"temperature",&temp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_FIXED);
 
@@ -665,6 +673,17 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   }
   LALInferenceAddVariable(runState->algorithmParams,"Nlive",&tmpi, LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
 
+  /* Number of live points replaced per iteration, one per thread */
+  ppt=LALInferenceGetProcParamVal(commandLine,"--Nbatch");
+  if(ppt){
+    INT4 Nbatch=atoi(ppt->value);
+    if(Nbatch<1 || Nbatch>runState->nthreads || Nbatch>=tmpi){
+      fprintf(stderr,"Error, --Nbatch %i must be at least 1, at most the number of threads (%i), and less than the number of live points\n",Nbatch,runState->nthreads);
+      exit(1);
+    }
+    LALInferenceAddVariable(runState->algorithmParams,"Nbatch",&Nbatch,LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
+  }
+
   /* Number of points in MCMC chain */
   ppt=LALInferenceGetProcParamVal(commandLine,"--Nmcmc");
   if(!ppt) ppt=LALInferenceGetProcParamVal(commandLine,"--nmcmc");
@@ -713,6 +732,36 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 }
 
 
+/* Evolve Nbatch replacement live points in parallel, one per thread.  Each
+ * thread clones a live point that is not being replaced, chosen using its
+ * own random number generator, and evolves it with the sloppy sampler
+ * until it finds a point with logL > logLmin.  The new points are left in
+ * threads[k].currentParams.  Returns the total number of attempts. */
+static UINT4 NestedSamplingEvolveBatch(LALInferenceRunState *runState, REAL8 logLmin, const REAL8 *logLikelihoods, const UINT4 *replace, LALInferenceVariables **batchParams, UINT4 Nbatch)
+{
+  UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
+  INT4 Nmcmc=*(INT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+  UINT4 itercounter=0;
+
+  #pragma omp parallel for reduction(+:itercounter)
+  for(UINT4 k=0;k<Nbatch;k++)
+  {
+    LALInferenceThreadState *thread=&runState->threads[k];
+    UINT4 j;
+    LALInferenceSetVariable(batchParams[k],"logLmin",(void *)&logLmin);
+    LALInferenceSetVariable(batchParams[k],"Nmcmc",&Nmcmc);
+    do{
+      while(replace[(j=gsl_rng_uniform_int(thread->GSLrandom,Nlive))]){};
+      LALInferenceCopyVariables(runState->livePoints[j],thread->currentParams);
+      thread->currentLikelihood = logLikelihoods[j];
+      NestedSamplingSloppySampleThread(runState,thread,batchParams[k],thread->GSLrandom);
+      itercounter++;
+    }while( thread->currentLikelihood<=logLmin || *(REAL8*)LALInferenceGetVariable(batchParams[k],"accept_rate")==0.0);
+  }
+
+  return(itercounter);
+}
+
 /* NestedSamplingAlgorithm implements the nested sampling algorithm,
  see e.g. Sivia & Skilling "Data Analysis: A Bayesian Tutorial, 2nd edition.
  REQUIREMENTS:
@@ -733,7 +782,11 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   UINT4 Nruns=100;
   REAL8 *logZarray,*Harray,*logwarray,*logtarray;
   REAL8 TOLERANCE=0.1;
-  REAL8 logZ,logZnew,logLmin,logLmax=-INFINITY,logLtmp,logw,H,logZnoise,dZ=0;
+  REAL8 logZ,logZnew,logLmin,logLnew,logLmax=-INFINITY,logLtmp,logw,H,logZnoise,dZ=0;
+  REAL8 accept_rate;
+  UINT4 Nbatch=1,k;
+  UINT4 *replace=NULL,*batchpos=NULL;
+  LALInferenceVariables **batchParams=NULL;
   LALInferenceVariables *temp;
   FILE *fpout=NULL;
   REAL8 neginfty=-INFINITY;
@@ -783,6 +836,10 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   if(LALInferenceCheckVariable(runState->algorithmParams,"tolerance"))
     TOLERANCE = *(REAL8 *) LALInferenceGetVariable(runState->algorithmParams,"tolerance");
 
+  /* Replace several live points per iteration if requested */
+  if(LALInferenceCheckVariable(runState->algorithmParams,"Nbatch"))
+    Nbatch = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nbatch");
+
   /* Check that necessary parameters are created */
   if(!LALInferenceCheckVariable(runState->algorithmParams,"logLmin"))
     LALInferenceAddVariable(runState->algorithmParams,"logLmin",&neginfty,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
@@ -834,9 +891,10 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   SetupEigenProposals(runState);
 
   /* Use the live points as differential evolution points */
-  /* Single thread here */
-  syncLivePointsDifferentialPoints(runState,threadState);
-  threadState->differentialPointsSkip=1;
+  for(INT4 t=0;t<runState->nthreads;t++){
+    syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
+    runState->threads[t].differentialPointsSkip=1;
+  }
 
   if(!LALInferenceCheckVariable(runState->algorithmParams,"Nmcmc")){
     INT4 tmp=MAX_MCMC;
@@ -937,6 +995,22 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   minpos=0;
   threadState->currentParams=currentVars;
+  if(Nbatch>1)
+  {
+    /* Each thread adapts its own copy of the sampler settings */
+    const char *batchNames[]={"logLmin","Nmcmc","sloppyfraction","accept_rate","sub_accept_rate","logZnoise"};
+    replace=XLALCalloc(Nlive,sizeof(UINT4));
+    batchpos=XLALCalloc(Nbatch,sizeof(UINT4));
+    batchParams=XLALCalloc(Nbatch,sizeof(LALInferenceVariables *));
+    for(k=0;k<Nbatch;k++)
+    {
+      batchParams[k]=XLALCalloc(1,sizeof(LALInferenceVariables));
+      for(i=0;i<sizeof(batchNames)/sizeof(batchNames[0]);i++)
+        LALInferenceAddVariable(batchParams[k],batchNames[i],LALInferenceGetVariable(runState->algorithmParams,batchNames[i]),
+                                LALInferenceGetVariableType(runState->algorithmParams,batchNames[i]),LALINFERENCE_PARAM_OUTPUT);
+    }
+    fprintf(stdout,"Replacing %i live points per iteration\n",Nbatch);
+  }
   fprintf(stdout,"Starting nested sampling loop!\n");
   /* Install interrupt handler for resuming */
   if(LALInferenceGetProcParamVal(runState->commandLine,"--resume"))
@@ -945,6 +1019,57 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   /* Iterate until termination condition is met */
   do {
+    UINT4 itercounter=0;
+    if(Nbatch>1)
+    {
+    /* Find the Nbatch lowest likelihood samples to replace, in increasing order */
+    for(i=0;i<Nlive;i++) replace[i]=0;
+    for(k=0;k<Nbatch;k++){
+      minpos=Nlive;
+      for(i=0;i<Nlive;i++)
+        if(!replace[i] && (minpos==Nlive || logLikelihoods[i]<logLikelihoods[minpos]))
+          minpos=i;
+      replace[minpos]=1;
+      batchpos[k]=minpos;
+    }
+    /* Remove them one at a time, the live set shrinking by one each time
+     * until the replacements are added */
+    for(k=0;k<Nbatch;k++){
+      logZnew=incrementEvidenceSamples(runState->GSLrandom, k+1<Nbatch ? Nlive-k-1 : Nlive, logLikelihoods[batchpos[k]], s);
+      if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[batchpos[k]]);
+    }
+    H=mean(Harray,Nruns);
+    logZ=logZnew;
+    logLmin=logLikelihoods[batchpos[Nbatch-1]];
+    if(samplePrior) logLmin=-INFINITY;
+
+    /* Generate the new live points in parallel */
+    itercounter=NestedSamplingEvolveBatch(runState, logLmin, logLikelihoods, replace, batchParams, Nbatch);
+
+    logw=mean(logwarray,Nruns);
+    logLnew=INFINITY;
+    accept_rate=0.0;
+    for(k=0;k<Nbatch;k++){
+      minpos=batchpos[k];
+      LALInferenceCopyVariables(runState->threads[k].currentParams,runState->livePoints[minpos]);
+      logLikelihoods[minpos]=runState->threads[k].currentLikelihood;
+      if(logLikelihoods[minpos]>logLmax) logLmax=logLikelihoods[minpos];
+      if(logLikelihoods[minpos]<logLnew) logLnew=logLikelihoods[minpos];
+      LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+      accept_rate+=*(REAL8 *)LALInferenceGetVariable(batchParams[k],"accept_rate")/(REAL8)Nbatch;
+    }
+    /* Report the average sampler statistics of the batch */
+    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
+    for(i=0;i<2;i++){
+      const char *name = i ? "sloppyfraction" : "sub_accept_rate";
+      REAL8 avg=0.0;
+      for(k=0;k<Nbatch;k++) avg+=*(REAL8 *)LALInferenceGetVariable(batchParams[k],name)/(REAL8)Nbatch;
+      LALInferenceSetVariable(runState->algorithmParams,name,&avg);
+    }
+    itercounter=(itercounter+Nbatch-1)/Nbatch;
+    }
+    else
+    {
     /* Find minimum likelihood sample to replace */
     minpos=0;
     for(i=1;i<Nlive;i++){
@@ -959,7 +1084,6 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     H=mean(Harray,Nruns);
     logZ=logZnew;
     if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
-    UINT4 itercounter=0;
 
     /* Generate a new live point */
     do{ /* This loop is here in case it is necessary to find a different sample */
@@ -974,12 +1098,14 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 
     LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
     logLikelihoods[minpos]=threadState->currentLikelihood;
+    logLnew=threadState->currentLikelihood;
 
   if (threadState->currentLikelihood>logLmax)
     logLmax=threadState->currentLikelihood;
 
   logw=mean(logwarray,Nruns);
   LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    }
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -990,13 +1116,13 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     100.0*sloppyfrac,\
     H,\
     logLmin,\
-    threadState->currentLikelihood,\
+    logLnew,\
     logZ,\
     (logLmax - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise")), \
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=Nbatch;
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1011,8 +1137,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     exit(CondorExitCode);
   }
 
-  /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
+  /* Update the proposal, when the iteration count has passed a multiple of Nlive/10 */
+  if(iter%(Nlive/10) < Nbatch) {
     /* Update the covariance matrix */
     if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
       SetupEigenProposals(runState);
@@ -1022,7 +1148,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     UpdateNMCMC(runState);
 
     /* Sync the live points to differential points */
-    syncLivePointsDifferentialPoints(runState,threadState);
+    for(INT4 t=0;t<runState->nthreads;t++)
+      syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
 
     /* Output some information */
     if(verbose){
@@ -1149,6 +1276,14 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     }
   
   /* Free memory */
+  if(batchParams){
+    for(k=0;k<Nbatch;k++){
+      LALInferenceClearVariables(batchParams[k]);
+      XLALFree(batchParams[k]);
+    }
+    XLALFree(batchParams);
+  }
+  XLALFree(replace); XLALFree(batchpos);
   XLALFree(logtarray); XLALFree(logwarray); XLALFree(logZarray);
 }
 
@@ -1338,7 +1473,13 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
 UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 {
     /* Single threaded here */
-    LALInferenceThreadState * threadState=&runState->threads[0];
+    return(MCMCSamplePriorThread(runState,&runState->threads[0],runState->algorithmParams,runState->GSLrandom));
+}
+
+/* Perform one MCMC iteration on threadState->currentParams, reading the
+ * likelihood bound from algParams and drawing acceptances from RNG */
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, LALInferenceVariables *algParams, gsl_rng *RNG)
+{
     UINT4 outOfBounds=0;
     UINT4 adaptProp=0;
     //LALInferenceVariables tempParams;
@@ -1346,7 +1487,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     //LALInferenceVariables *oldParams=&tempParams;
     LALInferenceVariables proposedParams;
     memset(&proposedParams,0,sizeof(proposedParams));
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(algParams,"logLmin");
     REAL8 thislogL=-INFINITY;
     UINT4 accepted=0;
 
@@ -1360,7 +1501,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 
     logProposalRatio = threadState->proposal(threadState,threadState->currentParams,&proposedParams);
     REAL8 logPriorNew=runState->prior(runState, &proposedParams, threadState->model);
-    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(runState->GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
+    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(RNG)) > (logPriorNew-logPriorOld) + logProposalRatio)
     {
 	/* Reject - don't need to copy new params back to currentParams */
         /*LALInferenceCopyVariables(oldParams,runState->currentParams); */
@@ -1484,9 +1625,17 @@ INT4 LALInferenceNestedSamplingCachedSampler(LALInferenceRunState *runState)
 
 INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
 {
-    LALInferenceVariables oldParams;
     /* Single thread here */
-    LALInferenceThreadState *threadState = &runState->threads[0];
+    return(NestedSamplingSloppySampleThread(runState,&runState->threads[0],runState->algorithmParams,runState->GSLrandom));
+}
+
+/* Sloppy sampling of threadState->currentParams.  The sampler settings
+ * (logLmin, Nmcmc, sloppyfraction) are read from algParams, which also
+ * receives the acceptance statistics, so that several threads can sample
+ * at once with their own copies */
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, LALInferenceVariables *algParams, gsl_rng *RNG)
+{
+    LALInferenceVariables oldParams;
     LALInferenceIFOData *data=runState->data;
     REAL8 tmp;
     REAL8 Target=0.3;
@@ -1494,14 +1643,14 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     REAL8 logLold=*(REAL8 *)LALInferenceGetVariable(threadState->currentParams,"logL");
     memset(&oldParams,0,sizeof(oldParams));
     LALInferenceCopyVariables(threadState->currentParams,&oldParams);
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
-    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(algParams,"logLmin");
+    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(algParams,"Nmcmc");
     REAL8 maxsloppyfraction=((REAL8)Nmcmc-1)/(REAL8)Nmcmc ;
     REAL8 sloppyfraction=maxsloppyfraction/2.0;
     REAL8 minsloppyfraction=0.;
     if(Nmcmc==1) maxsloppyfraction=minsloppyfraction=0.0;
-    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
-      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    if (LALInferenceCheckVariable(algParams,"sloppyfraction"))
+      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(algParams,"sloppyfraction");
     UINT4 mcmc_iter=0,Naccepted=0,sub_accepted=0;
     UINT4 sloppynumber=(UINT4) (sloppyfraction*(REAL8)Nmcmc);
     UINT4 testnumber=Nmcmc-sloppynumber;
@@ -1526,7 +1675,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         /* Draw an independent sample from the prior */
         do{
 
-            sub_accepted+=LALInferenceMCMCSamplePrior(runState);
+            sub_accepted+=MCMCSamplePriorThread(runState,threadState,algParams,RNG);
             subchain_length++;
             counter+=(1.-sloppyfraction);
         }while(counter<1);
@@ -1546,8 +1695,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
             Naccepted++;
             /* Update information to pass back out */
             LALInferenceAddVariable(threadState->currentParams,"logL",(void *)&logLnew,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
-            if(LALInferenceCheckVariable(runState->algorithmParams,"logZnoise")){
-               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logZnoise");
+            if(LALInferenceCheckVariable(algParams,"logZnoise")){
+               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(algParams,"logZnoise");
                LALInferenceAddVariable(threadState->currentParams,"deltalogL",(void *)&tmp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
             }
             ifo=0;
@@ -1577,8 +1726,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
             logLnew=runState->likelihood(threadState->currentParams,runState->data,threadState->model);
             threadState->currentLikelihood=logLnew;
             LALInferenceAddVariable(threadState->currentParams,"logL",(void *)&logLnew,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
-            if(LALInferenceCheckVariable(runState->algorithmParams,"logZnoise")){
-               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logZnoise");
+            if(LALInferenceCheckVariable(algParams,"logZnoise")){
+               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(algParams,"logZnoise");
                LALInferenceAddVariable(threadState->currentParams,"deltalogL",(void *)&tmp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
             }
             ifo=0;
@@ -1596,8 +1745,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     /* Compute some statistics for information */
     REAL8 sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
     REAL8 accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
-    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
-    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    LALInferenceSetVariable(algParams,"accept_rate",&accept_rate);
+    LALInferenceSetVariable(algParams,"sub_accept_rate",&sub_accept_rate);
     /* Adapt the sloppy fraction toward target acceptance of outer chain */
     if(isfinite(logLmin)){
         if((REAL8)accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
@@ -1605,7 +1754,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         if(sloppyfraction>maxsloppyfraction) sloppyfraction=maxsloppyfraction;
 	if(sloppyfraction<minsloppyfraction) sloppyfraction=minsloppyfraction;
 
-	LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+	LALInferenceSetVariable(algParams,"sloppyfraction",&sloppyfraction);
     }
     /* Cleanup */
     LALInferenceClearVariables(&oldParams);
@@ -1675,8 +1824,12 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 
 static void SetupEigenProposals(LALInferenceRunState *runState)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = &runState->threads[0];
+  for(INT4 t=0;t<runState->nthreads;t++)
+    SetupEigenProposalsThread(runState,&runState->threads[t]);
+}
+
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState)
+{
   gsl_matrix *eVectors=NULL;
   gsl_vector *eValues =NULL;
   REAL8Vector *eigenValues=NULL;
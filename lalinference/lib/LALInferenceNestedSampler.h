@@ -62,6 +62,11 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState);
 /**
  * NestedSamplingAlgorithm implements the nested sampling algorithm,
  * see e.g. Sivia "Data Analysis: A Bayesian Tutorial, 2nd edition
+ *
+ * If algorithmParams contains "Nbatch" = K > 1, the K lowest-likelihood
+ * live points are removed at each iteration and their replacements are
+ * evolved in parallel by runState->threads[0..K-1], using the sloppy
+ * sampler rather than runState->evolve.
  */
 void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState);
 
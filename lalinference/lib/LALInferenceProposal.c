@@ -23,12 +23,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <lal/LALInspiral.h>
 #include <lal/DetResponse.h>
 #include <lal/SeqFactories.h>
 #include <lal/Date.h>
 #include <lal/VectorOps.h>
 #include <lal/TimeFreqFFT.h>
+#include <lal/RealFFT.h>
 #include <lal/GenerateInspiral.h>
 #include <lal/TimeDelay.h>
 #include <lal/SkyCoordinates.h>
@@ -911,17 +913,35 @@ REAL8 LALInferenceEnsembleStretchNames(LALInferenceThreadState *thread,
     dePts = thread->differentialPoints;
     nPts = thread->differentialPointsLength;
 
-    if (dePts == NULL || nPts <= 1) {
+    if ((dePts == NULL && thread->differentialPointsMatrix == NULL) || nPts <= 1) {
         logPropRatio = 0.0;
         return logPropRatio; /* Quit now, since we don't have any points to use. */
     }
 
-    /* Choose a different sample */
-    do {
-        i = gsl_rng_uniform_int(thread->GSLrandom, nPts);
-    } while (!LALInferenceCompareVariables(currentParams, dePts[i]));
+    const REAL8 *rowI = NULL;
+    if (thread->differentialPointsMatrix) {
+        size_t k, dim = thread->differentialPointsDim;
+        REAL8 curRow[dim > 0 ? dim : 1];
+
+        for (k = 0; k < dim; k++)
+            curRow[k] = LALInferenceGetREAL8Variable(currentParams, thread->differentialPointsNames[k]);
+
+        /* Choose a different sample */
+        do {
+            i = gsl_rng_uniform_int(thread->GSLrandom, nPts);
+            rowI = thread->differentialPointsMatrix + i*dim;
+            for (k = 0; k < dim && rowI[k] == curRow[k]; k++);
+        } while (k == dim);
 
-    ptI = dePts[i];
+        ptI = NULL;
+    } else {
+        /* Choose a different sample */
+        do {
+            i = gsl_rng_uniform_int(thread->GSLrandom, nPts);
+        } while (!LALInferenceCompareVariables(currentParams, dePts[i]));
+
+        ptI = dePts[i];
+    }
 
     /* Scale z is chosen according to be symmetric under z -> 1/z */
     /* so p(x) \propto 1/z between 1/a and a */
@@ -936,8 +956,18 @@ REAL8 LALInferenceEnsembleStretchNames(LALInferenceThreadState *thread,
     scale = exp(X);
 
     for (i = 0; names[i] != NULL; i++) {
+        if (rowI) {
+            INT4 col = LALInferenceDifferentialPointsColumn(thread, names[i]);
+            if (col >= 0 && LALInferenceCheckVariableNonFixed(proposedParams, names[i])) {
+                cur = LALInferenceGetREAL8Variable(proposedParams, names[i]);
+                other = rowI[col];
+                x = other + scale*(cur-other);
+
+                LALInferenceSetVariable(proposedParams, names[i], &x);
+            }
+        }
         /* Ignore variable if it's not in each of the params. */
-        if (LALInferenceCheckVariableNonFixed(proposedParams, names[i]) &&
+        else if (LALInferenceCheckVariableNonFixed(proposedParams, names[i]) &&
             LALInferenceCheckVariableNonFixed(ptI, names[i])) {
                 cur = LALInferenceGetREAL8Variable(proposedParams, names[i]);
                 other= LALInferenceGetREAL8Variable(ptI, names[i]);
@@ -1019,8 +1049,10 @@ REAL8 LALInferenceEnsembleWalkNames(LALInferenceThreadState *thread,
 
   LALInferenceVariables **dePts = thread->differentialPoints;
   size_t nPts = thread->differentialPointsLength;
+  const REAL8 *deMatrix = thread->differentialPointsMatrix;
+  size_t deDim = thread->differentialPointsDim;
 
-  if (dePts == NULL || nPts <= 1) {
+  if ((dePts == NULL && deMatrix == NULL) || nPts <= 1) {
     logPropRatio = 0.0;
     return logPropRatio; /* Quit now, since we don't have any points to use. */
   }
@@ -1042,6 +1074,18 @@ REAL8 LALInferenceEnsembleWalkNames(LALInferenceThreadState *thread,
   {
     if(!LALInferenceCheckVariableNonFixed(proposedParams,names[k]) || LALInferenceGetVariableType(proposedParams,names[k])!=LALINFERENCE_REAL8_t) continue;
     REAL8 centre_of_mass=0.0;
+    if(deMatrix)
+    {
+      INT4 col=LALInferenceDifferentialPointsColumn(thread,names[k]);
+      if(col<0) continue;
+      for(i=0;i<sample_size;i++)
+        centre_of_mass+=deMatrix[indices[i]*deDim+col]/((REAL8)sample_size);
+      for(i=0,w=0.0;i<sample_size;i++)
+        w+= univariate_normals[i] * (deMatrix[indices[i]*deDim+col] - centre_of_mass);
+      REAL8 tmp = LALInferenceGetREAL8Variable(proposedParams,names[k]) + w;
+      LALInferenceSetVariable(proposedParams,names[k],&tmp);
+      continue;
+    }
     /* Compute centre of mass */
     for(i=0;i<sample_size;i++)
     {
@@ -1100,7 +1144,7 @@ REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
     dePts = thread->differentialPoints;
     nPts = thread->differentialPointsLength;
 
-    if (dePts == NULL || nPts <= 1)
+    if ((dePts == NULL && thread->differentialPointsMatrix == NULL) || nPts <= 1)
         return logPropRatio; /* Quit now, since we don't have any points to use. */
 
     LALInferenceCopyVariables(currentParams, proposedParams);
@@ -1111,8 +1155,15 @@ REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
         j = gsl_rng_uniform_int(rng, nPts);
     } while (j == i);
 
-    ptI = dePts[i];
-    ptJ = dePts[j];
+    const REAL8 *rowI = NULL, *rowJ = NULL;
+    if (thread->differentialPointsMatrix) {
+        rowI = thread->differentialPointsMatrix + i*thread->differentialPointsDim;
+        rowJ = thread->differentialPointsMatrix + j*thread->differentialPointsDim;
+        ptI = ptJ = NULL;
+    } else {
+        ptI = dePts[i];
+        ptJ = dePts[j];
+    }
 
     const REAL8 modeHoppingFrac = 0.5;
     /* Some fraction of the time, we do a "mode hopping" jump,
@@ -1126,7 +1177,15 @@ REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
     }
 
     for (i = 0; names[i] != NULL; i++) {
-        if (!LALInferenceCheckVariableNonFixed(currentParams, names[i]) ||
+        if (rowI) {
+            INT4 col = LALInferenceDifferentialPointsColumn(thread, names[i]);
+            if (col >= 0 && LALInferenceCheckVariableNonFixed(currentParams, names[i])) {
+                x = LALInferenceGetREAL8Variable(currentParams, names[i]);
+                x += scale * rowJ[col];
+                x -= scale * rowI[col];
+                LALInferenceSetVariable(proposedParams, names[i], &x);
+            }
+        } else if (!LALInferenceCheckVariableNonFixed(currentParams, names[i]) ||
             !LALInferenceCheckVariable(ptJ, names[i]) ||
             !LALInferenceCheckVariable(ptI, names[i])) {
         /* Ignore variable if it's not in each of the params. */
@@ -3484,6 +3543,20 @@ void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, IN
     /* Determine the number of iterations between each entry in the DE buffer */
     nSkip = thread->differentialPointsSkip;
 
+    /* A contiguous buffer can be used in place */
+    if (thread->differentialPointsMatrix) {
+        nPar = thread->differentialPointsDim;
+        max_acl = nSkip * LALInferenceComputeMaxAutoCorrLen(thread->differentialPointsMatrix + (nPoints/2)*nPar, nPoints-nPoints/2, nPar);
+
+        if (max_acl == INFINITY)
+            max_acl = INT_MAX;
+        else if (max_acl < 1.0)
+            max_acl = 1.0;
+
+        *maxACL = (INT4)max_acl;
+        return;
+    }
+
     /* Prepare 2D array for DE points */
     DEarray = (REAL8**) XLALCalloc(nPoints, sizeof(REAL8*));
     temp = (REAL8*) XLALCalloc(nPoints * nPar, sizeof(REAL8));
@@ -3503,6 +3576,37 @@ void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, IN
     XLALFree(DEarray);
 }
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+/* FFT plans used to estimate autocorrelations, indexed by the base-2
+ * logarithm of their length.  Plans are created on first use and shared by
+ * all chains for the lifetime of the process. */
+#define ACF_MAX_LOG2LEN 32
+static REAL8FFTPlan *acfForwardPlans[ACF_MAX_LOG2LEN];
+static REAL8FFTPlan *acfReversePlans[ACF_MAX_LOG2LEN];
+
+static int LALInferenceGetAutoCorrPlans(UINT4 log2len, REAL8FFTPlan **fwdplan, REAL8FFTPlan **revplan) {
+    if (log2len >= ACF_MAX_LOG2LEN)
+        XLAL_ERROR(XLAL_EINVAL, "Series of length 2^%u is too long.", log2len);
+
+    #pragma omp critical (LALInferenceAutoCorrPlans)
+    {
+        if (!acfForwardPlans[log2len])
+            acfForwardPlans[log2len] = XLALCreateForwardREAL8FFTPlan(1u << log2len, 0);
+        if (!acfReversePlans[log2len])
+            acfReversePlans[log2len] = XLALCreateReverseREAL8FFTPlan(1u << log2len, 0);
+        *fwdplan = acfForwardPlans[log2len];
+        *revplan = acfReversePlans[log2len];
+    }
+
+    if (!*fwdplan || !*revplan)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
 /**
  * Compute the maximum single-parameter autocorrelation length.  Each
  * parameter's ACL is the smallest s such that
@@ -3520,56 +3624,101 @@ void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, IN
  *
  * By default, safe parameters are M = 5, K = 2.
  *
+ * The ACF of each parameter is computed at all lags at once as the
+ * inverse FFT of its zero-padded power spectrum, normalised by the
+ * variance about the mean of the whole series.  FFT plans are cached and
+ * shared between calls, so the cost of a call is O(nPar N log N)
+ * regardless of the ACL.  The array is not modified.
+ *
  * If no estimate can be obtained, then return Infinity.
  *
  * @param array Array with rows containing samples.
- * @param nPoints UNDOCUMENTED
- * @param nPar UNDOCUMENTED
+ * @param nPoints Number of samples (rows) in the array.
+ * @param nPar Number of parameters (columns) in the array.
  * @return The maximum one-dimensional autocorrelation length
 */
 REAL8 LALInferenceComputeMaxAutoCorrLen(REAL8 *array, INT4 nPoints, INT4 nPar) {
     INT4 M=5, K=2;
 
-    REAL8 mean, ACL, ACF, maxACL=0;
+    REAL8 ACL, maxACL=0;
     INT4 par=0, lag=0, i=0, imax;
-    REAL8 cumACF, s;
-
-    if (nPoints > 1) {
-        imax = nPoints/K;
-
-        for (par=0; par<nPar; par++) {
-            mean = gsl_stats_mean(array+par, nPar, nPoints);
-            for (i=0; i<nPoints; i++)
-                array[i*nPar + par] -= mean;
-
-            lag=1;
-            ACL=1.0;
-            ACF=1.0;
-            s=1.0/(REAL8)M;
-            cumACF=1.0;
-            while (cumACF >= s) {
-                ACF = gsl_stats_correlation(array + par, nPar, array + lag*nPar + par, nPar, nPoints-lag);
-                cumACF += 2.0 * ACF;
-                lag++;
-                s = (REAL8)lag/(REAL8)M;
-                if (lag > imax) {
-                    return INFINITY; /* Short circuit: this parameter has indeterminate ACL */
-                }
+    UINT4 log2len, length, k;
+    REAL8 cumACF, s, C0;
+    REAL8 *mean;
+    REAL8Vector *series;
+    COMPLEX16Vector *power;
+    REAL8FFTPlan *fwdplan = NULL, *revplan = NULL;
+
+    if (nPoints <= 1 || nPar < 1)
+        return INFINITY;
+
+    imax = nPoints/K;
+
+    /* Zero-pad to at least twice the series length so the circular
+     * correlation computed by the FFT equals the linear one */
+    for (log2len=1; (1u << log2len) < 2u*(UINT4)nPoints; log2len++);
+    length = 1u << log2len;
+
+    if (LALInferenceGetAutoCorrPlans(log2len, &fwdplan, &revplan) != XLAL_SUCCESS)
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
+
+    mean = XLALCalloc(nPar, sizeof(REAL8));
+    series = XLALCreateREAL8Vector(length);
+    power = XLALCreateCOMPLEX16Vector(length/2 + 1);
+    if (!mean || !series || !power) {
+        XLALFree(mean);
+        XLALDestroyREAL8Vector(series);
+        XLALDestroyCOMPLEX16Vector(power);
+        XLAL_ERROR_REAL8(XLAL_ENOMEM);
+    }
+
+    /* Means of all parameters in a single pass over the rows */
+    for (i=0; i<nPoints; i++)
+        for (par=0; par<nPar; par++)
+            mean[par] += array[i*nPar + par];
+    for (par=0; par<nPar; par++)
+        mean[par] /= (REAL8)nPoints;
+
+    for (par=0; par<nPar; par++) {
+        for (i=0; i<nPoints; i++)
+            series->data[i] = array[i*nPar + par] - mean[par];
+        memset(series->data + nPoints, 0, (length - nPoints) * sizeof(REAL8));
+
+        /* The inverse transform of the power spectrum is the
+         * (unnormalised) autocovariance at every lag */
+        XLALREAL8ForwardFFT(power, series, fwdplan);
+        for (k=0; k<power->length; k++)
+            power->data[k] = creal(power->data[k])*creal(power->data[k]) + cimag(power->data[k])*cimag(power->data[k]);
+        XLALREAL8ReverseFFT(series, power, revplan);
+
+        /* Sum the ACF over a window of M times the running ACL estimate */
+        C0 = series->data[0];
+        lag=1;
+        s=1.0/(REAL8)M;
+        cumACF=1.0;
+        while (cumACF >= s) {
+            cumACF += 2.0 * series->data[lag] / C0;
+            lag++;
+            s = (REAL8)lag/(REAL8)M;
+            if (lag > imax) {
+                maxACL = INFINITY; /* Short circuit: this parameter has indeterminate ACL */
+                break;
             }
-            ACL = cumACF;
-
-            if (ACL > maxACL)
-                maxACL = ACL;
-            else if (gsl_isnan(ACL))
-                return INFINITY; /* Short circuit: this parameter has indeterminate ACL */
+        }
+        ACL = cumACF;
 
-            for (i=0; i<nPoints; i++)
-                array[i*nPar + par] += mean;
+        if (maxACL == INFINITY || gsl_isnan(ACL) || !(C0 > 0.0)) {
+            maxACL = INFINITY; /* Short circuit: this parameter has indeterminate ACL */
+            break;
+        } else if (ACL > maxACL) {
+            maxACL = ACL;
         }
-    } else {
-        maxACL = INFINITY;
     }
 
+    XLALFree(mean);
+    XLALDestroyREAL8Vector(series);
+    XLALDestroyCOMPLEX16Vector(power);
+
     return maxACL;
 }
 
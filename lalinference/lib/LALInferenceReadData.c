@@ -2627,7 +2627,7 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
 
   thisData=IFOdata;
     while (thisData) {
-      thisData->roq = XLALMalloc(sizeof(LALInferenceROQData));
+      thisData->roq = XLALCalloc(1, sizeof(LALInferenceROQData));
 
       thisData->roq->weights_linear = XLALMalloc(n_basis_linear*sizeof(LALInferenceROQSplineWeights));
 
@@ -2693,6 +2693,8 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
       thisData->roq->weightsFileLinear = NULL;
       fclose(tcFile);
 
+      LALInferenceSetupROQWeightGrid(thisData->roq, tmp_tcs, time_steps, n_basis_linear);
+
       sprintf(tmp, "--%s-roqweightsQuadratic", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
       thisData->roq->weightsQuadratic = (double*)malloc(n_basis_quadratic*sizeof(double));
@@ -2713,6 +2715,62 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
     }
 }
 
+void LALInferenceSetupROQWeightGrid(LALInferenceROQData *roq, const double *tcs, unsigned int time_steps, unsigned int n_basis_linear)
+{
+  roq->weightsLinearGrid = NULL;
+  roq->weightsLinearGridD2 = NULL;
+  roq->n_basis_linear = n_basis_linear;
+  if (time_steps < 3 || n_basis_linear == 0)
+    return;
+
+  const double step = (tcs[time_steps-1] - tcs[0]) / (time_steps - 1);
+  for (unsigned int k = 0; k < time_steps; k++)
+    if (!(step > 0) || fabs(tcs[k] - (tcs[0] + k*step)) > 1e-9*step) {
+      fprintf(stderr, "ROQ time shifts are not uniformly spaced, interpolating weights node by node\n");
+      return;
+    }
+
+  COMPLEX16 *y = XLALMalloc(time_steps*n_basis_linear*sizeof(COMPLEX16));
+  COMPLEX16 *M = XLALCalloc(time_steps*n_basis_linear, sizeof(COMPLEX16));
+  double *diag = XLALMalloc(time_steps*sizeof(double));
+  if (!y || !M || !diag) {
+    XLALFree(y);
+    XLALFree(M);
+    XLALFree(diag);
+    XLAL_ERROR_VOID(XLAL_ENOMEM);
+  }
+  for (unsigned int n = 0; n < n_basis_linear; n++)
+    for (unsigned int k = 0; k < time_steps; k++)
+      y[k*n_basis_linear + n] = roq->weightsLinear[n*time_steps + k];
+
+  /* With equal spacing h and M_0 = M_{N-1} = 0, the second derivatives
+   * satisfy M_{k-1} + 4 M_k + M_{k+1} = 6 (y_{k+1} - 2 y_k + y_{k-1}) / h^2,
+   * k = 1 ... N-2.  The system is the same for every node, so the Thomas
+   * algorithm sweeps all nodes together. */
+  const double scale = 6.0 / (step*step);
+  for (unsigned int k = 1; k + 1 < time_steps; k++) {
+    COMPLEX16 *Mk = &M[k*n_basis_linear];
+    const COMPLEX16 *Mprev = &M[(k-1)*n_basis_linear];
+    const COMPLEX16 *y0 = &y[(k-1)*n_basis_linear], *y1 = &y[k*n_basis_linear], *y2 = &y[(k+1)*n_basis_linear];
+    const double w = k > 1 ? 1.0 / diag[k-1] : 0.0;
+    diag[k] = 4.0 - w;
+    for (unsigned int n = 0; n < n_basis_linear; n++)
+      Mk[n] = scale*(y2[n] - 2.0*y1[n] + y0[n]) - w*Mprev[n];
+  }
+  for (unsigned int k = time_steps - 2; k >= 1; k--) {
+    COMPLEX16 *Mk = &M[k*n_basis_linear];
+    const COMPLEX16 *Mnext = &M[(k+1)*n_basis_linear];
+    for (unsigned int n = 0; n < n_basis_linear; n++)
+      Mk[n] = (Mk[n] - Mnext[n]) / diag[k];
+  }
+  XLALFree(diag);
+
+  roq->weightsLinearGrid = y;
+  roq->weightsLinearGridD2 = M;
+  roq->time_grid_start = tcs[0];
+  roq->time_grid_step = step;
+}
+
 static void LALInferenceSetGPSTrigtime(LIGOTimeGPS *GPStrig, ProcessParamsTable *commandLine){
 
     ProcessParamsTable *procparam;
@@ -56,6 +56,19 @@ void LALInferenceInjectInspiralSignal(struct tagLALInferenceIFOData *IFOdata, Pr
 void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *commandLine);
 void LALInferenceSetupROQmodel(LALInferenceModel *model, ProcessParamsTable *commandLine);
 
+/**
+ * \brief Stores the linear ROQ weights on a uniform grid of time shifts.
+ * If the time shifts \c tcs of the linear weights in \c roq->weightsLinear are
+ * uniformly spaced, stores the weights time-major in \c roq->weightsLinearGrid
+ * together with the second derivatives of the natural cubic splines through
+ * them (the same splines as the gsl_interp_cspline objects in
+ * \c roq->weights_linear), so that LALInferenceROQLinearInnerProduct() can
+ * interpolate all of the weights at one time shift in a single pass.
+ * Otherwise leaves \c roq->weightsLinearGrid NULL.
+ * Called by LALInferenceSetupROQdata().
+ */
+void LALInferenceSetupROQWeightGrid(LALInferenceROQData *roq, const double *tcs, unsigned int time_steps, unsigned int n_basis_linear);
+
 /**
  * \brief Fills the variable in vars with the injection values from theEventTable. Destroys contents of
  * vars. vars cannot be NULL. Resulting variables are LALINFERENCE_PARAM_FIXED.
@@ -39,6 +39,7 @@
 #include <lal/LIGOMetadataRingdownUtils.h>
 #include <lal/LALSimInspiral.h>
 #include <lal/LALInferenceTemplate.h>
+#include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceMultibanding.h>
 #include <lal/LALSimNeutronStar.h>
 
@@ -225,15 +226,18 @@ static void q2masses(double mc, double q, double *m1, double *m2)
   return;
 }
 
-void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
+/* Generate the polarisations for the parameters in model->params at each of
+   the nseq frequency sequences, with XLALSimInspiralChooseFDWaveformSequence.
+   The template functions that evaluate the waveform on sparse frequencies
+   share this. */
+static int FDWaveformSequences(LALInferenceModel *model, UINT4 nseq, REAL8Sequence **frequencies,
+                               COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde){
 /*************************************************************************************************************************/
   Approximant approximant = (Approximant) 0;
 
   int ret=0;
   INT4 errnum=0;
 
-  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
-  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
   REAL8 mc;
   REAL8 phi0, m1, m2, distance, inclination;
 
@@ -243,14 +247,14 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     approximant = *(Approximant*) LALInferenceGetVariable(model->params, "LAL_APPROXIMANT");
   else {
     XLALPrintError(" ERROR in templateLALGenerateInspiral(): (INT4) \"LAL_APPROXIMANT\" parameter not provided!\n");
-    XLAL_ERROR_VOID(XLAL_EDATA);
+    XLAL_ERROR(XLAL_EDATA);
   }
 
   if (LALInferenceCheckVariable(model->params, "LAL_PNORDER"))
     XLALSimInspiralWaveformParamsInsertPNPhaseOrder(model->LALpars, *(INT4 *) LALInferenceGetVariable(model->params, "LAL_PNORDER"));
   else {
     XLALPrintError(" ERROR in templateLALGenerateInspiral(): (INT4) \"LAL_PNORDER\" parameter not provided!\n");
-    XLAL_ERROR_VOID(XLAL_EDATA);
+    XLAL_ERROR(XLAL_EDATA);
   }
 
   /* Explicitly set the default amplitude order if one is not specified.
@@ -354,7 +358,7 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
       if (ret == XLAL_FAILURE)
       {
         XLALPrintError(" ERROR in XLALSimInspiralTransformPrecessingNewInitialConditions(): error converting angles. errnum=%d\n",errnum );
-        return;
+        return XLAL_FAILURE;
       }
   }
 /* ==== Spin induced quadrupole moment PARAMETERS ==== */ 
@@ -470,11 +474,40 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
   /* ==== Call the waveform generator ==== */
     /* Correct distance to account for renormalisation of data due to window RMS */
     double corrected_distance = distance * sqrt(model->window->sumofsquares/model->window->data->length);
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeLinear), &(model->roq->hctildeLinear), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesLinear)), errnum);
+    for(UINT4 n=0; n<nseq; n++)
+    {
+      hptilde[n]=NULL;
+      hctilde[n]=NULL;
+      XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(hptilde[n]), &(hctilde[n]), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
+                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, frequencies[n]), errnum);
+      if(ret!=XLAL_SUCCESS)
+      {
+        for(UINT4 k=0; k<=n; k++)
+        {
+          if ( hptilde[k] ) XLALDestroyCOMPLEX16FrequencySeries(hptilde[k]);
+          if ( hctilde[k] ) XLALDestroyCOMPLEX16FrequencySeries(hctilde[k]);
+          hptilde[k]=hctilde[k]=NULL;
+        }
+        errnum&=~XLAL_EFUNC; /* Mask out the internal function failure bit */
+        /* The waveform was called outside its domain: not an error */
+        if(errnum==XLAL_EDOM) XLAL_ERROR(XLAL_EUSR0);
+        XLAL_ERROR(errnum,"%s: Template generation failed in XLALSimInspiralChooseFDWaveformSequence",__func__);
+      }
+    }
 
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeQuadratic), &(model->roq->hctildeQuadratic), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-							spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesQuadratic)), errnum);
+    return XLAL_SUCCESS;
+}
+
+void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
+  REAL8Sequence *frequencies[2]={model->roq->frequencyNodesLinear, model->roq->frequencyNodesQuadratic};
+  COMPLEX16FrequencySeries *hptilde[2]={NULL,NULL}, *hctilde[2]={NULL,NULL};
+
+  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
+  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
+  if(FDWaveformSequences(model, 2, frequencies, hptilde, hctilde)!=XLAL_SUCCESS)
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+  model->roq->hptildeLinear=hptilde[0], model->roq->hctildeLinear=hctilde[0];
+  model->roq->hptildeQuadratic=hptilde[1], model->roq->hctildeQuadratic=hctilde[1];
 
     REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
     LALInferenceSetVariable(model->params, "time", &instant);
@@ -482,6 +515,21 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
         return;
 }
 
+void LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
+  if(!model->relbin || !model->relbin->frequencies)
+    XLAL_ERROR_VOID(XLAL_EFAULT, "Relative binning has not been set up");
+  REAL8Sequence *frequencies[1]={model->relbin->frequencies};
+
+  if ( model->relbin->hptilde ) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+  if ( model->relbin->hctilde ) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+  model->relbin->hptilde=model->relbin->hctilde=NULL;
+  if(FDWaveformSequences(model, 1, frequencies, &(model->relbin->hptilde), &(model->relbin->hctilde))!=XLAL_SUCCESS)
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+
+  REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
+  LALInferenceSetVariable(model->params, "time", &instant);
+}
+
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model)
 /*****************************************************/
 /* Sine-Gaussian (burst) template.                   */
@@ -2184,6 +2232,7 @@ void LALInferenceDumptemplateFreqDomain(LALInferenceVariables *currentParams,
   REAL8 deltaF = model->deltaF;
 
   LALInferenceCopyVariables(currentParams, model->params);
+  LALInferenceInvalidateTemplateCache(model);
   model->templt(model);
   if (model->domain == LAL_SIM_DOMAIN_TIME)
     LALInferenceExecuteFT(model);
@@ -2217,6 +2266,7 @@ void LALInferenceDumptemplateTimeDomain(LALInferenceVariables *currentParams,
   UINT4 i;
 
   LALInferenceCopyVariables(currentParams, model->params);
+  LALInferenceInvalidateTemplateCache(model);
   model->templt(model);
   if (model->domain == LAL_SIM_DOMAIN_FREQUENCY)
     LALInferenceExecuteInvFT(model);
@@ -123,6 +123,16 @@ void LALInferenceTemplateNullTimedomain(LALInferenceModel *model);
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model);
 
 void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
+
+/**
+ * Template for the relative binning likelihood.  Generates the polarisations
+ * only at the bin edges in \c model->relbin->frequencies, with
+ * XLALSimInspiralChooseFDWaveformSequence, and stores them in
+ * \c model->relbin->hptilde and \c model->relbin->hctilde.  The parameters
+ * are read from \c model->params as for the ROQ template.
+ */
+void LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
+
 /**
  * Damped Sinusoid template.
  *
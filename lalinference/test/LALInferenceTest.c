@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <complex.h>
 #include <lal/LALInference.h>
 #include <lal/Units.h>
 #include <lal/FrequencySeries.h>
@@ -37,6 +38,16 @@
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceTemplate.h>
 #include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceProposal.h>
+#include <lal/LALInferenceKDE.h>
+#include <lal/LALDetectors.h>
+#include <lal/DetResponse.h>
+#include <lal/TimeDelay.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spline.h>
 
 #include "LALInferenceTest.h"
 
@@ -59,6 +70,27 @@ int LALInferenceProcessParamLine_TEST_CHARFILE(void);
 /*  LALInferenceExecuteFT tests */
 int LALInferenceExecuteFTTEST_NULLPLAN(void);
 
+/*  LALInferenceSplineCalibrationBasis tests */
+int LALInferenceSplineCalibrationBasisTEST(void);
+
+/*  Differential evolution buffer tests */
+int LALInferenceDifferentialPointsMatrixTEST(void);
+
+/*  Autocorrelation length tests */
+int LALInferenceComputeMaxAutoCorrLenTEST(void);
+
+/*  Kernel density estimate tests */
+int LALInferenceKDEEvaluatePointTEST(void);
+
+/*  Likelihood template cache tests */
+int LALInferenceTemplateCacheTEST(void);
+
+/*  Relative binning likelihood tests */
+int LALInferenceRelativeBinningTEST(void);
+
+/*  ROQ linear weight interpolation tests */
+int LALInferenceROQWeightGridTEST(void);
+
 int main(void){
     
 	int failureCount = 0;
@@ -77,6 +109,20 @@ int main(void){
 	printf("\n");
 	failureCount += LALInferenceExecuteFTTEST_NULLPLAN();
 	printf("\n");
+	failureCount += LALInferenceSplineCalibrationBasisTEST();
+	printf("\n");
+	failureCount += LALInferenceDifferentialPointsMatrixTEST();
+	printf("\n");
+	failureCount += LALInferenceComputeMaxAutoCorrLenTEST();
+	printf("\n");
+	failureCount += LALInferenceKDEEvaluatePointTEST();
+	printf("\n");
+	failureCount += LALInferenceTemplateCacheTEST();
+	printf("\n");
+	failureCount += LALInferenceRelativeBinningTEST();
+	printf("\n");
+	failureCount += LALInferenceROQWeightGridTEST();
+	printf("\n");
 	printf("Test results: %i failure(s).\n", failureCount);
 
 	return failureCount;
@@ -357,6 +403,669 @@ int LALInferenceExecuteFTTEST_NULLPLAN(void){
 }
 
 
+/*****************     TEST CODE for LALInferenceSplineCalibrationBasis     *****************/
+/* Test that the precomputed spline calibration basis reproduces
+   LALInferenceSplineCalibrationFactor() on a frequency grid and on a set of
+   nodes, and that it is reused only for the same spline nodes. Expect pass. */
+
+int LALInferenceSplineCalibrationBasisTEST(void){
+
+    TEST_HEADER();
+
+    const UINT4 nnodes = 10, length = 8193;
+    const REAL8 deltaF = 0.125;
+    LIGOTimeGPS epoch = {0, 0};
+    UINT4 i;
+
+    REAL8Vector *logfreqs = XLALCreateREAL8Vector(nnodes);
+    REAL8Vector *amps = XLALCreateREAL8Vector(nnodes);
+    REAL8Vector *phases = XLALCreateREAL8Vector(nnodes);
+    for (i = 0; i < nnodes; i++) {
+        logfreqs->data[i] = log(20.0) + i * (log(1000.0) - log(20.0)) / (nnodes - 1);
+        amps->data[i] = 0.1 * sin(1.3 * i);
+        phases->data[i] = 0.05 * cos(0.7 * i);
+    }
+
+    COMPLEX16FrequencySeries *calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors", &epoch, 0.0, deltaF, &lalDimensionlessUnit, length);
+    COMPLEX16 *basisFactor = XLALMalloc(length * sizeof(COMPLEX16));
+    LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+
+    LALInferenceSplineCalibrationBasis *basis = LALInferenceCreateSplineCalibrationBasis(logfreqs, deltaF, length);
+    if (basis == NULL || LALInferenceSplineCalibrationFactorFromBasis(basis, amps, phases, basisFactor) != XLAL_SUCCESS) {
+        TEST_FAIL("Could not evaluate spline calibration basis.");
+    } else {
+        for (i = 0; i < length; i++)
+            if (cabs(calFactor->data->data[i] - basisFactor[i]) > 1e-12) {
+                TEST_FAIL("Calibration factor differs at bin %u.", i);
+                break;
+            }
+    }
+
+    if (!LALInferenceSplineCalibrationBasisMatches(basis, logfreqs, length))
+        TEST_FAIL("Basis does not match its own nodes.");
+    logfreqs->data[3] += 1e-3;
+    if (LALInferenceSplineCalibrationBasisMatches(basis, logfreqs, length))
+        TEST_FAIL("Basis matches different nodes.");
+    logfreqs->data[3] -= 1e-3;
+    LALInferenceDestroySplineCalibrationBasis(basis);
+
+    /* Frequencies given explicitly, e.g. ROQ nodes */
+    REAL8Sequence *freqNodes = XLALCreateREAL8Sequence(5);
+    COMPLEX16Sequence *calFactorNodes = XLALCreateCOMPLEX16Sequence(5);
+    COMPLEX16Sequence *calFactorQuad = XLALCreateCOMPLEX16Sequence(5);
+    freqNodes->data[0] = 10.0;
+    freqNodes->data[1] = 20.0;
+    freqNodes->data[2] = 101.3;
+    freqNodes->data[3] = 999.9;
+    freqNodes->data[4] = 55.5;
+    LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases, freqNodes, &calFactorNodes, freqNodes, &calFactorQuad);
+    basis = LALInferenceCreateSplineCalibrationBasisNodes(logfreqs, freqNodes);
+    if (basis == NULL || LALInferenceSplineCalibrationFactorFromBasis(basis, amps, phases, basisFactor) != XLAL_SUCCESS) {
+        TEST_FAIL("Could not evaluate spline calibration basis on nodes.");
+    } else {
+        for (i = 0; i < freqNodes->length; i++)
+            if (cabs(calFactorNodes->data[i] - basisFactor[i]) > 1e-12)
+                TEST_FAIL("Calibration factor differs at node %u.", i);
+    }
+    LALInferenceDestroySplineCalibrationBasis(basis);
+
+    XLALDestroyCOMPLEX16Sequence(calFactorQuad);
+    XLALDestroyCOMPLEX16Sequence(calFactorNodes);
+    XLALDestroyREAL8Sequence(freqNodes);
+    XLALFree(basisFactor);
+    XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+    XLALDestroyREAL8Vector(phases);
+    XLALDestroyREAL8Vector(amps);
+    XLALDestroyREAL8Vector(logfreqs);
+
+    TEST_FOOTER();
+
+}
+
+int LALInferenceDifferentialPointsMatrixTEST(void){
+
+    TEST_HEADER();
+
+    const UINT4 npoints = 5;
+    UINT4 i;
+    INT4 n = 3;
+    LALInferenceThreadState *thread = LALInferenceInitThread(NULL);
+    LALInferenceVariables params;
+
+    memset(&params, 0, sizeof(params));
+    LALInferenceAddREAL8Variable(&params, "b", 0.0, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "a", 0.0, LALINFERENCE_PARAM_CIRCULAR);
+    LALInferenceAddREAL8Variable(&params, "fixed", 7.0, LALINFERENCE_PARAM_FIXED);
+    LALInferenceAddINT4Variable(&params, "n", n, LALINFERENCE_PARAM_FIXED);
+
+    /* Points already in the buffer, as if read from a checkpoint */
+    thread->differentialPoints = XLALRealloc(thread->differentialPoints, npoints * sizeof(LALInferenceVariables *));
+    for (i = 0; i < npoints; i++) {
+        thread->differentialPoints[i] = XLALCalloc(1, sizeof(LALInferenceVariables));
+        LALInferenceCopyVariables(&params, thread->differentialPoints[i]);
+        LALInferenceSetREAL8Variable(thread->differentialPoints[i], "a", i);
+        LALInferenceSetREAL8Variable(thread->differentialPoints[i], "b", -2.0 * i);
+    }
+    thread->differentialPointsLength = thread->differentialPointsSize = npoints;
+
+    if (LALInferenceSetupDifferentialPointsMatrix(thread, &params) != XLAL_SUCCESS)
+        TEST_FAIL("Could not set up differential points matrix.");
+    if (thread->differentialPoints != NULL || thread->differentialPointsLength != npoints)
+        TEST_FAIL("Points were not moved into the matrix.");
+    if (thread->differentialPointsDim != 2)
+        TEST_FAIL("Matrix has %zu columns, expected 2.", thread->differentialPointsDim);
+
+    INT4 a = LALInferenceDifferentialPointsColumn(thread, "a");
+    INT4 b = LALInferenceDifferentialPointsColumn(thread, "b");
+    if (a < 0 || b < 0 || a == b || LALInferenceDifferentialPointsColumn(thread, "fixed") != -1 || LALInferenceDifferentialPointsColumn(thread, "n") != -1) {
+        TEST_FAIL("Wrong columns in differential points matrix.");
+    } else if (strcmp(thread->differentialPointsNames[a], "a") || strcmp(thread->differentialPointsNames[b], "b")) {
+        TEST_FAIL("Column map does not match the column names.");
+    } else {
+        for (i = 0; i < npoints; i++)
+            if (thread->differentialPointsMatrix[i * 2 + a] != i || thread->differentialPointsMatrix[i * 2 + b] != -2.0 * i)
+                TEST_FAIL("Wrong values in row %u of differential points matrix.", i);
+
+        LALInferenceCopyDifferentialPointToVariables(thread, 3, &params);
+        if (LALInferenceGetREAL8Variable(&params, "a") != 3.0 || LALInferenceGetREAL8Variable(&params, "b") != -6.0 || LALInferenceGetREAL8Variable(&params, "fixed") != 7.0)
+            TEST_FAIL("Could not copy row of differential points matrix to variables.");
+
+        LALInferenceSetREAL8Variable(&params, "a", 10.0);
+        LALInferenceCopyVariablesToDifferentialPoint(thread, &params, 1);
+        if (thread->differentialPointsMatrix[2 + a] != 10.0 || thread->differentialPointsMatrix[2 + b] != -6.0)
+            TEST_FAIL("Could not copy variables to row of differential points matrix.");
+    }
+
+    LALInferenceDestroyDifferentialPointsMatrix(thread);
+    if (thread->differentialPointsMatrix != NULL || thread->differentialPointsNames != NULL || thread->differentialPointsColumns != NULL)
+        TEST_FAIL("Differential points matrix was not freed.");
+
+    LALInferenceClearVariables(&params);
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for LALInferenceComputeMaxAutoCorrLen     *****************/
+
+/* The FFT estimate must agree with the ACF summed directly lag by lag. */
+int LALInferenceComputeMaxAutoCorrLenTEST(void){
+    TEST_HEADER();
+
+    const INT4 nPoints = 4000, nPar = 2, M = 5;
+    REAL8 *array = XLALCalloc(nPoints * nPar, sizeof(REAL8));
+    REAL8 *copy = XLALCalloc(nPoints * nPar, sizeof(REAL8));
+    REAL8 acl, expected = 0.0, mean, C0, Ck, cumACF;
+    REAL8 x = 0.0;
+    INT4 i, k, par;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 1234);
+
+    /* An AR(1) series with ACL (1 + 0.8) / (1 - 0.8) = 9 and white noise */
+    for (i=0; i<nPoints; i++) {
+        x = 0.8*x + gsl_ran_ugaussian(rng);
+        array[i*nPar] = x;
+        array[i*nPar + 1] = 5.0 + gsl_ran_ugaussian(rng);
+    }
+    memcpy(copy, array, nPoints * nPar * sizeof(REAL8));
+
+    for (par=0; par<nPar; par++) {
+        mean = 0.0;
+        for (i=0; i<nPoints; i++)
+            mean += array[i*nPar + par];
+        mean /= nPoints;
+        C0 = 0.0;
+        for (i=0; i<nPoints; i++)
+            C0 += (array[i*nPar + par] - mean) * (array[i*nPar + par] - mean);
+        cumACF = 1.0;
+        for (k=1; cumACF >= (REAL8)k/M; k++) {
+            Ck = 0.0;
+            for (i=0; i<nPoints-k; i++)
+                Ck += (array[i*nPar + par] - mean) * (array[(i+k)*nPar + par] - mean);
+            cumACF += 2.0 * Ck / C0;
+        }
+        if (cumACF > expected)
+            expected = cumACF;
+    }
+
+    acl = LALInferenceComputeMaxAutoCorrLen(array, nPoints, nPar);
+    if (fabs(acl - expected) > 1e-8 * expected)
+        TEST_FAIL("ACL %g differs from the direct estimate %g.", acl, expected);
+    if (acl < 5.0 || acl > 15.0)
+        TEST_FAIL("ACL %g is far from the expected value of 9.", acl);
+    if (memcmp(copy, array, nPoints * nPar * sizeof(REAL8)))
+        TEST_FAIL("Sample array was modified.");
+
+    /* A constant parameter has no defined ACL */
+    for (i=0; i<nPoints; i++)
+        array[i*nPar + 1] = 1.0;
+    acl = LALInferenceComputeMaxAutoCorrLen(array, nPoints, nPar);
+    if (acl != INFINITY)
+        TEST_FAIL("ACL of a constant series is %g, not infinity.", acl);
+
+    gsl_rng_free(rng);
+    XLALFree(array);
+    XLALFree(copy);
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for LALInferenceKDEEvaluatePoint     *****************/
+
+/* The tree-summed PDF must agree with a direct sum over all the kernels to
+ * within the tolerance, and the batch evaluation with single evaluations. */
+int LALInferenceKDEEvaluatePointTEST(void){
+    TEST_HEADER();
+
+    const INT4 npts = 5000, dim = 3, nquery = 50;
+    REAL8 *pts = XLALCalloc(npts * dim, sizeof(REAL8));
+    REAL8 *query = XLALCalloc(nquery * dim, sizeof(REAL8));
+    REAL8 *batch = XLALCalloc(nquery, sizeof(REAL8));
+    REAL8 *energies = XLALCalloc(npts, sizeof(REAL8));
+    gsl_vector *diff = gsl_vector_alloc(dim);
+    gsl_vector *tdiff = gsl_vector_alloc(dim);
+    INT4 i, j, p;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 4321);
+
+    /* Two correlated clusters */
+    for (i=0; i<npts; i++) {
+        REAL8 a = gsl_ran_ugaussian(rng);
+        for (p=0; p<dim; p++)
+            pts[i*dim + p] = a + 0.3*gsl_ran_ugaussian(rng) + (i%2 ? 5.0 : 0.0);
+    }
+    for (i=0; i<nquery*dim; i++)
+        query[i] = 3.0*gsl_ran_ugaussian(rng);
+
+    LALInferenceKDE *kde = LALInferenceNewKDE(pts, npts, dim, NULL);
+    LALInferenceKDEEvaluatePoints(kde, query, nquery, batch);
+
+    for (j=0; j<nquery; j++) {
+        REAL8 *x = query + j*dim;
+        REAL8 direct, tree = LALInferenceKDEEvaluatePoint(kde, x);
+
+        for (i=0; i<npts; i++) {
+            for (p=0; p<dim; p++)
+                gsl_vector_set(diff, p, pts[i*dim + p] - x[p]);
+            gsl_linalg_cholesky_solve(kde->cholesky_decomp_cov, diff, tdiff);
+            gsl_blas_ddot(diff, tdiff, &energies[i]);
+            energies[i] *= -0.5;
+        }
+        direct = log_add_exps(energies, npts) - kde->log_norm_factor;
+
+        if (fabs(tree - direct) > 2.0*kde->tolerance)
+            TEST_FAIL("KDE at query point %i is %g, direct sum gives %g.", j, tree, direct);
+        if (batch[j] != tree)
+            TEST_FAIL("Batch KDE at query point %i is %g, single evaluation gives %g.", j, batch[j], tree);
+    }
+
+    LALInferenceDestroyKDE(kde);
+    gsl_vector_free(diff);
+    gsl_vector_free(tdiff);
+    gsl_rng_free(rng);
+    XLALFree(pts);
+    XLALFree(query);
+    XLALFree(batch);
+    XLALFree(energies);
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for the likelihood template cache     *****************/
+
+static INT4 templateCacheTestCalls = 0;
+
+/* Polarisations whose shape is set by "x", placed at "time" and scaled to
+ * "logdistance" in the same way as the CBC templates. */
+static void templateCacheTestPolarisations(REAL8 x, REAL8 f, COMPLEX16 *hp, COMPLEX16 *hc)
+{
+    *hp = sin(x*f) + I*cos(0.5*x*f);
+    *hc = I*(cos(x*f) + 0.3*sin(x*f));
+}
+
+static void templateCacheTestTemplate(LALInferenceModel *model)
+{
+    REAL8 x = LALInferenceGetREAL8Variable(model->params, "x");
+    REAL8 dist = exp(LALInferenceGetREAL8Variable(model->params, "logdistance"));
+    REAL8 tc = LALInferenceGetREAL8Variable(model->params, "time") - XLALGPSGetREAL8(&model->freqhPlus->epoch);
+    UINT4 k;
+
+    for (k=0; k<model->freqhPlus->data->length; k++) {
+        REAL8 f = k*model->freqhPlus->deltaF;
+        COMPLEX16 hp, hc, shift = cexp(-I*LAL_TWOPI*f*tc)/dist;
+        templateCacheTestPolarisations(x, f, &hp, &hc);
+        model->freqhPlus->data->data[k] = shift*hp;
+        model->freqhCross->data->data[k] = shift*hc;
+    }
+    templateCacheTestCalls++;
+}
+
+/* Response of the detector to the polarisations for params, in the bins of
+ * the band (zero outside it). */
+static void templateCacheTestResponse(LALInferenceIFOData *data, LALInferenceVariables *params,
+                                      void (*polarisations)(REAL8, REAL8, COMPLEX16 *, COMPLEX16 *), COMPLEX16 *h)
+{
+    REAL8 ra = LALInferenceGetREAL8Variable(params, "rightascension");
+    REAL8 dec = LALInferenceGetREAL8Variable(params, "declination");
+    REAL8 psi = LALInferenceGetREAL8Variable(params, "polarisation");
+    REAL8 t = LALInferenceGetREAL8Variable(params, "time");
+    REAL8 x = LALInferenceGetREAL8Variable(params, "x");
+    REAL8 dist = exp(LALInferenceGetREAL8Variable(params, "logdistance"));
+    REAL8 deltaF = data->freqData->deltaF;
+    REAL8 fplus, fcross, tc;
+    LIGOTimeGPS gps;
+    UINT4 k;
+
+    XLALGPSSetREAL8(&gps, t);
+    XLALComputeDetAMResponse(&fplus, &fcross, (const REAL4(*)[3])data->detector->response, ra, dec, psi, XLALGreenwichMeanSiderealTime(&gps));
+    tc = t + XLALTimeDelayFromEarthCenter(data->detector->location, ra, dec, &gps) - XLALGPSGetREAL8(&data->freqData->epoch);
+    for (k=0; k<data->freqData->data->length; k++) {
+        REAL8 f = k*deltaF;
+        COMPLEX16 hp, hc;
+        h[k] = 0.0;
+        if (k < (UINT4)ceil(data->fLow/deltaF) || k > (UINT4)floor(data->fHigh/deltaF))
+            continue;
+        polarisations(x, f, &hp, &hc);
+        h[k] = (fplus*hp + fcross*hc)*cexp(-I*LAL_TWOPI*f*tc)/dist;
+    }
+}
+
+/* The Gaussian log likelihood of params, summed directly over the bins. */
+static REAL8 templateCacheTestLogL(LALInferenceIFOData *data, LALInferenceVariables *params,
+                                   void (*polarisations)(REAL8, REAL8, COMPLEX16 *, COMPLEX16 *))
+{
+    REAL8 deltaT = data->timeData->deltaT;
+    REAL8 deltaF = data->freqData->deltaF;
+    REAL8 logL = 0.0;
+    COMPLEX16 h[data->freqData->data->length];
+    UINT4 k;
+
+    templateCacheTestResponse(data, params, polarisations, h);
+    for (k=(UINT4)ceil(data->fLow/deltaF); k<=(UINT4)floor(data->fHigh/deltaF); k++) {
+        COMPLEX16 diff = data->freqData->data->data[k] - h[k];
+        logL -= 2.0*deltaT/data->timeData->data->length * creal(diff*conj(diff))
+                / (data->oneSidedNoisePowerSpectrum->data->data[k]*deltaT*deltaT);
+    }
+    return logL;
+}
+
+/* Checks that proposals which move only the extrinsic parameters reuse the
+ * template, and that the likelihood agrees with a direct sum either way.
+ * The band spans more than one of the blocks in which the likelihood sums
+ * the frequency bins. */
+int LALInferenceTemplateCacheTEST(void){
+    TEST_HEADER();
+
+    const UINT4 N = 16384;
+    const REAL8 deltaT = 1.0/256.0, deltaF = 1.0/(N*deltaT), t0 = 1000000000.5;
+    LIGOTimeGPS epoch = {1000000000, 0};
+    LALDetector detector = lalCachedDetectors[LAL_LHO_4K_DETECTOR];
+    LALInferenceVariables params;
+    UINT4 k, m;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 1234);
+
+    LALInferenceIFOData *data = XLALCalloc(1, sizeof(*data));
+    strcpy(data->name, "H1");
+    data->detector = &detector;
+    data->fLow = 20.0;
+    data->fHigh = 100.0;
+    data->timeData = XLALCreateREAL8TimeSeries("time", &epoch, 0.0, deltaT, &lalDimensionlessUnit, N);
+    data->freqData = XLALCreateCOMPLEX16FrequencySeries("freq", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+    data->oneSidedNoisePowerSpectrum = XLALCreateREAL8FrequencySeries("psd", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+    for (k=0; k<=N/2; k++) {
+        data->freqData->data->data[k] = gsl_ran_ugaussian(rng) + I*gsl_ran_ugaussian(rng);
+        data->oneSidedNoisePowerSpectrum->data->data[k] = 1.0 + 0.001*k;
+    }
+
+    LALInferenceModel *model = XLALCalloc(1, sizeof(*model));
+    model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
+    model->templt = templateCacheTestTemplate;
+    model->domain = LAL_SIM_DOMAIN_FREQUENCY;
+    model->freqhPlus = XLALCreateCOMPLEX16FrequencySeries("hplus", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+    model->freqhCross = XLALCreateCOMPLEX16FrequencySeries("hcross", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+    model->ifo_loglikelihoods = XLALCalloc(1, sizeof(REAL8));
+    model->ifo_SNRs = XLALCalloc(1, sizeof(REAL8));
+
+    memset(&params, 0, sizeof(params));
+    LALInferenceAddREAL8Variable(&params, "rightascension", 0.5, LALINFERENCE_PARAM_CIRCULAR);
+    LALInferenceAddREAL8Variable(&params, "declination", 0.3, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "polarisation", 1.0, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "time", t0, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "logdistance", log(100.0), LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "x", 0.02, LALINFERENCE_PARAM_LINEAR);
+
+    /* Each move is followed by the number of template calls expected so far */
+    const struct { const char *name; REAL8 value; INT4 calls; } moves[] = {
+        {NULL, 0.0, 1},
+        {"rightascension", 1.3, 1},
+        {"polarisation", 0.2, 1},
+        {"time", t0 + 0.01, 1},
+        {"logdistance", log(0.02), 1},
+        {"x", 0.021, 2},
+        {"declination", -0.4, 2},
+        {"logdistance", log(0.05), 2}
+    };
+
+    for (m=0; m<sizeof(moves)/sizeof(moves[0]); m++) {
+        if (moves[m].name)
+            LALInferenceSetREAL8Variable(&params, moves[m].name, moves[m].value);
+        REAL8 logL = LALInferenceUndecomposedFreqDomainLogLikelihood(&params, data, model);
+        REAL8 direct = templateCacheTestLogL(data, &params, templateCacheTestPolarisations);
+        if (fabs(logL - direct) > 1e-9*fabs(direct))
+            TEST_FAIL("Log likelihood after move %u is %.12g, direct sum gives %.12g.", m, logL, direct);
+        if (templateCacheTestCalls != moves[m].calls)
+            TEST_FAIL("Template called %i times after move %u, expected %i.", templateCacheTestCalls, m, moves[m].calls);
+    }
+
+    LALInferenceClearVariables(&params);
+    LALInferenceClearVariables(model->params);
+    XLALFree(model->params);
+    XLALDestroyCOMPLEX16FrequencySeries(model->freqhPlus);
+    XLALDestroyCOMPLEX16FrequencySeries(model->freqhCross);
+    XLALFree(model->ifo_loglikelihoods);
+    XLALFree(model->ifo_SNRs);
+    XLALFree(model);
+    XLALDestroyREAL8TimeSeries(data->timeData);
+    XLALDestroyCOMPLEX16FrequencySeries(data->freqData);
+    XLALDestroyREAL8FrequencySeries(data->oneSidedNoisePowerSpectrum);
+    XLALFree(data);
+    gsl_rng_free(rng);
+
+    TEST_FOOTER();
+
+}
+
+
+/* A chirp whose phase evolution is set by "x", for the relative binning test */
+static void relativeBinningTestPolarisations(REAL8 x, REAL8 f, COMPLEX16 *hp, COMPLEX16 *hc)
+{
+    *hp = 30.0*pow(f/20.0, -7.0/6.0)*cexp(-I*x*pow(f/20.0, -5.0/3.0));
+    *hc = -0.6*I*(*hp);
+}
+
+/* Fills model->relbin with the chirp at the bin edges, in the same way as
+ * templateCacheTestTemplate fills the frequency-domain buffers. */
+static void relativeBinningTestTemplate(LALInferenceModel *model)
+{
+    REAL8 x = LALInferenceGetREAL8Variable(model->params, "x");
+    REAL8 dist = exp(LALInferenceGetREAL8Variable(model->params, "logdistance"));
+    REAL8 tc = LALInferenceGetREAL8Variable(model->params, "time") - XLALGPSGetREAL8(&model->freqhPlus->epoch);
+    REAL8Sequence *frequencies = model->relbin->frequencies;
+    UINT4 k;
+
+    if (model->relbin->hptilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+    if (model->relbin->hctilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+    model->relbin->hptilde = XLALCreateCOMPLEX16FrequencySeries("hplus", &model->freqhPlus->epoch, 0.0, 0.0, &lalDimensionlessUnit, frequencies->length);
+    model->relbin->hctilde = XLALCreateCOMPLEX16FrequencySeries("hcross", &model->freqhPlus->epoch, 0.0, 0.0, &lalDimensionlessUnit, frequencies->length);
+    for (k=0; k<frequencies->length; k++) {
+        REAL8 f = frequencies->data[k];
+        COMPLEX16 hp, hc, shift = cexp(-I*LAL_TWOPI*f*tc)/dist;
+        relativeBinningTestPolarisations(x, f, &hp, &hc);
+        model->relbin->hptilde->data->data[k] = shift*hp;
+        model->relbin->hctilde->data->data[k] = shift*hc;
+    }
+}
+
+/* Checks that the relative binning likelihood, with a few hundred bins,
+ * agrees with the direct sum over the bins near the fiducial waveform. */
+int LALInferenceRelativeBinningTEST(void){
+    TEST_HEADER();
+
+    const UINT4 N = 8192;
+    const REAL8 deltaT = 1.0/1024.0, deltaF = 1.0/(N*deltaT), t0 = 1000000004.0;
+    LIGOTimeGPS epoch = {1000000000, 0};
+    LALDetector detector = lalCachedDetectors[LAL_LHO_4K_DETECTOR];
+    LALInferenceVariables params;
+    COMPLEX16 h[N/2+1];
+    UINT4 k, m;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 1234);
+
+    LALInferenceIFOData *data = XLALCalloc(1, sizeof(*data));
+    strcpy(data->name, "H1");
+    data->detector = &detector;
+    data->fLow = 20.0;
+    data->fHigh = 400.0;
+    data->timeData = XLALCreateREAL8TimeSeries("time", &epoch, 0.0, deltaT, &lalDimensionlessUnit, N);
+    data->freqData = XLALCreateCOMPLEX16FrequencySeries("freq", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+    data->oneSidedNoisePowerSpectrum = XLALCreateREAL8FrequencySeries("psd", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+
+    memset(&params, 0, sizeof(params));
+    LALInferenceAddREAL8Variable(&params, "rightascension", 0.5, LALINFERENCE_PARAM_CIRCULAR);
+    LALInferenceAddREAL8Variable(&params, "declination", 0.3, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "polarisation", 1.0, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "time", t0, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "logdistance", log(10.0), LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&params, "x", 100.0, LALINFERENCE_PARAM_LINEAR);
+
+    /* Noise plus the signal, which is also the fiducial waveform */
+    templateCacheTestResponse(data, &params, relativeBinningTestPolarisations, h);
+    for (k=0; k<=N/2; k++) {
+        REAL8 psd = 1.0 + 0.001*k;
+        REAL8 sigma = sqrt(psd/(8.0*deltaF));
+        data->oneSidedNoisePowerSpectrum->data->data[k] = psd;
+        data->freqData->data->data[k] = h[k] + gsl_ran_gaussian(rng, sigma) + I*gsl_ran_gaussian(rng, sigma);
+    }
+
+    LALInferenceModel *model = XLALCalloc(1, sizeof(*model));
+    model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
+    model->templt = relativeBinningTestTemplate;
+    model->domain = LAL_SIM_DOMAIN_FREQUENCY;
+    model->freqhPlus = XLALCreateCOMPLEX16FrequencySeries("hplus", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+    model->freqhCross = XLALCreateCOMPLEX16FrequencySeries("hcross", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2+1);
+    model->ifo_loglikelihoods = XLALCalloc(1, sizeof(REAL8));
+    model->ifo_SNRs = XLALCalloc(1, sizeof(REAL8));
+
+    if (LALInferenceSetupRelativeBinning(data, model, &params, 0.1) != XLAL_SUCCESS)
+        TEST_FAIL("Could not set up relative binning; XLAL error: %s.", XLALErrorString(xlalErrno));
+    if (data->relbin->nbins < 100 || data->relbin->nbins > 1000)
+        TEST_FAIL("Relative binning chose %u bins, expected a few hundred.", data->relbin->nbins);
+
+    const struct { const char *name; REAL8 value; } moves[] = {
+        {NULL, 0.0},
+        {"x", 100.05},
+        {"time", t0 + 0.0015},
+        {"logdistance", log(12.0)},
+        {"rightascension", 0.7},
+        {"polarisation", 0.6},
+        {"x", 99.9}
+    };
+
+    for (m=0; m<sizeof(moves)/sizeof(moves[0]); m++) {
+        if (moves[m].name)
+            LALInferenceSetREAL8Variable(&params, moves[m].name, moves[m].value);
+        REAL8 logL = LALInferenceUndecomposedFreqDomainLogLikelihood(&params, data, model);
+        REAL8 direct = templateCacheTestLogL(data, &params, relativeBinningTestPolarisations);
+        if (fabs(logL - direct) > 1e-2)
+            TEST_FAIL("Relative binning log likelihood after move %u is %.6f, direct sum gives %.6f.", m, logL, direct);
+    }
+
+    LALInferenceClearVariables(&params);
+    LALInferenceClearVariables(model->params);
+    XLALFree(model->params);
+    XLALDestroyREAL8Sequence(model->relbin->frequencies);
+    XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+    XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+    XLALFree(model->relbin);
+    XLALDestroyCOMPLEX16FrequencySeries(model->freqhPlus);
+    XLALDestroyCOMPLEX16FrequencySeries(model->freqhCross);
+    XLALFree(model->ifo_loglikelihoods);
+    XLALFree(model->ifo_SNRs);
+    XLALFree(model);
+    XLALFree(data->relbin->A0);
+    XLALFree(data->relbin->A1);
+    XLALFree(data->relbin->B0);
+    XLALFree(data->relbin->B1);
+    XLALFree(data->relbin->h0);
+    XLALFree(data->relbin);
+    XLALDestroyREAL8TimeSeries(data->timeData);
+    XLALDestroyCOMPLEX16FrequencySeries(data->freqData);
+    XLALDestroyREAL8FrequencySeries(data->oneSidedNoisePowerSpectrum);
+    XLALFree(data);
+    gsl_rng_free(rng);
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for the ROQ linear weight interpolation     *****************/
+
+/* Checks that the linear ROQ inner product computed from the weights on a
+ * uniform time grid agrees with the one from the gsl splines of each node,
+ * at time shifts on and between the grid points, with and without a
+ * calibration factor, and that non-uniform time shifts are not gridded. */
+int LALInferenceROQWeightGridTEST(void){
+    TEST_HEADER();
+
+    const UINT4 nodes = 7, steps = 41;
+    const REAL8 t_start = -0.1, t_step = 0.005;
+    const REAL8 fplus = 0.6, fcross = -0.35;
+    REAL8 tcs[steps], re[steps], im[steps];
+    COMPLEX16 hplus[nodes], hcross[nodes], cal[nodes];
+    UINT4 n, k, m;
+
+    LALInferenceROQData *roq = XLALCalloc(1, sizeof(*roq));
+    roq->n_time_steps = steps;
+    roq->weightsLinear = XLALMalloc(nodes*steps*sizeof(COMPLEX16));
+    roq->weights_linear = XLALMalloc(nodes*sizeof(LALInferenceROQSplineWeights));
+    for (k=0; k<steps; k++)
+        tcs[k] = t_start + k*t_step;
+    for (n=0; n<nodes; n++) {
+        /* weights oscillating at the node frequency, as they do in practice */
+        REAL8 f = 20.0 + 12.5*n;
+        for (k=0; k<steps; k++) {
+            roq->weightsLinear[n*steps + k] = (1.0 + 0.1*n)*cexp(-I*LAL_TWOPI*f*tcs[k]);
+            re[k] = creal(roq->weightsLinear[n*steps + k]);
+            im[k] = cimag(roq->weightsLinear[n*steps + k]);
+        }
+        roq->weights_linear[n].acc_real_weight_linear = NULL;
+        roq->weights_linear[n].acc_imag_weight_linear = NULL;
+        roq->weights_linear[n].spline_real_weight_linear = gsl_spline_alloc(gsl_interp_cspline, steps);
+        roq->weights_linear[n].spline_imag_weight_linear = gsl_spline_alloc(gsl_interp_cspline, steps);
+        gsl_spline_init(roq->weights_linear[n].spline_real_weight_linear, tcs, re, steps);
+        gsl_spline_init(roq->weights_linear[n].spline_imag_weight_linear, tcs, im, steps);
+        hplus[n] = cos(0.7*n) + I*sin(1.1*n);
+        hcross[n] = 0.5*I*hplus[n] + 0.2;
+        cal[n] = 1.0 + 0.05*n - 0.02*I*n;
+    }
+
+    LALInferenceSetupROQWeightGrid(roq, tcs, steps, nodes);
+    if (!roq->weightsLinearGrid || !roq->weightsLinearGridD2) {
+        TEST_FAIL("Uniformly spaced time shifts were not gridded.");
+    } else {
+        /* the first and last points, and points in the first, last and
+           some interior intervals */
+        const REAL8 offsets[] = {0.0, 0.37, 1.5, 7.01, 19.5, 20.0, 33.99, 39.25, 39.999, 40.0};
+        COMPLEX16 *grid = roq->weightsLinearGrid;
+
+        for (m=0; m<sizeof(offsets)/sizeof(offsets[0]); m++) {
+            REAL8 t = t_start + offsets[m]*t_step;
+            COMPLEX16 dh[2], dh_spline[2];
+            dh[0] = LALInferenceROQLinearInnerProduct(roq, nodes, t, NULL, hplus, hcross, fplus, fcross);
+            dh[1] = LALInferenceROQLinearInnerProduct(roq, nodes, t, cal, hplus, hcross, fplus, fcross);
+            roq->weightsLinearGrid = NULL;
+            dh_spline[0] = LALInferenceROQLinearInnerProduct(roq, nodes, t, NULL, hplus, hcross, fplus, fcross);
+            dh_spline[1] = LALInferenceROQLinearInnerProduct(roq, nodes, t, cal, hplus, hcross, fplus, fcross);
+            roq->weightsLinearGrid = grid;
+            for (k=0; k<2; k++)
+                if (cabs(dh[k] - dh_spline[k]) > 1e-10*cabs(dh_spline[k]))
+                    TEST_FAIL("Gridded inner product %s calibration at t = %g is %.15g%+.15gi, splines give %.15g%+.15gi.",
+                              k ? "with" : "without", t, creal(dh[k]), cimag(dh[k]), creal(dh_spline[k]), cimag(dh_spline[k]));
+        }
+    }
+
+    /* a single displaced time shift makes the grid non-uniform */
+    LALInferenceROQData *roq2 = XLALCalloc(1, sizeof(*roq2));
+    roq2->n_time_steps = steps;
+    roq2->weightsLinear = roq->weightsLinear;
+    tcs[steps/2] += 0.1*t_step;
+    LALInferenceSetupROQWeightGrid(roq2, tcs, steps, nodes);
+    if (roq2->weightsLinearGrid || roq2->weightsLinearGridD2)
+        TEST_FAIL("Non-uniformly spaced time shifts were gridded.");
+    XLALFree(roq2);
+
+    for (n=0; n<nodes; n++) {
+        gsl_spline_free(roq->weights_linear[n].spline_real_weight_linear);
+        gsl_spline_free(roq->weights_linear[n].spline_imag_weight_linear);
+    }
+    XLALFree(roq->weights_linear);
+    XLALFree(roq->weightsLinear);
+    XLALFree(roq->weightsLinearGrid);
+    XLALFree(roq->weightsLinearGridD2);
+    XLALFree(roq);
+
+    TEST_FOOTER();
+
+}
+
+
 /******************************************
  * 
  * Old tests
@@ -113,6 +113,61 @@ static double vector_peak_interp(const double ym1, const double y, const double
     return y + 0.5 * dy * dy / d2y;
 }
 
+/* maximize over |z(t)|^2 and refine the estimate of the maximum */
+static REAL8 match_peak(const COMPLEX8 *zdata, const size_t n) {
+    size_t k = n;
+    ssize_t argmax = -1;
+    REAL8 max = 0.;
+    for (;k--;) {
+        REAL8 temp = abs2(zdata[k]);
+        if (temp > max) {
+            argmax = k;
+            max = temp;
+        }
+    }
+    if (max == 0.) return 0.;
+
+    if (argmax == 0 || argmax == (ssize_t) n - 1)
+        return max;
+    return vector_peak_interp(abs2(zdata[argmax - 1]), abs2(zdata[argmax]), abs2(zdata[argmax + 1]));
+}
+
+/* maximize the (2,2)-mode detection statistic over time, sky location and polarization */
+static REAL8 max_sky_loc_peak(const COMPLEX8 *hpdata, const COMPLEX8 *hcdata, const REAL8 hphccorr, const size_t n) {
+    /* First start with constant values */
+    REAL8 delta = 2 * hphccorr;
+    REAL8 denom = 4 - delta * delta;
+    if (denom < 0)
+    {
+        fprintf(stderr, "DANGER WILL ROBINSON: CODE IS BROKEN!!\n");
+    }
+
+    /* Now the tricksy bit as we loop over time*/
+    size_t k = n;
+    /* FIXME: This is needed if we turn back on peak refinement. */
+    /*ssize_t argmax = -1;*/
+    REAL8 max = 0.;
+    for (;k--;) {
+        COMPLEX8 ratio = hcdata[k] / hpdata[k];
+        REAL8 ratio_real = creal(ratio);
+        REAL8 ratio_imag = cimag(ratio);
+        REAL8 beta = 2 * ratio_real;
+        REAL8 alpha = ratio_real * ratio_real + ratio_imag * ratio_imag;
+        REAL8 sqroot = alpha*alpha + alpha * (delta*delta - 2) + 1;
+        sqroot += beta * (beta - delta * (1 + alpha));
+        sqroot = sqrt(sqroot);
+        REAL8 brckt = 2*(alpha + 1) - beta*delta + 2*sqroot;
+        brckt = brckt / denom;
+        REAL8 det_stat_sq = abs2(hpdata[k]) * brckt;
+
+        if (det_stat_sq > max) {
+            /*argmax = k;*/
+            max = det_stat_sq;
+        }
+    }
+    return max;
+}
+
 /*
  * Returns the match for two whitened, normalized, positive-frequency
  * COMPLEX8FrequencySeries inputs.
@@ -135,25 +190,8 @@ REAL8 XLALInspiralSBankComputeMatch(const COMPLEX8FrequencySeries *inj, const CO
     XLALCOMPLEX8VectorFFT(ws->zt, ws->zf, ws->plan); /* plan is reverse */
 
     /* maximize over |z(t)|^2 */
-    COMPLEX8 *zdata = ws->zt->data;
-    size_t k = n;
-    ssize_t argmax = -1;
-    REAL8 max = 0.;
-    for (;k--;) {
-        REAL8 temp = abs2(zdata[k]);
-        if (temp > max) {
-            argmax = k;
-            max = temp;
-        }
-    }
-    if (max == 0.) return 0.;
-
-    /* refine estimate of maximum */
-    REAL8 result;
-    if (argmax == 0 || argmax == (ssize_t) n - 1)
-        result = max;
-    else
-        result = vector_peak_interp(abs2(zdata[argmax - 1]), abs2(zdata[argmax]), abs2(zdata[argmax + 1]));
+    REAL8 result = match_peak(ws->zt->data, n);
+    if (result == 0.) return 0.;
 
     /* compute match */
     /* return 4. * inj->deltaF * sqrt(result) / n; */  /* inverse FFT = reverse / n */
@@ -235,40 +273,7 @@ REAL8 XLALInspiralSBankComputeMatchMaxSkyLoc(const COMPLEX8FrequencySeries *hp,
 
 
     /* COMPUTE DETECTION STATISTIC */
-
-    /* First start with constant values */
-    REAL8 delta = 2 * hphccorr;
-    REAL8 denom = 4 - delta * delta;
-    if (denom < 0)
-    {
-        fprintf(stderr, "DANGER WILL ROBINSON: CODE IS BROKEN!!\n");
-    }
-
-    /* Now the tricksy bit as we loop over time*/
-    COMPLEX8 *hpdata = ws1->zt->data;
-    COMPLEX8 *hcdata = ws2->zt->data;
-    size_t k = n;
-    /* FIXME: This is needed if we turn back on peak refinement. */
-    /*ssize_t argmax = -1;*/
-    REAL8 max = 0.;
-    for (;k--;) {
-        COMPLEX8 ratio = hcdata[k] / hpdata[k];
-        REAL8 ratio_real = creal(ratio);
-        REAL8 ratio_imag = cimag(ratio);
-        REAL8 beta = 2 * ratio_real;
-        REAL8 alpha = ratio_real * ratio_real + ratio_imag * ratio_imag;
-        REAL8 sqroot = alpha*alpha + alpha * (delta*delta - 2) + 1;
-        sqroot += beta * (beta - delta * (1 + alpha));
-        sqroot = sqrt(sqroot);
-        REAL8 brckt = 2*(alpha + 1) - beta*delta + 2*sqroot;
-        brckt = brckt / denom;
-        REAL8 det_stat_sq = abs2(hpdata[k]) * brckt;
-
-        if (det_stat_sq > max) {
-            /*argmax = k;*/
-            max = det_stat_sq;
-        }
-    }
+    REAL8 max = max_sky_loc_peak(ws1->zt->data, ws2->zt->data, hphccorr, n);
     if (max == 0.) return 0.;
 
     /* FIXME: For now do *not* refine estimate of peak. */
@@ -354,3 +359,143 @@ REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySerie
     /* Return match */
     return 4. * proposal->deltaF * sqrt(max);
 }
+
+
+/*
+ * Compute the matches of one proposal against a contiguous block of
+ * templates of equal length.  If hc is NULL, the matches are those of
+ * XLALInspiralSBankComputeMatch() of the proposal against the rows of hp;
+ * otherwise they are those of XLALInspiralSBankComputeMatchMaxSkyLoc()
+ * against the rows of hp and hc, with the correlations in hphccorr.  The templates are
+ * distributed over threads, each with its own buffers; the reverse plan
+ * from the workspace cache is shared, as executing a plan is thread-safe.
+ * Each match takes the same steps as in the single-template function, so
+ * it is identical to the match that function returns with the same plan.
+ * Once a match exceeds min_match, templates after it are skipped.
+ */
+static INT4 compute_match_batch(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const COMPLEX8VectorSequence *hp, const COMPLEX8VectorSequence *hc, const REAL8Vector *hphccorr, const REAL8 min_match, WS *workspace_cache) {
+    if (!matches || !proposal || !proposal->data || !hp || !workspace_cache)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (matches->length != hp->length)
+        XLAL_ERROR(XLAL_EBADLEN, "matches has length %u but there are %u templates\n", matches->length, hp->length);
+    if (hc && (hc->length != hp->length || hc->vectorLength != hp->vectorLength || !hphccorr || hphccorr->length != hp->length))
+        XLAL_ERROR(XLAL_EBADLEN, "hp, hc and hphccorr have inconsistent lengths\n");
+
+    memset(matches->data, 0, matches->length * sizeof(*matches->data));
+    if (hp->length == 0)
+        return 0;
+
+    size_t min_len = (proposal->data->length <= hp->vectorLength) ? proposal->data->length : hp->vectorLength;
+    if (min_len < 2)
+        XLAL_ERROR(XLAL_EBADLEN, "templates must have at least two frequency bins\n");
+
+    /* get workspace for + and - frequencies; only its plan is used */
+    size_t n = 2 * (min_len - 1);   /* no need to integrate implicit zeros */
+    WS *ws = get_workspace(workspace_cache, n);
+    if (!ws) {
+        XLALPrintError("out of space in the workspace_cache\n");
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+
+    UINT4 found = hp->length;   /* first template whose match exceeds min_match */
+    int errnum = 0;
+
+#pragma omp parallel
+    {
+        /* the negative frequencies of zf stay zero */
+        COMPLEX8Vector *zf = XLALCreateCOMPLEX8Vector(n);
+        COMPLEX8Vector *zt1 = XLALCreateCOMPLEX8Vector(n);
+        COMPLEX8Vector *zt2 = hc ? XLALCreateCOMPLEX8Vector(n) : NULL;
+        int ok = zf && zt1 && (zt2 || !hc);
+        if (ok)
+            memset(zf->data, 0, n * sizeof(COMPLEX8));
+        else {
+#pragma omp critical (SBankComputeMatchBatch)
+            errnum = XLAL_ENOMEM;
+        }
+
+        UINT4 j;
+#pragma omp for schedule(dynamic)
+        for (j = 0; j < hp->length; ++j) {
+            UINT4 first;
+#pragma omp atomic read
+            first = found;
+            if (!ok || j > first)
+                continue;
+
+            REAL8 max;
+            if (hc)
+                multiply_conjugate(zf->data, hp->data + j * hp->vectorLength, proposal->data->data, min_len);
+            else
+                multiply_conjugate(zf->data, proposal->data->data, hp->data + j * hp->vectorLength, min_len);
+            if (XLALCOMPLEX8VectorFFT(zt1, zf, ws->plan) != XLAL_SUCCESS) {
+#pragma omp critical (SBankComputeMatchBatch)
+                errnum = XLAL_EFUNC;
+                continue;
+            }
+            if (hc) {
+                multiply_conjugate(zf->data, hc->data + j * hc->vectorLength, proposal->data->data, min_len);
+                if (XLALCOMPLEX8VectorFFT(zt2, zf, ws->plan) != XLAL_SUCCESS) {
+#pragma omp critical (SBankComputeMatchBatch)
+                    errnum = XLAL_EFUNC;
+                    continue;
+                }
+                max = max_sky_loc_peak(zt1->data, zt2->data, hphccorr->data[j], n);
+            } else
+                max = match_peak(zt1->data, n);
+
+            matches->data[j] = 4. * proposal->deltaF * sqrt(max);
+            if (matches->data[j] > min_match) {
+#pragma omp critical (SBankComputeMatchBatch)
+                if (j < found) {
+#pragma omp atomic write
+                    found = j;
+                }
+            }
+        }
+
+        XLALDestroyCOMPLEX8Vector(zf);
+        XLALDestroyCOMPLEX8Vector(zt1);
+        XLALDestroyCOMPLEX8Vector(zt2);
+    }
+
+    if (errnum)
+        XLAL_ERROR(errnum);
+
+    /* templates after the first match above threshold may or may not have
+       been computed, depending on the order the threads got to them */
+    for (UINT4 j = found + 1; j < hp->length; ++j)
+        matches->data[j] = 0.;
+    return found;
+}
+
+/*
+ * Batched version of XLALInspiralSBankComputeMatch(): computes the
+ * matches of a whitened, normalized, positive-frequency proposal against
+ * each row of templates, a contiguous block of templates of equal length,
+ * and stores them in matches.  Returns the index of the first template
+ * whose match exceeds min_match, or the number of templates if none does;
+ * matches of templates after that index are not computed and set to zero.
+ * Pass min_match = INFINITY to compute every match.
+ */
+INT4 XLALInspiralSBankComputeMatchBatch(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const COMPLEX8VectorSequence *templates, const REAL8 min_match, WS *workspace_cache) {
+    INT4 found = compute_match_batch(matches, proposal, templates, NULL, NULL, min_match, workspace_cache);
+    if (found < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return found;
+}
+
+/*
+ * Batched version of XLALInspiralSBankComputeMatchMaxSkyLoc(): the plus
+ * and cross polarizations of the templates are the rows of hp and hc, and
+ * hphccorr holds their correlations.  Matches, return value and early
+ * exit are as for XLALInspiralSBankComputeMatchBatch().
+ */
+INT4 XLALInspiralSBankComputeMatchMaxSkyLocBatch(REAL8Vector *matches, const COMPLEX8VectorSequence *hp, const COMPLEX8VectorSequence *hc, const REAL8Vector *hphccorr, const COMPLEX8FrequencySeries *proposal, const REAL8 min_match, WS *workspace_cache) {
+    if (!hc || !hphccorr)
+        XLAL_ERROR(XLAL_EFAULT);
+    INT4 found = compute_match_batch(matches, proposal, hp, hc, hphccorr, min_match, workspace_cache);
+    if (found < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return found;
+}
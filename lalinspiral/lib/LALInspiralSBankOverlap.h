@@ -20,3 +20,7 @@ REAL8 XLALInspiralSBankComputeRealMatch(const COMPLEX8FrequencySeries *inj, cons
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLoc(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
 
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
+
+INT4 XLALInspiralSBankComputeMatchBatch(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const COMPLEX8VectorSequence *templates, const REAL8 min_match, WS *workspace_cache);
+
+INT4 XLALInspiralSBankComputeMatchMaxSkyLocBatch(REAL8Vector *matches, const COMPLEX8VectorSequence *hp, const COMPLEX8VectorSequence *hc, const REAL8Vector *hphccorr, const COMPLEX8FrequencySeries *proposal, const REAL8 min_match, WS *workspace_cache);
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Tests the batched SBank match functions against the single-template
+ * functions, and checks that the early exit returns the first template
+ * whose match exceeds the threshold.  With OpenMP the batches run on
+ * several threads, so the matches must not depend on the scheduling.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
+#include <lal/LALInspiralSBankOverlap.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define NFREQ 1025
+#define NTMPLT 40
+#define DELTAF 0.25
+#define FLOW 20.0
+#define TOL 1e-5
+
+#define CHECK( cond, msg ) \
+  do { if ( ! (cond) ) { fprintf( stderr, "FAIL: %s\n", (msg) ); return 1; } } while (0)
+
+/* a stationary-phase chirp above FLOW with unit norm, 4 deltaF sum |h|^2 = 1 */
+static void make_waveform( COMPLEX8 *h, REAL8 mchirp, REAL8 phi0, REAL8 t0 )
+{
+  REAL8 norm = 0.0;
+  UINT4 k;
+  for ( k = 0; k < NFREQ; ++k )
+  {
+    REAL8 f = k * DELTAF;
+    REAL8 psi, amp;
+    if ( f < FLOW )
+    {
+      h[k] = 0.0;
+      continue;
+    }
+    psi = phi0 + LAL_TWOPI * f * t0 + 3.0 / ( 128.0 * pow( LAL_PI * mchirp * LAL_MTSUN_SI * f, 5.0 / 3.0 ) );
+    amp = pow( f, -7.0 / 6.0 );
+    h[k] = crectf( amp * cos( psi ), - amp * sin( psi ) );
+    norm += amp * amp;
+  }
+  norm = 1.0 / sqrt( 4.0 * DELTAF * norm );
+  for ( k = 0; k < NFREQ; ++k )
+    h[k] *= norm;
+}
+
+int main( void )
+{
+  COMPLEX8FrequencySeries *proposal, *tmplt, *tmpltc;
+  COMPLEX8VectorSequence *hp, *hc;
+  REAL8Vector *matches, *corr;
+  REAL8 single[NTMPLT];
+  WS *ws, *ws1, *ws2;
+  LIGOTimeGPS epoch = LIGOTIMEGPSZERO;
+  INT4 found;
+  UINT4 j, k;
+
+  XLALSetErrorHandler( XLALAbortErrorHandler );
+
+#ifdef _OPENMP
+  /* exercise the threaded path even on a single core */
+  omp_set_num_threads( 4 );
+#endif
+
+  proposal = XLALCreateCOMPLEX8FrequencySeries( "proposal", &epoch, 0.0, DELTAF, &lalDimensionlessUnit, NFREQ );
+  tmplt = XLALCreateCOMPLEX8FrequencySeries( "hp", &epoch, 0.0, DELTAF, &lalDimensionlessUnit, NFREQ );
+  tmpltc = XLALCreateCOMPLEX8FrequencySeries( "hc", &epoch, 0.0, DELTAF, &lalDimensionlessUnit, NFREQ );
+  hp = XLALCreateCOMPLEX8VectorSequence( NTMPLT, NFREQ );
+  hc = XLALCreateCOMPLEX8VectorSequence( NTMPLT, NFREQ );
+  matches = XLALCreateREAL8Vector( NTMPLT );
+  corr = XLALCreateREAL8Vector( NTMPLT );
+  ws = XLALCreateSBankWorkspaceCache();
+  ws1 = XLALCreateSBankWorkspaceCache();
+  ws2 = XLALCreateSBankWorkspaceCache();
+
+  /* templates approach the proposal in chirp mass, so the matches rise
+     along the block */
+  make_waveform( proposal->data->data, 1.2, 0.3, 0.01 );
+  for ( j = 0; j < NTMPLT; ++j )
+  {
+    COMPLEX8 *p = hp->data + j * NFREQ;
+    COMPLEX8 *c = hc->data + j * NFREQ;
+    REAL8 mchirp = 1.2 * ( 1.0 + 0.002 * ( NTMPLT - j ) / NTMPLT );
+    REAL8 re = 0.0;
+    make_waveform( p, mchirp, 0.0, 0.0 );
+    make_waveform( c, mchirp, 0.5 * LAL_PI + 0.1 * j / NTMPLT, 0.0 );
+    for ( k = 0; k < NFREQ; ++k )
+      re += crealf( p[k] * conjf( c[k] ) );
+    corr->data[j] = 4.0 * DELTAF * re;
+  }
+
+  /* every match equals that of XLALInspiralSBankComputeMatch(), which
+     does the same arithmetic with the same plan */
+  for ( j = 0; j < NTMPLT; ++j )
+  {
+    memcpy( tmplt->data->data, hp->data + j * NFREQ, NFREQ * sizeof( COMPLEX8 ) );
+    single[j] = XLALInspiralSBankComputeMatch( proposal, tmplt, ws );
+  }
+  found = XLALInspiralSBankComputeMatchBatch( matches, proposal, hp, INFINITY, ws );
+  CHECK( found == NTMPLT, "no match exceeds an infinite threshold" );
+  for ( j = 0; j < NTMPLT; ++j )
+    CHECK( matches->data[j] == single[j], "batched and single matches differ" );
+  CHECK( single[0] < single[NTMPLT - 1] && single[NTMPLT - 1] < 1.0 + TOL, "unexpected range of matches" );
+
+  /* the early exit returns the first template above threshold */
+  {
+    const REAL8 min_match = 0.5 * ( single[NTMPLT / 2] + single[NTMPLT / 2 - 1] );
+    UINT4 first = NTMPLT;
+    for ( j = 0; j < NTMPLT && first == NTMPLT; ++j )
+      if ( single[j] > min_match )
+        first = j;
+    CHECK( first < NTMPLT, "no template above threshold" );
+    found = XLALInspiralSBankComputeMatchBatch( matches, proposal, hp, min_match, ws );
+    CHECK( found == (INT4)first, "early exit at the wrong template" );
+    for ( j = 0; j <= first; ++j )
+      CHECK( matches->data[j] == single[j], "batched and single matches differ before early exit" );
+    for ( j = first + 1; j < NTMPLT; ++j )
+      CHECK( matches->data[j] == 0.0, "match computed after early exit" );
+  }
+
+  /* every match agrees with XLALInspiralSBankComputeMatchMaxSkyLoc(); it
+     transforms with the plans of two other caches, which FFTW may have
+     planned differently, so the matches agree to rounding only */
+  for ( j = 0; j < NTMPLT; ++j )
+  {
+    memcpy( tmplt->data->data, hp->data + j * NFREQ, NFREQ * sizeof( COMPLEX8 ) );
+    memcpy( tmpltc->data->data, hc->data + j * NFREQ, NFREQ * sizeof( COMPLEX8 ) );
+    single[j] = XLALInspiralSBankComputeMatchMaxSkyLoc( tmplt, tmpltc, corr->data[j], proposal, ws1, ws2 );
+  }
+  found = XLALInspiralSBankComputeMatchMaxSkyLocBatch( matches, hp, hc, corr, proposal, INFINITY, ws );
+  CHECK( found == NTMPLT, "no sky-maximized match exceeds an infinite threshold" );
+  for ( j = 0; j < NTMPLT; ++j )
+    CHECK( fabs( matches->data[j] - single[j] ) < TOL, "batched and single sky-maximized matches differ" );
+
+  XLALDestroySBankWorkspaceCache( ws2 );
+  XLALDestroySBankWorkspaceCache( ws1 );
+  XLALDestroySBankWorkspaceCache( ws );
+  XLALDestroyREAL8Vector( corr );
+  XLALDestroyREAL8Vector( matches );
+  XLALDestroyCOMPLEX8VectorSequence( hc );
+  XLALDestroyCOMPLEX8VectorSequence( hp );
+  XLALDestroyCOMPLEX8FrequencySeries( tmpltc );
+  XLALDestroyCOMPLEX8FrequencySeries( tmplt );
+  XLALDestroyCOMPLEX8FrequencySeries( proposal );
+  LALCheckMemoryLeaks();
+  return 0;
+}
@@ -0,0 +1,2139 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301  USA
+ */
+
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ * \brief Column-oriented storage of LIGO Light Weight XML tables.
+ *
+ * See \ref LIGOLwXMLColumnar.h for a description of the container.  The
+ * layout of each table is described by a static array of column
+ * descriptions, one entry per column of the table's linked-list row
+ * structure, listed in the order in which XLALWriteLIGOLwXML*Table()
+ * writes them.  All operations are driven by those descriptions so that
+ * adding a column means adding one line to its table's array.
+ */
+
+
+#include <locale.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+#include <lal/Date.h>
+#include <lal/FileIO.h>
+#include <lal/LALMalloc.h>
+#include <lal/LALStdio.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLColumnar.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/XLALError.h>
+
+
+/*
+ * ============================================================================
+ *
+ *                              Table Descriptions
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * Some columns have always been written in a format other than the usual
+ * one for their type, and are still written that way so that documents are
+ * unchanged:  the *_chisq_dof columns of sngl_inspiral are written as
+ * unsigned integers (as by %u), and eff_dist_v of sim_inspiral is written
+ * with printf()'s %16g.
+ */
+
+
+enum column_format {
+	FORMAT_DEFAULT,
+	FORMAT_UNSIGNED,	/* int_4s written as an unsigned integer */
+	FORMAT_16G		/* real written with %16g */
+};
+
+
+struct column_description {
+	const char *table;	/* table prefix of the column name in documents */
+	const char *name;
+	LIGOLwColumnType type;
+	size_t width;		/* size of the member in the row structure */
+	size_t offset;		/* offset of the member in the row structure */
+	enum column_format format;
+};
+
+
+#define COLUMN_FORMAT(rowtype, table, name, type, member, format) {table, name, LIGOLW_COLUMN_ ## type, sizeof(((rowtype *) 0)->member), offsetof(rowtype, member), format}
+#define COLUMN(rowtype, table, name, type, member) COLUMN_FORMAT(rowtype, table, name, type, member, FORMAT_DEFAULT)
+
+
+static const struct column_description sngl_burst_columns[] = {
+	COLUMN(SnglBurst, "process", "process_id", INT_8S, process_id),
+	COLUMN(SnglBurst, "sngl_burst", "ifo", LSTRING, ifo),
+	COLUMN(SnglBurst, "sngl_burst", "search", LSTRING, search),
+	COLUMN(SnglBurst, "sngl_burst", "channel", LSTRING, channel),
+	COLUMN(SnglBurst, "sngl_burst", "start_time", GPS, start_time),
+	COLUMN(SnglBurst, "sngl_burst", "peak_time", GPS, peak_time),
+	COLUMN(SnglBurst, "sngl_burst", "duration", REAL_4, duration),
+	COLUMN(SnglBurst, "sngl_burst", "central_freq", REAL_4, central_freq),
+	COLUMN(SnglBurst, "sngl_burst", "bandwidth", REAL_4, bandwidth),
+	COLUMN(SnglBurst, "sngl_burst", "amplitude", REAL_4, amplitude),
+	COLUMN(SnglBurst, "sngl_burst", "snr", REAL_4, snr),
+	COLUMN(SnglBurst, "sngl_burst", "confidence", REAL_4, confidence),
+	COLUMN(SnglBurst, "sngl_burst", "chisq", REAL_8, chisq),
+	COLUMN(SnglBurst, "sngl_burst", "chisq_dof", REAL_8, chisq_dof),
+	COLUMN(SnglBurst, "sngl_burst", "event_id", INT_8S, event_id),
+};
+
+
+static const struct column_description sim_burst_columns[] = {
+	COLUMN(SimBurst, "process", "process_id", INT_8S, process_id),
+	COLUMN(SimBurst, "sim_burst", "waveform", LSTRING, waveform),
+	COLUMN(SimBurst, "sim_burst", "ra", REAL_8, ra),
+	COLUMN(SimBurst, "sim_burst", "dec", REAL_8, dec),
+	COLUMN(SimBurst, "sim_burst", "psi", REAL_8, psi),
+	COLUMN(SimBurst, "sim_burst", "time_geocent_gps", GPS, time_geocent_gps),
+	COLUMN(SimBurst, "sim_burst", "time_geocent_gmst", REAL_8, time_geocent_gmst),
+	COLUMN(SimBurst, "sim_burst", "duration", REAL_8, duration),
+	COLUMN(SimBurst, "sim_burst", "frequency", REAL_8, frequency),
+	COLUMN(SimBurst, "sim_burst", "bandwidth", REAL_8, bandwidth),
+	COLUMN(SimBurst, "sim_burst", "q", REAL_8, q),
+	COLUMN(SimBurst, "sim_burst", "pol_ellipse_angle", REAL_8, pol_ellipse_angle),
+	COLUMN(SimBurst, "sim_burst", "pol_ellipse_e", REAL_8, pol_ellipse_e),
+	COLUMN(SimBurst, "sim_burst", "amplitude", REAL_8, amplitude),
+	COLUMN(SimBurst, "sim_burst", "hrss", REAL_8, hrss),
+	COLUMN(SimBurst, "sim_burst", "egw_over_rsquared", REAL_8, egw_over_rsquared),
+	COLUMN(SimBurst, "sim_burst", "waveform_number", INT_8U, waveform_number),
+	COLUMN(SimBurst, "time_slide", "time_slide_id", INT_8S, time_slide_id),
+	COLUMN(SimBurst, "sim_burst", "simulation_id", INT_8S, simulation_id),
+};
+
+
+static const struct column_description sngl_inspiral_columns[] = {
+	COLUMN(SnglInspiralTable, "process", "process_id", INT_8S, process_id),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "ifo", LSTRING, ifo),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "search", LSTRING, search),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "channel", LSTRING, channel),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "end_time", GPS, end),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "end_time_gmst", REAL_8, end_time_gmst),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "impulse_time", GPS, impulse_time),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "template_duration", REAL_8, template_duration),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "event_duration", REAL_8, event_duration),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "amplitude", REAL_4, amplitude),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "eff_distance", REAL_4, eff_distance),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "coa_phase", REAL_4, coa_phase),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "mass1", REAL_4, mass1),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "mass2", REAL_4, mass2),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "mchirp", REAL_4, mchirp),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "mtotal", REAL_4, mtotal),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "eta", REAL_4, eta),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "kappa", REAL_4, kappa),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "chi", REAL_4, chi),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "tau0", REAL_4, tau0),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "tau2", REAL_4, tau2),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "tau3", REAL_4, tau3),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "tau4", REAL_4, tau4),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "tau5", REAL_4, tau5),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "ttotal", REAL_4, ttotal),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "psi0", REAL_4, psi0),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "psi3", REAL_4, psi3),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "alpha", REAL_4, alpha),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "alpha1", REAL_4, alpha1),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "alpha2", REAL_4, alpha2),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "alpha3", REAL_4, alpha3),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "alpha4", REAL_4, alpha4),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "alpha5", REAL_4, alpha5),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "alpha6", REAL_4, alpha6),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "beta", REAL_4, beta),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "f_final", REAL_4, f_final),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "snr", REAL_4, snr),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "chisq", REAL_4, chisq),
+	COLUMN_FORMAT(SnglInspiralTable, "sngl_inspiral", "chisq_dof", INT_4S, chisq_dof, FORMAT_UNSIGNED),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "bank_chisq", REAL_4, bank_chisq),
+	COLUMN_FORMAT(SnglInspiralTable, "sngl_inspiral", "bank_chisq_dof", INT_4S, bank_chisq_dof, FORMAT_UNSIGNED),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "cont_chisq", REAL_4, cont_chisq),
+	COLUMN_FORMAT(SnglInspiralTable, "sngl_inspiral", "cont_chisq_dof", INT_4S, cont_chisq_dof, FORMAT_UNSIGNED),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "sigmasq", REAL_8, sigmasq),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "rsqveto_duration", REAL_4, rsqveto_duration),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma0", REAL_4, Gamma[0]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma1", REAL_4, Gamma[1]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma2", REAL_4, Gamma[2]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma3", REAL_4, Gamma[3]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma4", REAL_4, Gamma[4]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma5", REAL_4, Gamma[5]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma6", REAL_4, Gamma[6]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma7", REAL_4, Gamma[7]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma8", REAL_4, Gamma[8]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "Gamma9", REAL_4, Gamma[9]),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "spin1x", REAL_4, spin1x),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "spin1y", REAL_4, spin1y),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "spin1z", REAL_4, spin1z),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "spin2x", REAL_4, spin2x),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "spin2y", REAL_4, spin2y),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "spin2z", REAL_4, spin2z),
+	COLUMN(SnglInspiralTable, "sngl_inspiral", "event_id", INT_8S, event_id),
+};
+
+
+static const struct column_description sim_inspiral_columns[] = {
+	COLUMN(SimInspiralTable, "process", "process_id", INT_8S, process_id),
+	COLUMN(SimInspiralTable, "sim_inspiral", "waveform", LSTRING, waveform),
+	COLUMN(SimInspiralTable, "sim_inspiral", "geocent_end_time", GPS, geocent_end_time),
+	COLUMN(SimInspiralTable, "sim_inspiral", "h_end_time", GPS, h_end_time),
+	COLUMN(SimInspiralTable, "sim_inspiral", "l_end_time", GPS, l_end_time),
+	COLUMN(SimInspiralTable, "sim_inspiral", "g_end_time", GPS, g_end_time),
+	COLUMN(SimInspiralTable, "sim_inspiral", "t_end_time", GPS, t_end_time),
+	COLUMN(SimInspiralTable, "sim_inspiral", "v_end_time", GPS, v_end_time),
+	COLUMN(SimInspiralTable, "sim_inspiral", "end_time_gmst", REAL_8, end_time_gmst),
+	COLUMN(SimInspiralTable, "sim_inspiral", "source", LSTRING, source),
+	COLUMN(SimInspiralTable, "sim_inspiral", "mass1", REAL_4, mass1),
+	COLUMN(SimInspiralTable, "sim_inspiral", "mass2", REAL_4, mass2),
+	COLUMN(SimInspiralTable, "sim_inspiral", "mchirp", REAL_4, mchirp),
+	COLUMN(SimInspiralTable, "sim_inspiral", "eta", REAL_4, eta),
+	COLUMN(SimInspiralTable, "sim_inspiral", "distance", REAL_4, distance),
+	COLUMN(SimInspiralTable, "sim_inspiral", "longitude", REAL_4, longitude),
+	COLUMN(SimInspiralTable, "sim_inspiral", "latitude", REAL_4, latitude),
+	COLUMN(SimInspiralTable, "sim_inspiral", "inclination", REAL_4, inclination),
+	COLUMN(SimInspiralTable, "sim_inspiral", "coa_phase", REAL_4, coa_phase),
+	COLUMN(SimInspiralTable, "sim_inspiral", "polarization", REAL_4, polarization),
+	COLUMN(SimInspiralTable, "sim_inspiral", "psi0", REAL_4, psi0),
+	COLUMN(SimInspiralTable, "sim_inspiral", "psi3", REAL_4, psi3),
+	COLUMN(SimInspiralTable, "sim_inspiral", "alpha", REAL_4, alpha),
+	COLUMN(SimInspiralTable, "sim_inspiral", "alpha1", REAL_4, alpha1),
+	COLUMN(SimInspiralTable, "sim_inspiral", "alpha2", REAL_4, alpha2),
+	COLUMN(SimInspiralTable, "sim_inspiral", "alpha3", REAL_4, alpha3),
+	COLUMN(SimInspiralTable, "sim_inspiral", "alpha4", REAL_4, alpha4),
+	COLUMN(SimInspiralTable, "sim_inspiral", "alpha5", REAL_4, alpha5),
+	COLUMN(SimInspiralTable, "sim_inspiral", "alpha6", REAL_4, alpha6),
+	COLUMN(SimInspiralTable, "sim_inspiral", "beta", REAL_4, beta),
+	COLUMN(SimInspiralTable, "sim_inspiral", "spin1x", REAL_4, spin1x),
+	COLUMN(SimInspiralTable, "sim_inspiral", "spin1y", REAL_4, spin1y),
+	COLUMN(SimInspiralTable, "sim_inspiral", "spin1z", REAL_4, spin1z),
+	COLUMN(SimInspiralTable, "sim_inspiral", "spin2x", REAL_4, spin2x),
+	COLUMN(SimInspiralTable, "sim_inspiral", "spin2y", REAL_4, spin2y),
+	COLUMN(SimInspiralTable, "sim_inspiral", "spin2z", REAL_4, spin2z),
+	COLUMN(SimInspiralTable, "sim_inspiral", "theta0", REAL_4, theta0),
+	COLUMN(SimInspiralTable, "sim_inspiral", "phi0", REAL_4, phi0),
+	COLUMN(SimInspiralTable, "sim_inspiral", "f_lower", REAL_4, f_lower),
+	COLUMN(SimInspiralTable, "sim_inspiral", "f_final", REAL_4, f_final),
+	COLUMN(SimInspiralTable, "sim_inspiral", "eff_dist_h", REAL_4, eff_dist_h),
+	COLUMN(SimInspiralTable, "sim_inspiral", "eff_dist_l", REAL_4, eff_dist_l),
+	COLUMN(SimInspiralTable, "sim_inspiral", "eff_dist_g", REAL_4, eff_dist_g),
+	COLUMN(SimInspiralTable, "sim_inspiral", "eff_dist_t", REAL_4, eff_dist_t),
+	COLUMN_FORMAT(SimInspiralTable, "sim_inspiral", "eff_dist_v", REAL_4, eff_dist_v, FORMAT_16G),
+	COLUMN(SimInspiralTable, "sim_inspiral", "numrel_mode_min", INT_4S, numrel_mode_min),
+	COLUMN(SimInspiralTable, "sim_inspiral", "numrel_mode_max", INT_4S, numrel_mode_max),
+	COLUMN(SimInspiralTable, "sim_inspiral", "numrel_data", LSTRING, numrel_data),
+	COLUMN(SimInspiralTable, "sim_inspiral", "amp_order", INT_4S, amp_order),
+	COLUMN(SimInspiralTable, "sim_inspiral", "taper", LSTRING, taper),
+	COLUMN(SimInspiralTable, "sim_inspiral", "bandpass", INT_4S, bandpass),
+	COLUMN(SimInspiralTable, "sim_inspiral", "simulation_id", INT_8S, simulation_id),
+};
+
+
+struct table_description {
+	const char *name;
+	MetadataTableType metadata_type;
+	size_t row_size;
+	int real_4_digits;	/* significant figures written for real_4 columns */
+	int stream_newline;	/* a newline follows the Stream start tag */
+	int num_columns;
+	const struct column_description *columns;
+};
+
+
+static const struct table_description table_descriptions[] = {
+	[LIGOLW_SNGL_BURST_TABLE] = {"sngl_burst", sngl_burst_table, sizeof(SnglBurst), 8, 0, XLAL_NUM_ELEM(sngl_burst_columns), sngl_burst_columns},
+	[LIGOLW_SIM_BURST_TABLE] = {"sim_burst", sim_burst_table, sizeof(SimBurst), 8, 0, XLAL_NUM_ELEM(sim_burst_columns), sim_burst_columns},
+	[LIGOLW_SNGL_INSPIRAL_TABLE] = {"sngl_inspiral", sngl_inspiral_table, sizeof(SnglInspiralTable), 8, 0, XLAL_NUM_ELEM(sngl_inspiral_columns), sngl_inspiral_columns},
+	[LIGOLW_SIM_INSPIRAL_TABLE] = {"sim_inspiral", sim_inspiral_table, sizeof(SimInspiralTable), 16, 1, XLAL_NUM_ELEM(sim_inspiral_columns), sim_inspiral_columns}
+};
+
+
+static const struct table_description *get_table_description(LIGOLwColumnarTableType type)
+{
+	if((int) type < 0 || (size_t) type >= XLAL_NUM_ELEM(table_descriptions))
+		XLAL_ERROR_NULL(XLAL_EINVAL, "unrecognized table type %d", (int) type);
+	return &table_descriptions[type];
+}
+
+
+/* size of one element of a column's array */
+static size_t element_size(const struct column_description *column)
+{
+	switch(column->type) {
+	case LIGOLW_COLUMN_INT_4S:
+		return sizeof(INT4);
+	case LIGOLW_COLUMN_INT_8S:
+	case LIGOLW_COLUMN_GPS:
+		return sizeof(INT8);
+	case LIGOLW_COLUMN_INT_8U:
+		return sizeof(UINT8);
+	case LIGOLW_COLUMN_REAL_4:
+		return sizeof(REAL4);
+	case LIGOLW_COLUMN_REAL_8:
+		return sizeof(REAL8);
+	case LIGOLW_COLUMN_LSTRING:
+		return column->width;
+	}
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                            Creation and Destruction
+ *
+ * ============================================================================
+ */
+
+
+/**
+ * Free a \c LIGOLwColumnarTable.  Does nothing if table is NULL.
+ */
+void XLALDestroyLIGOLwColumnarTable(LIGOLwColumnarTable *table)
+{
+	if(table) {
+		if(table->columns) {
+			int i;
+			for(i = 0; i < table_descriptions[table->type].num_columns; i++)
+				XLALFree(table->columns[i]);
+			XLALFree(table->columns);
+		}
+		XLALFree(table);
+	}
+}
+
+
+/**
+ * Create a \c LIGOLwColumnarTable of the given type with length rows.
+ * All entries are zero, and all strings are empty.  Returns NULL on
+ * failure.
+ */
+LIGOLwColumnarTable *XLALCreateLIGOLwColumnarTable(LIGOLwColumnarTableType type, size_t length)
+{
+	const struct table_description *desc = get_table_description(type);
+	LIGOLwColumnarTable *new;
+
+	if(!desc)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	new = XLALMalloc(sizeof(*new));
+	if(!new)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	new->type = type;
+	new->length = 0;
+	new->capacity = 0;
+	new->columns = XLALCalloc(desc->num_columns, sizeof(*new->columns));
+	if(!new->columns) {
+		XLALFree(new);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+
+	if(XLALResizeLIGOLwColumnarTable(new, length) < 0) {
+		XLALDestroyLIGOLwColumnarTable(new);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	return new;
+}
+
+
+/**
+ * Change the number of rows in a \c LIGOLwColumnarTable.  Rows are
+ * removed from or added to the end of the table;  new rows are zeroed.
+ * The memory for the columns grows geometrically, so a table can be
+ * built up one row at a time at a cost proportional to its final size,
+ * and shrinking a table does not release memory.  Returns 0 on success,
+ * < 0 on failure.
+ */
+int XLALResizeLIGOLwColumnarTable(LIGOLwColumnarTable *table, size_t length)
+{
+	const struct table_description *desc;
+	int i;
+
+	if(!table)
+		XLAL_ERROR(XLAL_EFAULT);
+	desc = get_table_description(table->type);
+	if(!desc)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	if(length > table->capacity) {
+		size_t capacity = table->capacity ? 2 * table->capacity : 1;
+		while(capacity < length)
+			capacity *= 2;
+		for(i = 0; i < desc->num_columns; i++) {
+			size_t size = element_size(&desc->columns[i]);
+			void *column = XLALRealloc(table->columns[i], capacity * size);
+			if(!column)
+				XLAL_ERROR(XLAL_ENOMEM);
+			table->columns[i] = column;
+		}
+		table->capacity = capacity;
+	}
+
+	if(length > table->length)
+		for(i = 0; i < desc->num_columns; i++) {
+			size_t size = element_size(&desc->columns[i]);
+			memset((char *) table->columns[i] + table->length * size, 0, (length - table->length) * size);
+		}
+	table->length = length;
+
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                Column Access
+ *
+ * ============================================================================
+ */
+
+
+/**
+ * Return the name of the table, e.g. "sngl_burst", or NULL on failure.
+ */
+const char *XLALLIGOLwColumnarTableName(const LIGOLwColumnarTable *table)
+{
+	const struct table_description *desc;
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	desc = get_table_description(table->type);
+	if(!desc)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return desc->name;
+}
+
+
+/**
+ * Return the number of columns in the table, or < 0 on failure.
+ */
+int XLALLIGOLwColumnarTableNumColumns(const LIGOLwColumnarTable *table)
+{
+	const struct table_description *desc;
+	if(!table)
+		XLAL_ERROR(XLAL_EFAULT);
+	desc = get_table_description(table->type);
+	if(!desc)
+		XLAL_ERROR(XLAL_EFUNC);
+	return desc->num_columns;
+}
+
+
+static const struct column_description *get_column_description(const LIGOLwColumnarTable *table, int column)
+{
+	const struct table_description *desc;
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	desc = get_table_description(table->type);
+	if(!desc)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	if(column < 0 || column >= desc->num_columns)
+		XLAL_ERROR_NULL(XLAL_EDOM, "column %d out of range [0, %d)", column, desc->num_columns);
+	return &desc->columns[column];
+}
+
+
+/**
+ * Return the name of a column, or NULL on failure.
+ */
+const char *XLALLIGOLwColumnarTableColumnName(const LIGOLwColumnarTable *table, int column)
+{
+	const struct column_description *col = get_column_description(table, column);
+	if(!col)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return col->name;
+}
+
+
+/**
+ * Return the \c LIGOLwColumnType of a column, or < 0 on failure.
+ */
+int XLALLIGOLwColumnarTableColumnType(const LIGOLwColumnarTable *table, int column)
+{
+	const struct column_description *col = get_column_description(table, column);
+	if(!col)
+		XLAL_ERROR(XLAL_EFUNC);
+	return col->type;
+}
+
+
+/**
+ * Return the size in bytes of one element of a column, i.e. the width of
+ * the strings in a string column, or 0 on failure.
+ */
+size_t XLALLIGOLwColumnarTableColumnWidth(const LIGOLwColumnarTable *table, int column)
+{
+	const struct column_description *col = get_column_description(table, column);
+	if(!col)
+		XLAL_ERROR_VAL(0, XLAL_EFUNC);
+	return element_size(col);
+}
+
+
+/**
+ * Return the index of the column with the given name, or < 0 if the table
+ * has no such column.
+ */
+int XLALLIGOLwColumnarTableFindColumn(const LIGOLwColumnarTable *table, const char *name)
+{
+	const struct table_description *desc;
+	int i;
+
+	if(!table || !name)
+		XLAL_ERROR(XLAL_EFAULT);
+	desc = get_table_description(table->type);
+	if(!desc)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	for(i = 0; i < desc->num_columns; i++)
+		if(!strcmp(desc->columns[i].name, name))
+			return i;
+	XLAL_ERROR(XLAL_ENAME, "%s table has no column \"%s\"", desc->name, name);
+}
+
+
+/**
+ * Return the array holding the named column.  The column must have the
+ * given type;  the array is then a pointer to INT4, INT8, UINT8, REAL4,
+ * REAL8 or char as appropriate (see \c LIGOLwColumnType).  For string
+ * columns, row i starts at element i *
+ * XLALLIGOLwColumnarTableColumnWidth().  The pointer remains valid until
+ * the table is resized, sorted or destroyed.  Returns NULL on failure.
+ */
+void *XLALLIGOLwColumnarTableGetColumn(const LIGOLwColumnarTable *table, const char *name, LIGOLwColumnType type)
+{
+	int i = XLALLIGOLwColumnarTableFindColumn(table, name);
+	if(i < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	if(table_descriptions[table->type].columns[i].type != type)
+		XLAL_ERROR_NULL(XLAL_ETYPE, "column \"%s\" has the wrong type", name);
+	return table->columns[i];
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                          Linked List Conversion
+ *
+ * ============================================================================
+ */
+
+
+/* copy one row structure into row i of the table */
+static void row_to_columns(LIGOLwColumnarTable *table, size_t i, const void *row)
+{
+	const struct table_description *desc = &table_descriptions[table->type];
+	int j;
+
+	for(j = 0; j < desc->num_columns; j++) {
+		const struct column_description *col = &desc->columns[j];
+		const char *member = (const char *) row + col->offset;
+		void *column = table->columns[j];
+		switch(col->type) {
+		case LIGOLW_COLUMN_INT_4S:
+			((INT4 *) column)[i] = *(const INT4 *) member;
+			break;
+		case LIGOLW_COLUMN_INT_8S:
+			((INT8 *) column)[i] = *(const long *) member;
+			break;
+		case LIGOLW_COLUMN_INT_8U:
+			((UINT8 *) column)[i] = *(const unsigned long *) member;
+			break;
+		case LIGOLW_COLUMN_REAL_4:
+			((REAL4 *) column)[i] = *(const REAL4 *) member;
+			break;
+		case LIGOLW_COLUMN_REAL_8:
+			((REAL8 *) column)[i] = *(const REAL8 *) member;
+			break;
+		case LIGOLW_COLUMN_LSTRING:
+			memcpy((char *) column + i * col->width, member, col->width);
+			((char *) column)[(i + 1) * col->width - 1] = '\0';
+			break;
+		case LIGOLW_COLUMN_GPS:
+			((INT8 *) column)[i] = XLALGPSToINT8NS((const LIGOTimeGPS *) member);
+			break;
+		}
+	}
+}
+
+
+/* copy row i of the table into a row structure */
+static void columns_to_row(void *row, const LIGOLwColumnarTable *table, size_t i)
+{
+	const struct table_description *desc = &table_descriptions[table->type];
+	int j;
+
+	for(j = 0; j < desc->num_columns; j++) {
+		const struct column_description *col = &desc->columns[j];
+		char *member = (char *) row + col->offset;
+		const void *column = table->columns[j];
+		switch(col->type) {
+		case LIGOLW_COLUMN_INT_4S:
+			*(INT4 *) member = ((const INT4 *) column)[i];
+			break;
+		case LIGOLW_COLUMN_INT_8S:
+			*(long *) member = ((const INT8 *) column)[i];
+			break;
+		case LIGOLW_COLUMN_INT_8U:
+			*(unsigned long *) member = ((const UINT8 *) column)[i];
+			break;
+		case LIGOLW_COLUMN_REAL_4:
+			*(REAL4 *) member = ((const REAL4 *) column)[i];
+			break;
+		case LIGOLW_COLUMN_REAL_8:
+			*(REAL8 *) member = ((const REAL8 *) column)[i];
+			break;
+		case LIGOLW_COLUMN_LSTRING:
+			memcpy(member, (const char *) column + i * col->width, col->width);
+			break;
+		case LIGOLW_COLUMN_GPS:
+			XLALINT8NSToGPS((LIGOTimeGPS *) member, ((const INT8 *) column)[i]);
+			break;
+		}
+	}
+}
+
+
+/*
+ * The row structures all begin with their "next" pointer, so the linked
+ * lists can be walked without knowing the row type.
+ */
+
+
+static LIGOLwColumnarTable *from_linked_list(LIGOLwColumnarTableType type, const void *head)
+{
+	LIGOLwColumnarTable *table;
+	const void *row;
+	size_t length = 0;
+	size_t i;
+
+	for(row = head; row; row = *(void * const *) row)
+		length++;
+
+	table = XLALCreateLIGOLwColumnarTable(type, length);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	for(row = head, i = 0; row; row = *(void * const *) row, i++)
+		row_to_columns(table, i, row);
+
+	return table;
+}
+
+
+static void free_linked_list(void *head)
+{
+	while(head) {
+		void *next = *(void **) head;
+		XLALFree(head);
+		head = next;
+	}
+}
+
+
+static void *to_linked_list(const LIGOLwColumnarTable *table, LIGOLwColumnarTableType type)
+{
+	void *head = NULL;
+	void **next = &head;
+	size_t i;
+
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if(table->type != type)
+		XLAL_ERROR_NULL(XLAL_ETYPE, "table is a %s table, not a %s table", table_descriptions[table->type].name, table_descriptions[type].name);
+
+	for(i = 0; i < table->length; i++) {
+		void *row = XLALCalloc(1, table_descriptions[type].row_size);
+		if(!row) {
+			free_linked_list(head);
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		}
+		columns_to_row(row, table, i);
+		*next = row;
+		next = (void **) row;
+	}
+
+	return head;
+}
+
+
+/**
+ * Create a \c LIGOLwColumnarTable from a linked list of \c SnglBurst
+ * structures.  The list is not modified.  Returns NULL on failure.
+ */
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSnglBurst(const SnglBurst *head)
+{
+	LIGOLwColumnarTable *table = from_linked_list(LIGOLW_SNGL_BURST_TABLE, head);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return table;
+}
+
+
+/**
+ * Create a \c LIGOLwColumnarTable from a linked list of \c SimBurst
+ * structures.  The list is not modified.  Returns NULL on failure.
+ */
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSimBurst(const SimBurst *head)
+{
+	LIGOLwColumnarTable *table = from_linked_list(LIGOLW_SIM_BURST_TABLE, head);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return table;
+}
+
+
+/**
+ * Create a \c LIGOLwColumnarTable from a linked list of
+ * \c SnglInspiralTable structures.  The list is not modified.  Returns
+ * NULL on failure.
+ */
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSnglInspiral(const SnglInspiralTable *head)
+{
+	LIGOLwColumnarTable *table = from_linked_list(LIGOLW_SNGL_INSPIRAL_TABLE, head);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return table;
+}
+
+
+/**
+ * Create a \c LIGOLwColumnarTable from a linked list of
+ * \c SimInspiralTable structures.  The list is not modified.  Returns NULL
+ * on failure.
+ */
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSimInspiral(const SimInspiralTable *head)
+{
+	LIGOLwColumnarTable *table = from_linked_list(LIGOLW_SIM_INSPIRAL_TABLE, head);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return table;
+}
+
+
+/**
+ * Create a linked list of \c SnglBurst structures, in row order, from a
+ * sngl_burst \c LIGOLwColumnarTable.  Free the list with
+ * XLALDestroySnglBurstTable().  Returns NULL on failure or if the table
+ * is empty.
+ */
+SnglBurst *XLALSnglBurstFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table)
+{
+	SnglBurst *head = to_linked_list(table, LIGOLW_SNGL_BURST_TABLE);
+	if(!head && table && table->length)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
+
+
+/**
+ * Create a linked list of \c SimBurst structures, in row order, from a
+ * sim_burst \c LIGOLwColumnarTable.  Free the list with
+ * XLALDestroySimBurstTable().  Returns NULL on failure or if the table is
+ * empty.
+ */
+SimBurst *XLALSimBurstFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table)
+{
+	SimBurst *head = to_linked_list(table, LIGOLW_SIM_BURST_TABLE);
+	if(!head && table && table->length)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
+
+
+/**
+ * Create a linked list of \c SnglInspiralTable structures, in row order,
+ * from a sngl_inspiral \c LIGOLwColumnarTable.  Returns NULL on failure or
+ * if the table is empty.
+ */
+SnglInspiralTable *XLALSnglInspiralFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table)
+{
+	SnglInspiralTable *head = to_linked_list(table, LIGOLW_SNGL_INSPIRAL_TABLE);
+	if(!head && table && table->length)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
+
+
+/**
+ * Create a linked list of \c SimInspiralTable structures, in row order,
+ * from a sim_inspiral \c LIGOLwColumnarTable.  Returns NULL on failure or
+ * if the table is empty.
+ */
+SimInspiralTable *XLALSimInspiralFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table)
+{
+	SimInspiralTable *head = to_linked_list(table, LIGOLW_SIM_INSPIRAL_TABLE);
+	if(!head && table && table->length)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                  Input
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * The reader does not build a document tree.  The file is read in large
+ * blocks (decompressed by XLALFileRead() if necessary), the Table element
+ * of interest is located by scanning for start tags, and the contents of
+ * its Stream element are tokenized in place.  Each document column is
+ * mapped to a column of the LIGOLwColumnarTable once, before the first
+ * row is read.
+ */
+
+
+#define READER_BLOCK_SIZE (1 << 20)
+
+
+struct reader {
+	LALFILE *fp;
+	const char *filename;
+	char *buf;
+	size_t size;		/* allocated size of buf */
+	size_t pos;		/* first unconsumed byte */
+	size_t end;		/* end of the data in buf */
+	int eof;
+	char decimal_point;	/* of the current locale */
+};
+
+
+/* discard the consumed part of the buffer and read another block.
+ * returns the number of bytes read, 0 at the end of the file, < 0 on
+ * error */
+static long refill(struct reader *r)
+{
+	size_t n;
+
+	if(r->eof)
+		return 0;
+	if(r->pos) {
+		memmove(r->buf, r->buf + r->pos, r->end - r->pos);
+		r->end -= r->pos;
+		r->pos = 0;
+	}
+	if(r->size - r->end < READER_BLOCK_SIZE) {
+		/* the pending data is a single token or tag longer than
+		 * the free space, make room */
+		char *buf = XLALRealloc(r->buf, r->end + READER_BLOCK_SIZE + 1);
+		if(!buf)
+			XLAL_ERROR(XLAL_ENOMEM);
+		r->buf = buf;
+		r->size = r->end + READER_BLOCK_SIZE;
+	}
+	n = XLALFileRead(r->buf + r->end, 1, READER_BLOCK_SIZE, r->fp);
+	if(n < READER_BLOCK_SIZE) {
+		if(!XLALFileEOF(r->fp))
+			XLAL_ERROR(XLAL_EIO, "error reading \"%s\"", r->filename);
+		r->eof = 1;
+	}
+	r->end += n;
+	/* the buffer is always '\0'-terminated so that strtod() and the
+	 * like stop at the end of the data */
+	r->buf[r->end] = '\0';
+	return n;
+}
+
+
+/* advance to the next occurrence of c, refilling as needed.  on success
+ * *found points to it.  returns 0 on success, 1 if the file ends first,
+ * < 0 on error */
+static int find_char(struct reader *r, char c, char **found)
+{
+	size_t from = r->pos;
+	while(1) {
+		long n;
+		*found = memchr(r->buf + from, c, r->end - from);
+		if(*found)
+			return 0;
+		/* refill() moves the pending data to the start */
+		from = r->end - r->pos;
+		n = refill(r);
+		if(n < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		if(!n)
+			return 1;
+	}
+}
+
+
+/* advance to the next start or end tag, and make sure all of it is in the
+ * buffer.  on success, r->pos is the '<' and *tag_end the '>'.  returns 0
+ * on success, 1 at the end of the file, < 0 on error */
+static int next_tag(struct reader *r, char **tag_end)
+{
+	char *p;
+	int result = find_char(r, '<', &p);
+	if(result)
+		return result;
+	r->pos = p - r->buf;
+	result = find_char(r, '>', tag_end);
+	if(result < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(result > 0)
+		XLAL_ERROR(XLAL_EDATA, "\"%s\": unterminated tag", r->filename);
+	return 0;
+}
+
+
+/* does the tag starting at r->buf + r->pos have the given element name? */
+static int tag_is(const struct reader *r, const char *name)
+{
+	const char *tag = r->buf + r->pos + 1;
+	size_t len = strlen(name);
+	return !strncmp(tag, name, len) && strchr(" \t\r\n/>", tag[len]);
+}
+
+
+/* copy the value of an attribute of the tag between r->buf + r->pos and
+ * tag_end into value.  returns 0 if found, 1 if not */
+static int get_attribute(const struct reader *r, const char *tag_end, const char *name, char *value, size_t size)
+{
+	const size_t len = strlen(name);
+	const char *p = r->buf + r->pos;
+
+	while((p = memchr(p, name[0], tag_end - p))) {
+		if(tag_end - p > (long) len + 1 && !strncmp(p, name, len) && strchr(" \t\r\n", p[-1])) {
+			const char *q = p + len;
+			const char *v;
+			while(strchr(" \t\r\n", *q))
+				q++;
+			if(*q == '=') {
+				char quote;
+				q++;
+				while(strchr(" \t\r\n", *q))
+					q++;
+				quote = *q++;
+				v = memchr(q, quote, tag_end - q);
+				if(v && (quote == '"' || quote == '\'')) {
+					size_t n = v - q < (long) size - 1 ? (size_t) (v - q) : size - 1;
+					memcpy(value, q, n);
+					value[n] = '\0';
+					return 0;
+				}
+			}
+		}
+		p++;
+	}
+	return 1;
+}
+
+
+/* the column or table name with the table prefix and ":table" suffix
+ * removed, e.g. "sngl_burst:peak_time" -> "peak_time" and
+ * "sngl_burst:table" -> "sngl_burst" */
+static const char *strip_name(char *name)
+{
+	char *c = strrchr(name, ':');
+	if(c && !strcmp(c, ":table")) {
+		*c = '\0';
+		c = strrchr(name, ':');
+	}
+	return c ? c + 1 : name;
+}
+
+
+/* scan the next token of a stream.  on success, *token and *len give the
+ * token with surrounding white space and quotes removed, *quoted is set
+ * if the token was a quoted string (whose escapes remain in place), and
+ * r->pos is left after the delimiter.  returns 0 on success, 1 at the end
+ * of the stream, < 0 on error */
+static int next_token(struct reader *r, char delimiter, char **token, size_t *len, int *quoted)
+{
+	size_t p = r->pos;
+
+	while(1) {
+		/* skip white space */
+		while(p < r->end && strchr(" \t\r\n", r->buf[p]))
+			p++;
+		if(p < r->end)
+			break;
+		r->pos = p;
+		switch(refill(r)) {
+		case 0:
+			XLALPrintError("%s(): \"%s\": unterminated Stream\n", __func__, r->filename);
+			XLAL_ERROR(XLAL_EDATA);
+		case -1:
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+		p = r->pos;
+	}
+	r->pos = p;
+
+	if(r->buf[p] == '<')
+		return 1;
+
+	while(1) {
+		size_t q = r->pos;
+		int in_string = 0;
+		*quoted = 0;
+		for(; q < r->end; q++) {
+			const char c = r->buf[q];
+			if(in_string) {
+				if(c == '\\')
+					q++;
+				else if(c == '"')
+					in_string = 0;
+			} else if(c == '"') {
+				in_string = *quoted = 1;
+			} else if(c == delimiter || c == '<')
+				break;
+		}
+		if(q < r->end) {
+			size_t start = r->pos;
+			size_t stop = q;
+			/* the '<' of the end tag is not consumed */
+			r->pos = r->buf[q] == delimiter ? q + 1 : q;
+			while(stop > start && strchr(" \t\r\n", r->buf[stop - 1]))
+				stop--;
+			if(*quoted && stop - start >= 2 && r->buf[start] == '"' && r->buf[stop - 1] == '"') {
+				start++;
+				stop--;
+			}
+			*token = r->buf + start;
+			*len = stop - start;
+			return 0;
+		}
+		/* the token continues beyond the buffer */
+		switch(refill(r)) {
+		case 0:
+			XLALPrintError("%s(): \"%s\": unterminated Stream\n", __func__, r->filename);
+			XLAL_ERROR(XLAL_EDATA);
+		case -1:
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+	}
+}
+
+
+/* how a document column is read */
+struct column_map {
+	int column;		/* table column, or -1 to skip */
+	int is_ns;		/* the nanoseconds of a GPS column */
+	int is_ilwd;		/* ilwd:char ids, "table:column:N" */
+	int is_real;		/* document type is real_4 or real_8 */
+};
+
+
+static INT8 parse_int(const char *s, size_t len)
+{
+	const char *end = s + len;
+	UINT8 x = 0;
+	int negative = 0;
+	if(s < end && (*s == '-' || *s == '+'))
+		negative = *s++ == '-';
+	for(; s < end && *s >= '0' && *s <= '9'; s++)
+		x = 10 * x + (*s - '0');
+	return negative ? -(INT8) x : (INT8) x;
+}
+
+
+static REAL8 parse_real(struct reader *r, char *s, size_t len)
+{
+	char save = s[len];
+	char *dot = NULL;
+	REAL8 x;
+	s[len] = '\0';
+	if(r->decimal_point != '.' && (dot = strchr(s, '.')))
+		*dot = r->decimal_point;
+	x = strtod(s, NULL);
+	if(dot)
+		*dot = '.';
+	s[len] = save;
+	return x;
+}
+
+
+/* integer value of a token in a column of the given document type */
+static INT8 token_int(struct reader *r, const struct column_map *map, char *s, size_t len)
+{
+	if(map->is_ilwd) {
+		const char *c = memchr(s, ':', len);
+		const char *last = c;
+		while(c) {
+			last = c;
+			c = memchr(c + 1, ':', s + len - c - 1);
+		}
+		return last ? parse_int(last + 1, s + len - last - 1) : parse_int(s, len);
+	}
+	if(map->is_real)
+		return (INT8) parse_real(r, s, len);
+	return parse_int(s, len);
+}
+
+
+/* copy a quoted string token into a fixed-width field, removing the
+ * backslash escapes */
+static void copy_string(char *dst, size_t width, const char *s, size_t len, int quoted)
+{
+	size_t i, n = 0;
+	for(i = 0; i < len && n < width - 1; i++) {
+		if(quoted && s[i] == '\\' && i + 1 < len)
+			i++;
+		dst[n++] = s[i];
+	}
+	dst[n] = '\0';
+}
+
+
+/**
+ * Read a sngl_burst, sim_burst, sngl_inspiral or sim_inspiral table from
+ * a LIGO Light Weight XML file, which may be gzip-compressed, and append
+ * its rows to table.  The table in the document must be of table's type.
+ *
+ * If columns is not NULL, it is a NULL-terminated list of the names of the
+ * columns to read;  the other columns of the appended rows are zeroed,
+ * and are not converted, which saves time.  If time_column is not NULL,
+ * it names a GPS column, and only the rows whose time is in [start, end)
+ * are appended;  either bound may be NULL.  Columns missing from the
+ * document are left zeroed (empty, for strings), numeric columns are
+ * converted from whatever numeric type the document uses, and id columns
+ * may be int_8s or ilwd:char.
+ *
+ * The document is parsed by a scanner specific to the tables of LIGO
+ * Light Weight documents;  it does not validate the document.  Returns
+ * the number of rows appended, or < 0 on failure.  On failure the table's
+ * length is restored.
+ */
+long XLALLIGOLwColumnarTableAppendFromLIGOLw(
+	LIGOLwColumnarTable *table,
+	const char *filename,
+	const char * const *columns,
+	const char *time_column,
+	const LIGOTimeGPS *start,
+	const LIGOTimeGPS *end
+)
+{
+	const struct table_description *desc;
+	const size_t length = table ? table->length : 0;
+	struct reader r;
+	struct column_map *map = NULL;
+	unsigned char *selected = NULL;
+	int num_doc_columns = 0;
+	int time_index = -1;
+	const INT8 t_start = start ? XLALGPSToINT8NS(start) : 0;
+	const INT8 t_end = end ? XLALGPSToINT8NS(end) : 0;
+	char delimiter = ',';
+	char value[256];
+	char *tag_end;
+	int result;
+	int i;
+
+	if(!table || !filename)
+		XLAL_ERROR(XLAL_EFAULT);
+	desc = get_table_description(table->type);
+	if(!desc)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* columns to be read */
+
+	selected = XLALCalloc(desc->num_columns, 1);
+	if(!selected)
+		XLAL_ERROR(XLAL_ENOMEM);
+	for(i = 0; i < desc->num_columns; i++)
+		selected[i] = !columns;
+	for(; columns && *columns; columns++) {
+		int j = XLALLIGOLwColumnarTableFindColumn(table, *columns);
+		if(j < 0) {
+			XLALFree(selected);
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+		selected[j] = 1;
+	}
+	if(time_column) {
+		time_index = XLALLIGOLwColumnarTableFindColumn(table, time_column);
+		if(time_index < 0 || desc->columns[time_index].type != LIGOLW_COLUMN_GPS) {
+			XLALFree(selected);
+			XLAL_ERROR(XLAL_EINVAL, "\"%s\" is not a GPS column", time_column);
+		}
+		selected[time_index] = 1;
+	}
+
+	/* open the file */
+
+	memset(&r, 0, sizeof(r));
+	r.filename = filename;
+	r.decimal_point = localeconv()->decimal_point[0];
+	r.fp = XLALFileOpenRead(filename);
+	if(!r.fp) {
+		XLALFree(selected);
+		XLAL_ERROR(XLAL_EIO, "error opening \"%s\"", filename);
+	}
+
+#define FAIL(...) do { \
+	XLALFileClose(r.fp); \
+	XLALFree(r.buf); \
+	XLALFree(map); \
+	XLALFree(selected); \
+	table->length = length; \
+	XLAL_ERROR(__VA_ARGS__); \
+} while(0)
+
+	/* find the table */
+
+	while(1) {
+		result = next_tag(&r, &tag_end);
+		if(result < 0)
+			FAIL(XLAL_EFUNC);
+		if(result > 0)
+			FAIL(XLAL_EDATA, "cannot find %s table in \"%s\"", desc->name, filename);
+		if(tag_is(&r, "Table") && !get_attribute(&r, tag_end, "Name", value, sizeof(value)) && !strcmp(strip_name(value), desc->name))
+			break;
+		r.pos = tag_end - r.buf + 1;
+	}
+	r.pos = tag_end - r.buf + 1;
+
+	/* map the document's columns to the table's, up to the Stream */
+
+	while(1) {
+		result = next_tag(&r, &tag_end);
+		if(result < 0)
+			FAIL(XLAL_EFUNC);
+		if(result > 0 || tag_is(&r, "/Table"))
+			FAIL(XLAL_EDATA, "%s table in \"%s\" has no Stream", desc->name, filename);
+		if(tag_is(&r, "Column")) {
+			struct column_map *new = XLALRealloc(map, (num_doc_columns + 1) * sizeof(*map));
+			struct column_map *m;
+			char type[32] = "";
+			const char *name;
+			if(!new)
+				FAIL(XLAL_ENOMEM);
+			map = new;
+			m = &map[num_doc_columns++];
+			if(get_attribute(&r, tag_end, "Name", value, sizeof(value)))
+				FAIL(XLAL_EDATA, "Column without Name in \"%s\"", filename);
+			get_attribute(&r, tag_end, "Type", type, sizeof(type));
+			name = strip_name(value);
+			m->column = -1;
+			m->is_ns = 0;
+			m->is_ilwd = !strcmp(type, "ilwd:char");
+			m->is_real = !strncmp(type, "real_", 5);
+			for(i = 0; i < desc->num_columns; i++) {
+				const struct column_description *col = &desc->columns[i];
+				const size_t len = strlen(col->name);
+				if(!selected[i] || strncmp(name, col->name, len))
+					continue;
+				if(!name[len]) {
+					m->column = i;
+					break;
+				}
+				if(col->type == LIGOLW_COLUMN_GPS && !strcmp(name + len, "_ns")) {
+					m->column = i;
+					m->is_ns = 1;
+					break;
+				}
+			}
+			if(m->column >= 0 && (desc->columns[m->column].type == LIGOLW_COLUMN_LSTRING) != (!strcmp(type, "lstring") || !strncmp(type, "char_", 5)))
+				FAIL(XLAL_EDATA, "column \"%s\" in \"%s\" has wrong type", value, filename);
+		} else if(tag_is(&r, "Stream")) {
+			if(!get_attribute(&r, tag_end, "Delimiter", value, sizeof(value)) && value[0])
+				delimiter = value[0];
+			r.pos = tag_end - r.buf + 1;
+			break;
+		}
+		r.pos = tag_end - r.buf + 1;
+	}
+	if(!num_doc_columns)
+		FAIL(XLAL_EDATA, "%s table in \"%s\" has no columns", desc->name, filename);
+
+	/* read the rows.  each row is parsed into the slot after the end of
+	 * the table, which is kept only if it passes the time selection */
+
+	while(1) {
+		size_t row = table->length;
+		char *token;
+		size_t len;
+		int quoted;
+
+		result = next_token(&r, delimiter, &token, &len, &quoted);
+		if(result < 0)
+			FAIL(XLAL_EFUNC);
+		if(result > 0)
+			break;
+		if(XLALResizeLIGOLwColumnarTable(table, row + 1) < 0)
+			FAIL(XLAL_EFUNC);
+
+		for(i = 0; i < num_doc_columns; i++) {
+			const struct column_map *m = &map[i];
+			if(i) {
+				result = next_token(&r, delimiter, &token, &len, &quoted);
+				if(result < 0)
+					FAIL(XLAL_EFUNC);
+				if(result > 0)
+					FAIL(XLAL_EDATA, "incomplete row in %s table in \"%s\"", desc->name, filename);
+			}
+			if(m->column < 0 || !len)
+				continue;
+			{
+			const struct column_description *col = &desc->columns[m->column];
+			void *column = table->columns[m->column];
+			switch(col->type) {
+			case LIGOLW_COLUMN_INT_4S:
+				((INT4 *) column)[row] = token_int(&r, m, token, len);
+				break;
+			case LIGOLW_COLUMN_INT_8S:
+				((INT8 *) column)[row] = token_int(&r, m, token, len);
+				break;
+			case LIGOLW_COLUMN_INT_8U:
+				((UINT8 *) column)[row] = token_int(&r, m, token, len);
+				break;
+			case LIGOLW_COLUMN_REAL_4:
+				((REAL4 *) column)[row] = parse_real(&r, token, len);
+				break;
+			case LIGOLW_COLUMN_REAL_8:
+				((REAL8 *) column)[row] = parse_real(&r, token, len);
+				break;
+			case LIGOLW_COLUMN_LSTRING:
+				copy_string((char *) column + row * col->width, col->width, token, len, quoted);
+				break;
+			case LIGOLW_COLUMN_GPS:
+				((INT8 *) column)[row] += m->is_ns ? token_int(&r, m, token, len) : token_int(&r, m, token, len) * XLAL_BILLION_INT8;
+				break;
+			}
+			}
+		}
+
+		if(time_index >= 0) {
+			const INT8 t = ((const INT8 *) table->columns[time_index])[row];
+			if((start && t < t_start) || (end && t >= t_end))
+				table->length = row;
+		}
+	}
+
+#undef FAIL
+
+	XLALFree(map);
+	XLALFree(selected);
+	XLALFree(r.buf);
+	if(XLALFileClose(r.fp) < 0) {
+		table->length = length;
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	return table->length - length;
+}
+
+
+/**
+ * Read a sngl_burst, sim_burst, sngl_inspiral or sim_inspiral table from
+ * a LIGO Light Weight XML file into a new \c LIGOLwColumnarTable.  No row
+ * structures are created.  See XLALLIGOLwColumnarTableAppendFromLIGOLw(),
+ * which this calls to read all columns and rows, for details.  Returns
+ * NULL on failure.
+ */
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromLIGOLw(const char *filename, LIGOLwColumnarTableType type)
+{
+	LIGOLwColumnarTable *table = XLALCreateLIGOLwColumnarTable(type, 0);
+
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	if(XLALLIGOLwColumnarTableAppendFromLIGOLw(table, filename, NULL, NULL, NULL, NULL) < 0) {
+		XLALDestroyLIGOLwColumnarTable(table);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	return table;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                  Output
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * Rows are formatted into a large buffer which is handed to the file when
+ * it holds at least WRITER_BUFFER_SIZE bytes.  When LAL is built with
+ * pthread support, full buffers are written (and, for .gz files,
+ * compressed) by a background thread while the next buffer is filled.
+ */
+
+
+#define WRITER_BUFFER_SIZE (1 << 20)
+
+
+struct tagLIGOLwXMLTableWriter {
+	LIGOLwXMLStream *xml;
+	const struct table_description *desc;
+	LIGOLwColumnarTable *scratch;	/* one-row table for appending row structures */
+	char decimal_point;	/* of the current locale, replaced by '.' */
+	size_t row_size_max;
+	UINT8 rows;
+	char *buf[2];
+	int current;		/* index of the buffer being filled */
+	size_t used;		/* bytes used in the buffer being filled */
+	int error;		/* a write has failed */
+#ifdef LAL_PTHREAD_LOCK
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	const char *pending;	/* buffer waiting to be written */
+	size_t pending_len;
+	int finish;
+#endif
+};
+
+
+static int write_buffer(LIGOLwXMLTableWriter *writer, const char *buf, size_t len)
+{
+	return XLALFileWrite(buf, 1, len, writer->xml->fp) == len ? 0 : -1;
+}
+
+
+#ifdef LAL_PTHREAD_LOCK
+static void *writer_thread(void *arg)
+{
+	LIGOLwXMLTableWriter *writer = arg;
+
+	pthread_mutex_lock(&writer->mutex);
+	while(1) {
+		while(!writer->pending && !writer->finish)
+			pthread_cond_wait(&writer->cond, &writer->mutex);
+		if(!writer->pending)
+			break;
+		pthread_mutex_unlock(&writer->mutex);
+		/* the buffer is not touched by the formatting thread until
+		 * pending is cleared, so it is written without the lock */
+		if(write_buffer(writer, writer->pending, writer->pending_len) < 0) {
+			pthread_mutex_lock(&writer->mutex);
+			writer->error = 1;
+		} else
+			pthread_mutex_lock(&writer->mutex);
+		writer->pending = NULL;
+		pthread_cond_broadcast(&writer->cond);
+	}
+	pthread_mutex_unlock(&writer->mutex);
+
+	return NULL;
+}
+#endif
+
+
+/* hand the buffer being filled to the file and start filling the other */
+static int flush_buffer(LIGOLwXMLTableWriter *writer)
+{
+	int error;
+
+	if(!writer->used)
+		return 0;
+#ifdef LAL_PTHREAD_LOCK
+	pthread_mutex_lock(&writer->mutex);
+	while(writer->pending)
+		pthread_cond_wait(&writer->cond, &writer->mutex);
+	error = writer->error;
+	if(!error) {
+		writer->pending = writer->buf[writer->current];
+		writer->pending_len = writer->used;
+		pthread_cond_broadcast(&writer->cond);
+	}
+	pthread_mutex_unlock(&writer->mutex);
+#else
+	error = writer->error = write_buffer(writer, writer->buf[writer->current], writer->used) < 0;
+#endif
+	writer->current ^= 1;
+	writer->used = 0;
+	return error ? -1 : 0;
+}
+
+
+/*
+ * Locale-independent number formatting.  Each function writes the
+ * representation of x at s and returns a pointer to the end of it;  no
+ * '\0' is written.
+ */
+
+
+static char *format_uint(char *s, UINT8 x)
+{
+	char digits[20];
+	int n = 0;
+	do {
+		digits[n++] = '0' + x % 10;
+		x /= 10;
+	} while(x);
+	while(n)
+		*s++ = digits[--n];
+	return s;
+}
+
+
+static char *format_int(char *s, INT8 x)
+{
+	if(x < 0) {
+		*s++ = '-';
+		/* negate as unsigned to cope with the most negative value */
+		return format_uint(s, -(UINT8) x);
+	}
+	return format_uint(s, x);
+}
+
+
+/* the same digits as printf()'s %.<digits>g in the "C" locale */
+static char *format_real(char *s, REAL8 x, int digits, char decimal_point)
+{
+	/* integers below 10^digits are printed by %g without exponent or
+	 * decimal point;  this is the common case of zero-filled columns */
+	const REAL8 limit = digits >= 16 ? 1e15 : 1e8;
+	int n;
+
+	if(fabs(x) < limit && x == (REAL8) (INT8) x) {
+		if(x == 0 && signbit(x))
+			*s++ = '-';
+		return format_int(s, (INT8) x);
+	}
+
+	n = snprintf(s, 32, "%.*g", digits, x);
+	if(decimal_point != '.') {
+		char *c = memchr(s, decimal_point, n);
+		if(c)
+			*c = '.';
+	}
+	return s + n;
+}
+
+
+/* printf()'s %16g, with the locale's decimal point replaced */
+static char *format_real_16g(char *s, REAL8 x, char decimal_point)
+{
+	int n = snprintf(s, 32, "%16g", x);
+	if(decimal_point != '.') {
+		char *c = memchr(s, decimal_point, n);
+		if(c)
+			*c = '.';
+	}
+	return s + n;
+}
+
+
+static char *format_gps(char *s, INT8 ns)
+{
+	LIGOTimeGPS gps;
+	XLALINT8NSToGPS(&gps, ns);
+	s = format_int(s, gps.gpsSeconds);
+	*s++ = ',';
+	return format_int(s, gps.gpsNanoSeconds);
+}
+
+
+/* format row i of table, which has the writer's table type, into the
+ * buffer being filled */
+static void format_row(LIGOLwXMLTableWriter *writer, const LIGOLwColumnarTable *table, size_t i)
+{
+	const struct table_description *desc = writer->desc;
+	char *s = writer->buf[writer->current] + writer->used;
+	char *start = s;
+	int j;
+
+	if(writer->rows) {
+		memcpy(s, ",\n\t\t\t", 5);
+		s += 5;
+	} else {
+		memcpy(s, "\n\t\t\t", 4);
+		s += 4;
+	}
+
+	for(j = 0; j < desc->num_columns; j++) {
+		const struct column_description *col = &desc->columns[j];
+		const void *column = table->columns[j];
+		if(j)
+			*s++ = ',';
+		switch(col->type) {
+		case LIGOLW_COLUMN_INT_4S:
+			if(col->format == FORMAT_UNSIGNED)
+				s = format_uint(s, (UINT4) ((const INT4 *) column)[i]);
+			else
+				s = format_int(s, ((const INT4 *) column)[i]);
+			break;
+		case LIGOLW_COLUMN_INT_8S:
+			s = format_int(s, ((const INT8 *) column)[i]);
+			break;
+		case LIGOLW_COLUMN_INT_8U:
+			s = format_uint(s, ((const UINT8 *) column)[i]);
+			break;
+		case LIGOLW_COLUMN_REAL_4:
+			if(col->format == FORMAT_16G)
+				s = format_real_16g(s, ((const REAL4 *) column)[i], writer->decimal_point);
+			else
+				s = format_real(s, ((const REAL4 *) column)[i], desc->real_4_digits, writer->decimal_point);
+			break;
+		case LIGOLW_COLUMN_REAL_8:
+			s = format_real(s, ((const REAL8 *) column)[i], 16, writer->decimal_point);
+			break;
+		case LIGOLW_COLUMN_LSTRING: {
+			const char *str = (const char *) column + i * col->width;
+			size_t len = strnlen(str, col->width);
+			*s++ = '"';
+			memcpy(s, str, len);
+			s += len;
+			*s++ = '"';
+			break;
+		}
+		case LIGOLW_COLUMN_GPS:
+			s = format_gps(s, ((const INT8 *) column)[i]);
+			break;
+		}
+	}
+
+	writer->used += s - start;
+	writer->rows++;
+}
+
+
+static const char *column_type_name(LIGOLwColumnType type)
+{
+	switch(type) {
+	case LIGOLW_COLUMN_INT_4S:
+	case LIGOLW_COLUMN_GPS:
+		return "int_4s";
+	case LIGOLW_COLUMN_INT_8S:
+		return "int_8s";
+	case LIGOLW_COLUMN_INT_8U:
+		return "int_8u";
+	case LIGOLW_COLUMN_REAL_4:
+		return "real_4";
+	case LIGOLW_COLUMN_REAL_8:
+		return "real_8";
+	case LIGOLW_COLUMN_LSTRING:
+		return "lstring";
+	}
+	return NULL;
+}
+
+
+static void free_writer(LIGOLwXMLTableWriter *writer)
+{
+	if(writer) {
+		XLALDestroyLIGOLwColumnarTable(writer->scratch);
+		XLALFree(writer->buf[0]);
+		XLALFree(writer->buf[1]);
+		XLALFree(writer);
+	}
+}
+
+
+/**
+ * Start writing a sngl_burst, sim_burst, sngl_inspiral or sim_inspiral
+ * table to an XML file.  The table header is written immediately;  rows
+ * are then added with the XLALLIGOLwXMLTableWriterAppend*() functions, as
+ * many at a time as is convenient, and the table is completed with
+ * XLALLIGOLwXMLEndTable(), which must be called even if an append has
+ * failed.  No other table can be written to the stream in the meantime.
+ * Returns NULL on failure.
+ */
+LIGOLwXMLTableWriter *XLALLIGOLwXMLBeginTable(LIGOLwXMLStream *xml, LIGOLwColumnarTableType type)
+{
+	const struct table_description *desc = get_table_description(type);
+	LIGOLwXMLTableWriter *writer;
+	size_t row_size_max = 5;	/* row delimiter */
+	int i;
+
+	if(!desc)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	if(!xml)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if(xml->table != no_table) {
+		XLALPrintError("a table is still open");
+		XLAL_ERROR_NULL(XLAL_EFAILED);
+	}
+
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePrintf(xml->fp, "\t<Table Name=\"%s:table\">\n", desc->name);
+	for(i = 0; i < desc->num_columns; i++) {
+		const struct column_description *col = &desc->columns[i];
+		XLALFilePrintf(xml->fp, "\t\t<Column Name=\"%s:%s\" Type=\"%s\"/>\n", col->table, col->name, column_type_name(col->type));
+		if(col->type == LIGOLW_COLUMN_GPS)
+			XLALFilePrintf(xml->fp, "\t\t<Column Name=\"%s:%s_ns\" Type=\"int_4s\"/>\n", col->table, col->name);
+		/* room for the value and its delimiter */
+		row_size_max += col->type == LIGOLW_COLUMN_LSTRING ? col->width + 3 : 48;
+	}
+	XLALFilePrintf(xml->fp, "\t\t<Stream Name=\"%s:table\" Type=\"Local\" Delimiter=\",\">%s", desc->name, desc->stream_newline ? "\n" : "");
+	if(XLALGetBaseErrno())
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	/* writer */
+
+	writer = XLALCalloc(1, sizeof(*writer));
+	if(!writer)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	writer->xml = xml;
+	writer->desc = desc;
+	writer->decimal_point = localeconv()->decimal_point[0];
+	writer->row_size_max = row_size_max;
+	writer->scratch = XLALCreateLIGOLwColumnarTable(type, 1);
+	writer->buf[0] = XLALMalloc(WRITER_BUFFER_SIZE + row_size_max);
+	writer->buf[1] = XLALMalloc(WRITER_BUFFER_SIZE + row_size_max);
+	if(!writer->scratch || !writer->buf[0] || !writer->buf[1]) {
+		free_writer(writer);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+#ifdef LAL_PTHREAD_LOCK
+	pthread_mutex_init(&writer->mutex, NULL);
+	pthread_cond_init(&writer->cond, NULL);
+	if(pthread_create(&writer->thread, NULL, writer_thread, writer)) {
+		pthread_cond_destroy(&writer->cond);
+		pthread_mutex_destroy(&writer->mutex);
+		free_writer(writer);
+		XLAL_ERROR_NULL(XLAL_ESYS, "cannot start writer thread");
+	}
+#endif
+
+	xml->table = desc->metadata_type;
+	xml->rowCount = 0;
+
+	return writer;
+}
+
+
+/* format a row and flush the buffer if it is full */
+static int append_row(LIGOLwXMLTableWriter *writer, const LIGOLwColumnarTable *table, size_t i)
+{
+	format_row(writer, table, i);
+	if(writer->used >= WRITER_BUFFER_SIZE && flush_buffer(writer) < 0)
+		XLAL_ERROR(XLAL_EIO);
+	return 0;
+}
+
+
+static int append_struct(LIGOLwXMLTableWriter *writer, LIGOLwColumnarTableType type, const void *row)
+{
+	if(!writer || !row)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(writer->scratch->type != type)
+		XLAL_ERROR(XLAL_ETYPE, "cannot append a %s row to a %s table", table_descriptions[type].name, writer->desc->name);
+	row_to_columns(writer->scratch, 0, row);
+	if(append_row(writer, writer->scratch, 0) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Append all the rows of a \c LIGOLwColumnarTable of the writer's type.
+ * Returns 0 on success, < 0 on failure.
+ */
+int XLALLIGOLwXMLTableWriterAppendColumnar(LIGOLwXMLTableWriter *writer, const LIGOLwColumnarTable *table)
+{
+	size_t i;
+
+	if(!writer || !table)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(table->type != writer->scratch->type)
+		XLAL_ERROR(XLAL_ETYPE, "cannot append a %s table to a %s table", table_descriptions[table->type].name, writer->desc->name);
+
+	for(i = 0; i < table->length; i++)
+		if(append_row(writer, table, i) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Append one row to a sngl_burst table.  The row's next pointer is not
+ * followed.  Returns 0 on success, < 0 on failure.
+ */
+int XLALLIGOLwXMLTableWriterAppendSnglBurst(LIGOLwXMLTableWriter *writer, const SnglBurst *row)
+{
+	if(append_struct(writer, LIGOLW_SNGL_BURST_TABLE, row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Append one row to a sim_burst table.  The row's next pointer is not
+ * followed.  Returns 0 on success, < 0 on failure.
+ */
+int XLALLIGOLwXMLTableWriterAppendSimBurst(LIGOLwXMLTableWriter *writer, const SimBurst *row)
+{
+	if(append_struct(writer, LIGOLW_SIM_BURST_TABLE, row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Append one row to a sngl_inspiral table.  The row's next pointer is not
+ * followed.  Returns 0 on success, < 0 on failure.
+ */
+int XLALLIGOLwXMLTableWriterAppendSnglInspiral(LIGOLwXMLTableWriter *writer, const SnglInspiralTable *row)
+{
+	if(append_struct(writer, LIGOLW_SNGL_INSPIRAL_TABLE, row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Append one row to a sim_inspiral table.  The row's next pointer is not
+ * followed.  Returns 0 on success, < 0 on failure.
+ */
+int XLALLIGOLwXMLTableWriterAppendSimInspiral(LIGOLwXMLTableWriter *writer, const SimInspiralTable *row)
+{
+	if(append_struct(writer, LIGOLW_SIM_INSPIRAL_TABLE, row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Write the remaining rows and the table footer, and free the writer.
+ * Returns 0 on success, < 0 if this or any earlier write to the table
+ * failed.
+ */
+int XLALLIGOLwXMLEndTable(LIGOLwXMLTableWriter *writer)
+{
+	LIGOLwXMLStream *xml;
+	int error;
+
+	if(!writer)
+		XLAL_ERROR(XLAL_EFAULT);
+	xml = writer->xml;
+
+	flush_buffer(writer);
+#ifdef LAL_PTHREAD_LOCK
+	pthread_mutex_lock(&writer->mutex);
+	writer->finish = 1;
+	pthread_cond_broadcast(&writer->cond);
+	pthread_mutex_unlock(&writer->mutex);
+	pthread_join(writer->thread, NULL);
+	pthread_cond_destroy(&writer->cond);
+	pthread_mutex_destroy(&writer->mutex);
+#endif
+	error = writer->error;
+	xml->rowCount = writer->rows;
+	xml->table = no_table;
+	free_writer(writer);
+
+	if(error)
+		XLAL_ERROR(XLAL_EIO, "error writing table rows");
+
+	/* table footer */
+
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Write a \c LIGOLwColumnarTable to an XML file.  The document is the same
+ * as that written by the XLALWriteLIGOLwXML*Table() function for the
+ * corresponding linked list.  Returns 0 on success, < 0 on failure.
+ */
+int XLALWriteLIGOLwXMLColumnarTable(LIGOLwXMLStream *xml, const LIGOLwColumnarTable *table)
+{
+	LIGOLwXMLTableWriter *writer;
+	int result;
+
+	if(!table)
+		XLAL_ERROR(XLAL_EFAULT);
+	writer = XLALLIGOLwXMLBeginTable(xml, table->type);
+	if(!writer)
+		XLAL_ERROR(XLAL_EFUNC);
+	result = XLALLIGOLwXMLTableWriterAppendColumnar(writer, table);
+	if(XLALLIGOLwXMLEndTable(writer) < 0 || result < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                           Selection and Sorting
+ *
+ * ============================================================================
+ */
+
+
+/* replace every column with its elements at the given row indexes, in
+ * order.  when compacting (index[k] >= k) this can be done in place,
+ * otherwise all the new columns are allocated before any is replaced so
+ * that the table is left unchanged on failure */
+static int gather_rows(LIGOLwColumnarTable *table, const size_t *index, size_t length, int in_place)
+{
+	const struct table_description *desc = &table_descriptions[table->type];
+	void **columns = table->columns;
+	int i;
+
+	if(!in_place) {
+		columns = XLALCalloc(desc->num_columns, sizeof(*columns));
+		if(!columns)
+			XLAL_ERROR(XLAL_ENOMEM);
+		for(i = 0; i < desc->num_columns; i++) {
+			columns[i] = XLALMalloc(table->capacity * element_size(&desc->columns[i]));
+			if(!columns[i]) {
+				while(i >= 0)
+					XLALFree(columns[i--]);
+				XLALFree(columns);
+				XLAL_ERROR(XLAL_ENOMEM);
+			}
+		}
+	}
+
+	for(i = 0; i < desc->num_columns; i++) {
+		const size_t size = element_size(&desc->columns[i]);
+		const char *src = table->columns[i];
+		char *dst = columns[i];
+		size_t k;
+
+		switch(size) {
+		case 4:
+			for(k = 0; k < length; k++)
+				((INT4 *) dst)[k] = ((const INT4 *) src)[index[k]];
+			break;
+		case 8:
+			for(k = 0; k < length; k++)
+				((INT8 *) dst)[k] = ((const INT8 *) src)[index[k]];
+			break;
+		default:
+			for(k = 0; k < length; k++)
+				if(dst + k * size != src + index[k] * size)
+					memcpy(dst + k * size, src + index[k] * size, size);
+			break;
+		}
+	}
+
+	if(!in_place) {
+		for(i = 0; i < desc->num_columns; i++)
+			XLALFree(table->columns[i]);
+		XLALFree(table->columns);
+		table->columns = columns;
+	}
+	table->length = length;
+
+	return 0;
+}
+
+
+/**
+ * Remove from the table the rows for which keep[i] is 0, preserving the
+ * order of the remaining rows.  keep must have one element for each row.
+ * Returns the new number of rows, or < 0 on failure.
+ */
+int XLALLIGOLwColumnarTableSelectRows(LIGOLwColumnarTable *table, const unsigned char *keep)
+{
+	size_t *index;
+	size_t length = 0;
+	size_t i;
+
+	if(!table || (!keep && table->length))
+		XLAL_ERROR(XLAL_EFAULT);
+
+	index = XLALMalloc((table->length ? table->length : 1) * sizeof(*index));
+	if(!index)
+		XLAL_ERROR(XLAL_ENOMEM);
+	for(i = 0; i < table->length; i++)
+		if(keep[i])
+			index[length++] = i;
+
+	if(length < table->length && gather_rows(table, index, length, 1) < 0) {
+		XLALFree(index);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALFree(index);
+
+	return table->length;
+}
+
+
+/**
+ * Remove from the table the rows whose time in the named GPS column is
+ * outside the interval [start, end).  Either bound may be NULL, in which
+ * case the interval is unbounded on that side.  The comparisons are
+ * carried out on the integer nanosecond column in a single pass.  Returns
+ * the new number of rows, or < 0 on failure.
+ */
+int XLALLIGOLwColumnarTableSelectTime(LIGOLwColumnarTable *table, const char *column, const LIGOTimeGPS *start, const LIGOTimeGPS *end)
+{
+	const INT8 *t = XLALLIGOLwColumnarTableGetColumn(table, column, LIGOLW_COLUMN_GPS);
+	const INT8 t_start = start ? XLALGPSToINT8NS(start) : 0;
+	const INT8 t_end = end ? XLALGPSToINT8NS(end) : 0;
+	unsigned char *keep;
+	size_t i;
+	int length;
+
+	if(!t)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	keep = XLALMalloc(table->length ? table->length : 1);
+	if(!keep)
+		XLAL_ERROR(XLAL_ENOMEM);
+	for(i = 0; i < table->length; i++)
+		keep[i] = (!start || t[i] >= t_start) & (!end || t[i] < t_end);
+
+	length = XLALLIGOLwColumnarTableSelectRows(table, keep);
+	XLALFree(keep);
+	if(length < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return length;
+}
+
+
+struct sort_key {
+	union {
+		INT8 i;
+		UINT8 u;
+		REAL8 r;
+	} key;
+	size_t index;
+};
+
+
+/* the index breaks ties, which makes qsort() stable */
+
+static int compare_int(const void *a, const void *b)
+{
+	const struct sort_key *ka = a, *kb = b;
+	if(ka->key.i != kb->key.i)
+		return ka->key.i < kb->key.i ? -1 : +1;
+	return ka->index < kb->index ? -1 : ka->index > kb->index;
+}
+
+
+static int compare_uint(const void *a, const void *b)
+{
+	const struct sort_key *ka = a, *kb = b;
+	if(ka->key.u != kb->key.u)
+		return ka->key.u < kb->key.u ? -1 : +1;
+	return ka->index < kb->index ? -1 : ka->index > kb->index;
+}
+
+
+/* NaNs are placed after all other values */
+static int compare_real(const void *a, const void *b)
+{
+	const struct sort_key *ka = a, *kb = b;
+	const int nan_a = isnan(ka->key.r), nan_b = isnan(kb->key.r);
+	if(nan_a != nan_b)
+		return nan_a - nan_b;
+	if(!nan_a && ka->key.r != kb->key.r)
+		return ka->key.r < kb->key.r ? -1 : +1;
+	return ka->index < kb->index ? -1 : ka->index > kb->index;
+}
+
+
+/**
+ * Sort the rows of the table into increasing order of the named numeric
+ * or GPS column.  The sort is stable.  The keys are sorted together with
+ * the row indexes, then each column is permuted once.  Returns 0 on
+ * success, < 0 on failure.
+ */
+int XLALLIGOLwColumnarTableSort(LIGOLwColumnarTable *table, const char *column)
+{
+	int (*compare)(const void *, const void *);
+	struct sort_key *keys;
+	size_t *index;
+	const void *col;
+	size_t i;
+	int c;
+
+	c = XLALLIGOLwColumnarTableFindColumn(table, column);
+	if(c < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(table->length < 2)
+		return 0;
+	col = table->columns[c];
+
+	keys = XLALMalloc(table->length * sizeof(*keys));
+	index = XLALMalloc(table->length * sizeof(*index));
+	if(!keys || !index) {
+		XLALFree(keys);
+		XLALFree(index);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	switch(table_descriptions[table->type].columns[c].type) {
+	case LIGOLW_COLUMN_INT_4S:
+		for(i = 0; i < table->length; i++)
+			keys[i].key.i = ((const INT4 *) col)[i];
+		compare = compare_int;
+		break;
+	case LIGOLW_COLUMN_INT_8S:
+	case LIGOLW_COLUMN_GPS:
+		for(i = 0; i < table->length; i++)
+			keys[i].key.i = ((const INT8 *) col)[i];
+		compare = compare_int;
+		break;
+	case LIGOLW_COLUMN_INT_8U:
+		for(i = 0; i < table->length; i++)
+			keys[i].key.u = ((const UINT8 *) col)[i];
+		compare = compare_uint;
+		break;
+	case LIGOLW_COLUMN_REAL_4:
+		for(i = 0; i < table->length; i++)
+			keys[i].key.r = ((const REAL4 *) col)[i];
+		compare = compare_real;
+		break;
+	case LIGOLW_COLUMN_REAL_8:
+		for(i = 0; i < table->length; i++)
+			keys[i].key.r = ((const REAL8 *) col)[i];
+		compare = compare_real;
+		break;
+	default:
+		XLALFree(keys);
+		XLALFree(index);
+		XLAL_ERROR(XLAL_EINVAL, "cannot sort by string column \"%s\"", column);
+	}
+	for(i = 0; i < table->length; i++)
+		keys[i].index = i;
+
+	qsort(keys, table->length, sizeof(*keys), compare);
+	for(i = 0; i < table->length; i++)
+		index[i] = keys[i].index;
+	XLALFree(keys);
+
+	if(gather_rows(table, index, table->length, 0) < 0) {
+		XLALFree(index);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALFree(index);
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ * \brief Column-oriented containers for the sngl_burst, sim_burst,
+ * sngl_inspiral and sim_inspiral tables.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/LIGOLwXMLColumnar.h>
+ * \endcode
+ *
+ * A \c LIGOLwColumnarTable stores each column of a table in its own
+ * contiguous array instead of storing each row in its own structure.
+ * Tables of this kind can be read from and written to LIGO Light Weight
+ * XML files without creating any row structures, and can be converted to
+ * and from the linked lists of \c SnglBurst, \c SimBurst,
+ * \c SnglInspiralTable and \c SimInspiralTable structures used elsewhere.
+ *
+ * Columns are identified by their names in the XML document, without the
+ * table prefix (e.g., "peak_time", "snr", "Gamma3").  The pairs of
+ * int_4s columns holding the integer and nanosecond parts of GPS times
+ * (e.g., "peak_time" and "peak_time_ns") are stored as a single column of
+ * INT8 nanoseconds bearing the name of the first of the pair.  String
+ * columns are stored as fixed-width arrays of \c char whose width is that
+ * of the corresponding member of the row structure.
+ *
+ * A \c LIGOLwXMLTableWriter writes one of these tables to an XML file
+ * incrementally, so that rows can be written as they are produced.  Rows
+ * are formatted without printf() into large buffers, which are written
+ * (and compressed, if the file name ends in .gz) by a background thread
+ * when LAL is built with pthread support.
+ *
+ * Tables are read by a scanner specific to the Table and Stream elements
+ * of LIGO Light Weight documents rather than by metaio.  Document columns
+ * are matched to table columns once per table, and the rows are converted
+ * directly into the column arrays.  A subset of the columns, and the rows
+ * within a GPS time window, can be selected while reading, and several
+ * files can be read into the same table.
+ */
+
+#ifndef _LIGOLWXMLCOLUMNAR_H
+#define _LIGOLWXMLCOLUMNAR_H
+
+#include <stddef.h>
+#include <lal/LALDatatypes.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOLwXML.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * The tables that can be held in a \c LIGOLwColumnarTable.
+ */
+typedef enum tagLIGOLwColumnarTableType {
+	LIGOLW_SNGL_BURST_TABLE,
+	LIGOLW_SIM_BURST_TABLE,
+	LIGOLW_SNGL_INSPIRAL_TABLE,
+	LIGOLW_SIM_INSPIRAL_TABLE
+} LIGOLwColumnarTableType;
+
+
+/**
+ * The storage types of the columns of a \c LIGOLwColumnarTable.
+ */
+typedef enum tagLIGOLwColumnType {
+	LIGOLW_COLUMN_INT_4S,	/**< INT4 */
+	LIGOLW_COLUMN_INT_8S,	/**< INT8 */
+	LIGOLW_COLUMN_INT_8U,	/**< UINT8 */
+	LIGOLW_COLUMN_REAL_4,	/**< REAL4 */
+	LIGOLW_COLUMN_REAL_8,	/**< REAL8 */
+	LIGOLW_COLUMN_LSTRING,	/**< fixed-width, '\\0'-terminated strings */
+	LIGOLW_COLUMN_GPS	/**< INT8 nanoseconds */
+} LIGOLwColumnType;
+
+
+/**
+ * A table stored by column.  The rows are numbered 0 to length - 1;
+ * columns[i] points to the array holding column i, whose elements are of
+ * the type reported by XLALLIGOLwColumnarTableColumnType().  Memory is
+ * allocated for capacity rows.
+ */
+typedef struct tagLIGOLwColumnarTable {
+	LIGOLwColumnarTableType type;
+	size_t length;
+	size_t capacity;
+	void **columns;
+} LIGOLwColumnarTable;
+
+
+/**
+ * Incremental writer for the tables that can be held in a
+ * \c LIGOLwColumnarTable.  This is an opaque type.
+ */
+typedef struct tagLIGOLwXMLTableWriter LIGOLwXMLTableWriter;
+
+
+LIGOLwColumnarTable *XLALCreateLIGOLwColumnarTable(LIGOLwColumnarTableType type, size_t length);
+void XLALDestroyLIGOLwColumnarTable(LIGOLwColumnarTable *table);
+int XLALResizeLIGOLwColumnarTable(LIGOLwColumnarTable *table, size_t length);
+const char *XLALLIGOLwColumnarTableName(const LIGOLwColumnarTable *table);
+int XLALLIGOLwColumnarTableNumColumns(const LIGOLwColumnarTable *table);
+const char *XLALLIGOLwColumnarTableColumnName(const LIGOLwColumnarTable *table, int column);
+int XLALLIGOLwColumnarTableColumnType(const LIGOLwColumnarTable *table, int column);
+size_t XLALLIGOLwColumnarTableColumnWidth(const LIGOLwColumnarTable *table, int column);
+int XLALLIGOLwColumnarTableFindColumn(const LIGOLwColumnarTable *table, const char *name);
+void *XLALLIGOLwColumnarTableGetColumn(const LIGOLwColumnarTable *table, const char *name, LIGOLwColumnType type);
+
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSnglBurst(const SnglBurst *head);
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSimBurst(const SimBurst *head);
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSnglInspiral(const SnglInspiralTable *head);
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromSimInspiral(const SimInspiralTable *head);
+SnglBurst *XLALSnglBurstFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table);
+SimBurst *XLALSimBurstFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table);
+SnglInspiralTable *XLALSnglInspiralFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table);
+SimInspiralTable *XLALSimInspiralFromLIGOLwColumnarTable(const LIGOLwColumnarTable *table);
+
+LIGOLwColumnarTable *XLALLIGOLwColumnarTableFromLIGOLw(const char *filename, LIGOLwColumnarTableType type);
+long XLALLIGOLwColumnarTableAppendFromLIGOLw(LIGOLwColumnarTable *table, const char *filename, const char * const *columns, const char *time_column, const LIGOTimeGPS *start, const LIGOTimeGPS *end);
+int XLALWriteLIGOLwXMLColumnarTable(LIGOLwXMLStream *xml, const LIGOLwColumnarTable *table);
+
+LIGOLwXMLTableWriter *XLALLIGOLwXMLBeginTable(LIGOLwXMLStream *xml, LIGOLwColumnarTableType type);
+int XLALLIGOLwXMLTableWriterAppendColumnar(LIGOLwXMLTableWriter *writer, const LIGOLwColumnarTable *table);
+int XLALLIGOLwXMLTableWriterAppendSnglBurst(LIGOLwXMLTableWriter *writer, const SnglBurst *row);
+int XLALLIGOLwXMLTableWriterAppendSimBurst(LIGOLwXMLTableWriter *writer, const SimBurst *row);
+int XLALLIGOLwXMLTableWriterAppendSnglInspiral(LIGOLwXMLTableWriter *writer, const SnglInspiralTable *row);
+int XLALLIGOLwXMLTableWriterAppendSimInspiral(LIGOLwXMLTableWriter *writer, const SimInspiralTable *row);
+int XLALLIGOLwXMLEndTable(LIGOLwXMLTableWriter *writer);
+
+int XLALLIGOLwColumnarTableSelectRows(LIGOLwColumnarTable *table, const unsigned char *keep);
+int XLALLIGOLwColumnarTableSelectTime(LIGOLwColumnarTable *table, const char *column, const LIGOTimeGPS *start, const LIGOTimeGPS *end);
+int XLALLIGOLwColumnarTableSort(LIGOLwColumnarTable *table, const char *column);
+
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _LIGOLWXMLCOLUMNAR_H */
@@ -100,7 +100,9 @@ tagMetadataTableType
   sngl_ringdown_table,
   multi_inspiral_table,
   sim_inspiral_table,
-  sim_ringdown_table
+  sim_ringdown_table,
+  sngl_burst_table,
+  sim_burst_table
 }
 MetadataTableType;
 
@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301  USA
+ */
+
+
+/*
+ * Check the conversions between LIGOLwColumnarTable and the linked lists
+ * of row structures, and the row selection and sorting functions.
+ */
+
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/Date.h>
+#include <lal/LALMalloc.h>
+#include <lal/LIGOLwXMLColumnar.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/XLALError.h>
+
+
+#define NUM_ROWS 1000
+
+
+#define FAIL(...) do { fprintf(stderr, "%s(): ", __func__); fprintf(stderr, __VA_ARGS__); fprintf(stderr, "\n"); return -1; } while(0)
+
+
+/*
+ * ============================================================================
+ *
+ *                                Test Tables
+ *
+ * ============================================================================
+ */
+
+
+static UINT8 random_state = 1;
+
+
+static UINT8 next_random(void)
+{
+	random_state = random_state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return random_state ^ (random_state >> 29);
+}
+
+
+/* a table of the given type with every entry set */
+static LIGOLwColumnarTable *random_table(LIGOLwColumnarTableType type, size_t length)
+{
+	LIGOLwColumnarTable *table = XLALCreateLIGOLwColumnarTable(type, length);
+	int j;
+
+	if(!table)
+		return NULL;
+
+	for(j = 0; j < XLALLIGOLwColumnarTableNumColumns(table); j++) {
+		const char *name = XLALLIGOLwColumnarTableColumnName(table, j);
+		size_t width = XLALLIGOLwColumnarTableColumnWidth(table, j);
+		void *column = table->columns[j];
+		size_t i;
+
+		for(i = 0; i < table->length; i++) {
+			UINT8 r = next_random();
+			switch(XLALLIGOLwColumnarTableColumnType(table, j)) {
+			case LIGOLW_COLUMN_INT_4S:
+				((INT4 *) column)[i] = (INT4) r;
+				break;
+			case LIGOLW_COLUMN_INT_8S:
+				((INT8 *) column)[i] = (INT8) r;
+				break;
+			case LIGOLW_COLUMN_INT_8U:
+				((UINT8 *) column)[i] = r;
+				break;
+			case LIGOLW_COLUMN_REAL_4:
+				((REAL4 *) column)[i] = (INT8) r * 0x1p-40;
+				break;
+			case LIGOLW_COLUMN_REAL_8:
+				((REAL8 *) column)[i] = (INT8) r * 0x1p-40;
+				break;
+			case LIGOLW_COLUMN_LSTRING:
+				snprintf((char *) column + i * width, width, "%s%u", name, (unsigned) (r % 1000000));
+				break;
+			case LIGOLW_COLUMN_GPS:
+				((INT8 *) column)[i] = (INT8) (r % 2000000000000000000ULL);
+				break;
+			}
+		}
+	}
+
+	return table;
+}
+
+
+/* the row structures all begin with their next pointers */
+static void free_rows(void *head)
+{
+	while(head) {
+		void *next = *(void **) head;
+		XLALFree(head);
+		head = next;
+	}
+}
+
+
+static int tables_equal(const LIGOLwColumnarTable *a, const LIGOLwColumnarTable *b)
+{
+	int j;
+
+	if(a->type != b->type || a->length != b->length)
+		return 0;
+	for(j = 0; j < XLALLIGOLwColumnarTableNumColumns(a); j++) {
+		size_t width = XLALLIGOLwColumnarTableColumnWidth(a, j);
+		size_t i;
+		if(XLALLIGOLwColumnarTableColumnType(a, j) == LIGOLW_COLUMN_LSTRING) {
+			for(i = 0; i < a->length; i++)
+				if(strncmp((const char *) a->columns[j] + i * width, (const char *) b->columns[j] + i * width, width))
+					return 0;
+		} else {
+			size_t size = XLALLIGOLwColumnarTableColumnType(a, j) == LIGOLW_COLUMN_INT_4S || XLALLIGOLwColumnarTableColumnType(a, j) == LIGOLW_COLUMN_REAL_4 ? 4 : 8;
+			if(memcmp(a->columns[j], b->columns[j], a->length * size))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                Round Trips
+ *
+ * ============================================================================
+ */
+
+
+/* row list -> columnar table -> row list for each table type, and a few
+ * members of each row structure checked against the columns by name */
+
+
+static int test_sngl_burst(void)
+{
+	LIGOLwColumnarTable *a = random_table(LIGOLW_SNGL_BURST_TABLE, NUM_ROWS);
+	SnglBurst *rows = XLALSnglBurstFromLIGOLwColumnarTable(a);
+	LIGOLwColumnarTable *b = XLALLIGOLwColumnarTableFromSnglBurst(rows);
+	SnglBurst *rows2 = XLALSnglBurstFromLIGOLwColumnarTable(b);
+	const SnglBurst *row, *row2;
+	size_t i;
+
+	if(!a || !rows || !b || !rows2)
+		FAIL("conversion failed");
+	if(!tables_equal(a, b))
+		FAIL("columnar tables differ");
+	for(i = 0, row = rows, row2 = rows2; row && row2; i++, row = row->next, row2 = row2->next) {
+		if(strcmp(row->ifo, (const char *) XLALLIGOLwColumnarTableGetColumn(a, "ifo", LIGOLW_COLUMN_LSTRING) + i * sizeof(row->ifo)) ||
+		   XLALGPSToINT8NS(&row->peak_time) != ((const INT8 *) XLALLIGOLwColumnarTableGetColumn(a, "peak_time", LIGOLW_COLUMN_GPS))[i] ||
+		   row->snr != ((const REAL4 *) XLALLIGOLwColumnarTableGetColumn(a, "snr", LIGOLW_COLUMN_REAL_4))[i] ||
+		   row->chisq_dof != ((const REAL8 *) XLALLIGOLwColumnarTableGetColumn(a, "chisq_dof", LIGOLW_COLUMN_REAL_8))[i] ||
+		   row->event_id != ((const INT8 *) XLALLIGOLwColumnarTableGetColumn(a, "event_id", LIGOLW_COLUMN_INT_8S))[i])
+			FAIL("row %zu does not match the columns", i);
+		if(memcmp((const char *) row + sizeof(row->next), (const char *) row2 + sizeof(row2->next), sizeof(*row) - sizeof(row->next)))
+			FAIL("row %zu changed in the round trip", i);
+	}
+	if(i != NUM_ROWS || row || row2)
+		FAIL("wrong number of rows");
+
+	free_rows(rows);
+	free_rows(rows2);
+	XLALDestroyLIGOLwColumnarTable(a);
+	XLALDestroyLIGOLwColumnarTable(b);
+	return 0;
+}
+
+
+static int test_sim_burst(void)
+{
+	LIGOLwColumnarTable *a = random_table(LIGOLW_SIM_BURST_TABLE, NUM_ROWS);
+	SimBurst *rows = XLALSimBurstFromLIGOLwColumnarTable(a);
+	LIGOLwColumnarTable *b = XLALLIGOLwColumnarTableFromSimBurst(rows);
+	SimBurst *rows2 = XLALSimBurstFromLIGOLwColumnarTable(b);
+	const SimBurst *row, *row2;
+	size_t i;
+
+	if(!a || !rows || !b || !rows2)
+		FAIL("conversion failed");
+	if(!tables_equal(a, b))
+		FAIL("columnar tables differ");
+	for(i = 0, row = rows, row2 = rows2; row && row2; i++, row = row->next, row2 = row2->next) {
+		if(strcmp(row->waveform, (const char *) XLALLIGOLwColumnarTableGetColumn(a, "waveform", LIGOLW_COLUMN_LSTRING) + i * sizeof(row->waveform)) ||
+		   XLALGPSToINT8NS(&row->time_geocent_gps) != ((const INT8 *) XLALLIGOLwColumnarTableGetColumn(a, "time_geocent_gps", LIGOLW_COLUMN_GPS))[i] ||
+		   row->hrss != ((const REAL8 *) XLALLIGOLwColumnarTableGetColumn(a, "hrss", LIGOLW_COLUMN_REAL_8))[i] ||
+		   row->waveform_number != ((const UINT8 *) XLALLIGOLwColumnarTableGetColumn(a, "waveform_number", LIGOLW_COLUMN_INT_8U))[i] ||
+		   row->time_slide_id != ((const INT8 *) XLALLIGOLwColumnarTableGetColumn(a, "time_slide_id", LIGOLW_COLUMN_INT_8S))[i])
+			FAIL("row %zu does not match the columns", i);
+		if(memcmp((const char *) row + sizeof(row->next), (const char *) row2 + sizeof(row2->next), sizeof(*row) - sizeof(row->next)))
+			FAIL("row %zu changed in the round trip", i);
+	}
+	if(i != NUM_ROWS || row || row2)
+		FAIL("wrong number of rows");
+
+	free_rows(rows);
+	free_rows(rows2);
+	XLALDestroyLIGOLwColumnarTable(a);
+	XLALDestroyLIGOLwColumnarTable(b);
+	return 0;
+}
+
+
+static int test_sngl_inspiral(void)
+{
+	LIGOLwColumnarTable *a = random_table(LIGOLW_SNGL_INSPIRAL_TABLE, NUM_ROWS);
+	SnglInspiralTable *rows = XLALSnglInspiralFromLIGOLwColumnarTable(a);
+	LIGOLwColumnarTable *b = XLALLIGOLwColumnarTableFromSnglInspiral(rows);
+	SnglInspiralTable *rows2 = XLALSnglInspiralFromLIGOLwColumnarTable(b);
+	const SnglInspiralTable *row, *row2;
+	size_t i;
+
+	if(!a || !rows || !b || !rows2)
+		FAIL("conversion failed");
+	if(!tables_equal(a, b))
+		FAIL("columnar tables differ");
+	for(i = 0, row = rows, row2 = rows2; row && row2; i++, row = row->next, row2 = row2->next) {
+		if(strcmp(row->channel, (const char *) XLALLIGOLwColumnarTableGetColumn(a, "channel", LIGOLW_COLUMN_LSTRING) + i * sizeof(row->channel)) ||
+		   XLALGPSToINT8NS(&row->end) != ((const INT8 *) XLALLIGOLwColumnarTableGetColumn(a, "end_time", LIGOLW_COLUMN_GPS))[i] ||
+		   row->chisq_dof != ((const INT4 *) XLALLIGOLwColumnarTableGetColumn(a, "chisq_dof", LIGOLW_COLUMN_INT_4S))[i] ||
+		   row->Gamma[7] != ((const REAL4 *) XLALLIGOLwColumnarTableGetColumn(a, "Gamma7", LIGOLW_COLUMN_REAL_4))[i] ||
+		   row->sigmasq != ((const REAL8 *) XLALLIGOLwColumnarTableGetColumn(a, "sigmasq", LIGOLW_COLUMN_REAL_8))[i] ||
+		   row->spin2z != ((const REAL4 *) XLALLIGOLwColumnarTableGetColumn(a, "spin2z", LIGOLW_COLUMN_REAL_4))[i])
+			FAIL("row %zu does not match the columns", i);
+		if(memcmp((const char *) row + sizeof(row->next), (const char *) row2 + sizeof(row2->next), sizeof(*row) - sizeof(row->next)))
+			FAIL("row %zu changed in the round trip", i);
+	}
+	if(i != NUM_ROWS || row || row2)
+		FAIL("wrong number of rows");
+
+	free_rows(rows);
+	free_rows(rows2);
+	XLALDestroyLIGOLwColumnarTable(a);
+	XLALDestroyLIGOLwColumnarTable(b);
+	return 0;
+}
+
+
+static int test_sim_inspiral(void)
+{
+	LIGOLwColumnarTable *a = random_table(LIGOLW_SIM_INSPIRAL_TABLE, NUM_ROWS);
+	SimInspiralTable *rows = XLALSimInspiralFromLIGOLwColumnarTable(a);
+	LIGOLwColumnarTable *b = XLALLIGOLwColumnarTableFromSimInspiral(rows);
+	SimInspiralTable *rows2 = XLALSimInspiralFromLIGOLwColumnarTable(b);
+	const SimInspiralTable *row, *row2;
+	size_t i;
+
+	if(!a || !rows || !b || !rows2)
+		FAIL("conversion failed");
+	if(!tables_equal(a, b))
+		FAIL("columnar tables differ");
+	for(i = 0, row = rows, row2 = rows2; row && row2; i++, row = row->next, row2 = row2->next) {
+		if(strcmp(row->numrel_data, (const char *) XLALLIGOLwColumnarTableGetColumn(a, "numrel_data", LIGOLW_COLUMN_LSTRING) + i * sizeof(row->numrel_data)) ||
+		   XLALGPSToINT8NS(&row->v_end_time) != ((const INT8 *) XLALLIGOLwColumnarTableGetColumn(a, "v_end_time", LIGOLW_COLUMN_GPS))[i] ||
+		   row->eff_dist_v != ((const REAL4 *) XLALLIGOLwColumnarTableGetColumn(a, "eff_dist_v", LIGOLW_COLUMN_REAL_4))[i] ||
+		   row->end_time_gmst != ((const REAL8 *) XLALLIGOLwColumnarTableGetColumn(a, "end_time_gmst", LIGOLW_COLUMN_REAL_8))[i] ||
+		   row->bandpass != ((const INT4 *) XLALLIGOLwColumnarTableGetColumn(a, "bandpass", LIGOLW_COLUMN_INT_4S))[i] ||
+		   row->simulation_id != ((const INT8 *) XLALLIGOLwColumnarTableGetColumn(a, "simulation_id", LIGOLW_COLUMN_INT_8S))[i])
+			FAIL("row %zu does not match the columns", i);
+		if(memcmp((const char *) row + sizeof(row->next), (const char *) row2 + sizeof(row2->next), sizeof(*row) - sizeof(row->next)))
+			FAIL("row %zu changed in the round trip", i);
+	}
+	if(i != NUM_ROWS || row || row2)
+		FAIL("wrong number of rows");
+
+	free_rows(rows);
+	free_rows(rows2);
+	XLALDestroyLIGOLwColumnarTable(a);
+	XLALDestroyLIGOLwColumnarTable(b);
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                             Select and Sort
+ *
+ * ============================================================================
+ */
+
+
+/* a sngl_inspiral table whose event_id is the original row number, and
+ * whose other columns are derived from it so that permutations of the
+ * rows can be checked */
+static LIGOLwColumnarTable *indexed_table(size_t length)
+{
+	LIGOLwColumnarTable *table = XLALCreateLIGOLwColumnarTable(LIGOLW_SNGL_INSPIRAL_TABLE, length);
+	INT8 *event_id;
+	INT8 *end_time;
+	REAL4 *snr;
+	char *ifo;
+	size_t width;
+	size_t i;
+
+	if(!table)
+		return NULL;
+	event_id = XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S);
+	end_time = XLALLIGOLwColumnarTableGetColumn(table, "end_time", LIGOLW_COLUMN_GPS);
+	snr = XLALLIGOLwColumnarTableGetColumn(table, "snr", LIGOLW_COLUMN_REAL_4);
+	ifo = XLALLIGOLwColumnarTableGetColumn(table, "ifo", LIGOLW_COLUMN_LSTRING);
+	width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "ifo"));
+
+	for(i = 0; i < length; i++) {
+		event_id[i] = i;
+		/* 1000000000 s + 0.1 s per row, in a scrambled order */
+		end_time[i] = 1000000000000000000LL + (INT8) ((i * 7919) % length) * 100000000;
+		/* few distinct values, so that there are ties */
+		snr[i] = (i * 31) % 17;
+		snprintf(ifo + i * width, width, "%c%u", 'A' + (int) (i % 26), (unsigned) (i % 10));
+	}
+	/* NaNs sort last */
+	snr[length / 2] = NAN;
+
+	return table;
+}
+
+
+/* the columns derived from event_id still agree with it */
+static int check_indexed_rows(const LIGOLwColumnarTable *table, size_t length)
+{
+	const INT8 *event_id = XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S);
+	const INT8 *end_time = XLALLIGOLwColumnarTableGetColumn(table, "end_time", LIGOLW_COLUMN_GPS);
+	const REAL4 *snr = XLALLIGOLwColumnarTableGetColumn(table, "snr", LIGOLW_COLUMN_REAL_4);
+	const char *ifo = XLALLIGOLwColumnarTableGetColumn(table, "ifo", LIGOLW_COLUMN_LSTRING);
+	size_t width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "ifo"));
+	size_t i;
+
+	for(i = 0; i < table->length; i++) {
+		size_t k = event_id[i];
+		char expected[16];
+		snprintf(expected, width, "%c%u", 'A' + (int) (k % 26), (unsigned) (k % 10));
+		if(end_time[i] != 1000000000000000000LL + (INT8) ((k * 7919) % length) * 100000000 ||
+		   (k == length / 2 ? !isnan(snr[i]) : snr[i] != (k * 31) % 17) ||
+		   strcmp(ifo + i * width, expected))
+			return 0;
+	}
+	return 1;
+}
+
+
+static int test_select(void)
+{
+	LIGOLwColumnarTable *table = indexed_table(NUM_ROWS);
+	unsigned char keep[NUM_ROWS];
+	LIGOTimeGPS start, end;
+	const INT8 *event_id;
+	const INT8 *end_time;
+	size_t expected = 0;
+	size_t i;
+
+	if(!table)
+		FAIL("cannot create table");
+
+	/* every third row removed */
+	for(i = 0; i < NUM_ROWS; i++)
+		keep[i] = i % 3 != 0;
+	if(XLALLIGOLwColumnarTableSelectRows(table, keep) != NUM_ROWS - (NUM_ROWS + 2) / 3)
+		FAIL("wrong number of rows selected");
+	event_id = XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S);
+	for(i = 0; i < table->length; i++)
+		if(event_id[i] != (INT8) (i + i / 2 + 1))
+			FAIL("wrong rows selected");
+	if(!check_indexed_rows(table, NUM_ROWS))
+		FAIL("columns not selected together");
+
+	/* the rows from 1000000010 s to 1000000020 s, including the start
+	 * but not the end */
+	XLALGPSSet(&start, 1000000010, 0);
+	XLALGPSSet(&end, 1000000020, 0);
+	if(XLALLIGOLwColumnarTableSelectTime(table, "end_time", &start, &end) < 0)
+		FAIL("cannot select by time");
+	end_time = XLALLIGOLwColumnarTableGetColumn(table, "end_time", LIGOLW_COLUMN_GPS);
+	event_id = XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S);
+	for(i = 0; i < NUM_ROWS; i++) {
+		INT8 t = 1000000000000000000LL + (INT8) ((i * 7919) % NUM_ROWS) * 100000000;
+		expected += i % 3 != 0 && t >= XLALGPSToINT8NS(&start) && t < XLALGPSToINT8NS(&end);
+	}
+	if(table->length != expected)
+		FAIL("%zu rows in the time window, expected %zu", table->length, expected);
+	for(i = 0; i < table->length; i++)
+		if(end_time[i] < XLALGPSToINT8NS(&start) || end_time[i] >= XLALGPSToINT8NS(&end) || (i && event_id[i] <= event_id[i - 1]))
+			FAIL("wrong rows selected by time");
+	if(!check_indexed_rows(table, NUM_ROWS))
+		FAIL("columns not selected together");
+
+	/* unbounded windows keep everything */
+	i = table->length;
+	if(XLALLIGOLwColumnarTableSelectTime(table, "end_time", NULL, NULL) != (int) i)
+		FAIL("unbounded window removed rows");
+
+	/* only GPS columns */
+	XLALClearErrno();
+	if(XLALLIGOLwColumnarTableSelectTime(table, "snr", &start, NULL) >= 0)
+		FAIL("selected by a column that is not a time");
+	XLALClearErrno();
+
+	XLALDestroyLIGOLwColumnarTable(table);
+	return 0;
+}
+
+
+static int test_sort(void)
+{
+	LIGOLwColumnarTable *table = indexed_table(NUM_ROWS);
+	const INT8 *event_id;
+	const INT8 *end_time;
+	const REAL4 *snr;
+	size_t i;
+
+	if(!table)
+		FAIL("cannot create table");
+
+	/* by a real column with ties:  stable, with the NaN last */
+	if(XLALLIGOLwColumnarTableSort(table, "snr") < 0)
+		FAIL("cannot sort by snr");
+	event_id = XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S);
+	snr = XLALLIGOLwColumnarTableGetColumn(table, "snr", LIGOLW_COLUMN_REAL_4);
+	for(i = 1; i < table->length - 1; i++)
+		if(snr[i] < snr[i - 1] || (snr[i] == snr[i - 1] && event_id[i] < event_id[i - 1]))
+			FAIL("not sorted by snr at row %zu", i);
+	if(!isnan(snr[table->length - 1]))
+		FAIL("NaN not sorted last");
+	if(!check_indexed_rows(table, NUM_ROWS))
+		FAIL("columns not permuted together");
+
+	/* by a GPS column */
+	if(XLALLIGOLwColumnarTableSort(table, "end_time") < 0)
+		FAIL("cannot sort by end_time");
+	end_time = XLALLIGOLwColumnarTableGetColumn(table, "end_time", LIGOLW_COLUMN_GPS);
+	for(i = 0; i < table->length; i++)
+		if(end_time[i] != 1000000000000000000LL + (INT8) i * 100000000)
+			FAIL("not sorted by end_time at row %zu", i);
+	if(!check_indexed_rows(table, NUM_ROWS))
+		FAIL("columns not permuted together");
+
+	/* and back by an integer column */
+	if(XLALLIGOLwColumnarTableSort(table, "event_id") < 0)
+		FAIL("cannot sort by event_id");
+	event_id = XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S);
+	for(i = 0; i < table->length; i++)
+		if(event_id[i] != (INT8) i)
+			FAIL("not sorted by event_id at row %zu", i);
+	if(!check_indexed_rows(table, NUM_ROWS))
+		FAIL("columns not permuted together");
+
+	/* not by strings or missing columns */
+	XLALClearErrno();
+	if(XLALLIGOLwColumnarTableSort(table, "ifo") >= 0)
+		FAIL("sorted by a string column");
+	XLALClearErrno();
+	if(XLALLIGOLwColumnarTableSort(table, "no_such_column") >= 0)
+		FAIL("sorted by a missing column");
+	XLALClearErrno();
+
+	XLALDestroyLIGOLwColumnarTable(table);
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                Entry Point
+ *
+ * ============================================================================
+ */
+
+
+int main(void)
+{
+	int result = 0;
+
+	if(test_sngl_burst() || test_sim_burst() || test_sngl_inspiral() || test_sim_inspiral())
+		result = 1;
+	if(test_select() || test_sort())
+		result = 1;
+
+	LALCheckMemoryLeaks();
+
+	return result;
+}
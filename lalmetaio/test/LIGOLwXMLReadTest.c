@@ -0,0 +1,489 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301  USA
+ */
+
+
+/*
+ * Check XLALLIGOLwColumnarTableAppendFromLIGOLw() against metaio on
+ * sngl_burst documents with ilwd:char ids, escaped strings, columns in an
+ * unusual order, a missing column and an unknown column, plain and
+ * gzip-compressed, read whole, by column and by time, and appended one
+ * after another.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <metaio.h>
+
+#include <lal/Date.h>
+#include <lal/FileIO.h>
+#include <lal/LALMalloc.h>
+#include <lal/LALStdio.h>
+#include <lal/LIGOLwXMLColumnar.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/XLALError.h>
+
+
+#define PLAIN_FILE "LIGOLwXMLReadTest.xml"
+#define GZ_FILE "LIGOLwXMLReadTest.xml.gz"
+
+#define NUM_PLAIN_ROWS 700
+#define NUM_GZ_ROWS 300
+
+
+#define FAIL(...) do { fprintf(stderr, "%s(): ", __func__); fprintf(stderr, __VA_ARGS__); fprintf(stderr, "\n"); return -1; } while(0)
+
+
+/*
+ * ============================================================================
+ *
+ *                                Documents
+ *
+ * ============================================================================
+ */
+
+
+/* strings that must be quoted and escaped, or that look like other
+ * tokens */
+static const char *const search_names[] = {
+	"excesspower",
+	"comma,separated",
+	"say \"hello\"",
+	"back\\slash",
+	"two words",
+	"1234"
+};
+
+
+static UINT8 random_state = 1;
+
+
+static UINT8 next_random(void)
+{
+	random_state = random_state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return random_state ^ (random_state >> 29);
+}
+
+
+/* the expected contents of the documents:  rows 0 to NUM_PLAIN_ROWS - 1
+ * are in the plain file, the rest in the compressed file.  confidence is
+ * not in the documents and stays zero */
+static LIGOLwColumnarTable *expected_table(void)
+{
+	LIGOLwColumnarTable *table = XLALCreateLIGOLwColumnarTable(LIGOLW_SNGL_BURST_TABLE, NUM_PLAIN_ROWS + NUM_GZ_ROWS);
+	size_t ifo_width, search_width, channel_width;
+	size_t i;
+
+	if(!table)
+		return NULL;
+	ifo_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "ifo"));
+	search_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "search"));
+	channel_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "channel"));
+
+	for(i = 0; i < table->length; i++) {
+		INT8 peak = (INT8) (900000000 + i * 10) * XLAL_BILLION_INT8 + (INT8) (next_random() % XLAL_BILLION_INT8);
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(table, "process_id", LIGOLW_COLUMN_INT_8S))[i] = i < NUM_PLAIN_ROWS ? 0 : 1;
+		strncpy((char *) XLALLIGOLwColumnarTableGetColumn(table, "ifo", LIGOLW_COLUMN_LSTRING) + i * ifo_width, i % 2 ? "L1" : "H1", ifo_width - 1);
+		strncpy((char *) XLALLIGOLwColumnarTableGetColumn(table, "search", LIGOLW_COLUMN_LSTRING) + i * search_width, search_names[i % XLAL_NUM_ELEM(search_names)], search_width - 1);
+		snprintf((char *) XLALLIGOLwColumnarTableGetColumn(table, "channel", LIGOLW_COLUMN_LSTRING) + i * channel_width, channel_width, "%s:LSC-STRAIN_%zu", i % 2 ? "L1" : "H1", i);
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(table, "start_time", LIGOLW_COLUMN_GPS))[i] = peak - (INT8) (next_random() % XLAL_BILLION_INT8);
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(table, "peak_time", LIGOLW_COLUMN_GPS))[i] = peak;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(table, "duration", LIGOLW_COLUMN_REAL_4))[i] = (next_random() % 1000000) * 1e-6;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(table, "central_freq", LIGOLW_COLUMN_REAL_4))[i] = (next_random() % 2000000) * 1e-3;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(table, "bandwidth", LIGOLW_COLUMN_REAL_4))[i] = (next_random() % 512) + 0.5;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(table, "amplitude", LIGOLW_COLUMN_REAL_4))[i] = (next_random() % 1000000) * 1e-27;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(table, "snr", LIGOLW_COLUMN_REAL_4))[i] = (next_random() % 100000) * 1e-3;
+		((REAL8 *) XLALLIGOLwColumnarTableGetColumn(table, "chisq", LIGOLW_COLUMN_REAL_8))[i] = (next_random() % 1000000000) * 1e-4;
+		((REAL8 *) XLALLIGOLwColumnarTableGetColumn(table, "chisq_dof", LIGOLW_COLUMN_REAL_8))[i] = next_random() % 64;
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S))[i] = i;
+	}
+
+	return table;
+}
+
+
+/* a string as a quoted Stream token */
+static int print_string(LALFILE *fp, const char *s)
+{
+	if(XLALFilePuts("\"", fp) < 0)
+		return -1;
+	for(; *s; s++) {
+		char c[3] = {'\\', *s, '\0'};
+		if(XLALFilePuts(*s == '"' || *s == '\\' ? c : c + 1, fp) < 0)
+			return -1;
+	}
+	return XLALFilePuts("\"", fp);
+}
+
+
+/* write rows [first, first + n) of the expected table as a sngl_burst
+ * table.  ids are ilwd:char, and the column order is not the usual one */
+static int write_document(const char *filename, const LIGOLwColumnarTable *table, size_t first, size_t n)
+{
+	const INT8 *process_id = XLALLIGOLwColumnarTableGetColumn(table, "process_id", LIGOLW_COLUMN_INT_8S);
+	const char *ifo = XLALLIGOLwColumnarTableGetColumn(table, "ifo", LIGOLW_COLUMN_LSTRING);
+	const char *search = XLALLIGOLwColumnarTableGetColumn(table, "search", LIGOLW_COLUMN_LSTRING);
+	const char *channel = XLALLIGOLwColumnarTableGetColumn(table, "channel", LIGOLW_COLUMN_LSTRING);
+	const INT8 *start_time = XLALLIGOLwColumnarTableGetColumn(table, "start_time", LIGOLW_COLUMN_GPS);
+	const INT8 *peak_time = XLALLIGOLwColumnarTableGetColumn(table, "peak_time", LIGOLW_COLUMN_GPS);
+	const REAL4 *duration = XLALLIGOLwColumnarTableGetColumn(table, "duration", LIGOLW_COLUMN_REAL_4);
+	const REAL4 *central_freq = XLALLIGOLwColumnarTableGetColumn(table, "central_freq", LIGOLW_COLUMN_REAL_4);
+	const REAL4 *bandwidth = XLALLIGOLwColumnarTableGetColumn(table, "bandwidth", LIGOLW_COLUMN_REAL_4);
+	const REAL4 *amplitude = XLALLIGOLwColumnarTableGetColumn(table, "amplitude", LIGOLW_COLUMN_REAL_4);
+	const REAL4 *snr = XLALLIGOLwColumnarTableGetColumn(table, "snr", LIGOLW_COLUMN_REAL_4);
+	const REAL8 *chisq = XLALLIGOLwColumnarTableGetColumn(table, "chisq", LIGOLW_COLUMN_REAL_8);
+	const REAL8 *chisq_dof = XLALLIGOLwColumnarTableGetColumn(table, "chisq_dof", LIGOLW_COLUMN_REAL_8);
+	const INT8 *event_id = XLALLIGOLwColumnarTableGetColumn(table, "event_id", LIGOLW_COLUMN_INT_8S);
+	const size_t ifo_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "ifo"));
+	const size_t search_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "search"));
+	const size_t channel_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "channel"));
+	LALFILE *fp = XLALFileOpen(filename, "w");
+	size_t i;
+
+	if(!fp)
+		return -1;
+
+	XLALClearErrno();
+	XLALFilePuts("<?xml version='1.0' encoding='utf-8'?>\n", fp);
+	XLALFilePuts("<!DOCTYPE LIGO_LW SYSTEM \"http://ldas-sw.ligo.caltech.edu/doc/ligolwAPI/html/ligolw_dtd.txt\">\n", fp);
+	XLALFilePuts("<LIGO_LW>\n", fp);
+	XLALFilePuts("\t<Table Name=\"sngl_burst:table\">\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:event_id\" Type=\"ilwd:char\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:ifo\" Type=\"lstring\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time\" Type=\"int_4s\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time_ns\" Type=\"int_4s\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:search\" Type=\"lstring\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:channel\" Type=\"lstring\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time\" Type=\"int_4s\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time_ns\" Type=\"int_4s\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:duration\" Type=\"real_4\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:flow\" Type=\"real_4\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:central_freq\" Type=\"real_4\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:bandwidth\" Type=\"real_4\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:amplitude\" Type=\"real_4\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:snr\" Type=\"real_4\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq\" Type=\"real_8\"/>\n", fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq_dof\" Type=\"real_8\"/>\n", fp);
+	XLALFilePuts("\t\t<Stream Name=\"sngl_burst:table\" Type=\"Local\" Delimiter=\",\">", fp);
+	if(XLALGetBaseErrno()) {
+		XLALFileClose(fp);
+		return -1;
+	}
+
+	for(i = first; i < first + n; i++) {
+		LIGOTimeGPS start, peak;
+		XLALINT8NSToGPS(&start, start_time[i]);
+		XLALINT8NSToGPS(&peak, peak_time[i]);
+		if(XLALFilePrintf(fp, "%s\"sngl_burst:event_id:%" LAL_INT8_FORMAT "\",", i == first ? "\n\t\t\t" : ",\n\t\t\t", event_id[i]) < 0 ||
+		   print_string(fp, ifo + i * ifo_width) < 0 ||
+		   XLALFilePrintf(fp, ",%d,%d,\"process:process_id:%" LAL_INT8_FORMAT "\",", peak.gpsSeconds, peak.gpsNanoSeconds, process_id[i]) < 0 ||
+		   print_string(fp, search + i * search_width) < 0 ||
+		   XLALFilePuts(",", fp) < 0 ||
+		   print_string(fp, channel + i * channel_width) < 0 ||
+		   XLALFilePrintf(fp, ",%d,%d,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.17g,%.17g", start.gpsSeconds, start.gpsNanoSeconds, duration[i], 40.0, central_freq[i], bandwidth[i], amplitude[i], snr[i], chisq[i], chisq_dof[i]) < 0) {
+			XLALFileClose(fp);
+			return -1;
+		}
+	}
+
+	XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n</LIGO_LW>\n", fp);
+	if(XLALGetBaseErrno()) {
+		XLALFileClose(fp);
+		return -1;
+	}
+	return XLALFileClose(fp);
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                   Checks
+ *
+ * ============================================================================
+ */
+
+
+static size_t element_size(const LIGOLwColumnarTable *table, int column)
+{
+	switch(XLALLIGOLwColumnarTableColumnType(table, column)) {
+	case LIGOLW_COLUMN_INT_4S:
+	case LIGOLW_COLUMN_REAL_4:
+		return 4;
+	case LIGOLW_COLUMN_LSTRING:
+		return XLALLIGOLwColumnarTableColumnWidth(table, column);
+	default:
+		return 8;
+	}
+}
+
+
+/* row i of a must equal row j of b in the named columns, or in all
+ * columns if names is NULL;  the other columns of a must be zero */
+static int rows_equal(const LIGOLwColumnarTable *a, size_t i, const LIGOLwColumnarTable *b, size_t j, const char * const *names)
+{
+	int k;
+
+	for(k = 0; k < XLALLIGOLwColumnarTableNumColumns(a); k++) {
+		const char *name = XLALLIGOLwColumnarTableColumnName(a, k);
+		size_t width = element_size(a, k);
+		const char *x = (const char *) a->columns[k] + i * width;
+		const char *y = (const char *) b->columns[k] + j * width;
+		int selected = !names;
+		const char * const *n;
+		for(n = names; n && *n && !selected; n++)
+			selected = !strcmp(*n, name);
+		if(XLALLIGOLwColumnarTableColumnType(a, k) == LIGOLW_COLUMN_LSTRING) {
+			if(selected ? strncmp(x, y, width) : *x != '\0')
+				return 0;
+		} else {
+			static const char zero[8];
+			if(memcmp(x, selected ? y : zero, width))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+
+/* read the sngl_burst table with metaio, and compare it with rows
+ * [first, first + table->length) of the expected table and with the rows
+ * of table, which was read from the same document */
+static int check_against_metaio(const char *filename, const LIGOLwColumnarTable *table, const LIGOLwColumnarTable *expected, size_t first)
+{
+	struct MetaioParseEnvironment env;
+	struct {
+		int process_id, ifo, search, channel, start_time, start_time_ns, peak_time, peak_time_ns, duration, central_freq, bandwidth, amplitude, snr, chisq, chisq_dof, event_id;
+	} pos;
+	const size_t ifo_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "ifo"));
+	const size_t search_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "search"));
+	const size_t channel_width = XLALLIGOLwColumnarTableColumnWidth(table, XLALLIGOLwColumnarTableFindColumn(table, "channel"));
+	LIGOLwColumnarTable *row = XLALCreateLIGOLwColumnarTable(LIGOLW_SNGL_BURST_TABLE, 1);
+	size_t i;
+	int result;
+
+	if(!row)
+		FAIL("cannot create table");
+	if(MetaioOpenFile(&env, filename) || MetaioOpenTableOnly(&env, "sngl_burst")) {
+		MetaioAbort(&env);
+		XLALDestroyLIGOLwColumnarTable(row);
+		FAIL("metaio cannot read %s: %s", filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+	}
+
+	XLALClearErrno();
+	pos.process_id = XLALLIGOLwFindColumn(&env, "process_id", METAIO_TYPE_ILWD_CHAR, 1);
+	pos.ifo = XLALLIGOLwFindColumn(&env, "ifo", METAIO_TYPE_LSTRING, 1);
+	pos.search = XLALLIGOLwFindColumn(&env, "search", METAIO_TYPE_LSTRING, 1);
+	pos.channel = XLALLIGOLwFindColumn(&env, "channel", METAIO_TYPE_LSTRING, 1);
+	pos.start_time = XLALLIGOLwFindColumn(&env, "start_time", METAIO_TYPE_INT_4S, 1);
+	pos.start_time_ns = XLALLIGOLwFindColumn(&env, "start_time_ns", METAIO_TYPE_INT_4S, 1);
+	pos.peak_time = XLALLIGOLwFindColumn(&env, "peak_time", METAIO_TYPE_INT_4S, 1);
+	pos.peak_time_ns = XLALLIGOLwFindColumn(&env, "peak_time_ns", METAIO_TYPE_INT_4S, 1);
+	pos.duration = XLALLIGOLwFindColumn(&env, "duration", METAIO_TYPE_REAL_4, 1);
+	pos.central_freq = XLALLIGOLwFindColumn(&env, "central_freq", METAIO_TYPE_REAL_4, 1);
+	pos.bandwidth = XLALLIGOLwFindColumn(&env, "bandwidth", METAIO_TYPE_REAL_4, 1);
+	pos.amplitude = XLALLIGOLwFindColumn(&env, "amplitude", METAIO_TYPE_REAL_4, 1);
+	pos.snr = XLALLIGOLwFindColumn(&env, "snr", METAIO_TYPE_REAL_4, 1);
+	pos.chisq = XLALLIGOLwFindColumn(&env, "chisq", METAIO_TYPE_REAL_8, 1);
+	pos.chisq_dof = XLALLIGOLwFindColumn(&env, "chisq_dof", METAIO_TYPE_REAL_8, 1);
+	pos.event_id = XLALLIGOLwFindColumn(&env, "event_id", METAIO_TYPE_ILWD_CHAR, 1);
+	if(XLALGetBaseErrno()) {
+		MetaioAbort(&env);
+		XLALDestroyLIGOLwColumnarTable(row);
+		FAIL("metaio cannot find the columns of %s", filename);
+	}
+
+	/* convert each metaio row to a one-row columnar table */
+
+	for(i = 0; (result = MetaioGetRow(&env)) > 0; i++) {
+		const struct MetaioRowElement *elt = env.ligo_lw.table.elt;
+		LIGOTimeGPS gps;
+
+		if(i >= table->length) {
+			MetaioAbort(&env);
+			XLALDestroyLIGOLwColumnarTable(row);
+			FAIL("%s: more rows read by metaio", filename);
+		}
+		XLALResizeLIGOLwColumnarTable(row, 0);
+		XLALResizeLIGOLwColumnarTable(row, 1);
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(row, "process_id", LIGOLW_COLUMN_INT_8S))[0] = XLALLIGOLwParseIlwdChar(&env, pos.process_id, "process", "process_id");
+		strncpy(XLALLIGOLwColumnarTableGetColumn(row, "ifo", LIGOLW_COLUMN_LSTRING), elt[pos.ifo].data.lstring.data, ifo_width - 1);
+		strncpy(XLALLIGOLwColumnarTableGetColumn(row, "search", LIGOLW_COLUMN_LSTRING), elt[pos.search].data.lstring.data, search_width - 1);
+		strncpy(XLALLIGOLwColumnarTableGetColumn(row, "channel", LIGOLW_COLUMN_LSTRING), elt[pos.channel].data.lstring.data, channel_width - 1);
+		XLALGPSSet(&gps, elt[pos.start_time].data.int_4s, elt[pos.start_time_ns].data.int_4s);
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(row, "start_time", LIGOLW_COLUMN_GPS))[0] = XLALGPSToINT8NS(&gps);
+		XLALGPSSet(&gps, elt[pos.peak_time].data.int_4s, elt[pos.peak_time_ns].data.int_4s);
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(row, "peak_time", LIGOLW_COLUMN_GPS))[0] = XLALGPSToINT8NS(&gps);
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(row, "duration", LIGOLW_COLUMN_REAL_4))[0] = elt[pos.duration].data.real_4;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(row, "central_freq", LIGOLW_COLUMN_REAL_4))[0] = elt[pos.central_freq].data.real_4;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(row, "bandwidth", LIGOLW_COLUMN_REAL_4))[0] = elt[pos.bandwidth].data.real_4;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(row, "amplitude", LIGOLW_COLUMN_REAL_4))[0] = elt[pos.amplitude].data.real_4;
+		((REAL4 *) XLALLIGOLwColumnarTableGetColumn(row, "snr", LIGOLW_COLUMN_REAL_4))[0] = elt[pos.snr].data.real_4;
+		((REAL8 *) XLALLIGOLwColumnarTableGetColumn(row, "chisq", LIGOLW_COLUMN_REAL_8))[0] = elt[pos.chisq].data.real_8;
+		((REAL8 *) XLALLIGOLwColumnarTableGetColumn(row, "chisq_dof", LIGOLW_COLUMN_REAL_8))[0] = elt[pos.chisq_dof].data.real_8;
+		((INT8 *) XLALLIGOLwColumnarTableGetColumn(row, "event_id", LIGOLW_COLUMN_INT_8S))[0] = XLALLIGOLwParseIlwdChar(&env, pos.event_id, "sngl_burst", "event_id");
+
+		if(!rows_equal(row, 0, expected, first + i, NULL)) {
+			MetaioAbort(&env);
+			XLALDestroyLIGOLwColumnarTable(row);
+			FAIL("%s: row %zu read by metaio is not the row written", filename, i);
+		}
+		if(!rows_equal(row, 0, table, i, NULL)) {
+			MetaioAbort(&env);
+			XLALDestroyLIGOLwColumnarTable(row);
+			FAIL("%s: row %zu read by metaio and by the columnar reader differ", filename, i);
+		}
+	}
+	XLALDestroyLIGOLwColumnarTable(row);
+	if(result < 0) {
+		MetaioAbort(&env);
+		FAIL("metaio cannot parse %s: %s", filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+	}
+	if(MetaioClose(&env))
+		FAIL("metaio cannot parse %s: %s", filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+	if(i != table->length)
+		FAIL("%s: %zu rows read by metaio, %zu by the columnar reader", filename, i, table->length);
+
+	return 0;
+}
+
+
+/* each document read whole, and checked against metaio */
+static int test_whole(const LIGOLwColumnarTable *expected)
+{
+	LIGOLwColumnarTable *table;
+
+	table = XLALLIGOLwColumnarTableFromLIGOLw(PLAIN_FILE, LIGOLW_SNGL_BURST_TABLE);
+	if(!table || table->length != NUM_PLAIN_ROWS)
+		FAIL("cannot read %s", PLAIN_FILE);
+	if(check_against_metaio(PLAIN_FILE, table, expected, 0))
+		FAIL("%s differs", PLAIN_FILE);
+	XLALDestroyLIGOLwColumnarTable(table);
+
+	table = XLALLIGOLwColumnarTableFromLIGOLw(GZ_FILE, LIGOLW_SNGL_BURST_TABLE);
+	if(!table || table->length != NUM_GZ_ROWS)
+		FAIL("cannot read %s", GZ_FILE);
+	if(check_against_metaio(GZ_FILE, table, expected, NUM_PLAIN_ROWS))
+		FAIL("%s differs", GZ_FILE);
+	XLALDestroyLIGOLwColumnarTable(table);
+
+	return 0;
+}
+
+
+/* both documents appended to the same table, some columns at a time, and
+ * rows in a time window */
+static int test_append(const LIGOLwColumnarTable *expected)
+{
+	static const char * const subset[] = {"event_id", "snr", "channel", "peak_time", NULL};
+	const INT8 *peak_time = XLALLIGOLwColumnarTableGetColumn(expected, "peak_time", LIGOLW_COLUMN_GPS);
+	LIGOLwColumnarTable *table = XLALCreateLIGOLwColumnarTable(LIGOLW_SNGL_BURST_TABLE, 0);
+	LIGOTimeGPS start, end;
+	size_t i, j;
+
+	if(!table)
+		FAIL("cannot create table");
+
+	/* all columns */
+
+	if(XLALLIGOLwColumnarTableAppendFromLIGOLw(table, PLAIN_FILE, NULL, NULL, NULL, NULL) != NUM_PLAIN_ROWS ||
+	   XLALLIGOLwColumnarTableAppendFromLIGOLw(table, GZ_FILE, NULL, NULL, NULL, NULL) != NUM_GZ_ROWS)
+		FAIL("cannot append documents");
+	if(table->length != expected->length)
+		FAIL("wrong number of rows");
+	for(i = 0; i < table->length; i++)
+		if(!rows_equal(table, i, expected, i, NULL))
+			FAIL("row %zu of the appended documents is wrong", i);
+
+	/* a subset of the columns, appended after the rows already read */
+
+	if(XLALLIGOLwColumnarTableAppendFromLIGOLw(table, GZ_FILE, subset, NULL, NULL, NULL) != NUM_GZ_ROWS)
+		FAIL("cannot append columns of %s", GZ_FILE);
+	for(i = 0; i < NUM_GZ_ROWS; i++)
+		if(!rows_equal(table, expected->length + i, expected, NUM_PLAIN_ROWS + i, subset))
+			FAIL("row %zu of the column subset is wrong", i);
+
+	/* a time window spanning both documents, in the order of
+	 * the documents */
+
+	XLALResizeLIGOLwColumnarTable(table, 0);
+	XLALINT8NSToGPS(&start, peak_time[NUM_PLAIN_ROWS - 100]);
+	XLALINT8NSToGPS(&end, peak_time[NUM_PLAIN_ROWS + 100]);
+	if(XLALLIGOLwColumnarTableAppendFromLIGOLw(table, GZ_FILE, NULL, "peak_time", &start, &end) < 0 ||
+	   XLALLIGOLwColumnarTableAppendFromLIGOLw(table, PLAIN_FILE, NULL, "peak_time", &start, &end) < 0)
+		FAIL("cannot select rows by time");
+	if(table->length != 200)
+		FAIL("%zu rows in the time window, expected 200", table->length);
+	for(i = 0; i < table->length; i++) {
+		j = i < 100 ? NUM_PLAIN_ROWS + i : NUM_PLAIN_ROWS - 200 + i;
+		if(!rows_equal(table, i, expected, j, NULL))
+			FAIL("row %zu of the time window is wrong", i);
+	}
+
+	/* and a window open at the start, with only some columns read */
+
+	XLALResizeLIGOLwColumnarTable(table, 0);
+	if(XLALLIGOLwColumnarTableAppendFromLIGOLw(table, PLAIN_FILE, subset, "peak_time", NULL, &start) != NUM_PLAIN_ROWS - 100)
+		FAIL("cannot select rows before a time");
+	for(i = 0; i < table->length; i++)
+		if(!rows_equal(table, i, expected, i, subset))
+			FAIL("row %zu before the time is wrong", i);
+
+	/* a failed read leaves the table unchanged */
+
+	XLALClearErrno();
+	if(XLALLIGOLwColumnarTableAppendFromLIGOLw(table, "LIGOLwXMLReadTest_missing.xml", NULL, NULL, NULL, NULL) >= 0 || table->length != NUM_PLAIN_ROWS - 100)
+		FAIL("reading a missing file changed the table");
+	XLALClearErrno();
+
+	XLALDestroyLIGOLwColumnarTable(table);
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                Entry Point
+ *
+ * ============================================================================
+ */
+
+
+int main(void)
+{
+	LIGOLwColumnarTable *expected = expected_table();
+	int result = 0;
+
+	if(!expected || write_document(PLAIN_FILE, expected, 0, NUM_PLAIN_ROWS) || write_document(GZ_FILE, expected, NUM_PLAIN_ROWS, NUM_GZ_ROWS)) {
+		fprintf(stderr, "cannot write test documents\n");
+		return 1;
+	}
+
+	if(test_whole(expected) || test_append(expected))
+		result = 1;
+
+	XLALDestroyLIGOLwColumnarTable(expected);
+	LALCheckMemoryLeaks();
+
+	return result;
+}
@@ -0,0 +1,880 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301  USA
+ */
+
+
+/*
+ * Check that the sngl_burst, sngl_inspiral, sim_burst and sim_inspiral
+ * table writers produce the same documents as the printf()-based writers
+ * they replaced, and that the documents are read back correctly by
+ * metaio.
+ */
+
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <metaio.h>
+
+#include <lal/FileIO.h>
+#include <lal/LALMalloc.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLColumnar.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/XLALError.h>
+
+
+#define NEW_FILE "LIGOLwXMLWriteTest.xml"
+#define LEGACY_FILE "LIGOLwXMLWriteTest_legacy.xml"
+
+/* enough rows that the sngl_inspiral table overflows the writer's buffer */
+#define NUM_ROWS 2000
+
+
+/*
+ * ============================================================================
+ *
+ *                              Legacy Writers
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * The table writers as they were before they were replaced by
+ * LIGOLwXMLTableWriter.
+ */
+
+
+static int legacy_write_sngl_burst(
+	LIGOLwXMLStream *xml,
+	const SnglBurst *sngl_burst
+)
+{
+	const char *row_head = "\n\t\t\t";
+
+	if(xml->table != no_table) {
+		XLALPrintError("a table is still open");
+		XLAL_ERROR(XLAL_EFAILED);
+	}
+
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePuts("\t<Table Name=\"sngl_burst:table\">\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:ifo\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:search\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:channel\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:duration\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:central_freq\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:bandwidth\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:amplitude\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:snr\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:confidence\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq_dof\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:event_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Stream Name=\"sngl_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	if(XLALGetBaseErrno())
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* rows */
+
+	for(; sngl_burst; sngl_burst = sngl_burst->next) {
+		if(XLALFilePrintf(xml->fp, "%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,%ld",
+			row_head,
+			sngl_burst->process_id,
+			sngl_burst->ifo,
+			sngl_burst->search,
+			sngl_burst->channel,
+			sngl_burst->start_time.gpsSeconds,
+			sngl_burst->start_time.gpsNanoSeconds,
+			sngl_burst->peak_time.gpsSeconds,
+			sngl_burst->peak_time.gpsNanoSeconds,
+			sngl_burst->duration,
+			sngl_burst->central_freq,
+			sngl_burst->bandwidth,
+			sngl_burst->amplitude,
+			sngl_burst->snr,
+			sngl_burst->confidence,
+			sngl_burst->chisq,
+			sngl_burst->chisq_dof,
+			sngl_burst->event_id
+		) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		row_head = ",\n\t\t\t";
+	}
+
+	/* table footer */
+
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* done */
+
+	return 0;
+}
+
+
+static int legacy_write_sngl_inspiral(
+	LIGOLwXMLStream *xml,
+	const SnglInspiralTable *sngl_inspiral
+)
+{
+	const char *row_head = "\n\t\t\t";
+
+	if(xml->table != no_table) {
+		XLALPrintError("a table is still open");
+		XLAL_ERROR(XLAL_EFAILED);
+	}
+
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePuts("\t<Table Name=\"sngl_inspiral:table\">\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:ifo\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:search\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:channel\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time_gmst\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:impulse_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:impulse_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:template_duration\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:event_duration\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:amplitude\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:eff_distance\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:coa_phase\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mass1\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mass2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mchirp\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mtotal\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:eta\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:kappa\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chi\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau4\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau5\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:ttotal\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:psi0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:psi3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha1\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha4\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha5\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha6\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:beta\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:f_final\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:snr\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chisq\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:bank_chisq\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:bank_chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:cont_chisq\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:cont_chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:sigmasq\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:rsqveto_duration\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma1\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma4\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma5\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma6\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma7\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma8\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma9\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1x\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1y\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1z\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2x\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2y\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2z\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:event_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Stream Name=\"sngl_inspiral:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	if(XLALGetBaseErrno())
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* rows */
+
+	for(; sngl_inspiral; sngl_inspiral = sngl_inspiral->next) {
+		if( XLALFilePrintf(xml->fp,"%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%ld",
+			row_head,
+			sngl_inspiral->process_id,
+			sngl_inspiral->ifo,
+			sngl_inspiral->search,
+			sngl_inspiral->channel,
+			sngl_inspiral->end.gpsSeconds,
+			sngl_inspiral->end.gpsNanoSeconds,
+			sngl_inspiral->end_time_gmst,
+			sngl_inspiral->impulse_time.gpsSeconds,
+			sngl_inspiral->impulse_time.gpsNanoSeconds,
+			sngl_inspiral->template_duration,
+			sngl_inspiral->event_duration,
+			sngl_inspiral->amplitude,
+			sngl_inspiral->eff_distance,
+			sngl_inspiral->coa_phase,
+			sngl_inspiral->mass1,
+			sngl_inspiral->mass2,
+			sngl_inspiral->mchirp,
+			sngl_inspiral->mtotal,
+			sngl_inspiral->eta,
+			sngl_inspiral->kappa,
+			sngl_inspiral->chi,
+			sngl_inspiral->tau0,
+			sngl_inspiral->tau2,
+			sngl_inspiral->tau3,
+			sngl_inspiral->tau4,
+			sngl_inspiral->tau5,
+			sngl_inspiral->ttotal,
+			sngl_inspiral->psi0,
+			sngl_inspiral->psi3,
+			sngl_inspiral->alpha,
+			sngl_inspiral->alpha1,
+			sngl_inspiral->alpha2,
+			sngl_inspiral->alpha3,
+			sngl_inspiral->alpha4,
+			sngl_inspiral->alpha5,
+			sngl_inspiral->alpha6,
+			sngl_inspiral->beta,
+			sngl_inspiral->f_final,
+			sngl_inspiral->snr,
+			sngl_inspiral->chisq,
+			sngl_inspiral->chisq_dof,
+			sngl_inspiral->bank_chisq,
+			sngl_inspiral->bank_chisq_dof,
+			sngl_inspiral->cont_chisq,
+			sngl_inspiral->cont_chisq_dof,
+			sngl_inspiral->sigmasq,
+			sngl_inspiral->rsqveto_duration,
+			sngl_inspiral->Gamma[0],
+			sngl_inspiral->Gamma[1],
+			sngl_inspiral->Gamma[2],
+			sngl_inspiral->Gamma[3],
+			sngl_inspiral->Gamma[4],
+			sngl_inspiral->Gamma[5],
+			sngl_inspiral->Gamma[6],
+			sngl_inspiral->Gamma[7],
+			sngl_inspiral->Gamma[8],
+			sngl_inspiral->Gamma[9],
+			sngl_inspiral->spin1x,
+			sngl_inspiral->spin1y,
+			sngl_inspiral->spin1z,
+			sngl_inspiral->spin2x,
+			sngl_inspiral->spin2y,
+			sngl_inspiral->spin2z,
+			sngl_inspiral->event_id ) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		row_head = ",\n\t\t\t";
+	}
+
+	/* table footer */
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* done */
+	return 0;
+}
+
+
+static int legacy_write_sim_burst(
+	LIGOLwXMLStream *xml,
+	const SimBurst *sim_burst
+)
+{
+	const char *row_head = "\n\t\t\t";
+
+	if(xml->table != no_table) {
+		XLALPrintError("a table is still open");
+		XLAL_ERROR(XLAL_EFAILED);
+	}
+
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePuts("\t<Table Name=\"sim_burst:table\">\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:ra\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:dec\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:psi\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gmst\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:duration\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:frequency\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:bandwidth\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:q\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_angle\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_e\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:amplitude\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:hrss\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:egw_over_rsquared\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform_number\" Type=\"int_8u\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:simulation_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Stream Name=\"sim_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	if(XLALGetBaseErrno())
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* rows */
+
+	for(; sim_burst; sim_burst = sim_burst->next) {
+		if(XLALFilePrintf(xml->fp, "%s%ld,\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,%ld,%ld",
+			row_head,
+			sim_burst->process_id,
+			sim_burst->waveform,
+			sim_burst->ra,
+			sim_burst->dec,
+			sim_burst->psi,
+			sim_burst->time_geocent_gps.gpsSeconds,
+			sim_burst->time_geocent_gps.gpsNanoSeconds,
+			sim_burst->time_geocent_gmst,
+			sim_burst->duration,
+			sim_burst->frequency,
+			sim_burst->bandwidth,
+			sim_burst->q,
+			sim_burst->pol_ellipse_angle,
+			sim_burst->pol_ellipse_e,
+			sim_burst->amplitude,
+			sim_burst->hrss,
+			sim_burst->egw_over_rsquared,
+			sim_burst->waveform_number,
+			sim_burst->time_slide_id,
+			sim_burst->simulation_id
+		) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		row_head = ",\n\t\t\t";
+	}
+
+	/* table footer */
+
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* done */
+
+	return 0;
+}
+
+
+static int legacy_write_sim_inspiral(
+	LIGOLwXMLStream *xml,
+	const SimInspiralTable *sim_inspiral
+)
+{
+	const char *row_head = "\n\t\t\t";
+
+	if(xml->table != no_table) {
+		XLALPrintError("a table is still open");
+		XLAL_ERROR(XLAL_EFAILED);
+	}
+
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePuts("\t<Table Name=\"sim_inspiral:table\">\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:waveform\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:geocent_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:geocent_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:h_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:h_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:l_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:l_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:g_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:g_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:t_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:t_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:v_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:v_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:end_time_gmst\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:source\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:mass1\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:mass2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:mchirp\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eta\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:distance\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:longitude\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:latitude\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:inclination\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:coa_phase\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:polarization\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:psi0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:psi3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha1\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha4\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha5\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha6\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:beta\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin1x\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin1y\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin1z\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin2x\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin2y\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin2z\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:theta0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:phi0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:f_lower\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:f_final\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_h\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_l\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_g\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_t\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_v\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:numrel_mode_min\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:numrel_mode_max\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:numrel_data\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:amp_order\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:taper\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:bandpass\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:simulation_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Stream Name=\"sim_inspiral:table\" Type=\"Local\" Delimiter=\",\">\n", xml->fp);
+
+	if(XLALGetBaseErrno())
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* rows */
+
+	for(; sim_inspiral; sim_inspiral = sim_inspiral->next) {
+		if(XLALFilePrintf(xml->fp, "%s%ld,\"%s\",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.16g,\"%s\",%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%16g,%d,%d,\"%s\",%d,\"%s\",%d,%ld",
+					row_head,
+					sim_inspiral->process_id,
+					sim_inspiral->waveform,
+					sim_inspiral->geocent_end_time.gpsSeconds,
+					sim_inspiral->geocent_end_time.gpsNanoSeconds,
+					sim_inspiral->h_end_time.gpsSeconds,
+					sim_inspiral->h_end_time.gpsNanoSeconds,
+					sim_inspiral->l_end_time.gpsSeconds,
+					sim_inspiral->l_end_time.gpsNanoSeconds,
+					sim_inspiral->g_end_time.gpsSeconds,
+					sim_inspiral->g_end_time.gpsNanoSeconds,
+					sim_inspiral->t_end_time.gpsSeconds,
+					sim_inspiral->t_end_time.gpsNanoSeconds,
+					sim_inspiral->v_end_time.gpsSeconds,
+					sim_inspiral->v_end_time.gpsNanoSeconds,
+					sim_inspiral->end_time_gmst,
+					sim_inspiral->source,
+					sim_inspiral->mass1,
+					sim_inspiral->mass2,
+					sim_inspiral->mchirp,
+					sim_inspiral->eta,
+					sim_inspiral->distance,
+					sim_inspiral->longitude,
+					sim_inspiral->latitude,
+					sim_inspiral->inclination,
+					sim_inspiral->coa_phase,
+					sim_inspiral->polarization,
+					sim_inspiral->psi0,
+					sim_inspiral->psi3,
+					sim_inspiral->alpha,
+					sim_inspiral->alpha1,
+					sim_inspiral->alpha2,
+					sim_inspiral->alpha3,
+					sim_inspiral->alpha4,
+					sim_inspiral->alpha5,
+					sim_inspiral->alpha6,
+					sim_inspiral->beta,
+					sim_inspiral->spin1x,
+					sim_inspiral->spin1y,
+					sim_inspiral->spin1z,
+					sim_inspiral->spin2x,
+					sim_inspiral->spin2y,
+					sim_inspiral->spin2z,
+					sim_inspiral->theta0,
+					sim_inspiral->phi0,
+					sim_inspiral->f_lower,
+					sim_inspiral->f_final,
+					sim_inspiral->eff_dist_h,
+					sim_inspiral->eff_dist_l,
+					sim_inspiral->eff_dist_g,
+					sim_inspiral->eff_dist_t,
+					sim_inspiral->eff_dist_v,
+					sim_inspiral->numrel_mode_min,
+					sim_inspiral->numrel_mode_max,
+					sim_inspiral->numrel_data,
+					sim_inspiral->amp_order,
+					sim_inspiral->taper,
+					sim_inspiral->bandpass,
+					sim_inspiral->simulation_id
+						) < 0)
+						XLAL_ERROR(XLAL_EFUNC);
+		row_head = ",\n\t\t\t";
+	}
+
+	/* table footer */
+
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* done */
+
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                Test Tables
+ *
+ * ============================================================================
+ */
+
+
+static UINT8 random_state = 1;
+
+
+static UINT8 next_random(void)
+{
+	random_state = random_state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return random_state ^ (random_state >> 29);
+}
+
+
+/* zeros, signed zeros, integers, and fractions of very different
+ * magnitudes, to exercise each branch of the number formatting */
+static REAL8 random_real(void)
+{
+	UINT8 r = next_random();
+	REAL8 u = (r >> 11) * (1.0 / 9007199254740992.0);
+
+	switch(r % 8) {
+	case 0:
+		return 0.0;
+	case 1:
+		return -0.0;
+	case 2:
+		return (REAL8) (INT8) (r % 2000001) - 1000000.0;
+	case 3:
+		return 1e9 + (REAL8) (r % 1000000000);
+	case 4:
+		return 1000.0 * u - 500.0;
+	case 5:
+		return 1e-20 * u;
+	case 6:
+		return -1e25 * u;
+	default:
+		return u;
+	}
+}
+
+
+static void fill_table(LIGOLwColumnarTable *table)
+{
+	int j;
+
+	for(j = 0; j < XLALLIGOLwColumnarTableNumColumns(table); j++) {
+		const char *name = XLALLIGOLwColumnarTableColumnName(table, j);
+		size_t width = XLALLIGOLwColumnarTableColumnWidth(table, j);
+		void *column = table->columns[j];
+		size_t i;
+
+		for(i = 0; i < table->length; i++)
+			switch(XLALLIGOLwColumnarTableColumnType(table, j)) {
+			case LIGOLW_COLUMN_INT_4S:
+				((INT4 *) column)[i] = (INT4) (next_random() % 2001) - 1000;
+				break;
+			case LIGOLW_COLUMN_INT_8S:
+				((INT8 *) column)[i] = (INT8) next_random();
+				break;
+			case LIGOLW_COLUMN_INT_8U:
+				((UINT8 *) column)[i] = next_random();
+				break;
+			case LIGOLW_COLUMN_REAL_4:
+				((REAL4 *) column)[i] = random_real();
+				break;
+			case LIGOLW_COLUMN_REAL_8:
+				((REAL8 *) column)[i] = random_real();
+				break;
+			case LIGOLW_COLUMN_LSTRING:
+				snprintf((char *) column + i * width, width, "%s_%u", name, (unsigned) (next_random() % 100000));
+				break;
+			case LIGOLW_COLUMN_GPS:
+				((INT8 *) column)[i] = (INT8) (800000000 + next_random() % 600000000) * 1000000000 + (INT8) (next_random() % 1000000000);
+				break;
+			}
+	}
+}
+
+
+/* the row structures all begin with their next pointers */
+static void free_rows(void *head)
+{
+	while(head) {
+		void *next = *(void **) head;
+		XLALFree(head);
+		head = next;
+	}
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                   Checks
+ *
+ * ============================================================================
+ */
+
+
+static int compare_files(const char *a, const char *b)
+{
+	FILE *fa = fopen(a, "r");
+	FILE *fb = fopen(b, "r");
+	long line = 1;
+	int ca, cb;
+	int result = 0;
+
+	if(!fa || !fb) {
+		fprintf(stderr, "cannot open %s or %s\n", a, b);
+		result = -1;
+	} else
+		do {
+			ca = getc(fa);
+			cb = getc(fb);
+			if(ca != cb) {
+				fprintf(stderr, "%s and %s differ at line %ld\n", a, b, line);
+				result = -1;
+				break;
+			}
+			if(ca == '\n')
+				line++;
+		} while(ca != EOF);
+
+	if(fa)
+		fclose(fa);
+	if(fb)
+		fclose(fb);
+	return result;
+}
+
+
+static int metaio_type(LIGOLwColumnType type)
+{
+	switch(type) {
+	case LIGOLW_COLUMN_INT_4S:
+	case LIGOLW_COLUMN_GPS:
+		return METAIO_TYPE_INT_4S;
+	case LIGOLW_COLUMN_INT_8S:
+		return METAIO_TYPE_INT_8S;
+	case LIGOLW_COLUMN_INT_8U:
+		return METAIO_TYPE_INT_8U;
+	case LIGOLW_COLUMN_REAL_4:
+		return METAIO_TYPE_REAL_4;
+	case LIGOLW_COLUMN_REAL_8:
+		return METAIO_TYPE_REAL_8;
+	case LIGOLW_COLUMN_LSTRING:
+		return METAIO_TYPE_LSTRING;
+	}
+	return METAIO_TYPE_UNKNOWN;
+}
+
+
+static int close_to(REAL8 a, REAL8 b, REAL8 tolerance)
+{
+	return fabs(a - b) <= tolerance * fabs(b);
+}
+
+
+/* read the table from the document with metaio and compare it with the
+ * table that was written */
+static int check_table(const char *filename, const LIGOLwColumnarTable *table)
+{
+	const char *table_name = XLALLIGOLwColumnarTableName(table);
+	int num_columns = XLALLIGOLwColumnarTableNumColumns(table);
+	int pos[num_columns], pos_ns[num_columns];
+	struct MetaioParseEnvironment env;
+	size_t i;
+	int j;
+	int result = 0;
+
+	if(MetaioOpenFile(&env, filename) || MetaioOpenTableOnly(&env, table_name)) {
+		fprintf(stderr, "metaio cannot open the %s table in %s: %s\n", table_name, filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+		MetaioAbort(&env);
+		return -1;
+	}
+
+	for(j = 0; j < num_columns; j++) {
+		const char *name = XLALLIGOLwColumnarTableColumnName(table, j);
+		LIGOLwColumnType type = XLALLIGOLwColumnarTableColumnType(table, j);
+		pos[j] = XLALLIGOLwFindColumn(&env, name, metaio_type(type), 1);
+		pos_ns[j] = 0;
+		if(type == LIGOLW_COLUMN_GPS) {
+			char name_ns[64];
+			snprintf(name_ns, sizeof(name_ns), "%s_ns", name);
+			pos_ns[j] = XLALLIGOLwFindColumn(&env, name_ns, METAIO_TYPE_INT_4S, 1);
+		}
+		if(pos[j] < 0 || pos_ns[j] < 0) {
+			fprintf(stderr, "%s table in %s: column %s not found\n", table_name, filename, name);
+			MetaioAbort(&env);
+			return -1;
+		}
+	}
+
+	for(i = 0; !result && (result = MetaioGetRow(&env)) > 0; i++) {
+		result = 0;
+		if(i >= table->length) {
+			fprintf(stderr, "%s table in %s: too many rows\n", table_name, filename);
+			result = -1;
+			break;
+		}
+		for(j = 0; j < num_columns; j++) {
+			const char *name = XLALLIGOLwColumnarTableColumnName(table, j);
+			const void *column = table->columns[j];
+			const struct MetaioRowElement *elt = &env.ligo_lw.table.elt[pos[j]];
+			int ok = 1;
+
+			switch(XLALLIGOLwColumnarTableColumnType(table, j)) {
+			case LIGOLW_COLUMN_INT_4S:
+				/* the *_chisq_dof columns of sngl_inspiral
+				 * are written unsigned */
+				ok = elt->data.int_4s == ((const INT4 *) column)[i] || (((const INT4 *) column)[i] < 0 && strstr(name, "chisq_dof"));
+				break;
+			case LIGOLW_COLUMN_INT_8S:
+				ok = elt->data.int_8s == ((const INT8 *) column)[i];
+				break;
+			case LIGOLW_COLUMN_INT_8U:
+				ok = elt->data.int_8u == ((const UINT8 *) column)[i];
+				break;
+			case LIGOLW_COLUMN_REAL_4:
+				/* eff_dist_v is written with %16g */
+				ok = close_to(elt->data.real_4, ((const REAL4 *) column)[i], strcmp(name, "eff_dist_v") ? 2e-7 : 1e-5);
+				break;
+			case LIGOLW_COLUMN_REAL_8:
+				ok = close_to(elt->data.real_8, ((const REAL8 *) column)[i], 1e-15);
+				break;
+			case LIGOLW_COLUMN_LSTRING:
+				ok = !strcmp(elt->data.lstring.data, (const char *) column + i * XLALLIGOLwColumnarTableColumnWidth(table, j));
+				break;
+			case LIGOLW_COLUMN_GPS:
+				ok = elt->data.int_4s * (INT8) 1000000000 + env.ligo_lw.table.elt[pos_ns[j]].data.int_4s == ((const INT8 *) column)[i];
+				break;
+			}
+			if(!ok) {
+				fprintf(stderr, "%s table in %s: row %zu: wrong %s\n", table_name, filename, i, name);
+				result = -1;
+			}
+		}
+	}
+	if(result < 0) {
+		if(env.mierrmsg.data && env.mierrmsg.data[0])
+			fprintf(stderr, "%s table in %s: %s\n", table_name, filename, env.mierrmsg.data);
+		MetaioAbort(&env);
+		return -1;
+	}
+	if(i != table->length) {
+		fprintf(stderr, "%s table in %s: %zu rows read, %zu written\n", table_name, filename, i, table->length);
+		MetaioAbort(&env);
+		return -1;
+	}
+
+	if(MetaioClose(&env)) {
+		fprintf(stderr, "metaio cannot parse %s: %s\n", filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+		return -1;
+	}
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                Entry Point
+ *
+ * ============================================================================
+ */
+
+
+int main(void)
+{
+	static const LIGOLwColumnarTableType types[] = {LIGOLW_SNGL_BURST_TABLE, LIGOLW_SNGL_INSPIRAL_TABLE, LIGOLW_SIM_BURST_TABLE, LIGOLW_SIM_INSPIRAL_TABLE};
+	LIGOLwColumnarTable *tables[XLAL_NUM_ELEM(types)];
+	SnglBurst *sngl_burst;
+	SnglInspiralTable *sngl_inspiral;
+	SimBurst *sim_burst;
+	SimInspiralTable *sim_inspiral;
+	LIGOLwXMLStream *xml;
+	size_t k;
+	int result = 0;
+
+	for(k = 0; k < XLAL_NUM_ELEM(types); k++) {
+		tables[k] = XLALCreateLIGOLwColumnarTable(types[k], NUM_ROWS);
+		if(!tables[k]) {
+			fprintf(stderr, "cannot create tables\n");
+			return 1;
+		}
+		fill_table(tables[k]);
+	}
+	sngl_burst = XLALSnglBurstFromLIGOLwColumnarTable(tables[0]);
+	sngl_inspiral = XLALSnglInspiralFromLIGOLwColumnarTable(tables[1]);
+	sim_burst = XLALSimBurstFromLIGOLwColumnarTable(tables[2]);
+	sim_inspiral = XLALSimInspiralFromLIGOLwColumnarTable(tables[3]);
+	if(!sngl_burst || !sngl_inspiral || !sim_burst || !sim_inspiral) {
+		fprintf(stderr, "cannot create rows\n");
+		return 1;
+	}
+
+	/* the same document from each set of writers */
+
+	xml = XLALOpenLIGOLwXMLFile(NEW_FILE);
+	if(!xml || XLALWriteLIGOLwXMLSnglBurstTable(xml, sngl_burst) || XLALWriteLIGOLwXMLSnglInspiralTable(xml, sngl_inspiral) || XLALWriteLIGOLwXMLSimBurstTable(xml, sim_burst) || XLALWriteLIGOLwXMLSimInspiralTable(xml, sim_inspiral) || XLALCloseLIGOLwXMLFile(xml)) {
+		fprintf(stderr, "cannot write %s\n", NEW_FILE);
+		return 1;
+	}
+
+	xml = XLALOpenLIGOLwXMLFile(LEGACY_FILE);
+	if(!xml || legacy_write_sngl_burst(xml, sngl_burst) || legacy_write_sngl_inspiral(xml, sngl_inspiral) || legacy_write_sim_burst(xml, sim_burst) || legacy_write_sim_inspiral(xml, sim_inspiral) || XLALCloseLIGOLwXMLFile(xml)) {
+		fprintf(stderr, "cannot write %s\n", LEGACY_FILE);
+		return 1;
+	}
+
+	if(compare_files(NEW_FILE, LEGACY_FILE))
+		result = 1;
+
+	/* and the document is what was written */
+
+	for(k = 0; k < XLAL_NUM_ELEM(types); k++)
+		if(check_table(NEW_FILE, tables[k]))
+			result = 1;
+
+	free_rows(sngl_burst);
+	free_rows(sngl_inspiral);
+	free_rows(sim_burst);
+	free_rows(sim_inspiral);
+	for(k = 0; k < XLAL_NUM_ELEM(types); k++)
+		XLALDestroyLIGOLwColumnarTable(tables[k]);
+	LALCheckMemoryLeaks();
+
+	return result;
+}
@@ -72,18 +72,20 @@ INT4 verbose=0;
 
 int main(int argc, char *argv[]){
   InputParams inputParams;
-  HeterodyneParams hetParams;
+  HeterodyneParams *hetParams=NULL;
 
-  Filters iirFilters;
+  Filters *iirFilters=NULL;
 
   LALFILE *fpin=NULL;
-  FILE *fpout=NULL;
   LALCache *cache=NULL;
   INT4 count=0;
 
-  CHAR outputfile[256]="";
+  CHAR **outputfiles=NULL;
+  INT4 *gzipoutput=NULL;
   CHAR channel[128]="";
-  const CHAR *psrname;
+
+  CHAR **paramfiles=NULL;
+  INT4 numPulsars=1, p=0;
 
   INT4Vector *starts=NULL, *stops=NULL; /* science segment start and stop times */
   INT4 numSegs=0;
@@ -103,126 +105,26 @@ int main(int argc, char *argv[]){
 
   if( inputParams.verbose ) verbose=1;
 
-  hetParams.heterodyneflag = inputParams.heterodyneflag; /* set type of heterodyne */
-
-  /* read in pulsar data */
-  hetParams.het = XLALReadTEMPOParFile( inputParams.paramfile );
-  hetParams.hetUpdate = NULL;
-  hetParams.outputPhase = inputParams.outputPhase;
-
-  /* set pulsar name - take from par file if available, or if not get from command line args */
-  if( PulsarCheckParam( hetParams.het, "PSRJ" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "PSRJ" );
-  else if( PulsarCheckParam( hetParams.het, "PSRB" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "PSRB" );
-  else if( PulsarCheckParam( hetParams.het, "NAME" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "NAME" );
-  else if( PulsarCheckParam( hetParams.het, "PSR" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "PSR" );
-  else{
-    fprintf(stderr, "No pulsar name specified!\n");
-    exit(0);
-  }
-
-  /* if there is an epoch given manually (i.e. not from the pulsar parameter
-     file) then set it here and overwrite any other value - this is used, for
-     example, with the pulsar hardware injections in which this should be set
-     at 751680013.0 */
-  if(inputParams.manualEpoch != 0.){
-    PulsarSetParam( hetParams.het, "PEPOCH", &inputParams.manualEpoch );
-    PulsarSetParam( hetParams.het, "POSEPOCH", &inputParams.manualEpoch );
-  }
-
-  if(verbose){
-    fprintf(stderr, "I've read in the pulsar parameters for %s.\n", psrname);
-    REAL8 rav, decv, pepochv;
-    if ( PulsarCheckParam( hetParams.het, "RAJ" ) ){ rav = PulsarGetREAL8Param( hetParams.het, "RAJ" ); }
-    else { rav = PulsarGetREAL8ParamOrZero( hetParams.het, "RA" ); }
-
-    if ( PulsarCheckParam( hetParams.het, "DECJ" ) ){ decv = PulsarGetREAL8Param( hetParams.het, "DECJ" ); }
-    else { decv = PulsarGetREAL8ParamOrZero( hetParams.het, "DEC" ); }
+  /* get the pulsar parameter files and output files - either a list of them,
+     all heterodyned in a single pass through the frame data, or a single one
+     from the command line */
+  if( inputParams.pulsarlist[0] != '\0' ){
+    numPulsars = read_pulsar_list(&paramfiles, &outputfiles,
+      inputParams.pulsarlist);
 
-    fprintf(stderr, "alpha = %lf rads, delta = %lf rads.\n", rav, decv);
-
-    if ( PulsarCheckParam( hetParams.het, "F" ) ) {
-      const REAL8Vector *freqsv = PulsarGetREAL8VectorParam( hetParams.het, "F" );
-      UINT4 i = 0;
-
-      pepochv = PulsarGetREAL8ParamOrZero( hetParams.het, "PEPOCH" );
-      for ( i=0; i<freqsv->length; i++ ){ fprintf(stderr, "f%u = %.1e Hz/s^%u, ", i, freqsv->data[i], i); }
-      fprintf(stderr, "epoch = %.1lf.\n", pepochv);
-    }
-
-    fprintf(stderr, "I'm looking for gravitational waves at %.2lf times the pulsars spin frequency.\n", inputParams.freqfactor);
+    if(verbose){ fprintf(stderr, "I've read in a list of %d pulsars.\n", numPulsars); }
   }
-
-  /*if performing fine heterdoyne using same params as coarse */
-  if(inputParams.heterodyneflag == 1 || inputParams.heterodyneflag == 3)
-    hetParams.hetUpdate = hetParams.het;
-
-  hetParams.samplerate = inputParams.samplerate;
-
-  /* set detector */
-  hetParams.detector = *XLALGetSiteInfo( inputParams.ifo );
-
-  if(verbose){  fprintf(stderr, "I've set the detector location for %s.\n", inputParams.ifo); }
-
-  if(inputParams.heterodyneflag == 2 || inputParams.heterodyneflag == 4){ /* if updating parameters read in updated par file */
-    hetParams.hetUpdate = XLALReadTEMPOParFile( inputParams.paramfileupdate );
-
-    /* if there is an epoch given manually (i.e. not from the pulsar parameter
-       file) then set it here and overwrite any other value */
-    if(inputParams.manualEpoch != 0.){
-      PulsarSetParam( hetParams.hetUpdate, "PEPOCH", &inputParams.manualEpoch );
-      PulsarSetParam( hetParams.hetUpdate, "POSEPOCH", &inputParams.manualEpoch );
-    }
-
-    if(verbose){
-      fprintf(stderr, "I've read the updated parameters for %s.\n", psrname);
-
-      REAL8 rav, decv, pepochv;
-      if ( PulsarCheckParam( hetParams.hetUpdate, "RAJ" ) ){ rav = PulsarGetREAL8Param( hetParams.hetUpdate, "RAJ" ); }
-      else { rav = PulsarGetREAL8ParamOrZero( hetParams.hetUpdate, "RA" ); }
-
-      if ( PulsarCheckParam( hetParams.hetUpdate, "DECJ" ) ){ decv = PulsarGetREAL8Param( hetParams.hetUpdate, "DECJ" ); }
-      else { decv = PulsarGetREAL8ParamOrZero( hetParams.hetUpdate, "DEC" ); }
-
-      fprintf(stderr, "alpha = %lf rads, delta = %lf rads.\n", rav, decv);
-
-      if ( PulsarCheckParam( hetParams.hetUpdate, "F" ) ) {
-        const REAL8Vector *freqsv = PulsarGetREAL8VectorParam( hetParams.hetUpdate, "F" );
-        UINT4 i = 0;
-
-        pepochv = PulsarGetREAL8ParamOrZero( hetParams.hetUpdate, "PEPOCH" );
-        for ( i=0; i<freqsv->length; i++ ){ fprintf(stderr, "f%u = %.1e Hz/s^%u, ", i, freqsv->data[i], i); }
-        fprintf(stderr, "epoch = %.1lf.\n", pepochv);
-      }
-    }
+  else{
+    paramfiles = XLALCalloc(1, sizeof(CHAR*));
+    outputfiles = XLALCalloc(1, sizeof(CHAR*));
+    paramfiles[0] = XLALStringDuplicate(inputParams.paramfile);
+    outputfiles[0] = XLALStringDuplicate(inputParams.outputfile);
   }
 
-  if( inputParams.heterodyneflag > 0 ){
-    snprintf(hetParams.earthfile, sizeof(hetParams.earthfile), "%s",
-      inputParams.earthfile);
-    snprintf(hetParams.sunfile, sizeof(hetParams.sunfile), "%s",
-      inputParams.sunfile);
-
-    if( inputParams.timeCorrFile != NULL ){
-      hetParams.timeCorrFile = XLALStringDuplicate( inputParams.timeCorrFile );
-
-      if ( PulsarCheckParam( hetParams.hetUpdate, "UNITS" ) ){
-        if ( !strcmp( PulsarGetStringParam( hetParams.hetUpdate, "UNITS" ), "TDB" ) )
-          hetParams.ttype = TIMECORRECTION_TDB; /* use TDB units i.e. TEMPO standard */
-        else
-          hetParams.ttype = TIMECORRECTION_TCB; /* default to TCB i.e. TEMPO2 standard */
-      }
-      else /* don't recognise units type, so default to the original code */
-        hetParams.ttype = TIMECORRECTION_ORIGINAL;
-    }
-    else{
-      hetParams.timeCorrFile = NULL;
-      hetParams.ttype = TIMECORRECTION_ORIGINAL;
-    }
-  }
+  /* set up the heterodyne parameters for each pulsar */
+  hetParams = XLALCalloc(numPulsars, sizeof(HeterodyneParams));
+  for( p=0; p<numPulsars; p++ )
+    set_heterodyne_params(&hetParams[p], &inputParams, paramfiles[p]);
 
   /* get science segment lists - allocate initial memory for starts and stops */
   if( (starts = XLALCreateINT4Vector(1)) == NULL ||
@@ -268,66 +170,22 @@ data!\n");
   /************************BIT THAT DOES EVERYTHING****************************/
 
   /* set filters - values held for the whole data set so we don't get lots of
-     glitches from the filter ringing */
+     glitches from the filter ringing - each pulsar's data needs its own set */
+  iirFilters = XLALCalloc(numPulsars, sizeof(Filters));
   if(inputParams.filterknee > 0.0){
-    set_filters(&iirFilters, inputParams.filterknee, inputParams.samplerate);
+    for( p=0; p<numPulsars; p++ )
+      set_filters(&iirFilters[p], inputParams.filterknee, inputParams.samplerate);
     if(verbose){  fprintf(stderr, "I've set up the filters.\n");  }
   }
 
-  /* set output file */
-  snprintf(outputfile, sizeof(outputfile), "%s", inputParams.outputfile);
-
-  // check if output should be gzipped due to ".gz" suffix on file name */
-  if ( XLALStringCaseSubstring( outputfile, ".gz" ) != NULL ){
-    if ( inputParams.binaryoutput ){
-      XLALPrintError("Error... do not use a \".gz\" file extension for a binary output file\n");
-    }
-
-    inputParams.gzipoutput = 1;
-    // remove ".gz" suffix
-    CHAR *strloc = XLALStringCaseSubstring( outputfile, ".gz" );
-    strloc[0] = '\0';
-  }
-
-  /* add header to the files: header information will be a string consisting of several lines starting with %%s.
-   *  - the first line will contain the time and date of the file creation
-   *  - the next set of lines will contain the version and git hash of the lalsuite versions
-   *  - the penulimate line will contain the command line inputs used to create the file
-   *  - the final will contain headers for the three columns in the file: GPS time, Real, Imag */
-  if( (fpout = fopen(outputfile, "w")) == NULL ){
-    fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
-    return 0;
+  /* set output files and add headers to them */
+  gzipoutput = XLALCalloc(numPulsars, sizeof(INT4));
+  for( p=0; p<numPulsars; p++ ){
+    gzipoutput[p] = inputParams.gzipoutput;
+    write_output_header(outputfiles[p], &gzipoutput[p], inputParams.binaryoutput,
+      argc, argv);
   }
 
-  CHAR *headerinfo = XLALStringDuplicate("%% File created on ");
-  headerinfo = XLALStringAppend(headerinfo, LogTimeToString( XLALGetTimeOfDay() ));
-  headerinfo = XLALStringAppend(headerinfo, "\n");
-  headerinfo = XLALStringAppend(headerinfo, XLALVCSInfoString( lalPulsarVCSInfoList, 0, "%% " ) );
-  headerinfo = XLALStringAppend(headerinfo, "%% ");
-  for ( INT4 j=0; j<argc; j++ ) {
-    headerinfo = XLALStringAppend(headerinfo, argv[j]);
-    headerinfo = XLALStringAppend(headerinfo, " ");
-  }
-  CHAR dataline[] = "\n%% GPS time\tReal\tImag\n";
-  if ( strlen(headerinfo)+strlen(dataline) > HEADERSIZE ) {
-    fprintf(stderr, "Error... HEADERSIZE needs to be increased to accommodate information\n");
-    return 0;
-  }
-  else{
-    /* fill in rest of string with whitespace */
-    for ( INT4 j=strlen(headerinfo); j<HEADERSIZE; j++ ){ headerinfo = XLALStringAppend(headerinfo, " "); }
-    memcpy(&headerinfo[HEADERSIZE-strlen(dataline)], &dataline[0], sizeof(CHAR)*strlen(dataline));
-
-    /* output the header to the file */
-    size_t rc = fwrite(&headerinfo[0], sizeof(CHAR), HEADERSIZE, fpout);
-    if ( ferror(fpout) || !rc ){
-      fprintf(stderr, "Error... problem writing out header data!\n");
-      exit(1);
-    }
-  }
-  XLALFree( headerinfo );
-  fclose(fpout);
-
   snprintf(channel, sizeof(channel), "%s", inputParams.channel);
 
   #if TRACKMEMUSE
@@ -343,7 +201,7 @@ data!\n");
      as it should be significantly downsampled */
   do{
     COMPLEX16TimeSeries *data=NULL; /* data for heterodyning */
-    COMPLEX16TimeSeries *resampData=NULL; /* resampled data */
+    REAL8TimeSeries *datareal=NULL; /* frame data, shared by all pulsars */
     REAL8Vector *times=NULL; /*times of data read from coarse heterodyne file*/
     INT4 i;
 
@@ -351,12 +209,7 @@ data!\n");
       /* i.e. reading from frame files */
       REAL8 gpstime;
       INT4 duration;
-      REAL8TimeSeries *datareal=NULL;
       LALCache *smalllist=NULL; /* list of frame files for a science segment */
-      LIGOTimeGPS epochdummy;
-
-      epochdummy.gpsSeconds = 0;
-      epochdummy.gpsNanoSeconds = 0;
 
       /* if the seg list has segment before the start time of the available
          data frame then increment the segment and continue */
@@ -376,8 +229,10 @@ data!\n");
       fprintf(stderr, "Getting data between %d and %d.\n", starts->data[count],
         starts->data[count]+duration);
 
-      hetParams.timestamp = (REAL8)starts->data[count];
-      hetParams.length = inputParams.samplerate * duration;
+      for( p=0; p<numPulsars; p++ ){
+        hetParams[p].timestamp = (REAL8)starts->data[count];
+        hetParams[p].length = inputParams.samplerate * duration;
+      }
       gpstime = (REAL8)starts->data[count];
 
       /* if there was no frame file for that segment move on */
@@ -397,13 +252,7 @@ data!\n");
         }
       }
 
-      /* make vector (make sure imaginary parts are set to zero) */
-      if( (data = XLALCreateCOMPLEX16TimeSeries( "", &epochdummy,
-        PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ), 1./inputParams.samplerate, &lalSecondUnit,
-        (INT4)inputParams.samplerate * duration )) == NULL )
-        {  XLALPrintError("Error allocating data memory.\n");  }
-
-      /* read in frame data */
+      /* read in frame data - this is done once for all pulsars */
       if( (datareal = get_frame_data(smalllist, channel, gpstime,
         inputParams.samplerate * duration, duration, inputParams.samplerate,
         inputParams.scaleFac, inputParams.highPass)) == NULL ){
@@ -413,14 +262,11 @@ data!\n");
         if( count < numSegs ){
           count++;/*if not finished reading in all data try next set of frames*/
 
-          XLALDestroyCOMPLEX16TimeSeries( data );
-
           XLALDestroyCache( smalllist );
 
           continue;
         }
         else{
-          XLALDestroyCOMPLEX16TimeSeries( data );
           break; /* if at the end of data anyway then break */
         }
       }
@@ -428,13 +274,6 @@ data!\n");
       /* if any data has successfully been read-in set flag to 0 */
       nodata = 0;
 
-      /* put data into COMPLEX16 vector and set imaginary parts to zero */
-      for( i=0;i<inputParams.samplerate * duration;i++ ){
-        data->data->data[i] = (REAL8)datareal->data->data[i];
-      }
-
-      XLALDestroyREAL8TimeSeries( datareal );
-
       XLALDestroyCache( smalllist );
 
       count++;
@@ -449,7 +288,7 @@ data!\n");
       epochdummy.gpsNanoSeconds = 0;
 
       if( (data = XLALCreateCOMPLEX16TimeSeries( "", &epochdummy,
-        PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ), 1./inputParams.samplerate, &lalSecondUnit, 1))
+        PulsarGetREAL8VectorParamIndividual( hetParams[0].het, "F0" ), 1./inputParams.samplerate, &lalSecondUnit, 1))
           == NULL || (times = XLALCreateREAL8Vector( 1 )) == NULL )
         {  XLALPrintError("Error allocating memory for data.\n");  }
       i=0;
@@ -558,13 +397,13 @@ data!\n");
 
       XLALFileClose(fpin);
 
-      hetParams.timestamp = times->data[0]; /* set initial time stamp */
+      hetParams[0].timestamp = times->data[0]; /* set initial time stamp */
 
       /* resize vector to actual size */
       if( (data = XLALResizeCOMPLEX16TimeSeries( data, 0, i )) == NULL ||
           (times = XLALResizeREAL8Vector(times, i)) == NULL )
         {  XLALPrintError("Error resizing data memory.\n");  }
-      hetParams.length = i;
+      hetParams[0].length = i;
 
       if( verbose ) fprintf(stderr, "I've read in the fine heterodyne data.\n");
     }
@@ -573,125 +412,52 @@ data!\n");
       return 0;
     }
 
-    XLALGPSSetREAL8(&data->epoch, hetParams.timestamp);
-
-    /* heterodyne data */
-    heterodyne_data(data, times, hetParams, inputParams.freqfactor, filtresp);
-    if( verbose ){ fprintf(stderr, "I've heterodyned the data.\n"); }
-
-    /* filter data */
-    if( inputParams.filterknee > 0. ){/* filter if knee frequency is not zero */
-      filter_data(data, &iirFilters);
-
-      if( verbose ){  fprintf(stderr, "I've low pass filtered the data at %.2lf Hz\n", inputParams.filterknee);  }
-    }
-
-    if( inputParams.heterodyneflag==0 || inputParams.heterodyneflag==3 )
-      if( (times = XLALCreateREAL8Vector( data->data->length )) == NULL )
-        XLALPrintError("Error creating vector of data times.\n");
-
-    /* resample data and data times */
-    resampData = resample_data(data, times, starts, stops,
-      inputParams.samplerate, inputParams.resamplerate,
-      inputParams.heterodyneflag);
-    if( verbose ){  fprintf(stderr, "I've resampled the data from %.2lf to %.4lf Hz\n", inputParams.samplerate, inputParams.resamplerate);  }
-
-    XLALDestroyCOMPLEX16TimeSeries( data );
-
-    /*perform outlier removal twice incase very large outliers skew the stddev*/
-    if( inputParams.stddevthresh != 0. ){
-      INT4 numOutliers=0;
-      numOutliers = remove_outliers(resampData, times,
-        inputParams.stddevthresh);
-      if( verbose ){
-        fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 1st time.\n",
-          100.*(double)numOutliers/(double)resampData->data->length,
-          inputParams.stddevthresh);
-      }
-    }
-
-    /* calibrate */
-    if( inputParams.calibrate ){
-      calibrate(resampData, times, inputParams.calibfiles,
-        inputParams.freqfactor*PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ), inputParams.channel);
-      if( verbose ){ fprintf(stderr, "I've calibrated the data at %.1lf Hz\n", inputParams.freqfactor*PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ));  }
-    }
-
-    /* remove outliers above our threshold */
-    if( inputParams.stddevthresh != 0. ){
-      INT4 numOutliers = 0;
-      numOutliers = remove_outliers(resampData, times,
-        inputParams.stddevthresh);
-      if( verbose ){
-        fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 2nd time.\n",
-          100.*(double)numOutliers/(double)resampData->data->length,
-          inputParams.stddevthresh);
-      }
-    }
+    /* heterodyne, filter, resample, calibrate and output the data for each
+       pulsar - for frame data each pulsar works on its own copy of the data
+       read in above, so the pulsars can be processed in parallel */
+#pragma omp parallel for schedule(dynamic)
+    for( INT4 q=0; q<numPulsars; q++ ){
+      COMPLEX16TimeSeries *pdata = data;
+      REAL8Vector *ptimes = times;
+
+      if( datareal != NULL ){
+        LIGOTimeGPS epochdummy;
+
+        epochdummy.gpsSeconds = 0;
+        epochdummy.gpsNanoSeconds = 0;
+
+        /* make vector (make sure imaginary parts are set to zero) */
+        if( (pdata = XLALCreateCOMPLEX16TimeSeries( "", &epochdummy,
+          PulsarGetREAL8VectorParamIndividual( hetParams[q].het, "F0" ), 1./inputParams.samplerate, &lalSecondUnit,
+          datareal->data->length )) == NULL )
+          {  XLALPrintError("Error allocating data memory.\n");  }
+
+        /* put data into COMPLEX16 vector and set imaginary parts to zero */
+        for( UINT4 j=0; j<datareal->data->length; j++ ){
+          pdata->data->data[j] = (REAL8)datareal->data->data[j];
+        }
 
-    /* output data */
-    if( inputParams.binaryoutput ){
-      if((fpout = fopen(outputfile, "ab"))==NULL){
-        fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
-        return 0;
+        /* times of the resampled data get set by resample_data */
+        if( (ptimes = XLALCreateREAL8Vector( pdata->data->length )) == NULL )
+          XLALPrintError("Error creating vector of data times.\n");
       }
-    }
-    else{
-      if( (fpout = fopen(outputfile, "a")) == NULL ){
-        fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
-        return 0;
-      }
-    }
-
-    /* buffer the output, so that file system is not thrashed when outputing */
-    /* buffer will be 1Mb */
-    if( setvbuf(fpout, NULL, _IOFBF, 0x100000) ){ fprintf(stderr, "Warning: Unable to set output file buffer!"); }
-
-    for( i=0;i<(INT4)resampData->data->length;i++ ){
-      /* if data has been scaled then undo scaling for output */
 
-      if( inputParams.binaryoutput ){
-        size_t rc = 0;
-        REAL8 tempreal, tempimag;
+      XLALGPSSetREAL8(&pdata->epoch, hetParams[q].timestamp);
 
-        tempreal = creal(resampData->data->data[i]);
-        tempimag = cimag(resampData->data->data[i]);
+      COMPLEX16TimeSeries *resampData = process_data(pdata, ptimes, hetParams[q],
+        &iirFilters[q], filtresp, starts, stops, &inputParams);
 
-        /* binary output will be same as ASCII text - time real imag */
-        if( inputParams.scaleFac > 1.0 ){
-          tempreal /= inputParams.scaleFac;
-          tempimag /= inputParams.scaleFac;
-        }
+      XLALDestroyCOMPLEX16TimeSeries( pdata );
 
-        rc = fwrite(&times->data[i], sizeof(REAL8), 1, fpout);
-        rc = fwrite(&tempreal, sizeof(REAL8), 1, fpout);
-        rc = fwrite(&tempimag, sizeof(REAL8), 1, fpout);
+      /* output data */
+      output_data(outputfiles[q], resampData, ptimes, &inputParams);
 
-        if( ferror(fpout) || !rc ){
-          fprintf(stderr, "Error... problem writing out data to binary file!\n");
-          exit(1);
-        }
-      }
-      else{
-        if( inputParams.scaleFac > 1.0 ){
-          fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
-                  creal(resampData->data->data[i])/inputParams.scaleFac,
-                  cimag(resampData->data->data[i])/inputParams.scaleFac);
-        }
-        else{
-          fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
-            creal(resampData->data->data[i]), cimag(resampData->data->data[i]));
-        }
-      }
+      XLALDestroyCOMPLEX16TimeSeries( resampData );
 
+      XLALDestroyREAL8Vector( ptimes );
     }
-    if( verbose ){ fprintf(stderr, "I've output the data.\n"); }
-
-    fclose(fpout);
-
-    XLALDestroyCOMPLEX16TimeSeries( resampData );
 
-    XLALDestroyREAL8Vector( times );
+    XLALDestroyREAL8TimeSeries( datareal );
   }while( count < numSegs && (inputParams.heterodyneflag==0 || inputParams.heterodyneflag==3) );
 
   /* check if any data has been read - if not exit with an error */
@@ -701,10 +467,12 @@ data!\n");
   }
 
   /* check whether to gzip the output */
-  if ( !inputParams.binaryoutput && inputParams.gzipoutput ){
-    fprintf(stderr, "Outputing %s to gzipped file\n", outputfile);
-    if ( XLALGzipTextFile(outputfile) != XLAL_SUCCESS ){ // gzip it
-      XLALPrintError("Error... problem gzipping the output file.\n");
+  for( p=0; p<numPulsars; p++ ){
+    if ( !inputParams.binaryoutput && gzipoutput[p] ){
+      fprintf(stderr, "Outputing %s to gzipped file\n", outputfiles[p]);
+      if ( XLALGzipTextFile(outputfiles[p]) != XLAL_SUCCESS ){ // gzip it
+        XLALPrintError("Error... problem gzipping the output file.\n");
+      }
     }
   }
 
@@ -722,20 +490,31 @@ data!\n");
   }
 
   if( inputParams.filterknee > 0. ){
-    XLALDestroyREAL8IIRFilter( iirFilters.filter1Re );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter1Im );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter2Re );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter2Im );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter3Re );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter3Im );
+    for( p=0; p<numPulsars; p++ ){
+      XLALDestroyREAL8IIRFilter( iirFilters[p].filter1Re );
+      XLALDestroyREAL8IIRFilter( iirFilters[p].filter1Im );
+      XLALDestroyREAL8IIRFilter( iirFilters[p].filter2Re );
+      XLALDestroyREAL8IIRFilter( iirFilters[p].filter2Im );
+      XLALDestroyREAL8IIRFilter( iirFilters[p].filter3Re );
+      XLALDestroyREAL8IIRFilter( iirFilters[p].filter3Im );
+    }
 
     if( verbose ){ fprintf(stderr, "I've destroyed all filters.\n"); }
   }
+  XLALFree( iirFilters );
 
   if ( filtresp != NULL ){ destroy_filter_response( filtresp ); }
 
-  PulsarFreeParams( hetParams.het );
-  if ( inputParams.heterodyneflag == 2 || inputParams.heterodyneflag == 4 ){ PulsarFreeParams( hetParams.hetUpdate ); }
+  for( p=0; p<numPulsars; p++ ){
+    if ( inputParams.heterodyneflag == 2 || inputParams.heterodyneflag == 4 ){ PulsarFreeParams( hetParams[p].hetUpdate ); }
+    PulsarFreeParams( hetParams[p].het );
+    XLALFree( paramfiles[p] );
+    XLALFree( outputfiles[p] );
+  }
+  XLALFree( hetParams );
+  XLALFree( paramfiles );
+  XLALFree( outputfiles );
+  XLALFree( gzipoutput );
 
   #if TRACKMEMUSE
     fprintf(stderr, "Memory use at the end of the code:\n"); printmemuse();
@@ -781,10 +560,11 @@ void get_input_args(InputParams *inputParams, int argc, char *argv[]){
     { "legacy-input",             no_argument,     NULL, 'L' },
     { "verbose",                  no_argument,     NULL, 'v' },
     { "output-phase",             no_argument,     NULL, 'P' },
+    { "pulsar-list",              required_argument,  0, 'x' },
     { 0, 0, 0, 0 }
   };
 
-  char args[] = "hi:p:z:f:g:k:s:r:d:D:c:o:e:S:t:l:R:C:F:O:T:m:G:H:M:ABbZLvP";
+  char args[] = "hi:p:z:f:g:k:s:r:d:D:c:o:e:S:t:l:R:C:F:O:T:m:G:H:M:x:ABbZLvP";
   char *program = argv[0];
 
   /* set defaults */
@@ -819,6 +599,8 @@ the pulsar parameter file */
 
   inputParams->timeCorrFile = NULL;
 
+  inputParams->pulsarlist[0] = '\0'; /* default to a single pulsar */
+
   /* get input arguments */
   while(1){
     int option_index = 0;
@@ -1008,6 +790,10 @@ the pulsar parameter file */
       case 'P':
         inputParams->outputPhase = 1;
         break;
+      case 'x': /* list of pulsars to heterodyne in one pass */
+        snprintf(inputParams->pulsarlist, sizeof(inputParams->pulsarlist), "%s",
+          LALoptarg);
+        break;
       case '?':
         fprintf(stderr, "unknown error while parsing options\n" );
 		break;
@@ -1057,6 +843,373 @@ heterodyne!\n");
       exit(1);
     }
   }
+
+  /* check that a list of pulsars is only given when reading frame data, and
+     that the phase (which is output to a single file) is not requested */
+  if( inputParams->pulsarlist[0] != '\0' ){
+    if( inputParams->heterodyneflag != 0 && inputParams->heterodyneflag != 3 ){
+      fprintf(stderr, "Error... a pulsar list can only be used for a coarse \
+(0) or one step fine (3) heterodyne of frame data!\n");
+      exit(1);
+    }
+    if( inputParams->outputPhase ){
+      fprintf(stderr, "Error... the phase evolution cannot be output when \
+heterodyning a list of pulsars!\n");
+      exit(1);
+    }
+  }
+}
+
+/* function to read in the list of pulsars to heterodyne in a single pass
+   through the data - each (non-comment) line of the file contains a pulsar
+   parameter file and the output file for that pulsar. Returns the number of
+   pulsars */
+INT4 read_pulsar_list(CHAR ***paramfiles, CHAR ***outputfiles, CHAR *pulsarlist){
+  FILE *fp=NULL;
+  INT4 numPulsars=0;
+  CHAR line[1024];
+
+  if( (fp = fopen(pulsarlist, "r")) == NULL ){
+    fprintf(stderr, "Error... can't open pulsar list file %s.\n", pulsarlist);
+    exit(1);
+  }
+
+  *paramfiles = NULL;
+  *outputfiles = NULL;
+
+  while( fgets(line, sizeof(line), fp) != NULL ){
+    CHAR parfile[256], outfile[256];
+
+    /* skip comment and blank lines */
+    if( line[0] == '#' || line[0] == '%' ) continue;
+    if( sscanf(line, "%255s%255s", parfile, outfile) != 2 ) continue;
+
+    *paramfiles = XLALRealloc(*paramfiles, (numPulsars+1)*sizeof(CHAR*));
+    *outputfiles = XLALRealloc(*outputfiles, (numPulsars+1)*sizeof(CHAR*));
+    (*paramfiles)[numPulsars] = XLALStringDuplicate(parfile);
+    (*outputfiles)[numPulsars] = XLALStringDuplicate(outfile);
+    numPulsars++;
+  }
+
+  fclose(fp);
+
+  if( numPulsars == 0 ){
+    fprintf(stderr, "Error... no pulsars given in pulsar list file %s.\n", pulsarlist);
+    exit(1);
+  }
+
+  return numPulsars;
+}
+
+/* function to read in the pulsar parameters and set up the heterodyne
+   parameters for one pulsar */
+void set_heterodyne_params(HeterodyneParams *hetParams, InputParams *inputParams,
+  const CHAR *paramfile){
+  const CHAR *psrname;
+
+  hetParams->heterodyneflag = inputParams->heterodyneflag; /* set type of heterodyne */
+
+  /* read in pulsar data */
+  hetParams->het = XLALReadTEMPOParFile( paramfile );
+  hetParams->hetUpdate = NULL;
+  hetParams->outputPhase = inputParams->outputPhase;
+
+  /* set pulsar name - take from par file if available, or if not get from command line args */
+  if( PulsarCheckParam( hetParams->het, "PSRJ" ) )
+    psrname = PulsarGetStringParam( hetParams->het, "PSRJ" );
+  else if( PulsarCheckParam( hetParams->het, "PSRB" ) )
+    psrname = PulsarGetStringParam( hetParams->het, "PSRB" );
+  else if( PulsarCheckParam( hetParams->het, "NAME" ) )
+    psrname = PulsarGetStringParam( hetParams->het, "NAME" );
+  else if( PulsarCheckParam( hetParams->het, "PSR" ) )
+    psrname = PulsarGetStringParam( hetParams->het, "PSR" );
+  else{
+    fprintf(stderr, "No pulsar name specified!\n");
+    exit(0);
+  }
+
+  /* if there is an epoch given manually (i.e. not from the pulsar parameter
+     file) then set it here and overwrite any other value - this is used, for
+     example, with the pulsar hardware injections in which this should be set
+     at 751680013.0 */
+  if(inputParams->manualEpoch != 0.){
+    PulsarSetParam( hetParams->het, "PEPOCH", &inputParams->manualEpoch );
+    PulsarSetParam( hetParams->het, "POSEPOCH", &inputParams->manualEpoch );
+  }
+
+  if(verbose){
+    fprintf(stderr, "I've read in the pulsar parameters for %s.\n", psrname);
+    REAL8 rav, decv, pepochv;
+    if ( PulsarCheckParam( hetParams->het, "RAJ" ) ){ rav = PulsarGetREAL8Param( hetParams->het, "RAJ" ); }
+    else { rav = PulsarGetREAL8ParamOrZero( hetParams->het, "RA" ); }
+
+    if ( PulsarCheckParam( hetParams->het, "DECJ" ) ){ decv = PulsarGetREAL8Param( hetParams->het, "DECJ" ); }
+    else { decv = PulsarGetREAL8ParamOrZero( hetParams->het, "DEC" ); }
+
+    fprintf(stderr, "alpha = %lf rads, delta = %lf rads.\n", rav, decv);
+
+    if ( PulsarCheckParam( hetParams->het, "F" ) ) {
+      const REAL8Vector *freqsv = PulsarGetREAL8VectorParam( hetParams->het, "F" );
+      UINT4 i = 0;
+
+      pepochv = PulsarGetREAL8ParamOrZero( hetParams->het, "PEPOCH" );
+      for ( i=0; i<freqsv->length; i++ ){ fprintf(stderr, "f%u = %.1e Hz/s^%u, ", i, freqsv->data[i], i); }
+      fprintf(stderr, "epoch = %.1lf.\n", pepochv);
+    }
+
+    fprintf(stderr, "I'm looking for gravitational waves at %.2lf times the pulsars spin frequency.\n", inputParams->freqfactor);
+  }
+
+  /*if performing fine heterdoyne using same params as coarse */
+  if(inputParams->heterodyneflag == 1 || inputParams->heterodyneflag == 3)
+    hetParams->hetUpdate = hetParams->het;
+
+  hetParams->samplerate = inputParams->samplerate;
+
+  /* set detector */
+  hetParams->detector = *XLALGetSiteInfo( inputParams->ifo );
+
+  if(verbose){  fprintf(stderr, "I've set the detector location for %s.\n", inputParams->ifo); }
+
+  if(inputParams->heterodyneflag == 2 || inputParams->heterodyneflag == 4){ /* if updating parameters read in updated par file */
+    hetParams->hetUpdate = XLALReadTEMPOParFile( inputParams->paramfileupdate );
+
+    /* if there is an epoch given manually (i.e. not from the pulsar parameter
+       file) then set it here and overwrite any other value */
+    if(inputParams->manualEpoch != 0.){
+      PulsarSetParam( hetParams->hetUpdate, "PEPOCH", &inputParams->manualEpoch );
+      PulsarSetParam( hetParams->hetUpdate, "POSEPOCH", &inputParams->manualEpoch );
+    }
+
+    if(verbose){
+      fprintf(stderr, "I've read the updated parameters for %s.\n", psrname);
+
+      REAL8 rav, decv, pepochv;
+      if ( PulsarCheckParam( hetParams->hetUpdate, "RAJ" ) ){ rav = PulsarGetREAL8Param( hetParams->hetUpdate, "RAJ" ); }
+      else { rav = PulsarGetREAL8ParamOrZero( hetParams->hetUpdate, "RA" ); }
+
+      if ( PulsarCheckParam( hetParams->hetUpdate, "DECJ" ) ){ decv = PulsarGetREAL8Param( hetParams->hetUpdate, "DECJ" ); }
+      else { decv = PulsarGetREAL8ParamOrZero( hetParams->hetUpdate, "DEC" ); }
+
+      fprintf(stderr, "alpha = %lf rads, delta = %lf rads.\n", rav, decv);
+
+      if ( PulsarCheckParam( hetParams->hetUpdate, "F" ) ) {
+        const REAL8Vector *freqsv = PulsarGetREAL8VectorParam( hetParams->hetUpdate, "F" );
+        UINT4 i = 0;
+
+        pepochv = PulsarGetREAL8ParamOrZero( hetParams->hetUpdate, "PEPOCH" );
+        for ( i=0; i<freqsv->length; i++ ){ fprintf(stderr, "f%u = %.1e Hz/s^%u, ", i, freqsv->data[i], i); }
+        fprintf(stderr, "epoch = %.1lf.\n", pepochv);
+      }
+    }
+  }
+
+  if( inputParams->heterodyneflag > 0 ){
+    snprintf(hetParams->earthfile, sizeof(hetParams->earthfile), "%s",
+      inputParams->earthfile);
+    snprintf(hetParams->sunfile, sizeof(hetParams->sunfile), "%s",
+      inputParams->sunfile);
+
+    if( inputParams->timeCorrFile != NULL ){
+      hetParams->timeCorrFile = XLALStringDuplicate( inputParams->timeCorrFile );
+
+      if ( PulsarCheckParam( hetParams->hetUpdate, "UNITS" ) ){
+        if ( !strcmp( PulsarGetStringParam( hetParams->hetUpdate, "UNITS" ), "TDB" ) )
+          hetParams->ttype = TIMECORRECTION_TDB; /* use TDB units i.e. TEMPO standard */
+        else
+          hetParams->ttype = TIMECORRECTION_TCB; /* default to TCB i.e. TEMPO2 standard */
+      }
+      else /* don't recognise units type, so default to the original code */
+        hetParams->ttype = TIMECORRECTION_ORIGINAL;
+    }
+    else{
+      hetParams->timeCorrFile = NULL;
+      hetParams->ttype = TIMECORRECTION_ORIGINAL;
+    }
+  }
+}
+
+/* function to create an output file and write the header information to it -
+   if the file name has a ".gz" suffix it is removed and gzipoutput is set */
+void write_output_header(CHAR *outputfile, INT4 *gzipoutput, INT4 binaryoutput,
+  int argc, char *argv[]){
+  FILE *fpout=NULL;
+
+  // check if output should be gzipped due to ".gz" suffix on file name */
+  if ( XLALStringCaseSubstring( outputfile, ".gz" ) != NULL ){
+    if ( binaryoutput ){
+      XLALPrintError("Error... do not use a \".gz\" file extension for a binary output file\n");
+    }
+
+    *gzipoutput = 1;
+    // remove ".gz" suffix
+    CHAR *strloc = XLALStringCaseSubstring( outputfile, ".gz" );
+    strloc[0] = '\0';
+  }
+
+  /* add header to the files: header information will be a string consisting of several lines starting with %%s.
+   *  - the first line will contain the time and date of the file creation
+   *  - the next set of lines will contain the version and git hash of the lalsuite versions
+   *  - the penulimate line will contain the command line inputs used to create the file
+   *  - the final will contain headers for the three columns in the file: GPS time, Real, Imag */
+  if( (fpout = fopen(outputfile, "w")) == NULL ){
+    fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
+    exit(0);
+  }
+
+  CHAR *headerinfo = XLALStringDuplicate("%% File created on ");
+  headerinfo = XLALStringAppend(headerinfo, LogTimeToString( XLALGetTimeOfDay() ));
+  headerinfo = XLALStringAppend(headerinfo, "\n");
+  headerinfo = XLALStringAppend(headerinfo, XLALVCSInfoString( lalPulsarVCSInfoList, 0, "%% " ) );
+  headerinfo = XLALStringAppend(headerinfo, "%% ");
+  for ( INT4 j=0; j<argc; j++ ) {
+    headerinfo = XLALStringAppend(headerinfo, argv[j]);
+    headerinfo = XLALStringAppend(headerinfo, " ");
+  }
+  CHAR dataline[] = "\n%% GPS time\tReal\tImag\n";
+  if ( strlen(headerinfo)+strlen(dataline) > HEADERSIZE ) {
+    fprintf(stderr, "Error... HEADERSIZE needs to be increased to accommodate information\n");
+    exit(0);
+  }
+  else{
+    /* fill in rest of string with whitespace */
+    for ( INT4 j=strlen(headerinfo); j<HEADERSIZE; j++ ){ headerinfo = XLALStringAppend(headerinfo, " "); }
+    memcpy(&headerinfo[HEADERSIZE-strlen(dataline)], &dataline[0], sizeof(CHAR)*strlen(dataline));
+
+    /* output the header to the file */
+    size_t rc = fwrite(&headerinfo[0], sizeof(CHAR), HEADERSIZE, fpout);
+    if ( ferror(fpout) || !rc ){
+      fprintf(stderr, "Error... problem writing out header data!\n");
+      exit(1);
+    }
+  }
+  XLALFree( headerinfo );
+  fclose(fpout);
+}
+
+/* function to heterodyne, filter, resample, calibrate and remove outliers from
+   a chunk of data for one pulsar - the input data is overwritten and the
+   resampled data is returned, with its times in times */
+COMPLEX16TimeSeries *process_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
+  HeterodyneParams hetParams, Filters *iirFilters, FilterResponse *filtresp,
+  INT4Vector *starts, INT4Vector *stops, InputParams *inputParams){
+  COMPLEX16TimeSeries *resampData=NULL; /* resampled data */
+
+  /* heterodyne data */
+  heterodyne_data(data, times, hetParams, inputParams->freqfactor, filtresp);
+  if( verbose ){ fprintf(stderr, "I've heterodyned the data.\n"); }
+
+  /* filter data */
+  if( inputParams->filterknee > 0. ){/* filter if knee frequency is not zero */
+    filter_data(data, iirFilters);
+
+    if( verbose ){  fprintf(stderr, "I've low pass filtered the data at %.2lf Hz\n", inputParams->filterknee);  }
+  }
+
+  /* resample data and data times */
+  resampData = resample_data(data, times, starts, stops,
+    inputParams->samplerate, inputParams->resamplerate,
+    inputParams->heterodyneflag);
+  if( verbose ){  fprintf(stderr, "I've resampled the data from %.2lf to %.4lf Hz\n", inputParams->samplerate, inputParams->resamplerate);  }
+
+  /*perform outlier removal twice incase very large outliers skew the stddev*/
+  if( inputParams->stddevthresh != 0. ){
+    INT4 numOutliers=0;
+    numOutliers = remove_outliers(resampData, times,
+      inputParams->stddevthresh);
+    if( verbose ){
+      fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 1st time.\n",
+        100.*(double)numOutliers/(double)resampData->data->length,
+        inputParams->stddevthresh);
+    }
+  }
+
+  /* calibrate */
+  if( inputParams->calibrate ){
+    calibrate(resampData, times, inputParams->calibfiles,
+      inputParams->freqfactor*PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ), inputParams->channel);
+    if( verbose ){ fprintf(stderr, "I've calibrated the data at %.1lf Hz\n", inputParams->freqfactor*PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ));  }
+  }
+
+  /* remove outliers above our threshold */
+  if( inputParams->stddevthresh != 0. ){
+    INT4 numOutliers = 0;
+    numOutliers = remove_outliers(resampData, times,
+      inputParams->stddevthresh);
+    if( verbose ){
+      fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 2nd time.\n",
+        100.*(double)numOutliers/(double)resampData->data->length,
+        inputParams->stddevthresh);
+    }
+  }
+
+  return resampData;
+}
+
+/* function to append a chunk of heterodyned data to an output file */
+void output_data(CHAR *outputfile, COMPLEX16TimeSeries *resampData, REAL8Vector *times,
+  InputParams *inputParams){
+  FILE *fpout=NULL;
+  INT4 i;
+
+  if( inputParams->binaryoutput ){
+    if((fpout = fopen(outputfile, "ab"))==NULL){
+      fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
+      exit(0);
+    }
+  }
+  else{
+    if( (fpout = fopen(outputfile, "a")) == NULL ){
+      fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
+      exit(0);
+    }
+  }
+
+  /* buffer the output, so that file system is not thrashed when outputing */
+  /* buffer will be 1Mb */
+  if( setvbuf(fpout, NULL, _IOFBF, 0x100000) ){ fprintf(stderr, "Warning: Unable to set output file buffer!"); }
+
+  for( i=0;i<(INT4)resampData->data->length;i++ ){
+    /* if data has been scaled then undo scaling for output */
+
+    if( inputParams->binaryoutput ){
+      size_t rc = 0;
+      REAL8 tempreal, tempimag;
+
+      tempreal = creal(resampData->data->data[i]);
+      tempimag = cimag(resampData->data->data[i]);
+
+      /* binary output will be same as ASCII text - time real imag */
+      if( inputParams->scaleFac > 1.0 ){
+        tempreal /= inputParams->scaleFac;
+        tempimag /= inputParams->scaleFac;
+      }
+
+      rc = fwrite(&times->data[i], sizeof(REAL8), 1, fpout);
+      rc = fwrite(&tempreal, sizeof(REAL8), 1, fpout);
+      rc = fwrite(&tempimag, sizeof(REAL8), 1, fpout);
+
+      if( ferror(fpout) || !rc ){
+        fprintf(stderr, "Error... problem writing out data to binary file!\n");
+        exit(1);
+      }
+    }
+    else{
+      if( inputParams->scaleFac > 1.0 ){
+        fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
+                creal(resampData->data->data[i])/inputParams->scaleFac,
+                cimag(resampData->data->data[i])/inputParams->scaleFac);
+      }
+      else{
+        fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
+          creal(resampData->data->data[i]), cimag(resampData->data->data[i]));
+      }
+    }
+
+  }
+  if( verbose ){ fprintf(stderr, "I've output the data.\n"); }
+
+  fclose(fpout);
 }
 
 /* heterodyne data function */
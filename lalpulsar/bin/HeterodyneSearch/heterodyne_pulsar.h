@@ -131,6 +131,11 @@ extern "C" {
                           if not this suffix will be appended\n"\
 " --output-phase (-P)      if set, output the phase evolution to a text file\n\
                           (for debugging purposes)\n"\
+" --pulsar-list (-x)       file listing a pulsar parameter file and an output\n\
+                          file on each line. All the pulsars are heterodyned\n\
+                          in a single pass through the frame data (coarse or\n\
+                          one step fine heterodyne only), instead of using\n\
+                          --param-file and --output-file\n"\
 "\n"
 
 #define MAXDATALENGTH 256   /* maximum length of data to be read from frames */
@@ -186,6 +191,7 @@ typedef struct tagInputParams{
 
   CHAR outputfile[256];
   CHAR segfile[256];
+  CHAR pulsarlist[256];
 
   INT4 calibrate;
   CalibrationFiles calibfiles;
@@ -243,6 +249,28 @@ typedef struct tagFilterResponse{
 /* define functions */
 void get_input_args(InputParams *inputParams, int argc, char *argv[]);
 
+/* read in a list of pulsar parameter files and output files - returns the
+number of pulsars */
+INT4 read_pulsar_list(CHAR ***paramfiles, CHAR ***outputfiles, CHAR *pulsarlist);
+
+/* read in a pulsar parameter file and set the heterodyne parameters */
+void set_heterodyne_params(HeterodyneParams *hetParams, InputParams *inputParams,
+const CHAR *paramfile);
+
+/* create an output file and write its header */
+void write_output_header(CHAR *outputfile, INT4 *gzipoutput, INT4 binaryoutput,
+int argc, char *argv[]);
+
+/* heterodyne, filter, resample, calibrate and remove outliers from a chunk of
+data - returns the resampled data */
+COMPLEX16TimeSeries *process_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
+HeterodyneParams hetParams, Filters *iirFilters, FilterResponse *filtresp,
+INT4Vector *starts, INT4Vector *stops, InputParams *inputParams);
+
+/* append a chunk of heterodyned data to an output file */
+void output_data(CHAR *outputfile, COMPLEX16TimeSeries *resampData, REAL8Vector *times,
+InputParams *inputParams);
+
 void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times, HeterodyneParams hetParams,
 REAL8 freqfactor, FilterResponse *filtResp);
 
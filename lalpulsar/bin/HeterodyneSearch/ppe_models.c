@@ -441,7 +441,6 @@ void pulsar_model( PulsarParameters *params, LALInferenceIFOModel *ifo ){
             ifomodel2->compTimeSignal->data->data[i] = M * expp;
           }
 
-          XLALDestroyREAL8Vector( dphi );
         }
 
         ifomodel2 = ifomodel2->next;
@@ -451,6 +450,223 @@ void pulsar_model( PulsarParameters *params, LALInferenceIFOModel *ifo ){
 }
 
 
+/* maximum number of parameter values that can be held in a phase model parameter cache */
+#define PHASE_CACHE_MAX_VALUES 128
+
+/* The values of a set of parameters used to calculate a term in the phase model */
+typedef struct tagPhaseParameterCache {
+  INT4 set;                              /* non-zero if the cached values are valid */
+  UINT4 length;                          /* number of cached values */
+  REAL8 values[PHASE_CACHE_MAX_VALUES];  /* cached values */
+} PhaseParameterCache;
+
+/**
+ * \brief Workspace for the phase model
+ *
+ * This holds the buffers used by \c get_phase_model, so that no memory is allocated when evaluating the
+ * likelihood, along with quantities that do not depend on the model parameters (the data time stamps as
+ * \c REAL8 values, the state of the Earth at each time stamp and the Taylor expansion coefficients). It also
+ * holds the most recently calculated solar system and binary system barycentring delays and glitch phases, and
+ * the values of the parameters that they were calculated from, so that they are only recalculated if one of
+ * those parameters changes.
+ */
+struct tagPhaseModelWorkspace {
+  const LIGOTimeGPSVector *times;   /**< The time stamps that the workspace has been set up for */
+  UINT4 length;                     /**< The number of time stamps */
+  REAL8 tfirst;                     /**< The first time stamp */
+  REAL8 tlast;                      /**< The last time stamp */
+  REAL8 *tgps;                      /**< The time stamps as GPS seconds */
+  EarthState *earth;                /**< The Earth state at each time stamp for the solar system delays */
+  REAL8 *earthposvel;               /**< The Earth position and velocity at each time stamp for the binary delays */
+  REAL8Vector *dts;                 /**< The solar system barycentring delays */
+  REAL8Vector *bdts;                /**< The binary system barycentring delays */
+  REAL8Vector *glphase;             /**< The glitch phases */
+  REAL8Vector *phis;                /**< The phase model */
+  PhaseParameterCache skycache;     /**< The parameters used to calculate \c dts */
+  PhaseParameterCache binarycache;  /**< The parameters used to calculate \c bdts */
+  PhaseParameterCache glitchcache;  /**< The parameters used to calculate \c glphase */
+  UINT4 nfreqs;                     /**< The number of frequency derivatives in the coefficient tables */
+  REAL8 *invfact;                   /**< The inverse factorials \f$1/(j+1)!\f$ */
+  REAL8 *binom;                     /**< The binomial coefficients \f$(j+1)!/(k!(j+1-k)!)\f$ in rows of length \c nfreqs */
+};
+
+static int ssb_delays( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, const EarthState *earth,
+                       EphemerisData *ephem, TimeCorrectionData *tdat, TimeCorrectionType ttype,
+                       LALDetector *detector, REAL8 *dts );
+static void bsb_delays( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, const REAL8 *dts, EphemerisData *edat,
+                        const REAL8 *earthposvel, REAL8 *bdts );
+static void glitch_phases( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, const REAL8 *dts, const REAL8 *bdts,
+                           REAL8 *glphase );
+
+/* parameters that the solar system barycentring delay depends upon */
+static const CHAR *ssb_parameter_names[] = { "RA", "RAJ", "DEC", "DECJ", "PMRA", "PMDEC", "PEPOCH", "POSEPOCH",
+                                             "PX", NULL };
+
+/* parameters that the binary system barycentring delay depends upon (as well as the solar system delay), which
+ * must include every numerical parameter read by XLALBinaryPulsarDeltaTNew() */
+static const CHAR *bsb_parameter_names[] = { "PB", "PBDOT", "XPBDOT", "FB", "T0", "TASC", "A1", "XDOT", "ECC",
+                                             "EDOT", "EPS1", "EPS1DOT", "EPS2", "EPS2DOT", "OM", "OMDOT", "GAMMA",
+                                             "SINI", "SHAPMAX", "M2", "DR", "DTHETA", "A0", "B0", "KIN", "KOM",
+                                             "D_AOP", "PB_2", "PB_3", "T0_2", "T0_3", "A1_2", "A1_3", "ECC_2",
+                                             "ECC_3", "OM_2", "OM_3", "RA", "RAJ", "DEC", "DECJ", "PMRA", "PMDEC",
+                                             "POSEPOCH", "PX", NULL };
+
+/* parameters that the glitch phase depends upon (as well as the barycentring delays) */
+static const CHAR *glitch_parameter_names[] = { "PEPOCH", "CGW", "GLEP", "GLPH", "GLF0", "GLF1", "GLF2", "GLF0D",
+                                                "GLTD", NULL };
+
+
+/**
+ * \brief Check whether a set of parameters has changed
+ *
+ * The values of the named parameters (all the elements of vector parameters) are compared with those in the
+ * cache, which is then updated with the new values.
+ *
+ * \param pars [in] A set of pulsar parameters
+ * \param names [in] A \c NULL terminated list of parameter names
+ * \param cache [in] The cached parameter values
+ *
+ * \return Zero if the parameters have changed (or the cache was not set), and non-zero otherwise
+ */
+static INT4 phase_parameters_unchanged( PulsarParameters *pars, const CHAR **names, PhaseParameterCache *cache ){
+  REAL8 values[PHASE_CACHE_MAX_VALUES];
+  UINT4 i = 0, j = 0, n = 0;
+  INT4 unchanged = 0;
+
+  for ( i = 0; names[i] != NULL; i++ ){
+    if ( !PulsarCheckParam( pars, names[i] ) ){ continue; }
+
+    /* include the position in the list, so that a parameter being added or removed is seen as a change */
+    if ( n < PHASE_CACHE_MAX_VALUES ){ values[n] = (REAL8)i; }
+    n++;
+
+    if ( PulsarGetParamType( pars, names[i] ) == PULSARTYPE_REAL8_t ){
+      if ( n < PHASE_CACHE_MAX_VALUES ){ values[n] = PulsarGetREAL8Param( pars, names[i] ); }
+      n++;
+    }
+    else if ( PulsarGetParamType( pars, names[i] ) == PULSARTYPE_REAL8Vector_t ){
+      const REAL8Vector *vals = PulsarGetREAL8VectorParam( pars, names[i] );
+      for ( j = 0; j < vals->length; j++ ){
+        if ( n < PHASE_CACHE_MAX_VALUES ){ values[n] = vals->data[j]; }
+        n++;
+      }
+    }
+  }
+
+  /* too many values to cache, so always recalculate */
+  if ( n > PHASE_CACHE_MAX_VALUES ){
+    cache->set = 0;
+    return 0;
+  }
+
+  if ( cache->set && cache->length == n ){
+    unchanged = 1;
+    for ( i = 0; i < n; i++ ){
+      if ( cache->values[i] != values[i] ){
+        unchanged = 0;
+        break;
+      }
+    }
+  }
+
+  if ( !unchanged ){
+    memcpy( cache->values, values, n*sizeof(REAL8) );
+    cache->length = n;
+    cache->set = 1;
+  }
+
+  return unchanged;
+}
+
+
+/**
+ * \brief Free a phase model workspace
+ *
+ * \param ws [in] The workspace
+ */
+void destroy_phase_model_workspace( PhaseModelWorkspace *ws ){
+  if ( ws == NULL ){ return; }
+
+  XLALFree( ws->tgps );
+  XLALFree( ws->earth );
+  XLALFree( ws->earthposvel );
+  XLALDestroyREAL8Vector( ws->dts );
+  XLALDestroyREAL8Vector( ws->bdts );
+  XLALDestroyREAL8Vector( ws->glphase );
+  XLALDestroyREAL8Vector( ws->phis );
+  XLALFree( ws->invfact );
+  XLALFree( ws->binom );
+  XLALFree( ws );
+}
+
+
+/**
+ * \brief Get the phase model workspace for an ifo model
+ *
+ * The workspace is created on the first call, and its buffers are (re)allocated, and its cached values
+ * cleared, if the data time stamps have changed since the last call. The Taylor expansion coefficient tables
+ * are extended if required for \c nfreqs frequency derivatives.
+ *
+ * \param ifo [in] The ifo model structure containing the data time stamps
+ * \param nfreqs [in] The number of frequency derivatives in the phase model
+ *
+ * \return The workspace
+ */
+static PhaseModelWorkspace *get_phase_model_workspace( LALInferenceIFOModel *ifo, UINT4 nfreqs ){
+  LIGOTimeGPSVector *datatimes = IFO_XTRA_DATA( ifo )->times;
+  PhaseModelWorkspace *ws = IFO_XTRA_DATA( ifo )->phasews;
+  UINT4 i = 0, j = 0, k = 0, length = datatimes->length;
+
+  if ( ws == NULL ){
+    XLAL_CHECK_NULL( (ws = XLALCalloc( 1, sizeof(*ws) )) != NULL, XLAL_ENOMEM );
+    IFO_XTRA_DATA( ifo )->phasews = ws;
+  }
+
+  /* check whether the time stamps have changed */
+  if ( ws->tgps == NULL || ws->times != datatimes || ws->length != length ||
+       ( length > 0 && ( ws->tfirst != XLALGPSGetREAL8( &datatimes->data[0] ) ||
+                         ws->tlast != XLALGPSGetREAL8( &datatimes->data[length-1] ) ) ) ){
+    XLALFree( ws->tgps );
+    XLALFree( ws->earth );
+    XLALFree( ws->earthposvel );
+    XLALDestroyREAL8Vector( ws->dts );
+    XLALDestroyREAL8Vector( ws->bdts );
+    XLALDestroyREAL8Vector( ws->glphase );
+    XLALDestroyREAL8Vector( ws->phis );
+    ws->earth = NULL;
+    ws->earthposvel = NULL;
+    ws->skycache.set = ws->binarycache.set = ws->glitchcache.set = 0;
+
+    XLAL_CHECK_NULL( (ws->tgps = XLALMalloc( ( length > 0 ? length : 1 )*sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_NULL( (ws->dts = XLALCreateREAL8Vector( length )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_NULL( (ws->bdts = XLALCreateREAL8Vector( length )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_NULL( (ws->glphase = XLALCreateREAL8Vector( length )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_NULL( (ws->phis = XLALCreateREAL8Vector( length )) != NULL, XLAL_EFUNC );
+
+    for ( i = 0; i < length; i++ ){ ws->tgps[i] = XLALGPSGetREAL8( &datatimes->data[i] ); }
+
+    ws->times = datatimes;
+    ws->length = length;
+    ws->tfirst = length > 0 ? ws->tgps[0] : 0.;
+    ws->tlast = length > 0 ? ws->tgps[length-1] : 0.;
+  }
+
+  /* set the Taylor expansion coefficients */
+  if ( nfreqs > ws->nfreqs ){
+    XLAL_CHECK_NULL( (ws->invfact = XLALRealloc( ws->invfact, nfreqs*sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_NULL( (ws->binom = XLALRealloc( ws->binom, nfreqs*nfreqs*sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+
+    for ( j = 0; j < nfreqs; j++ ){
+      ws->invfact[j] = 1./gsl_sf_fact(j+1);
+      for ( k = 0; k < nfreqs; k++ ){ ws->binom[j*nfreqs + k] = k < j+1 ? gsl_sf_choose(j+1, k) : 0.; }
+    }
+    ws->nfreqs = nfreqs;
+  }
+
+  return ws;
+}
+
+
 /**
  * \brief The phase evolution of a source
  *
@@ -477,24 +693,32 @@ void pulsar_model( PulsarParameters *params, LALInferenceIFOModel *ifo ){
  * In this function the time delay needed to correct to the solar system barycenter is only calculated if
  * required, i.e., if an update is required due to a change in the sky position.
  * The same is true for the binary system time delay, which is only calculated if it
- * needs updating due to a change in the binary system parameters.
+ * needs updating due to a change in the binary system parameters, and for the glitch phase.
+ *
+ * The calculation uses a workspace attached to \c ifo (see \c get_phase_model_workspace), which holds the
+ * Earth's state at each time stamp, so that this is not recalculated whenever the sky position changes, and
+ * the delays from the previous call, which are reused if the parameters that they depend upon have not changed
+ * (e.g. if only the amplitude or frequency parameters have changed). No memory is allocated after the first call.
  *
  * \param params [in] A set of pulsar parameters
  * \param ifo [in] The ifo model structure containing the detector parameters and buffers
  * \param freqFactor [in] the multiplicative factor on the pulsar frequency for a particular model
  *
- * \return A vector of rotational phase difference values
+ * \return A vector of rotational phase difference values. This is held in the workspace of \c ifo, so must not be
+ * freed, and is overwritten by the next call.
  *
  * \sa get_ssb_delay
  * \sa get_bsb_delay
  */
 REAL8Vector *get_phase_model( PulsarParameters *params, LALInferenceIFOModel *ifo, REAL8 freqFactor ){
-  UINT4 i = 0, j = 0, k = 0, length = 0, isbinary = 0;
-
-  REAL8 DT = 0., deltat = 0., deltatpow = 0., deltatpowinner = 1., taylorcoeff = 1., Ddelay = 0., Ddelaypow = 0.;
+  UINT4 i = 0, j = 0, k = 0, length = 0, nfreqs = 0, isbinary = 0;
+  INT4 dtsupdated = 0, bdtsupdated = 0, unchanged = 0;
 
-  REAL8Vector *phis = NULL, *dts = NULL, *fixdts = NULL, *bdts = NULL, *fixbdts = NULL, *glitchphase = NULL, *fixglitchphase = NULL;
+  const REAL8 *dts = NULL, *fixdts = NULL, *bdts = NULL, *fixbdts = NULL, *glitchphase = NULL, *fixglitchphase = NULL;
+  const REAL8 *tgps = NULL, *invfact = NULL, *binom = NULL;
+  REAL8 *phis = NULL;
   LIGOTimeGPSVector *datatimes = NULL;
+  PhaseModelWorkspace *ws = NULL;
 
   REAL8 pepoch = PulsarGetREAL8ParamOrZero(params, "PEPOCH"); /* time of ephem info */
   REAL8 cgw = PulsarGetREAL8ParamOrZero(params, "CGW");
@@ -506,70 +730,97 @@ REAL8Vector *get_phase_model( PulsarParameters *params, LALInferenceIFOModel *if
   /* if edat is NULL then return a NULL pointer */
   if( IFO_XTRA_DATA( ifo )->ephem == NULL ) return NULL;
 
-  length = datatimes->length;
+  /* get vector of frequencies and frequency differences */
+  const REAL8Vector *freqs = PulsarGetREAL8VectorParam( params, "F" );
+  const REAL8Vector *deltafs = PulsarGetREAL8VectorParam( params, "DELTAF" );
+  nfreqs = freqs->length;
 
-  /* allocate memory for phases */
-  phis = XLALCreateREAL8Vector( length );
+  XLAL_CHECK_NULL( (ws = get_phase_model_workspace( ifo, nfreqs )) != NULL, XLAL_EFUNC );
+  length = ws->length;
+  tgps = ws->tgps;
+  invfact = ws->invfact;
+  binom = ws->binom;
+  phis = ws->phis->data;
 
   /* get time delays */
-  fixdts = LALInferenceGetREAL8VectorVariable( ifo->params, "ssb_delays" );
+  fixdts = LALInferenceGetREAL8VectorVariable( ifo->params, "ssb_delays" )->data;
   if( LALInferenceCheckVariable( ifo->params, "varyskypos" ) ){
-    dts = get_ssb_delay( params, datatimes, IFO_XTRA_DATA( ifo )->ephem, IFO_XTRA_DATA( ifo )->tdat, IFO_XTRA_DATA( ifo )->ttype, ifo->detector );
+    if ( !phase_parameters_unchanged( params, ssb_parameter_names, &ws->skycache ) ){
+      /* the Earth's state at each time stamp does not depend on the parameters, so only get it once */
+      if ( ws->earth == NULL ){
+        XLAL_CHECK_NULL( (ws->earth = XLALMalloc( ( length > 0 ? length : 1 )*sizeof(EarthState) )) != NULL, XLAL_ENOMEM );
+        for ( i = 0; i < length; i++ ){
+          if ( XLALBarycenterEarthNew( &ws->earth[i], &datatimes->data[i], IFO_XTRA_DATA( ifo )->ephem, IFO_XTRA_DATA( ifo )->tdat, IFO_XTRA_DATA( ifo )->ttype ) != XLAL_SUCCESS ){
+            XLALFree( ws->earth );
+            ws->earth = NULL;
+            ws->skycache.set = 0;
+            XLAL_ERROR_NULL( XLAL_EFUNC, "Barycentring routine failed" );
+          }
+        }
+      }
+
+      if ( ssb_delays( params, datatimes, ws->earth, IFO_XTRA_DATA( ifo )->ephem, IFO_XTRA_DATA( ifo )->tdat, IFO_XTRA_DATA( ifo )->ttype, ifo->detector, ws->dts->data ) != XLAL_SUCCESS ){
+        ws->skycache.set = 0;
+        XLAL_ERROR_NULL( XLAL_EFUNC );
+      }
+      dtsupdated = 1;
+    }
+    dts = ws->dts->data;
   }
 
-  if( LALInferenceCheckVariable( ifo->params, "varybinary" ) ){
+  if ( PulsarCheckParam( params, "BINARY" ) ){ isbinary = 1; } /* see if pulsar is in binary */
+
+  if( LALInferenceCheckVariable( ifo->params, "varybinary" ) && isbinary ){
     /* get binary system time delays */
-    if ( dts != NULL ){ bdts = get_bsb_delay( params, datatimes, dts, IFO_XTRA_DATA( ifo )->ephem ); }
-    else{ bdts = get_bsb_delay( params, datatimes, fixdts, IFO_XTRA_DATA( ifo )->ephem ); }
+    unchanged = phase_parameters_unchanged( params, bsb_parameter_names, &ws->binarycache );
+    if ( dtsupdated || !unchanged ){
+      /* the Earth's position and velocity at each time stamp do not depend on the parameters, so only get them once */
+      if ( ws->earthposvel == NULL ){
+        XLAL_CHECK_NULL( (ws->earthposvel = XLALMalloc( ( length > 0 ? length : 1 )*6*sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+        for ( i = 0; i < length; i++ ){
+          EarthState earth;
+          get_earth_pos_vel( &earth, IFO_XTRA_DATA( ifo )->ephem, &datatimes->data[i] );
+          memcpy( &ws->earthposvel[6*i], earth.posNow, 3*sizeof(REAL8) );
+          memcpy( &ws->earthposvel[6*i+3], earth.velNow, 3*sizeof(REAL8) );
+        }
+      }
+
+      bsb_delays( params, datatimes, dts != NULL ? dts : fixdts, IFO_XTRA_DATA( ifo )->ephem, ws->earthposvel, ws->bdts->data );
+      bdtsupdated = 1;
+    }
+    bdts = ws->bdts->data;
   }
   if( LALInferenceCheckVariable( ifo->params, "bsb_delays" ) ){
-    fixbdts = LALInferenceGetREAL8VectorVariable( ifo->params, "bsb_delays" );
+    fixbdts = LALInferenceGetREAL8VectorVariable( ifo->params, "bsb_delays" )->data;
   }
 
-  /* get vector of frequencies and frequency differences */
-  const REAL8Vector *freqs = PulsarGetREAL8VectorParam( params, "F" );
-  const REAL8Vector *deltafs = PulsarGetREAL8VectorParam( params, "DELTAF" );
-
-  if ( PulsarCheckParam( params, "BINARY" ) ){ isbinary = 1; } /* see if pulsar is in binary */
-
-  if ( LALInferenceCheckVariable( ifo->params, "varyglitch" ) ){
+  if ( LALInferenceCheckVariable( ifo->params, "varyglitch" ) && PulsarCheckParam( params, "GLEP" ) ){
     /* get the phase (in cycles due to glitch parameters */
-    if ( dts != NULL ){
-      if ( LALInferenceCheckVariable( ifo->params, "varybinary" ) ){
-        glitchphase = get_glitch_phase( params, datatimes, dts, bdts );
-      }
-      else{
-        glitchphase = get_glitch_phase( params, datatimes, dts, fixbdts );
-      }
-    }
-    else{
-      if ( LALInferenceCheckVariable( ifo->params, "varybinary" ) ){
-        glitchphase = get_glitch_phase( params, datatimes, fixdts, bdts );
-      }
-      else{
-        glitchphase = get_glitch_phase( params, datatimes, fixdts, fixbdts );
-      }
+    unchanged = phase_parameters_unchanged( params, glitch_parameter_names, &ws->glitchcache );
+    if ( dtsupdated || bdtsupdated || !unchanged ){
+      glitch_phases( params, datatimes, dts != NULL ? dts : fixdts, bdts != NULL ? bdts : fixbdts, ws->glphase->data );
     }
+    glitchphase = ws->glphase->data;
   }
   if ( LALInferenceCheckVariable( ifo->params, "glitch_phase" ) ){
-    fixglitchphase = LALInferenceGetREAL8VectorVariable( ifo->params, "glitch_phase" );
+    fixglitchphase = LALInferenceGetREAL8VectorVariable( ifo->params, "glitch_phase" )->data;
   }
 
   for( i=0; i<length; i++){
     REAL8 deltaphi = 0., innerphi = 0.; /* change in phase */
-    Ddelay = 0.;                        /* change in SSB/BSB delay */
+    REAL8 Ddelay = 0.;                  /* change in SSB/BSB delay */
+    REAL8 deltat = 0., deltatpow = 0., deltatpowinner = 1., Ddelaypow = 0., Ddelaypowj = 1.;
 
-    REAL8 realT = XLALGPSGetREAL8( &datatimes->data[i] ); /* time of data */
-    DT = realT - T0; /* time diff between data and start of data */
+    REAL8 DT = tgps[i] - T0; /* time diff between data and start of data */
 
     /* get difference in solar system barycentring time delays */
-    if ( dts != NULL ){ Ddelay += ( dts->data[i] - fixdts->data[i] ); }
-    deltat = DT + fixdts->data[i];
+    if ( dts != NULL ){ Ddelay += ( dts[i] - fixdts[i] ); }
+    deltat = DT + fixdts[i];
 
     if ( isbinary ){
       /* get difference in binary system barycentring time delays */
-      if ( bdts != NULL && fixbdts != NULL ) { Ddelay += ( bdts->data[i] - fixbdts->data[i] ); }
-      deltat += fixbdts->data[i];
+      if ( bdts != NULL && fixbdts != NULL ) { Ddelay += ( bdts[i] - fixbdts[i] ); }
+      deltat += fixbdts[i];
     }
 
     /* correct for speed of GW compared to speed of light */
@@ -580,38 +831,116 @@ REAL8Vector *get_phase_model( PulsarParameters *params, LALInferenceIFOModel *if
 
     /* get the change in phase (compared to the heterodyned phase) */
     deltatpow = deltat;
-    for ( j=0; j<freqs->length; j++ ){
-      taylorcoeff = gsl_sf_fact(j+1);
-      deltaphi += deltafs->data[j]*deltatpow/taylorcoeff;
+    for ( j=0; j<nfreqs; j++ ){
+      deltaphi += deltafs->data[j]*deltatpow*invfact[j];
       if ( Ddelay != 0. ){
         innerphi = 0.;
         deltatpowinner = 1.; /* this starts as one as it is first raised to the power of zero */
-        Ddelaypow = pow(Ddelay, j+1);
+        Ddelaypowj *= Ddelay;
+        Ddelaypow = Ddelaypowj;
         for ( k=0; k<j+1; k++ ){
-          innerphi += gsl_sf_choose(j+1, k) * Ddelaypow * deltatpowinner;
+          innerphi += binom[j*nfreqs + k] * Ddelaypow * deltatpowinner;
           deltatpowinner *= deltat; /* raise power */
           Ddelaypow /= Ddelay;      /* reduce power */
         }
-        deltaphi += innerphi*freqs->data[j]/taylorcoeff;
+        deltaphi += innerphi*freqs->data[j]*invfact[j];
       }
       deltatpow *= deltat;
     }
 
     /* get the differences for glitch phases */
     if ( glitchphase !=  NULL ){
-      deltaphi += ( glitchphase->data[i] - fixglitchphase->data[i] );
+      deltaphi += ( glitchphase[i] - fixglitchphase[i] );
     }
 
     deltaphi *= freqFactor; /* multiply by frequency factor */
-    phis->data[i] = deltaphi - floor(deltaphi); /* only need to keep the fractional part of the phase */
+    phis[i] = deltaphi - floor(deltaphi); /* only need to keep the fractional part of the phase */
+  }
+
+  return ws->phis;
+}
+
+
+/* get the sky position and distance parameters used for solar system barycentring, with the right ascension and
+ * declination wrapped within 0--2pi and -pi/2--pi/2 respectively */
+static int ssb_parameters( PulsarParameters *pars, REAL8 *ra, REAL8 *dec, REAL8 *pmra, REAL8 *pmdec, REAL8 *posepoch,
+                           REAL8 *dInv ){
+  if ( PulsarCheckParam( pars, "RA" ) ) { *ra = PulsarGetREAL8Param( pars, "RA" ); }
+  else if ( PulsarCheckParam( pars, "RAJ" ) ) { *ra = PulsarGetREAL8Param( pars, "RAJ" ); }
+  else {
+    XLAL_ERROR( XLAL_EINVAL, "No source right ascension specified!" );
+  }
+  if ( PulsarCheckParam( pars, "DEC" ) ) { *dec = PulsarGetREAL8Param( pars, "DEC" ); }
+  else if ( PulsarCheckParam( pars, "DECJ" ) ) { *dec = PulsarGetREAL8Param( pars, "DECJ" ); }
+  else {
+    XLAL_ERROR( XLAL_EINVAL, "No source declination specified!" );
+  }
+  *pmra = PulsarGetREAL8ParamOrZero( pars, "PMRA" );
+  *pmdec = PulsarGetREAL8ParamOrZero( pars, "PMDEC" );
+  REAL8 pepoch = PulsarGetREAL8ParamOrZero( pars, "PEPOCH" );
+  *posepoch = PulsarGetREAL8ParamOrZero( pars, "POSEPOCH" );
+  REAL8 px = PulsarGetREAL8ParamOrZero( pars, "PX" );     /* parallax */
+
+   /* set the position and frequency epochs if not already set */
+  if( pepoch == 0. && *posepoch != 0.) { pepoch = *posepoch; }
+  else if( *posepoch == 0. && pepoch != 0. ) { *posepoch = pepoch; }
+
+  /* set 1/distance if parallax value is given (1/sec) */
+  if( px != 0. ) { *dInv = px*(LAL_C_SI/LAL_AU_SI); }
+  else { *dInv = 0.; }
+
+  /* make sure ra and dec are wrapped within 0--2pi and -pi.2--pi/2 respectively */
+  *ra = fmod(*ra, LAL_TWOPI);
+  REAL8 absdec = fabs(*dec);
+  if ( absdec > LAL_PI_2 ){
+    UINT4 nwrap = floor((absdec+LAL_PI_2)/LAL_PI);
+    *dec = (*dec > 0 ? 1. : -1.)*(nwrap%2 == 1 ? -1. : 1.)*(fmod(absdec + LAL_PI_2, LAL_PI) - LAL_PI_2);
+    *ra = fmod(*ra + (REAL8)nwrap*LAL_PI, LAL_TWOPI); /* move RA by pi */
   }
 
-  /* free memory */
-  if ( dts != NULL ){ XLALDestroyREAL8Vector( dts ); }
-  if ( bdts != NULL ){ XLALDestroyREAL8Vector( bdts ); }
-  if ( glitchphase != NULL ){ XLALDestroyREAL8Vector( glitchphase ); }
+  return XLAL_SUCCESS;
+}
+
+
+/* calculate the solar system barycentring delays into dts, using the Earth states in earth if it is not NULL,
+ * or calculating them at each time stamp otherwise */
+static int ssb_delays( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, const EarthState *earth,
+                       EphemerisData *ephem, TimeCorrectionData *tdat, TimeCorrectionType ttype,
+                       LALDetector *detector, REAL8 *dts ){
+  UINT4 i = 0;
+  REAL8 ra = 0., dec = 0., pmra = 0., pmdec = 0., posepoch = 0.;
+
+  BarycenterInput bary;
+
+  /* copy barycenter and ephemeris data */
+  bary.site.location[0] = detector->location[0]/LAL_C_SI;
+  bary.site.location[1] = detector->location[1]/LAL_C_SI;
+  bary.site.location[2] = detector->location[2]/LAL_C_SI;
+
+  XLAL_CHECK( ssb_parameters( pars, &ra, &dec, &pmra, &pmdec, &posepoch, &bary.dInv ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  EarthState earthi;
+  EmissionTime emit;
+  for( i=0; i<datatimes->length; i++){
+    REAL8 realT = XLALGPSGetREAL8( &datatimes->data[i] );
 
-  return phis;
+    bary.tgps = datatimes->data[i];
+    bary.delta = dec + ( realT - posepoch ) * pmdec;
+    bary.alpha = ra + ( realT - posepoch ) * pmra / cos( bary.delta );
+
+    /* call barycentring routines */
+    if ( earth == NULL ){
+      XLAL_CHECK( XLALBarycenterEarthNew( &earthi, &bary.tgps, ephem, tdat, ttype ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
+      XLAL_CHECK( XLALBarycenter( &emit, &bary, &earthi ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
+    }
+    else{
+      XLAL_CHECK( XLALBarycenter( &emit, &bary, &earth[i] ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
+    }
+
+    dts[i] = emit.deltaT;
+  }
+
+  return XLAL_SUCCESS;
 }
 
 
@@ -639,77 +968,46 @@ REAL8Vector *get_phase_model( PulsarParameters *params, LALInferenceIFOModel *if
  */
 REAL8Vector *get_ssb_delay( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, EphemerisData *ephem,
                             TimeCorrectionData *tdat, TimeCorrectionType ttype, LALDetector *detector ){
-  INT4 i = 0, length = 0;
-
-  BarycenterInput bary;
-
   REAL8Vector *dts = NULL;
 
   /* if edat is NULL then return a NULL poniter */
   if( ephem == NULL ) { return NULL; }
 
-  /* copy barycenter and ephemeris data */
-  bary.site.location[0] = detector->location[0]/LAL_C_SI;
-  bary.site.location[1] = detector->location[1]/LAL_C_SI;
-  bary.site.location[2] = detector->location[2]/LAL_C_SI;
+  /* allocate memory for times delays */
+  dts = XLALCreateREAL8Vector( datatimes->length );
 
-  REAL8 ra = 0.;
-  if ( PulsarCheckParam( pars, "RA" ) ) { ra = PulsarGetREAL8Param( pars, "RA" ); }
-  else if ( PulsarCheckParam( pars, "RAJ" ) ) { ra = PulsarGetREAL8Param( pars, "RAJ" ); }
-  else {
-    XLAL_ERROR_NULL( XLAL_EINVAL, "No source right ascension specified!" );
+  if ( ssb_delays( pars, datatimes, NULL, ephem, tdat, ttype, detector, dts->data ) != XLAL_SUCCESS ){
+    XLALDestroyREAL8Vector( dts );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
   }
-  REAL8 dec = 0.;
-  if ( PulsarCheckParam( pars, "DEC" ) ) { dec = PulsarGetREAL8Param( pars, "DEC" ); }
-  else if ( PulsarCheckParam( pars, "DECJ" ) ) { dec = PulsarGetREAL8Param( pars, "DECJ" ); }
-  else {
-    XLAL_ERROR_NULL( XLAL_EINVAL, "No source declination specified!" );
-  }
-  REAL8 pmra = PulsarGetREAL8ParamOrZero( pars, "PMRA" );
-  REAL8 pmdec = PulsarGetREAL8ParamOrZero( pars, "PMDEC" );
-  REAL8 pepoch = PulsarGetREAL8ParamOrZero( pars, "PEPOCH" );
-  REAL8 posepoch = PulsarGetREAL8ParamOrZero( pars, "POSEPOCH" );
-  REAL8 px = PulsarGetREAL8ParamOrZero( pars, "PX" );     /* parallax */
-
-   /* set the position and frequency epochs if not already set */
-  if( pepoch == 0. && posepoch != 0.) { pepoch = posepoch; }
-  else if( posepoch == 0. && pepoch != 0. ) { posepoch = pepoch; }
-
-  length = datatimes->length;
 
-  /* allocate memory for times delays */
-  dts = XLALCreateREAL8Vector( length );
-
-  /* set 1/distance if parallax value is given (1/sec) */
-  if( px != 0. ) { bary.dInv = px*(LAL_C_SI/LAL_AU_SI); }
-  else { bary.dInv = 0.; }
+  return dts;
+}
 
-  /* make sure ra and dec are wrapped within 0--2pi and -pi.2--pi/2 respectively */
-  ra = fmod(ra, LAL_TWOPI);
-  REAL8 absdec = fabs(dec);
-  if ( absdec > LAL_PI_2 ){
-    UINT4 nwrap = floor((absdec+LAL_PI_2)/LAL_PI);
-    dec = (dec > 0 ? 1. : -1.)*(nwrap%2 == 1 ? -1. : 1.)*(fmod(absdec + LAL_PI_2, LAL_PI) - LAL_PI_2);
-    ra = fmod(ra + (REAL8)nwrap*LAL_PI, LAL_TWOPI); /* move RA by pi */
-  }
 
+/* calculate the binary system barycentring delays into bdts, using the Earth positions and velocities in
+ * earthposvel (six values per time stamp) if it is not NULL, or calculating them at each time stamp otherwise */
+static void bsb_delays( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, const REAL8 *dts, EphemerisData *edat,
+                        const REAL8 *earthposvel, REAL8 *bdts ){
+  BinaryPulsarInput binput;
+  BinaryPulsarOutput boutput;
   EarthState earth;
-  EmissionTime emit;
-  for( i=0; i<length; i++){
-    REAL8 realT = XLALGPSGetREAL8( &datatimes->data[i] );
 
-    bary.tgps = datatimes->data[i];
-    bary.delta = dec + ( realT - posepoch ) * pmdec;
-    bary.alpha = ra + ( realT - posepoch ) * pmra / cos( bary.delta );
+  UINT4 i = 0;
 
-    /* call barycentring routines */
-    XLAL_CHECK_NULL( XLALBarycenterEarthNew( &earth, &bary.tgps, ephem, tdat, ttype ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
-    XLAL_CHECK_NULL( XLALBarycenter( &emit, &bary, &earth ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
+  for ( i = 0; i < datatimes->length; i++ ){
+    binput.tb = XLALGPSGetREAL8( &datatimes->data[i] ) + dts[i];
 
-    dts->data[i] = emit.deltaT;
-  }
+    if ( earthposvel == NULL ){ get_earth_pos_vel( &earth, edat, &datatimes->data[i] ); }
+    else{
+      memcpy( earth.posNow, &earthposvel[6*i], 3*sizeof(REAL8) );
+      memcpy( earth.velNow, &earthposvel[6*i+3], 3*sizeof(REAL8) );
+    }
 
-  return dts;
+    binput.earth = earth; /* current Earth state */
+    XLALBinaryPulsarDeltaTNew( &boutput, &binput, pars );
+    bdts[i] = boutput.deltaT;
+  }
 }
 
 
@@ -731,134 +1029,89 @@ REAL8Vector *get_ssb_delay( PulsarParameters *pars, LIGOTimeGPSVector *datatimes
  */
 REAL8Vector *get_bsb_delay( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, REAL8Vector *dts, EphemerisData *edat ){
   REAL8Vector *bdts = NULL;
-  BinaryPulsarInput binput;
-  BinaryPulsarOutput boutput;
-  EarthState earth;
-
-  INT4 i = 0, length = datatimes->length;
 
   /* check whether there's a binary model */
   if ( PulsarCheckParam( pars, "BINARY" ) ){
-    bdts = XLALCreateREAL8Vector( length );
+    bdts = XLALCreateREAL8Vector( datatimes->length );
 
-    for ( i = 0; i < length; i++ ){
-      binput.tb = XLALGPSGetREAL8( &datatimes->data[i] ) + dts->data[i];
-
-      get_earth_pos_vel( &earth, edat, &datatimes->data[i] );
-
-      binput.earth = earth; /* current Earth state */
-      XLALBinaryPulsarDeltaTNew( &boutput, &binput, pars );
-      bdts->data[i] = boutput.deltaT;
-    }
+    bsb_delays( pars, datatimes, dts->data, edat, NULL, bdts->data );
   }
   return bdts;
 }
 
 
-/**
- * \brief Computes the phase from the glitch model.
- *
- * \param pars [in] A set of pulsar parameters
- * \param datatimes [in] A vector of GPS times
- * \param dts [in] A vector of solar system barycentre time delays
- * \param bdts [in] A vector of binary system barycentre time delays
- * \return A vector of phases in cycles
- */
-REAL8Vector *get_glitch_phase( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, REAL8Vector *dts, REAL8Vector *bdts ){
-  REAL8Vector *glphase = NULL;
-
-  /* glitch parameters */
-  REAL8 *glep = NULL, *glph = NULL, *glf0 = NULL, *glf1 = NULL, *glf2 = NULL, *glf0d = NULL, *gltd = NULL;
-  UINT4 glnum = 0;
+/* get the jth value of a glitch parameter vector, or zero if it is not given */
+#define GLITCH_PARAMETER( glpars, j ) ( ( (glpars) != NULL && (j) < (glpars)->length ) ? (glpars)->data[(j)] : 0. )
 
+/* calculate the glitch phase (in cycles) at each time stamp into glphase */
+static void glitch_phases( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, const REAL8 *dts, const REAL8 *bdts,
+                           REAL8 *glphase ){
   UINT4 i = 0, j = 0, length = datatimes->length;
 
   REAL8 pepoch = PulsarGetREAL8ParamOrZero(pars, "PEPOCH"); /* time of ephem info */
   REAL8 cgw = PulsarGetREAL8ParamOrZero(pars, "CGW");
   REAL8 T0 = pepoch;
 
-  if ( PulsarCheckParam( pars, "GLEP" ) ){ /* see if pulsar has glitch parameters */
-    const REAL8Vector *gleppars = PulsarGetREAL8VectorParam( pars, "GLEP" );
-    glnum = gleppars->length;
-
-    /* get epochs */
-    glep = XLALCalloc(glnum, sizeof(REAL8)); /* initialise to zeros */
-    for ( i=0; i<gleppars->length; i++ ){ glep[i] = gleppars->data[i]; }
-
-    /* get phase offsets */
-    glph = XLALCalloc(glnum, sizeof(REAL8)); /* initialise to zeros */
-    if ( PulsarCheckParam( pars, "GLPH" ) ){
-      const REAL8Vector *glpars = PulsarGetREAL8VectorParam( pars, "GLPH" );
-      for ( i=0; i<glpars->length; i++ ){ glph[i] = glpars->data[i]; }
-    }
-
-    /* get frequencies offsets */
-    glf0 = XLALCalloc(glnum, sizeof(REAL8)); /* initialise to zeros */
-    if ( PulsarCheckParam( pars, "GLF0" ) ){
-      const REAL8Vector *glpars = PulsarGetREAL8VectorParam( pars, "GLF0" );
-      for ( i=0; i<glpars->length; i++ ){ glf0[i] = glpars->data[i]; }
-    }
+  /* glitch parameters */
+  const REAL8Vector *glep = PulsarGetREAL8VectorParam( pars, "GLEP" );
+  const REAL8Vector *glph = PulsarCheckParam( pars, "GLPH" ) ? PulsarGetREAL8VectorParam( pars, "GLPH" ) : NULL;
+  const REAL8Vector *glf0 = PulsarCheckParam( pars, "GLF0" ) ? PulsarGetREAL8VectorParam( pars, "GLF0" ) : NULL;
+  const REAL8Vector *glf1 = PulsarCheckParam( pars, "GLF1" ) ? PulsarGetREAL8VectorParam( pars, "GLF1" ) : NULL;
+  const REAL8Vector *glf2 = PulsarCheckParam( pars, "GLF2" ) ? PulsarGetREAL8VectorParam( pars, "GLF2" ) : NULL;
+  const REAL8Vector *glf0d = PulsarCheckParam( pars, "GLF0D" ) ? PulsarGetREAL8VectorParam( pars, "GLF0D" ) : NULL;
+  const REAL8Vector *gltd = PulsarCheckParam( pars, "GLTD" ) ? PulsarGetREAL8VectorParam( pars, "GLTD" ) : NULL;
+  UINT4 glnum = glep->length;
+
+  for ( i = 0; i < length; i++ ){
+    REAL8 deltaphi = 0., deltat = 0., DT = 0.;
+    REAL8 realT = XLALGPSGetREAL8( &datatimes->data[i] ); /* time of data */
+    DT = realT - T0; /* time diff between data and start of data */
 
-    /* get frequency derivative offsets */
-    glf1 = XLALCalloc(glnum, sizeof(REAL8)); /* initialise to zeros */
-    if ( PulsarCheckParam( pars, "GLF1" ) ){
-      const REAL8Vector *glpars = PulsarGetREAL8VectorParam( pars, "GLF1" );
-      for ( i=0; i<glpars->length; i++ ){ glf1[i] = glpars->data[i]; }
-    }
+    /* include solar system barycentring time delays */
+    deltat = DT + dts[i];
 
-    /* get second frequency derivative offsets */
-    glf2 = XLALCalloc(glnum, sizeof(REAL8)); /* initialise to zeros */
-    if ( PulsarCheckParam( pars, "GLF2" ) ){
-      const REAL8Vector *glpars = PulsarGetREAL8VectorParam( pars, "GLF2" );
-      for ( i=0; i<glpars->length; i++ ){ glf2[i] = glpars->data[i]; }
+    /* include binary system barycentring time delays */
+    if ( bdts != NULL ){
+      deltat += bdts[i];
     }
 
-    /* get decaying frequency component offset derivative */
-    glf0d = XLALCalloc(glnum, sizeof(REAL8)); /* initialise to zeros */
-    if ( PulsarCheckParam( pars, "GLF0D" ) ){
-      const REAL8Vector *glpars = PulsarGetREAL8VectorParam( pars, "GLF0D" );
-      for ( i=0; i<glpars->length; i++ ){ glf0d[i] = glpars->data[i]; }
+    /* correct for speed of GW compared to speed of light */
+    if ( cgw > 0.0 && cgw < 1. ) {
+      deltat /= cgw;
     }
 
-    /* get decaying frequency component decay time constant */
-    gltd = XLALCalloc(glnum, sizeof(REAL8)); /* initialise to zeros */
-    if ( PulsarCheckParam( pars, "GLTD" ) ){
-      const REAL8Vector *glpars = PulsarGetREAL8VectorParam( pars, "GLTD" );
-      for ( i=0; i<glpars->length; i++ ){ gltd[i] = glpars->data[i]; }
+    /* get glitch phase - based on equations in formResiduals.C of TEMPO2 from Eqn 1 of Yu et al (2013) http://ukads.nottingham.ac.uk/abs/2013MNRAS.429..688Y */
+    for ( j=0; j<glnum; j++ ){
+      if ( deltat >= (glep->data[j]-T0) ){
+        REAL8 dtg = 0, expd = 1., td = GLITCH_PARAMETER( gltd, j );
+        dtg = deltat - (glep->data[j]-T0); /* time since glitch */
+        if ( td != 0. ) { expd = exp(-dtg/td); } /* decaying part of glitch */
+        deltaphi += GLITCH_PARAMETER( glph, j ) + GLITCH_PARAMETER( glf0, j )*dtg + 0.5*GLITCH_PARAMETER( glf1, j )*dtg*dtg
+          + (1./6.)*GLITCH_PARAMETER( glf2, j )*dtg*dtg*dtg + GLITCH_PARAMETER( glf0d, j )*td*(1.-expd);
+      }
     }
 
-    glphase = XLALCreateREAL8Vector( length );
-
-    for ( i = 0; i < length; i++ ){
-      REAL8 deltaphi = 0., deltat = 0., DT = 0.;
-      REAL8 realT = XLALGPSGetREAL8( &datatimes->data[i] ); /* time of data */
-      DT = realT - T0; /* time diff between data and start of data */
+    glphase[i] = deltaphi;
+  }
+}
 
-      /* include solar system barycentring time delays */
-      deltat = DT + dts->data[i];
 
-      /* include binary system barycentring time delays */
-      if ( bdts != NULL ){
-        deltat += bdts->data[i];
-      }
-
-      /* correct for speed of GW compared to speed of light */
-      if ( cgw > 0.0 && cgw < 1. ) {
-        deltat /= cgw;
-      }
+/**
+ * \brief Computes the phase from the glitch model.
+ *
+ * \param pars [in] A set of pulsar parameters
+ * \param datatimes [in] A vector of GPS times
+ * \param dts [in] A vector of solar system barycentre time delays
+ * \param bdts [in] A vector of binary system barycentre time delays
+ * \return A vector of phases in cycles
+ */
+REAL8Vector *get_glitch_phase( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, REAL8Vector *dts, REAL8Vector *bdts ){
+  REAL8Vector *glphase = NULL;
 
-      /* get glitch phase - based on equations in formResiduals.C of TEMPO2 from Eqn 1 of Yu et al (2013) http://ukads.nottingham.ac.uk/abs/2013MNRAS.429..688Y */
-      for ( j=0; j<glnum; j++ ){
-        if ( deltat >= (glep[j]-T0) ){
-          REAL8 dtg = 0, expd = 1.;
-          dtg = deltat - (glep[j]-T0); /* time since glitch */
-          if ( gltd[j] != 0. ) { expd = exp(-dtg/gltd[j]); } /* decaying part of glitch */
-          deltaphi += glph[j] + glf0[j]*dtg + 0.5*glf1[j]*dtg*dtg + (1./6.)*glf2[j]*dtg*dtg*dtg + glf0d[j]*gltd[j]*(1.-expd);
-        }
-      }
+  if ( PulsarCheckParam( pars, "GLEP" ) ){ /* see if pulsar has glitch parameters */
+    glphase = XLALCreateREAL8Vector( datatimes->length );
 
-      glphase->data[i] = deltaphi;
-    }
+    glitch_phases( pars, datatimes, dts->data, bdts != NULL ? bdts->data : NULL, glphase->data );
   }
 
   return glphase;
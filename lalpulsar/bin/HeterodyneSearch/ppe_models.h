@@ -35,11 +35,15 @@ extern "C" {
 #define IFO_XTRA_DATA( ifo ) ( (IFOModelExtraData*) ( ifo )->extraData )
 
 /* types */
+/** Workspace for the phase model (see \c get_phase_model) */
+typedef struct tagPhaseModelWorkspace PhaseModelWorkspace;
+
 typedef struct tagIFOModelExtraData {
-  LIGOTimeGPSVector  *times;   /** Vector of time stamps for time domain data */
-  EphemerisData      *ephem;   /** Ephemeris data */
-  TimeCorrectionData *tdat;    /** Einstein delay time correction data */
-  TimeCorrectionType  ttype;   /** The time correction type e.g. TDB, TCB */
+  LIGOTimeGPSVector   *times;   /** Vector of time stamps for time domain data */
+  EphemerisData       *ephem;   /** Ephemeris data */
+  TimeCorrectionData  *tdat;    /** Einstein delay time correction data */
+  TimeCorrectionType   ttype;   /** The time correction type e.g. TDB, TCB */
+  PhaseModelWorkspace *phasews; /** Phase model workspace (created when first used) */
 } IFOModelExtraData;
 
 /* global variables */
@@ -57,6 +61,8 @@ void set_nonGR_model_parameters( PulsarParameters *pars, char* nonGRmodel );
 
 REAL8Vector *get_phase_model( PulsarParameters *params, LALInferenceIFOModel *ifo, REAL8 freqFactor );
 
+void destroy_phase_model_workspace( PhaseModelWorkspace *ws );
+
 REAL8Vector *get_ssb_delay( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, EphemerisData *ephem,
                             TimeCorrectionData *tdat, TimeCorrectionType ttype, LALDetector *detector);
 
@@ -455,6 +455,7 @@ void generate_interpolant( LALInferenceRunState *runState ){
 
         XLALDestroyREAL8Vector( deltas );
         XLALDestroyTimestampVector( IFO_XTRA_DATA( ifotmp )->times );
+        destroy_phase_model_workspace( IFO_XTRA_DATA( ifotmp )->phasews );
         XLALDestroyCOMPLEX16TimeSeries( ifotmp->compTimeSignal );
         LALInferenceClearVariables( ifotmp->params );
         XLALFree( tmpRS->threads[0].model );
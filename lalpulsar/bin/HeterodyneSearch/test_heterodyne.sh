@@ -67,6 +67,31 @@ if [ $? != "0" ]; then
         exit 2
 fi
 
+# create a parameter file for a second pulsar (for testing the pulsar list mode)
+PSRNAME2=J1200+1000
+FREQ2=201.234567
+FDOT2=-1.23456789e-11
+RA2=12:00:00.0
+DEC2=10:00:00.0
+PFILE2=$PSRNAME2.par
+
+if [ -f $PFILE2 ]; then
+        rm -f $PFILE2
+fi
+
+echo PSR    $PSRNAME2 > $PFILE2
+echo F0     $FREQ2 >> $PFILE2
+echo F1     $FDOT2 >> $PFILE2
+echo RAJ    $RA2 >> $PFILE2
+echo DECJ   $DEC2 >> $PFILE2
+echo PEPOCH $PEPOCH >> $PFILE2
+echo UNITS  $UNITS >> $PFILE2
+
+if [ $? != "0" ]; then
+        echo Error writing parameter file!
+        exit 2
+fi
+
 # set ephemeris file
 EEPHEM="earth00-40-DE405.dat.gz"
 SEPHEM="sun00-40-DE405.dat.gz"
@@ -350,6 +375,105 @@ fi
 # move file
 mv $FINEFILE $FINEFILE.full
 
+################### HETERODYNE A LIST OF PULSARS #############
+# heterodyne two pulsars in a single pass through the frame data, in coarse
+# (mode 0) and one step fine (mode 3) mode, and check that the output for each
+# pulsar is identical to that of a run with just its own parameter file
+
+# compare the data in two output files, ignoring the "%%" header lines (which
+# contain the file creation time and the command line)
+same_data(){
+  diff <(grep -v "^%%" $1) <(grep -v "^%%" $2) > /dev/null
+}
+
+LISTFILE=$LOCATION/pulsarlist
+LISTCOARSE=$OUTDIR/listcoarsehet
+LISTFINE=$OUTDIR/listfinehet
+
+if [ -f $LISTFILE ]; then
+        rm -f $LISTFILE
+fi
+
+echo "# parameter file    output file" > $LISTFILE
+echo $PFILE $LISTCOARSE.1 >> $LISTFILE
+echo $PFILE2 $LISTCOARSE.2 >> $LISTFILE
+
+if [ $? != "0" ]; then
+        echo Error writing pulsar list file!
+        exit 2
+fi
+
+echo Performing coarse heterodyne - mode 0 - of a list of pulsars
+$CODENAME --heterodyne-flag 0 --ifo $DETECTOR --pulsar-list $LISTFILE --sample-rate $SRATE1 --resample-rate $SRATE2 --filter-knee $FKNEE --data-file $LOCATION/cachefile --seg-file $LOCATION/segfile --channel $CHANNEL --freq-factor 2
+
+# check the exit status of the code
+ret_code=$?
+if [ $ret_code != "0" ]; then
+        echo lalpulsar_heterodyne exited with error $ret_code!
+        exit 2
+fi
+
+echo Performing coarse heterodyne - mode 0 - of the second pulsar on its own
+$CODENAME --heterodyne-flag 0 --ifo $DETECTOR --pulsar $PSRNAME2 --param-file $PFILE2 --sample-rate $SRATE1 --resample-rate $SRATE2 --filter-knee $FKNEE --data-file $LOCATION/cachefile --seg-file $LOCATION/segfile --channel $CHANNEL --output-file $LISTCOARSE.2.single --freq-factor 2
+
+# check the exit status of the code
+ret_code=$?
+if [ $ret_code != "0" ]; then
+        echo lalpulsar_heterodyne exited with error $ret_code!
+        exit 2
+fi
+
+# the first pulsar is compared with the text file output by the coarse heterodyne above
+if ! same_data $LISTCOARSE.1 $COARSEFILE.txt; then
+        echo Error! Coarse heterodyne of the first pulsar in the list differs from a single pulsar run
+        exit 2
+fi
+
+if ! same_data $LISTCOARSE.2 $LISTCOARSE.2.single; then
+        echo Error! Coarse heterodyne of the second pulsar in the list differs from a single pulsar run
+        exit 2
+fi
+
+echo "# parameter file    output file" > $LISTFILE
+echo $PFILE $LISTFINE.1 >> $LISTFILE
+echo $PFILE2 $LISTFINE.2 >> $LISTFILE
+
+if [ $? != "0" ]; then
+        echo Error writing pulsar list file!
+        exit 2
+fi
+
+echo Performing entire heterodyne in one go - mode 3 - of a list of pulsars
+$CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 3 --ifo $DETECTOR --pulsar-list $LISTFILE --sample-rate $SRATE1 --resample-rate $SRATE3 --filter-knee $FKNEE --data-file $LOCATION/cachefile --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --calibrate --response-file $RESPFILE --stddev-thresh 5
+
+# check the exit status of the code
+ret_code=$?
+if [ $ret_code != "0" ]; then
+        echo lalpulsar_heterodyne exited with error $ret_code!
+        exit 2
+fi
+
+echo Performing entire heterodyne in one go - mode 3 - of the second pulsar on its own
+$CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 3 --ifo $DETECTOR --pulsar $PSRNAME2 --param-file $PFILE2 --sample-rate $SRATE1 --resample-rate $SRATE3 --filter-knee $FKNEE --data-file $LOCATION/cachefile --output-file $LISTFINE.2.single --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --calibrate --response-file $RESPFILE --stddev-thresh 5
+
+# check the exit status of the code
+ret_code=$?
+if [ $ret_code != "0" ]; then
+        echo lalpulsar_heterodyne exited with error $ret_code!
+        exit 2
+fi
+
+# the first pulsar is compared with the output of the mode 3 heterodyne above
+if ! same_data $LISTFINE.1 $FINEFILE.full; then
+        echo Error! Fine heterodyne of the first pulsar in the list differs from a single pulsar run
+        exit 2
+fi
+
+if ! same_data $LISTFINE.2 $LISTFINE.2.single; then
+        echo Error! Fine heterodyne of the second pulsar in the list differs from a single pulsar run
+        exit 2
+fi
+
 ################### REHETERODYNE THE ALREADY FINE HETERODYNED FILE #####
 echo Performing updating heterodyne of already fine heterodyned data
 $CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 4 --ifo $DETECTOR --pulsar $PSRNAME --param-file $PFILEOFF --param-file-update $PFILE --sample-rate $SRATE3 --resample-rate $SRATE3 --filter-knee 0 --data-file $FINEFILE.off2 --output-file $FINEFILE --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --stddev-thresh 5
@@ -696,6 +820,10 @@ rm -f segfile
 # remove parameter files
 rm -f $PFILE
 rm -f $PFILEOFF
+rm -f $PFILE2
+
+# remove pulsar list file
+rm -f $LISTFILE
 
 # remove upacked frame files
 rm -f ${LOCATION}/framedir/*
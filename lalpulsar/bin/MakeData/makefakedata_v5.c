@@ -119,6 +119,7 @@ typedef struct
   REAL8 fmin;		/**< Lowest frequency in output SFT (= heterodyning frequency) */
   REAL8 Band;		/**< bandwidth of output SFT in Hz (= 1/2 sampling frequency) */
   REAL8 sourceDeltaT;   /**< source-frame sampling period. '0' implies defaults set in XLALGeneratePulsarSignal() */
+  UINT4 SFTDterms;      /**< if >0, synthesise SFTs directly in the frequency domain using this many Dirichlet-kernel terms */
 
   /* SFT params */
   REAL8 Tsft;		        /**< SFT time baseline Tsft */
@@ -200,11 +201,14 @@ main(int argc, char *argv[])
   DataParams.SFTWindowType      = GV.window_type;
   DataParams.SFTWindowParam     = GV.window_param;
   DataParams.sourceDeltaT       = uvar.sourceDeltaT;
+  DataParams.SFTDterms          = uvar.SFTDterms;
   DataParams.inputMultiTS       = GV.inputMultiTS;
   DataParams.fMin               = GV.fminOut;
   DataParams.Band               = GV.BandOut;
 
-  XLAL_CHECK ( XLALCWMakeFakeMultiData ( &mSFTs, &mTseries, injectionSources, &DataParams, GV.edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // no time-series is generated when synthesising SFTs directly in the frequency domain
+  MultiREAL8TimeSeries **mTseriesOut = ( uvar.SFTDterms > 0 ) ? NULL : &mTseries;
+  XLAL_CHECK ( XLALCWMakeFakeMultiData ( &mSFTs, mTseriesOut, injectionSources, &DataParams, GV.edat ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLALDestroyPulsarParamsVector ( injectionSources );
   injectionSources = NULL;
@@ -225,17 +229,19 @@ main(int argc, char *argv[])
     }
 
   // determine output channel names for frames and public SFT filenames
+  const UINT4 numDet = mSFTs->length;
 #ifdef HAVE_LIBLALFRAME
   if ( XLALUserVarWasSet ( &uvar.outFrChannels ) ) {
-    XLAL_CHECK ( uvar.outFrChannels->length == mTseries->length, XLAL_EINVAL, "--outFrChannels: number of channel names (%d) must agree with number of IFOs (%d)\n",
-                 uvar.outFrChannels->length, mTseries->length );
+    XLAL_CHECK ( uvar.outFrChannels->length == numDet, XLAL_EINVAL, "--outFrChannels: number of channel names (%d) must agree with number of IFOs (%d)\n",
+                 uvar.outFrChannels->length, numDet );
   }
 #endif
-  LALStringVector *outChannelNames = XLALCreateEmptyStringVector( mTseries->length );
+  LALStringVector *outChannelNames = XLALCreateEmptyStringVector( numDet );
   XLAL_CHECK ( outChannelNames != NULL, XLAL_EFUNC );
-  for ( UINT4 X=0; X < mTseries->length; X ++ )
+  for ( UINT4 X=0; X < numDet; X ++ )
     {
-      REAL8TimeSeries *Tseries = mTseries->data[X];
+      // detector prefix, from time-series or SFT name
+      const char *detName = ( mTseries != NULL ) ? mTseries->data[X]->name : mSFTs->data[X]->data[0].name;
       char buffer[LALNameLength];
 
       size_t written = 0;
@@ -244,14 +250,14 @@ main(int argc, char *argv[])
       } else if ( XLALUserVarWasSet ( &uvar.outFrChannels ) ) { // if output frame channel names given, use those
         written = snprintf ( buffer, sizeof(buffer), "%s", uvar.outFrChannels->data[X] );
         if ( buffer[2] == ':' ) { // check we got correct IFO association
-          XLAL_CHECK ( (buffer[0] == Tseries->name[0]) && (buffer[1] == Tseries->name[1]), XLAL_EINVAL,
-                       "Possible IFO mismatch: outFrChannel[%d] = '%s', IFO = '%c%c': be careful about --outFrChannel ordering\n", X, buffer, Tseries->name[0], Tseries->name[1] );
+          XLAL_CHECK ( (buffer[0] == detName[0]) && (buffer[1] == detName[1]), XLAL_EINVAL,
+                       "Possible IFO mismatch: outFrChannel[%d] = '%s', IFO = '%c%c': be careful about --outFrChannel ordering\n", X, buffer, detName[0], detName[1] );
         } // if buffer[2]==':'
       } else if ( XLALUserVarWasSet ( &uvar.inFrChannels ) ) { // otherwise: if input frame channel names given, use them for output, append "-<outLabel>"
         written = snprintf ( buffer, sizeof(buffer), "%s-%s", uvar.inFrChannels->data[X], uvar.outLabel );
 #endif
       } else { // otherwise: fall back to <IFO>:<outLabel> channel name
-        written = snprintf ( buffer, sizeof(buffer), "%c%c:%s", Tseries->name[0], Tseries->name[1], uvar.outLabel );
+        written = snprintf ( buffer, sizeof(buffer), "%c%c:%s", detName[0], detName[1], uvar.outLabel );
       }
       XLAL_CHECK ( written < LALNameLength, XLAL_ESIZE, "Output frame name exceeded max length (%d): '%s'\n", LALNameLength, buffer );
 
@@ -419,6 +425,11 @@ XLALInitMakefakedata ( ConfigVars_t *cfg, UserVariables_t *uvar )
   BOOLEAN have_channels= (uvar->inFrChannels != NULL);
   XLAL_CHECK ( !(have_frames || have_channels) || (have_frames && have_channels), XLAL_EINVAL, "Need both --inFrames and --inFrChannels, or NONE\n");
 
+  // ----- frequency-domain SFT synthesis produces no time-series
+  if ( uvar->SFTDterms > 0 ) {
+    XLAL_CHECK ( !have_frames && (uvar->outFrameDir == NULL) && (uvar->TDDfile == NULL), XLAL_EINVAL, "--SFTDterms>0 is incompatible with time-series input or output {--inFrames, --outFrameDir, --TDDfile}\n");
+  }
+
   // ----- IFOs : only from one of {--IFOs, --noiseSFTs, --inFrChannels}: mutually exclusive
   BOOLEAN have_IFOs      = (uvar->IFOs != NULL);
   BOOLEAN have_noiseSFTs = (uvar->noiseSFTs != NULL);
@@ -729,6 +740,8 @@ XLALInitUserVars ( UserVariables_t *uvar, int argc, char *argv[] )
   /* pulsar params */
   XLALRegisterUvarMember( injectionSources,     STRINGVector, 0, OPTIONAL, "%s", InjectionSourcesHelpString );
   XLALRegisterUvarMember( sourceDeltaT,         REAL8,  0, OPTIONAL, "Source-frame sampling period. '0' implies implies defaults set in XLALGeneratePulsarSignal()." );
+  XLALRegisterUvarMember( SFTDterms,            UINT4,  0, OPTIONAL, "If >0, synthesise SFTs directly in the frequency domain using this many Dirichlet-kernel terms either side of each signal frequency, "
+                          "instead of generating and Fourier-transforming a time-series (rectangular SFT window only; incompatible with time-series input or output)." );
 
   /* noise */
   XLALRegisterUvarMember( noiseSFTs,          STRING, 'D', OPTIONAL, "Noise-SFTs to be added to signal. Possibilities are:\n"
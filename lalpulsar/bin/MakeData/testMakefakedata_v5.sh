@@ -442,6 +442,46 @@ if ! eval ${right_win_call}; then
     exit 1
 fi
 
+echo
+echo "-------------------------------------------------------"
+echo " Test frequency-domain SFT synthesis (--SFTDterms) "
+echo "-------------------------------------------------------"
+## a low-frequency isolated signal, and Dterms covering the whole band, so that the
+## linear-phase approximation within each SFT and the truncated kernel are accurate
+mkdir -p fdSFT/
+fdInj="{Alpha=${s1_Alpha};Delta=${s1_Delta};refTime=${s1_refTime};Freq=50.3;f1dot=-1e-10;h0=${s1_h0};cosi=${s1_cosi};psi=${s1_psi};phi0=${s1_phi0};}"
+fd_CL="$mfdv5_CODE --IFOs=H1 --timestampsFiles=${timestamps1} --fmin=50 --Band=1 --injectionSources='${fdInj}' --outSingleSFT --outSFTdir=fdSFT/"
+cmdline="${fd_CL} --outLabel=mfdv5TD"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+cmdline="${fd_CL} --outLabel=mfdv5FD --SFTDterms=2000"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+fdtol=5e-2
+cmdline="$cmp_CODE -V -e ${fdtol} -1 './fdSFT/*_mfdv5TD-*.sft' -2 './fdSFT/*_mfdv5FD-*.sft'"
+echo ${cmdline}
+if ! eval $cmdline; then
+    echo "Failed. SFTs synthesised in the frequency domain differ from time-domain SFTs by more than ${fdtol}!"
+    exit 2
+else
+    echo "OK."
+fi
+cmdline="${fd_CL} --outLabel=mfdv5FD --SFTDterms=16 --SFTWindowType=hann"
+echo "Running frequency-domain SFT synthesis with a Hann window, should fail:"
+echo ${cmdline}
+if ! eval ${cmdline}; then
+    echo "Failed, as expected."
+else
+    echo "Did not fail, but it should have!"
+    exit 1
+fi
+
 echo
 echo "-------------------------------------------------------"
 echo " Test creation of SFTs with public filenames "
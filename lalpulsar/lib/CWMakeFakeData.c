@@ -45,11 +45,16 @@
 #include <lal/FFTWMutex.h>
 #include <lal/ExtrapolatePulsarSpins.h>
 #include <lal/ConfigFile.h>
+#include <lal/LALComputeAM.h>
+#include <lal/SSBtimes.h>
 
 // ---------- local defines
+#define DIRECT_SFT_SMALL_KAPPA 1e-9	// below this |kappa - k|, use the limit of the Dirichlet kernel
 
 // ---------- local macro definitions
 #define SQ(x) ( (x) * (x) )
+#define MYMAX(x,y) ( (x) > (y) ? (x) : (y) )
+#define MYMIN(x,y) ( (x) < (y) ? (x) : (y) )
 // ---------- local type definitions
 
 // ---------- Global variables
@@ -74,6 +79,7 @@ const char *const InjectionSourcesHelpString = "Source parameters to inject for
 
 // ---------- local prototypes
 static UINT4 gcd (UINT4 numer, UINT4 denom);
+static int XLALCWMakeFakeSFTsDirect ( SFTVector **SFTvect, const PulsarParamsVector *injectionSources, const CWMFDataParams *dataParams, UINT4 detectorIndex, const EphemerisData *edat );
 int XLALcorrect_phase ( SFTtype *sft, LIGOTimeGPS tHeterodyne );
 int XLALCheckConfigFileWasFullyParsed ( const char *fname, const LALParsedDataFile *cfgdata );
 
@@ -182,6 +188,17 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
   XLAL_CHECK ( detectorIndex < dataParams->multiTimestamps->length, XLAL_EINVAL );
   XLAL_CHECK ( (dataParams->inputMultiTS == NULL) || (detectorIndex < dataParams->inputMultiTS->length), XLAL_EINVAL );
 
+  // frequency-domain synthesis of SFTs, if requested: no time-series is generated at all
+  if ( dataParams->SFTDterms > 0 )
+    {
+      XLAL_CHECK ( (SFTvect != NULL) && (Tseries == NULL), XLAL_EINVAL, "Frequency-domain SFT synthesis (SFTDterms=%d) can only output SFTs, not time-series\n", dataParams->SFTDterms );
+      XLAL_CHECK ( dataParams->inputMultiTS == NULL, XLAL_EINVAL, "Frequency-domain SFT synthesis (SFTDterms=%d) cannot add input time-series\n", dataParams->SFTDterms );
+      XLAL_CHECK ( (dataParams->SFTWindowType == NULL) || (XLALStringCaseCompare ( dataParams->SFTWindowType, "rectangular" ) == 0), XLAL_EINVAL,
+                   "Frequency-domain SFT synthesis (SFTDterms=%d) only supports rectangular SFT windows, got '%s'\n", dataParams->SFTDterms, dataParams->SFTWindowType );
+      XLAL_CHECK ( XLALCWMakeFakeSFTsDirect ( SFTvect, injectionSources, dataParams, detectorIndex, edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+      return XLAL_SUCCESS;
+    } // if SFTDterms > 0
+
   // initial default values fMin, sampling rate from caller input or timeseries
   REAL8 fMin  = dataParams->fMin;
   REAL8 fBand = dataParams->Band;
@@ -395,6 +412,211 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
 } // XLALCWMakeFakeData()
 
 
+/**
+ * Frequency-domain variant of XLALCWMakeFakeData() for SFT output only: instead of generating and
+ * Fourier-transforming a time-series, each signal is synthesised directly into the 2*SFTDterms SFT bins
+ * around its instantaneous frequency, using the Dirichlet-kernel expansion of the 'Demod' F-statistic,
+ * and Gaussian noise is drawn directly for each SFT bin. The cost therefore scales with the number of
+ * signals and SFTDterms rather than with the SFT band.
+ *
+ * Within each SFT the signal phase is taken as linear in time, and the antenna-pattern functions and
+ * transient window as constant, all evaluated at the SFT midpoint. Signal power outside of the
+ * 2*SFTDterms bins, or outside of the SFT band, is dropped.
+ */
+static int
+XLALCWMakeFakeSFTsDirect ( SFTVector **SFTvect,
+                           const PulsarParamsVector *injectionSources,
+                           const CWMFDataParams *dataParams,
+                           UINT4 detectorIndex,	/* index for current detector in dataParams */
+                           const EphemerisData *edat
+                           )
+{
+  const LIGOTimeGPSVector *timestamps = dataParams->multiTimestamps->data[detectorIndex];
+  const LALDetector *site = &dataParams->multiIFO.sites[detectorIndex];
+  const REAL8 Tsft = timestamps->deltaT;
+  const UINT4 numSFTs = timestamps->length;
+  const INT4 Dterms = dataParams->SFTDterms;
+
+  // SFTs covering the requested band, the strict band is extracted at the end as for the time-domain SFTs
+  UINT4 firstBin, numBins;
+  XLAL_CHECK ( XLALFindCoveringSFTBins ( &firstBin, &numBins, dataParams->fMin, dataParams->Band, Tsft ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  int retn = XLAL_FAILURE;
+  SFTVector *sftVect = NULL;
+  CHAR *detPrefix = NULL;
+  REAL4TimeSeries *noise = NULL;
+  DetectorStateSeries *detStates = NULL;
+  SSBtimes **tSSB = NULL;
+  AMCoeffs **amcoe = NULL;
+  UINT4 *tWin0 = NULL, *tWin1 = NULL;
+  const UINT4 numPulsars = injectionSources ? injectionSources->length : 0;
+
+  XLAL_CHECK_FAIL ( (sftVect = XLALCreateSFTVector ( numSFTs, numBins )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_FAIL ( (detPrefix = XLALGetChannelPrefix ( site->frDetector.name )) != NULL, XLAL_EFUNC );
+  for ( UINT4 j = 0; j < numSFTs; j ++ )
+    {
+      SFTtype *thisSFT = &(sftVect->data[j]);
+      strcpy ( thisSFT->name, detPrefix );
+      thisSFT->epoch = timestamps->data[j];
+      thisSFT->f0 = firstBin / Tsft;
+      thisSFT->deltaF = 1.0 / Tsft;
+      memset ( thisSFT->data->data, 0, numBins * sizeof(thisSFT->data->data[0]) );
+    }
+
+  // add Gaussian noise if requested: white noise of one-sided PSD Sn has E[|X_k|^2] = Tsft * Sn / 2,
+  // ie. standard-deviation sqrt(Tsft * Sn) / 2 for each of the real and imaginary parts of an SFT bin
+  REAL8 sqrtSn = dataParams->multiNoiseFloor.sqrtSn[detectorIndex];
+  if ( sqrtSn > 0 )
+    {
+      LIGOTimeGPS XLAL_INIT_DECL(epoch0);
+      XLAL_CHECK_FAIL ( (noise = XLALCreateREAL4TimeSeries ( "noise", &epoch0, 0, 1, &lalDimensionlessUnit, 2 * numSFTs * numBins )) != NULL, XLAL_EFUNC );
+      memset ( noise->data->data, 0, noise->data->length * sizeof(noise->data->data[0]) );
+      INT4 randSeed = (dataParams->randSeed == 0) ? 0 : (dataParams->randSeed + detectorIndex);	// seed=0 means to use /dev/urandom, so don't touch it
+      XLAL_CHECK_FAIL ( XLALAddGaussianNoise ( noise, 0.5 * sqrtSn * sqrt ( Tsft ), randSeed ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( UINT4 j = 0; j < numSFTs; j ++ )
+        {
+          const REAL4 *noise_j = noise->data->data + 2 * j * numBins;
+          for ( UINT4 k = 0; k < numBins; k ++ ) {
+            sftVect->data[j].data->data[k] = crectf ( noise_j[2*k], noise_j[2*k+1] );
+          }
+        }
+      XLALDestroyREAL4TimeSeries ( noise );
+      noise = NULL;
+    } // if sqrtSn > 0
+
+  if ( numPulsars > 0 )
+    {
+      // detector states at the SFT midpoints
+      XLAL_CHECK_FAIL ( (detStates = XLALGetDetectorStates ( timestamps, site, edat, 0.5 * Tsft )) != NULL, XLAL_EFUNC );
+
+      // ----- per-signal SSB (and binary) timing and antenna-pattern functions, in parallel over signals
+      XLAL_CHECK_FAIL ( (tSSB = XLALCalloc ( numPulsars, sizeof(tSSB[0]) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( (amcoe = XLALCalloc ( numPulsars, sizeof(amcoe[0]) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( (tWin0 = XLALCalloc ( numPulsars, sizeof(tWin0[0]) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( (tWin1 = XLALCalloc ( numPulsars, sizeof(tWin1[0]) )) != NULL, XLAL_ENOMEM );
+      int errnum = 0;
+
+#pragma omp parallel for schedule(dynamic)
+      for ( UINT4 iInj = 0; iInj < numPulsars; iInj ++ )
+        {
+          const PulsarDopplerParams *Doppler = &(injectionSources->data[iInj].Doppler);
+          SkyPosition skypos;
+          skypos.longitude = Doppler->Alpha;
+          skypos.latitude  = Doppler->Delta;
+          skypos.system    = COORDINATESYSTEM_EQUATORIAL;
+
+          int ok = ( XLALGetTransientWindowTimespan ( &tWin0[iInj], &tWin1[iInj], injectionSources->data[iInj].Transient ) == XLAL_SUCCESS );
+          ok = ok && ( (tSSB[iInj] = XLALGetSSBtimes ( detStates, skypos, Doppler->refTime, SSBPREC_RELATIVISTICOPT )) != NULL );
+          ok = ok && ( (Doppler->asini <= 0) || (XLALAddBinaryTimes ( &tSSB[iInj], tSSB[iInj], Doppler ) == XLAL_SUCCESS) );
+          ok = ok && ( (amcoe[iInj] = XLALComputeAMCoeffs ( detStates, skypos )) != NULL );
+          if ( !ok )
+            {
+#pragma omp critical (CWMakeFakeSFTsDirect)
+              errnum = XLAL_EFUNC;
+            }
+        } // for iInj < numPulsars
+
+      // ----- synthesise all signals into the SFT bins, in parallel over SFTs so that no two threads write to the same SFT
+      if ( errnum == 0 )
+        {
+#pragma omp parallel for schedule(static)
+          for ( UINT4 j = 0; j < numSFTs; j ++ )
+            {
+              COMPLEX8 *data = sftVect->data[j].data->data;
+              UINT4 tMid = (UINT4) lround ( XLALGPSGetREAL8 ( &timestamps->data[j] ) + 0.5 * Tsft );
+
+              for ( UINT4 iInj = 0; iInj < numPulsars; iInj ++ )
+                {
+                  const PulsarParams *pulsarParams = &( injectionSources->data[iInj] );
+                  REAL8 win = XLALGetTransientWindowValue ( tMid, tWin0[iInj], tWin1[iInj], pulsarParams->Transient.tau, pulsarParams->Transient.type );
+                  if ( win <= 0 ) {
+                    continue;
+                  }
+
+                  // source-frame frequency and phase (in cycles) at the SFT midpoint
+                  REAL8 DT = tSSB[iInj]->DeltaT->data[j];
+                  REAL8 Tdot = tSSB[iInj]->Tdot->data[j];
+                  REAL8 freq = 0, phi = 0, Tas = 1;	// Tas = DT^s / s!
+                  for ( UINT4 s = 0; s < PULSAR_MAX_SPINS; s ++ )
+                    {
+                      REAL8 fsdot = pulsarParams->Doppler.fkdot[s];
+                      freq += fsdot * Tas;
+                      Tas *= DT / ( s + 1 );
+                      phi += fsdot * Tas;
+                    }
+
+                  // kappa = detector-frame frequency in units of SFT bins, phase at the SFT start, reduced to [0,1) cycles
+                  REAL8 kappa = freq * Tdot * Tsft;
+                  REAL8 phiStart = phi + pulsarParams->Amp.phi0 / LAL_TWOPI - 0.5 * kappa;
+                  phiStart -= floor ( phiStart );
+
+                  INT8 k0 = (INT8) floor ( kappa );
+                  INT8 kMin = MYMAX ( k0 - Dterms + 1, (INT8)firstBin );
+                  INT8 kMax = MYMIN ( k0 + Dterms, (INT8)firstBin + numBins - 1 );
+                  if ( kMin > kMax ) {
+                    continue;
+                  }
+
+                  // signal h = F+ A+ cos(Phi) + Fx Ax sin(Phi) = Re[ (F+ A+ - i Fx Ax) e^{i Phi} ]
+                  REAL8 a = amcoe[iInj]->a->data[j];
+                  REAL8 b = amcoe[iInj]->b->data[j];
+                  REAL8 sin2psi = sin ( 2.0 * pulsarParams->Amp.psi );
+                  REAL8 cos2psi = cos ( 2.0 * pulsarParams->Amp.psi );
+                  REAL8 Fplus  = a * cos2psi + b * sin2psi;
+                  REAL8 Fcross = b * cos2psi - a * sin2psi;
+                  COMPLEX16 Q = 0.5 * Tsft * win * crect ( Fplus * pulsarParams->Amp.aPlus, - Fcross * pulsarParams->Amp.aCross ) * cpolar ( 1.0, LAL_TWOPI * phiStart );
+
+                  // Dirichlet kernel: integral over the SFT of e^{2 pi i (kappa - k) t / Tsft} dt / Tsft
+                  REAL8 sin2pikappa = sin ( LAL_TWOPI * ( kappa - k0 ) );
+                  REAL8 cos2pikappa = cos ( LAL_TWOPI * ( kappa - k0 ) );
+                  for ( INT8 k = kMin; k <= kMax; k ++ )
+                    {
+                      REAL8 x = kappa - k;
+                      COMPLEX16 P;
+                      if ( fabs ( x ) < DIRECT_SFT_SMALL_KAPPA ) {
+                        P = 1;
+                      } else {
+                        P = crect ( sin2pikappa, 1.0 - cos2pikappa ) / ( LAL_TWOPI * x );
+                      }
+                      data[k - firstBin] += (COMPLEX8) ( Q * P );
+                    } // for k in [kMin, kMax]
+
+                } // for iInj < numPulsars
+            } // for j < numSFTs
+        } // if errnum == 0
+
+      XLAL_CHECK_FAIL ( errnum == 0, errnum, "Failed to compute timing or antenna-pattern functions of injection signals\n" );
+    } // if numPulsars > 0
+
+  // extract requested band
+  XLAL_CHECK_FAIL ( ((*SFTvect) = XLALExtractStrictBandFromSFTVector ( sftVect, dataParams->fMin, dataParams->Band )) != NULL, XLAL_EFUNC );
+
+  retn = XLAL_SUCCESS;
+XLAL_FAIL:
+
+  for ( UINT4 iInj = 0; iInj < numPulsars; iInj ++ )
+    {
+      if ( tSSB != NULL ) {
+        XLALDestroySSBtimes ( tSSB[iInj] );
+      }
+      if ( amcoe != NULL ) {
+        XLALDestroyAMCoeffs ( amcoe[iInj] );
+      }
+    }
+  XLALFree ( tSSB );
+  XLALFree ( amcoe );
+  XLALFree ( tWin0 );
+  XLALFree ( tWin1 );
+  XLALDestroyDetectorStateSeries ( detStates );
+  XLALDestroyREAL4TimeSeries ( noise );
+  XLALFree ( detPrefix );
+  XLALDestroySFTVector ( sftVect );
+
+  return retn;
+
+} // XLALCWMakeFakeSFTsDirect()
+
+
 /**
  * Generate a (heterodyned) REAL4 timeseries of a CW signal for given pulsarParams,
  * site, start-time, duration, and sampling-rate
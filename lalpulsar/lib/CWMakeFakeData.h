@@ -81,6 +81,7 @@ typedef struct tagCWMFDataParams
   UINT4 randSeed;				//!< seed value for random-number generator
   MultiREAL8TimeSeries *inputMultiTS;		//!< [optional] input time-series for signals+noise to be added to
   REAL8 sourceDeltaT;                           //!< [optional] source-frame sampling period. '0' means to use the previous internal defaults
+  UINT4 SFTDterms;				//!< [optional] if >0, synthesise SFTs directly in the frequency domain using this many Dirichlet-kernel terms either side of each signal frequency [SFT output only]. '0' means to generate SFTs from a time-series
 } CWMFDataParams;
 
 // ---------- Global variables ----------
@@ -45,6 +45,8 @@
 #include "ComputeFstat_internal.h"
 
 /* ----- MACRO definitions ---------- */
+#define TRANSIENT_MAP_ROW_BLOCK	16	// number of t0-rows per work unit in XLALComputeTransientFstatMapAndBstat()
+#define TRANSIENT_MAP_MAX_GROWTH	1e3	// recompute recursive exponential-window sums once their weights have grown by this factor
 
 /* ----- module-local fast lookup-table handling of negative exponentials ----- */
 /**
@@ -854,6 +856,425 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
 } /* XLALComputeTransientFstatMap() */
 
 
+/* ----- internal helpers for XLALComputeTransientFstatMapAndBstat() ----- */
+
+/** read-only quantities shared by all threads of the transient F-stat map engine */
+typedef struct tagTransientMapEngine {
+  transientWindowRange_t range;	/**< window range, with type TRANSIENT_NONE already replaced */
+  UINT4 N_t0Range;		/**< number of t0 values */
+  UINT4 N_tauRange;		/**< number of tau values */
+  BOOLEAN useFReg;		/**< return FReg = F - log(D) instead of F */
+  const FstatAtom *atoms;	/**< binned atoms, atoms[i] at t_i = t0_data + i * TAtom */
+  UINT4 numAtoms;		/**< number of binned atoms */
+  UINT4 TAtom;			/**< atoms time-step */
+  UINT4 t0_data;		/**< timestamp of the first binned atom */
+  REAL8 *cumA, *cumB, *cumC;	/**< rectangular windows: prefix sums of a2, b2, ab over atoms [0, i) */
+  COMPLEX16 *cumFa, *cumFb;	/**< rectangular windows: prefix sums of Fa, Fb over atoms [0, i) */
+  REAL8 *growth;		/**< exponential windows: e^(dt0/tau_n), rescaling the window weights from t0_m to t0_{m+1} */
+  REAL8 *growth2;		/**< exponential windows: e^(2*dt0/tau_n), the same for squared weights */
+} TransientMapEngine;
+
+/** per-thread running maximum of F and log-sum-exp of F_mn */
+typedef struct tagTransientMapSummary {
+  REAL8 maxF;			/**< loudest (unregularized) F encountered */
+  UINT4 m_ML, n_ML;		/**< map indices of maxF; m_ML == LAL_UINT4_MAX if nothing was computed */
+  REAL8 lseMax;			/**< offset of the running log-sum-exp of F_mn */
+  REAL8 lseSum;			/**< running sum of e^(F_mn - lseMax) */
+} TransientMapSummary;
+
+/* Fstat-atom index of the atom closest to the start-time t0, and of the last atom before the end-time t1;
+ * this is the same rounding as in XLALComputeTransientFstatMap(), but safe against times before the data */
+static inline UINT4
+transient_atom_index ( const TransientMapEngine *eng, UINT4 t, INT4 offset )
+{
+  INT8 i_tmp = ( (INT8)t - eng->t0_data + eng->TAtom/2 );
+  i_tmp = ( i_tmp < 0 ) ? offset : i_tmp / eng->TAtom + offset;
+  if ( i_tmp < 0 ) i_tmp = 0;
+  if ( i_tmp >= eng->numAtoms ) i_tmp = eng->numAtoms - 1;
+  return (UINT4) i_tmp;
+}
+
+/* e^(-(t_i - t0)/tau) for the binned atom i */
+static inline REAL8
+transient_exp_weight ( const TransientMapEngine *eng, UINT4 i, REAL8 t0, REAL8 tau )
+{
+  return exp ( - ( (REAL8)eng->t0_data + (REAL8)i * eng->TAtom - t0 ) / tau );
+}
+
+/* add (sign=+1) or remove (sign=-1) atom i with window weight w to/from the sums of one window */
+static inline void
+transient_add_atom ( const TransientMapEngine *eng, UINT4 i, REAL8 w, REAL8 sign, REAL8 *A, REAL8 *B, REAL8 *C, COMPLEX16 *Fa, COMPLEX16 *Fb )
+{
+  const FstatAtom *atom = &eng->atoms[i];
+  REAL8 w2 = sign * w * w;
+  w *= sign;
+  (*A) += w2 * atom->a2_alpha;
+  (*B) += w2 * atom->b2_alpha;
+  (*C) += w2 * atom->ab_alpha;
+  (*Fa) += w * atom->Fa_alpha;
+  (*Fb) += w * atom->Fb_alpha;
+}
+
+/* F-statistic of one map element, computed in the same single precision as XLALComputeTransientFstatMap();
+ * returns the value stored in the map (FReg if requested) and the plain F in *F_out */
+static inline REAL8
+transient_cell_Fstat ( REAL8 A, REAL8 B, REAL8 C, COMPLEX16 Fa, COMPLEX16 Fb, BOOLEAN useFReg, REAL4 *F_out )
+{
+  /* the recursive exponential-window sums can drift a rounding error below zero */
+  REAL4 Ad = ( A > 0 ) ? A : 0;
+  REAL4 Bd = ( B > 0 ) ? B : 0;
+  REAL4 Cd = C;
+  REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
+  REAL4 DdInv = 1.0f / Dd;
+  REAL4 twoF = compute_fstat_from_fa_fb ( (COMPLEX8)Fa, (COMPLEX8)Fb, Ad, Bd, Cd, 0, DdInv );
+  REAL4 F = 0.5 * twoF;
+  (*F_out) = F;
+  if ( useFReg )
+    F += log( DdInv );
+  return F;
+}
+
+/* record one map element in the running summary of a thread; rows are visited in increasing order
+ * within each thread, so the strict comparison keeps the first (m,n) as the sequential code does */
+static inline void
+transient_summary_add ( TransientMapSummary *sum, UINT4 m, UINT4 n, REAL4 F, REAL8 F_mn )
+{
+  if ( F > sum->maxF ) {
+    sum->maxF = F;
+    sum->m_ML = m;
+    sum->n_ML = n;
+  }
+  if ( F_mn > sum->lseMax ) {
+    sum->lseSum = sum->lseSum * exp ( sum->lseMax - F_mn ) + 1.0;
+    sum->lseMax = F_mn;
+  } else {
+    sum->lseSum += exp ( F_mn - sum->lseMax );
+  }
+}
+
+/*
+ * Compute rows [m0, m1) of the transient F-stat map. Each row is a vector over tau: for rectangular
+ * windows the sums are differences of the prefix sums, and for exponential windows the sums of row m-1
+ * are carried over to row m by removing the atoms that fell out of the window, rescaling all weights by
+ * e^(dt0/tau), and adding the atoms that came in. The sums are computed from scratch on the first row
+ * of the block, whenever consecutive windows do not overlap, and once the rescaling has grown by more than
+ * TRANSIENT_MAP_MAX_GROWTH, since the rounding errors left by removing atoms grow with it.
+ * The work arrays hold at least 6*N_tauRange REAL8s, 2*N_tauRange COMPLEX16s and 3*N_tauRange INT8s.
+ */
+static int
+transient_map_rows ( const TransientMapEngine *eng, UINT4 m0, UINT4 m1, gsl_matrix *F_mn, TransientMapSummary *sum,
+                     REAL8 *work, COMPLEX16 *cwork, INT8 *iwork )
+{
+  const UINT4 N = eng->N_tauRange;
+  const transientWindowRange_t *range = &eng->range;
+  REAL8 *restrict A = work;
+  REAL8 *restrict B = A + N;
+  REAL8 *restrict C = B + N;
+  REAL8 *restrict Frow = C + N;
+  REAL8 *restrict F4row = Frow + N;
+  REAL8 *restrict scale = F4row + N;
+  COMPLEX16 *restrict Fa = cwork;
+  COMPLEX16 *restrict Fb = Fa + N;
+  INT8 *restrict lo = iwork;
+  INT8 *restrict hi = lo + N;
+  INT8 *restrict hi_next = hi + N;
+  transientWindow_t win_mn;
+  win_mn.type = range->type;
+  UINT4 m, n;
+
+  for ( m = m0; m < m1; m ++ )
+    {
+      win_mn.t0 = range->t0 + m * range->dt0;
+      UINT4 i_t0 = transient_atom_index ( eng, win_mn.t0, 0 );
+
+      for ( n = 0; n < N; n ++ )
+        {
+          win_mn.tau = range->tau + n * range->dtau;
+          UINT4 t0, t1;
+          if ( XLALGetTransientWindowTimespan ( &t0, &t1, win_mn ) != XLAL_SUCCESS ) {
+            XLAL_ERROR ( XLAL_EFUNC );
+          }
+          UINT4 i_t1 = transient_atom_index ( eng, t1, -1 );
+
+          /* protection against degenerate 1-atom case: (this implies D=0 and therefore F->inf) */
+          if ( i_t1 == i_t0 ) {
+            XLALPrintError ("%s: encountered a single-atom Fstat-calculation. This is degenerate and cannot be computed!\n", __func__ );
+            XLALPrintError ("Window-values m=%d (t0=%d=t0_data + %d), n=%d (tau=%d)\n", m, win_mn.t0, i_t0 * eng->TAtom, n, win_mn.tau );
+            XLALPrintError ("The most likely cause is that your t0-range covered all of your data: t0 must stay away *at least* 2*TAtom from the end of the data!\n");
+            XLAL_ERROR ( XLAL_EDOM );
+          }
+
+          if ( range->type == TRANSIENT_RECTANGULAR )
+            {
+              A[n] = eng->cumA[i_t1 + 1] - eng->cumA[i_t0];
+              B[n] = eng->cumB[i_t1 + 1] - eng->cumB[i_t0];
+              C[n] = eng->cumC[i_t1 + 1] - eng->cumC[i_t0];
+              Fa[n] = eng->cumFa[i_t1 + 1] - eng->cumFa[i_t0];
+              Fb[n] = eng->cumFb[i_t1 + 1] - eng->cumFb[i_t0];
+              continue;
+            }
+
+          /* exponential window: the atoms in [i_t0, i_t1] with non-zero weight, ie. t0 <= t_i <= t1 */
+          INT8 lo_mn = i_t0, hi_mn = i_t1;
+          while ( lo_mn <= hi_mn && (INT8)eng->t0_data + lo_mn * eng->TAtom < (INT8)t0 ) lo_mn ++;
+          while ( hi_mn >= lo_mn && (INT8)eng->t0_data + hi_mn * eng->TAtom > (INT8)t1 ) hi_mn --;
+
+          if ( m > m0 && lo[n] <= hi[n] && lo_mn <= hi[n] && scale[n] < TRANSIENT_MAP_MAX_GROWTH )
+            {
+              /* remove the atoms which dropped out of the window, with their weights for t0_{m-1} */
+              REAL8 t0_prev = (REAL8)win_mn.t0 - range->dt0;
+              for ( INT8 i = lo[n]; i < lo_mn; i ++ ) {
+                transient_add_atom ( eng, i, transient_exp_weight ( eng, i, t0_prev, win_mn.tau ), -1, &A[n], &B[n], &C[n], &Fa[n], &Fb[n] );
+              }
+            }
+          else
+            {
+              A[n] = B[n] = C[n] = 0;
+              Fa[n] = Fb[n] = 0;
+              hi[n] = lo_mn - 1;
+              scale[n] = 1;
+            }
+          lo[n] = lo_mn;
+          hi_next[n] = hi_mn;
+        } /* for n < N */
+
+      if ( range->type == TRANSIENT_EXPONENTIAL )
+        {
+          /* move the weights of all carried-over sums from t0_{m-1} to t0_m */
+          if ( m > m0 )
+            {
+              for ( n = 0; n < N; n ++ )
+                {
+                  A[n] *= eng->growth2[n];
+                  B[n] *= eng->growth2[n];
+                  C[n] *= eng->growth2[n];
+                  Fa[n] *= eng->growth[n];
+                  Fb[n] *= eng->growth[n];
+                  scale[n] *= eng->growth2[n];
+                }
+            }
+
+          /* add the atoms which came into the window */
+          for ( n = 0; n < N; n ++ )
+            {
+              REAL8 t0 = (REAL8)win_mn.t0;
+              REAL8 tau = range->tau + n * range->dtau;
+              for ( INT8 i = ( hi[n] + 1 > lo[n] ) ? hi[n] + 1 : lo[n]; i <= hi_next[n]; i ++ ) {
+                transient_add_atom ( eng, i, transient_exp_weight ( eng, i, t0, tau ), +1, &A[n], &B[n], &C[n], &Fa[n], &Fb[n] );
+              }
+              hi[n] = hi_next[n];
+            }
+        } /* if exponential window */
+
+      /* generic F-stat calculation from A,B,C, Fa, Fb */
+      for ( n = 0; n < N; n ++ )
+        {
+          REAL4 F;
+          Frow[n] = transient_cell_Fstat ( A[n], B[n], C[n], Fa[n], Fb[n], eng->useFReg, &F );
+          F4row[n] = F;
+        }
+
+      for ( n = 0; n < N; n ++ )
+        {
+          transient_summary_add ( sum, m, n, F4row[n], Frow[n] );
+        }
+      if ( F_mn ) {
+        memcpy ( gsl_matrix_ptr ( F_mn, m, 0 ), Frow, N * sizeof(Frow[0]) );
+      }
+
+    } /* for m in [m0, m1) */
+
+  return XLAL_SUCCESS;
+
+} /* transient_map_rows() */
+
+
+/**
+ * Parallel engine computing the transient-window F-statistic map over start-time and timescale {t0, tau},
+ * as XLALComputeTransientFstatMap() does, together with the transient B-statistic of XLALComputeTransientBstat().
+ *
+ * The t0-rows of the map are distributed in blocks over OpenMP threads, and each row is computed as a vector
+ * over tau: rectangular windows are differences of prefix sums of the atoms, and exponential windows are updated
+ * recursively from one t0 to the next instead of summing over all atoms of every window.
+ * The B-statistic is accumulated on the fly, so the map itself is only stored if 'computeMap' is true;
+ * otherwise the returned struct has F_mn = NULL, and only holds the maximum-likelihood values maxF, t0_ML, tau_ML.
+ *
+ * Note: the exponential window weights and the B-statistic use the exact exponential, not the lookup-table
+ * XLALFastNegExp(), so the results differ from the sequential functions by the accuracy of that table.
+ * The sums are accumulated in double precision, and the F-statistic of each element is computed in single
+ * precision as in XLALComputeTransientFstatMap().
+ *
+ * Note2: if window->type == none, we compute a single rectangular window covering all the data.
+ */
+transientFstatMap_t *
+XLALComputeTransientFstatMapAndBstat ( REAL8 *logBstat,				/**< [out] transient B-statistic log(B_SG), or NULL if not required */
+                                       const MultiFstatAtomVector *multiFstatAtoms,	/**< [in] multi-IFO F-statistic atoms */
+                                       transientWindowRange_t windowRange,	/**< [in] type and parameters specifying transient window range to search */
+                                       BOOLEAN useFReg,				/**< [in] experimental switch: compute FReg = F - log(D) instead of F */
+                                       BOOLEAN computeMap			/**< [in] store the map F_mn in the returned struct */
+                                       )
+{
+  /* check input consistency */
+  XLAL_CHECK_NULL ( multiFstatAtoms && multiFstatAtoms->data && multiFstatAtoms->data[0], XLAL_EINVAL, "Invalid NULL input.\n" );
+  XLAL_CHECK_NULL ( windowRange.type < TRANSIENT_LAST, XLAL_EINVAL, "Unknown window-type (%d) passed as input. Allowed are [0,%d].\n", windowRange.type, TRANSIENT_LAST-1 );
+
+  /* ----- first combine all multi-atoms into a single atoms-vector with *unique* timestamps */
+  UINT4 TAtom = multiFstatAtoms->data[0]->TAtom;
+  FstatAtomVector *atoms = NULL;
+  transientFstatMap_t *ret = NULL;
+  TransientMapEngine XLAL_INIT_DECL(eng);
+  XLAL_CHECK_FAIL ( (atoms = XLALmergeMultiFstatAtomsBinned ( multiFstatAtoms, TAtom )) != NULL, XLAL_EFUNC );
+
+  eng.atoms = atoms->data;
+  eng.numAtoms = atoms->length;
+  eng.TAtom = TAtom;
+  eng.t0_data = atoms->data[0].timestamp;
+  eng.useFReg = useFReg;
+
+  /* ----- special treatment of window_type = none ==> replace by rectangular window spanning all the data */
+  if ( windowRange.type == TRANSIENT_NONE )
+    {
+      windowRange.type = TRANSIENT_RECTANGULAR;
+      windowRange.t0 = eng.t0_data;
+      windowRange.t0Band = 0;
+      windowRange.dt0 = TAtom;	/* irrelevant */
+      windowRange.tau = eng.numAtoms * TAtom;
+      windowRange.tauBand = 0;
+      windowRange.dtau = TAtom;	/* irrelevant */
+    }
+  eng.range = windowRange;
+  eng.N_t0Range  = (UINT4) floor ( windowRange.t0Band / windowRange.dt0 ) + 1;
+  eng.N_tauRange = (UINT4) floor ( windowRange.tauBand / windowRange.dtau ) + 1;
+  const UINT4 N_tau = eng.N_tauRange;
+
+  /* ----- prepare return container ----- */
+  XLAL_CHECK_FAIL ( (ret = XLALCalloc ( 1, sizeof(*ret) )) != NULL, XLAL_ENOMEM );
+  if ( computeMap ) {
+    XLAL_CHECK_FAIL ( (ret->F_mn = gsl_matrix_alloc ( eng.N_t0Range, N_tau )) != NULL, XLAL_ENOMEM, "gsl_matrix_alloc ( %d, %d ) failed.\n", eng.N_t0Range, N_tau );
+  }
+
+  if ( windowRange.type == TRANSIENT_RECTANGULAR )
+    {
+      /* prefix sums of the atoms, so that any window sum is a single difference */
+      XLAL_CHECK_FAIL ( (eng.cumA = XLALMalloc ( 3 * ( eng.numAtoms + 1 ) * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( (eng.cumFa = XLALMalloc ( 2 * ( eng.numAtoms + 1 ) * sizeof(COMPLEX16) )) != NULL, XLAL_ENOMEM );
+      eng.cumB = eng.cumA + eng.numAtoms + 1;
+      eng.cumC = eng.cumB + eng.numAtoms + 1;
+      eng.cumFb = eng.cumFa + eng.numAtoms + 1;
+      eng.cumA[0] = eng.cumB[0] = eng.cumC[0] = 0;
+      eng.cumFa[0] = eng.cumFb[0] = 0;
+      for ( UINT4 i = 0; i < eng.numAtoms; i ++ )
+        {
+          eng.cumA[i+1] = eng.cumA[i] + atoms->data[i].a2_alpha;
+          eng.cumB[i+1] = eng.cumB[i] + atoms->data[i].b2_alpha;
+          eng.cumC[i+1] = eng.cumC[i] + atoms->data[i].ab_alpha;
+          eng.cumFa[i+1] = eng.cumFa[i] + atoms->data[i].Fa_alpha;
+          eng.cumFb[i+1] = eng.cumFb[i] + atoms->data[i].Fb_alpha;
+        }
+    }
+  else
+    {
+      /* rescaling factors of the exponential window weights between consecutive start-times;
+       * these are only ever applied to overlapping windows, ie. dt0 <~ 3 tau, so cutting off huge
+       * values (which would only multiply zero sums) is safe */
+      XLAL_CHECK_FAIL ( (eng.growth = XLALMalloc ( 2 * N_tau * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+      eng.growth2 = eng.growth + N_tau;
+      for ( UINT4 n = 0; n < N_tau; n ++ )
+        {
+          REAL8 x = 1.0 * windowRange.dt0 / ( windowRange.tau + n * windowRange.dtau );
+          eng.growth[n]  = ( x < 300 ) ? exp ( x ) : 0;
+          eng.growth2[n] = ( x < 300 ) ? exp ( 2 * x ) : 0;
+        }
+    }
+
+  /* ----- compute the map in blocks of t0-rows, distributed over threads */
+  TransientMapSummary total = { -1.0, LAL_UINT4_MAX, LAL_UINT4_MAX, -INFINITY, 0 };
+  const UINT4 numBlocks = ( eng.N_t0Range + TRANSIENT_MAP_ROW_BLOCK - 1 ) / TRANSIENT_MAP_ROW_BLOCK;
+  int errnum = 0;
+
+#pragma omp parallel if ( numBlocks > 1 )
+  {
+    TransientMapSummary sum = { -1.0, LAL_UINT4_MAX, LAL_UINT4_MAX, -INFINITY, 0 };
+    REAL8 *work = XLALMalloc ( 6 * N_tau * sizeof(*work) );
+    COMPLEX16 *cwork = XLALMalloc ( 2 * N_tau * sizeof(*cwork) );
+    INT8 *iwork = XLALMalloc ( 3 * N_tau * sizeof(*iwork) );
+    int myerr = ( work && cwork && iwork ) ? 0 : XLAL_ENOMEM;
+    INT4 b;
+
+#pragma omp for schedule(dynamic)
+    for ( b = 0; b < (INT4)numBlocks; b ++ )
+      {
+        if ( myerr != 0 ) {
+          continue;
+        }
+        UINT4 m0 = b * TRANSIENT_MAP_ROW_BLOCK;
+        UINT4 m1 = ( m0 + TRANSIENT_MAP_ROW_BLOCK < eng.N_t0Range ) ? m0 + TRANSIENT_MAP_ROW_BLOCK : eng.N_t0Range;
+        if ( transient_map_rows ( &eng, m0, m1, ret->F_mn, &sum, work, cwork, iwork ) != XLAL_SUCCESS ) {
+          myerr = ( xlalErrno != 0 ) ? xlalErrno : XLAL_EFUNC;
+        }
+      }
+
+    XLALFree ( work );
+    XLALFree ( cwork );
+    XLALFree ( iwork );
+
+    /* combine the per-thread summaries, breaking ties in maxF in favour of the first (m,n) */
+#pragma omp critical (TransientFstatMap)
+    {
+      if ( myerr != 0 && errnum == 0 ) {
+        errnum = myerr;
+      }
+      if ( sum.m_ML != LAL_UINT4_MAX &&
+           ( total.m_ML == LAL_UINT4_MAX || sum.maxF > total.maxF
+             || ( sum.maxF == total.maxF && ( sum.m_ML < total.m_ML || ( sum.m_ML == total.m_ML && sum.n_ML < total.n_ML ) ) ) ) )
+        {
+          total.maxF = sum.maxF;
+          total.m_ML = sum.m_ML;
+          total.n_ML = sum.n_ML;
+        }
+      if ( sum.lseSum > 0 )
+        {
+          if ( sum.lseMax > total.lseMax ) {
+            total.lseSum = total.lseSum * exp ( total.lseMax - sum.lseMax ) + sum.lseSum;
+            total.lseMax = sum.lseMax;
+          } else {
+            total.lseSum += sum.lseSum * exp ( sum.lseMax - total.lseMax );
+          }
+        }
+    }
+  } /* omp parallel */
+
+  XLAL_CHECK_FAIL ( errnum == 0, errnum );
+
+  ret->maxF = total.maxF;
+  ret->t0_ML  = windowRange.t0  + total.m_ML * windowRange.dt0;
+  ret->tau_ML = windowRange.tau + total.n_ML * windowRange.dtau;
+
+  /* final normalized Bayes factor, assuming rhohMax=1, see XLALComputeTransientBstat() */
+  if ( logBstat ) {
+    REAL8 normBh = 70.0 / ( eng.N_t0Range * N_tau );
+    (*logBstat) = log ( normBh ) + total.lseMax + log ( total.lseSum );
+  }
+
+  /* free internal mem */
+  XLALFree ( eng.cumA );
+  XLALFree ( eng.cumFa );
+  XLALFree ( eng.growth );
+  XLALDestroyFstatAtomVector ( atoms );
+
+  return ret;
+
+XLAL_FAIL:
+  XLALFree ( eng.cumA );
+  XLALFree ( eng.cumFa );
+  XLALFree ( eng.growth );
+  XLALDestroyFstatAtomVector ( atoms );
+  XLALDestroyTransientFstatMap ( ret );
+  return NULL;
+
+} /* XLALComputeTransientFstatMapAndBstat() */
+
+
 
 
 /**
@@ -129,6 +129,12 @@ transientFstatMap_t *XLALComputeTransientFstatMap ( const MultiFstatAtomVector *
                                                     transientWindowRange_t windowRange,
                                                     BOOLEAN useFReg );
 
+transientFstatMap_t *XLALComputeTransientFstatMapAndBstat ( REAL8 *logBstat,
+                                                           const MultiFstatAtomVector *multiFstatAtoms,
+                                                           transientWindowRange_t windowRange,
+                                                           BOOLEAN useFReg,
+                                                           BOOLEAN computeMap );
+
 REAL8 XLALComputeTransientBstat ( transientWindowRange_t windowRange, const transientFstatMap_t *FstatMap );
 pdf1D_t *XLALComputeTransientPosterior_t0  ( transientWindowRange_t windowRange, const transientFstatMap_t *FstatMap );
 pdf1D_t *XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange, const transientFstatMap_t *FstatMap );
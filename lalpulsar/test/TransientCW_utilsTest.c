@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/*********************************************************************************/
+/**
+ * \file
+ * \brief Test for XLALComputeTransientFstatMapAndBstat().
+ *
+ * Compares the transient F-stat map and B-statistic of the parallel engine against
+ * XLALComputeTransientFstatMap() and XLALComputeTransientBstat() for rectangular windows,
+ * and against a direct sum over all atoms of each window for exponential windows.
+ */
+#include <math.h>
+
+#include <lal/TransientCW_utils.h>
+#include <lal/LALComputeAM.h>
+
+#define TATOM 1800
+#define TSTART 1000000000
+#define SQ(x) ((x)*(x))
+
+/* random F-stat atoms for two detectors with gaps, and a 'signal' in part of the data */
+static MultiFstatAtomVector *
+make_atoms ( UINT4 numAtoms )
+{
+  MultiFstatAtomVector *multiAtoms;
+  XLAL_CHECK_NULL ( (multiAtoms = XLALCreateMultiFstatAtomVector ( 2 )) != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < 2; X ++ )
+    {
+      FstatAtomVector *atoms;
+      XLAL_CHECK_NULL ( (atoms = multiAtoms->data[X] = XLALCreateFstatAtomVector ( numAtoms )) != NULL, XLAL_EFUNC );
+      atoms->TAtom = TATOM;
+      UINT4 k = 0;
+      for ( UINT4 i = 0; i < numAtoms; i ++ )
+        {
+          if ( X == 0 && (i % 7) == 3 ) {
+            continue;
+          }
+          REAL4 a = 1.0 * rand() / RAND_MAX - 0.5;
+          REAL4 b = 1.0 * rand() / RAND_MAX - 0.5;
+          REAL4 sig = ( i > numAtoms / 3 && i < numAtoms / 2 ) ? 5 : 0;
+          FstatAtom *atom = &atoms->data[k++];
+          atom->timestamp = TSTART + i * TATOM;
+          atom->a2_alpha = a * a;
+          atom->b2_alpha = b * b;
+          atom->ab_alpha = a * b;
+          atom->Fa_alpha = crectf ( 3.0 * rand() / RAND_MAX - 1.5 + sig * a, 3.0 * rand() / RAND_MAX - 1.5 );
+          atom->Fb_alpha = crectf ( 3.0 * rand() / RAND_MAX - 1.5 + sig * b, 3.0 * rand() / RAND_MAX - 1.5 );
+        }
+      atoms->length = k;
+    }
+  return multiAtoms;
+}
+
+/* reference F_mn of an exponential window, summing over all its atoms with the exact exponential */
+static REAL8
+exp_window_Fstat ( const FstatAtomVector *atoms, UINT4 t0, UINT4 tau )
+{
+  UINT4 t1 = lround ( t0 + TRANSIENT_EXP_EFOLDING * tau );
+  REAL8 A = 0, B = 0, C = 0;
+  COMPLEX16 Fa = 0, Fb = 0;
+  UINT4 t0_data = atoms->data[0].timestamp;
+  INT4 i_t0 = ( (INT4)t0 - (INT4)t0_data + TATOM/2 ) / TATOM;
+  INT4 i_t1 = ( (INT4)t1 - (INT4)t0_data + TATOM/2 ) / TATOM - 1;
+  if ( i_t0 < 0 ) i_t0 = 0;
+  if ( i_t1 >= (INT4)atoms->length ) i_t1 = atoms->length - 1;
+  for ( INT4 i = i_t0; i <= i_t1; i ++ )
+    {
+      UINT4 t_i = t0_data + i * TATOM;
+      if ( t_i < t0 || t_i > t1 ) {
+        continue;
+      }
+      REAL8 w = exp ( - 1.0 * ( t_i - t0 ) / tau );
+      A += w * w * atoms->data[i].a2_alpha;
+      B += w * w * atoms->data[i].b2_alpha;
+      C += w * w * atoms->data[i].ab_alpha;
+      Fa += w * atoms->data[i].Fa_alpha;
+      Fb += w * atoms->data[i].Fb_alpha;
+    }
+  REAL8 Dd = XLALComputeAntennaPatternSqrtDeterminant ( A, B, C, 0 );
+  return ( B * SQ(cabs(Fa)) + A * SQ(cabs(Fb)) - 2.0 * C * creal ( Fa * conj(Fb) ) ) / Dd;
+}
+
+static int
+compare_maps ( const transientFstatMap_t *map, const transientFstatMap_t *mapNoF, REAL8 logB, REAL8 logBNoF )
+{
+  XLAL_CHECK ( mapNoF->F_mn == NULL, XLAL_EFAILED, "F_mn was computed although not requested\n" );
+  XLAL_CHECK ( map->maxF == mapNoF->maxF && map->t0_ML == mapNoF->t0_ML && map->tau_ML == mapNoF->tau_ML, XLAL_EFAILED,
+               "maxF, t0_ML, tau_ML differ without map: %g, %d, %d != %g, %d, %d\n",
+               mapNoF->maxF, mapNoF->t0_ML, mapNoF->tau_ML, map->maxF, map->t0_ML, map->tau_ML );
+  XLAL_CHECK ( fabs ( logB - logBNoF ) < 1e-12 * fabs ( logB ), XLAL_EFAILED, "logBstat differs without map: %.16g != %.16g\n", logBNoF, logB );
+  return XLAL_SUCCESS;
+}
+
+int main ( void )
+{
+  srand ( 1 );
+  MultiFstatAtomVector *multiAtoms;
+  XLAL_CHECK_MAIN ( (multiAtoms = make_atoms ( 600 )) != NULL, XLAL_EFUNC );
+
+  /* ---------- rectangular windows: compare against XLALComputeTransientFstatMap() and XLALComputeTransientBstat() ---------- */
+  transientWindowRange_t rect = { TRANSIENT_RECTANGULAR, TSTART + TATOM, 400 * TATOM, 3600, 2 * TATOM, 100 * TATOM, 900 };
+  transientFstatMap_t *ref, *map, *mapNoF;
+  REAL8 logB, logBNoF;
+  XLAL_CHECK_MAIN ( (ref = XLALComputeTransientFstatMap ( multiAtoms, rect, 0 )) != NULL, XLAL_EFUNC );
+  REAL8 logBref = XLALComputeTransientBstat ( rect, ref );
+  XLAL_CHECK_MAIN ( xlalErrno == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( (map = XLALComputeTransientFstatMapAndBstat ( &logB, multiAtoms, rect, 0, 1 )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( (mapNoF = XLALComputeTransientFstatMapAndBstat ( &logBNoF, multiAtoms, rect, 0, 0 )) != NULL, XLAL_EFUNC );
+
+  XLAL_CHECK_MAIN ( map->F_mn->size1 == ref->F_mn->size1 && map->F_mn->size2 == ref->F_mn->size2, XLAL_EFAILED );
+  for ( UINT4 m = 0; m < ref->F_mn->size1; m ++ )
+    {
+      for ( UINT4 n = 0; n < ref->F_mn->size2; n ++ )
+        {
+          REAL8 F_ref = gsl_matrix_get ( ref->F_mn, m, n );
+          REAL8 F = gsl_matrix_get ( map->F_mn, m, n );
+          XLAL_CHECK_MAIN ( fabs ( F - F_ref ) <= 1e-4 * ( 1 + F_ref ), XLAL_EFAILED, "rectangular F_mn(%d,%d) = %g differs from %g\n", m, n, F, F_ref );
+        }
+    }
+  XLAL_CHECK_MAIN ( map->t0_ML == ref->t0_ML && map->tau_ML == ref->tau_ML, XLAL_EFAILED,
+                    "(t0_ML, tau_ML) = (%d, %d) differs from (%d, %d)\n", map->t0_ML, map->tau_ML, ref->t0_ML, ref->tau_ML );
+  XLAL_CHECK_MAIN ( fabs ( map->maxF - ref->maxF ) <= 1e-4 * ref->maxF, XLAL_EFAILED, "maxF = %g differs from %g\n", map->maxF, ref->maxF );
+  /* XLALComputeTransientBstat() uses a lookup-table for e^-x */
+  XLAL_CHECK_MAIN ( fabs ( logB - logBref ) < 1e-2, XLAL_EFAILED, "logBstat = %g differs from %g\n", logB, logBref );
+  XLAL_CHECK_MAIN ( compare_maps ( map, mapNoF, logB, logBNoF ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyTransientFstatMap ( ref );
+  XLALDestroyTransientFstatMap ( map );
+  XLALDestroyTransientFstatMap ( mapNoF );
+
+  /* ---------- exponential windows: compare against direct sums with exact exponentials ---------- */
+  transientWindowRange_t expw = { TRANSIENT_EXPONENTIAL, TSTART + 1000, 300 * TATOM, 5000, TATOM, 60 * TATOM, 777 };
+  FstatAtomVector *atoms;
+  XLAL_CHECK_MAIN ( (atoms = XLALmergeMultiFstatAtomsBinned ( multiAtoms, TATOM )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( (map = XLALComputeTransientFstatMapAndBstat ( &logB, multiAtoms, expw, 0, 1 )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( (mapNoF = XLALComputeTransientFstatMapAndBstat ( &logBNoF, multiAtoms, expw, 0, 0 )) != NULL, XLAL_EFUNC );
+
+  REAL8 maxF = -1, sum_eF = 0;
+  for ( UINT4 m = 0; m < map->F_mn->size1; m ++ )
+    {
+      for ( UINT4 n = 0; n < map->F_mn->size2; n ++ )
+        {
+          REAL8 F_ref = exp_window_Fstat ( atoms, expw.t0 + m * expw.dt0, expw.tau + n * expw.dtau );
+          REAL8 F = gsl_matrix_get ( map->F_mn, m, n );
+          XLAL_CHECK_MAIN ( fabs ( F - F_ref ) <= 1e-4 * ( 1 + F_ref ), XLAL_EFAILED, "exponential F_mn(%d,%d) = %g differs from %g\n", m, n, F, F_ref );
+          maxF = fmax ( maxF, F_ref );
+        }
+    }
+  for ( UINT4 m = 0; m < map->F_mn->size1; m ++ )
+    {
+      for ( UINT4 n = 0; n < map->F_mn->size2; n ++ )
+        {
+          sum_eF += exp ( gsl_matrix_get ( map->F_mn, m, n ) - maxF );
+        }
+    }
+  logBref = log ( 70.0 / ( map->F_mn->size1 * map->F_mn->size2 ) ) + maxF + log ( sum_eF );
+  XLAL_CHECK_MAIN ( fabs ( map->maxF - maxF ) <= 1e-4 * maxF, XLAL_EFAILED, "maxF = %g differs from %g\n", map->maxF, maxF );
+  XLAL_CHECK_MAIN ( fabs ( logB - logBref ) < 1e-4 * fabs ( logBref ), XLAL_EFAILED, "logBstat = %g differs from %g\n", logB, logBref );
+  XLAL_CHECK_MAIN ( compare_maps ( map, mapNoF, logB, logBNoF ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyTransientFstatMap ( map );
+  XLALDestroyTransientFstatMap ( mapNoF );
+  XLALDestroyFstatAtomVector ( atoms );
+  XLALDestroyMultiFstatAtomVector ( multiAtoms );
+  XLALDestroyExpLUT();
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} /* main() */